@@ -29,7 +29,8 @@ namespace Phoenix
 	bool FEngineConfig::Read()
 	{
 		bool bWindowParseSuccess = ParseWindowConfig();
-		bool bParseSuccess = bWindowParseSuccess; // && OtherSuccess && OtherSuccess, etc
+		bool bHeadlessParseSuccess = ParseHeadlessConfig();
+		bool bParseSuccess = bWindowParseSuccess && bHeadlessParseSuccess; // && OtherSuccess && OtherSuccess, etc
 
 		ConfigFile.Close();
 
@@ -41,9 +42,24 @@ namespace Phoenix
 		const int WindowX = IntFromString(INIParser.GetValue(CONFIG_INI_WINDOW_SETTINGS_SECTION, CONFIG_INI_WINDOW_WIDTH_KEY, "1024"));
 		const int WindowY = IntFromString(INIParser.GetValue(CONFIG_INI_WINDOW_SETTINGS_SECTION, CONFIG_INI_WINDOW_HEIGHT_KEY, "768"));
 		const FString WindowTitle = INIParser.GetValue(CONFIG_INI_WINDOW_SETTINGS_SECTION, CONFIG_INI_WINDOW_TITLE_KEY, "DefaultTitle");
+		const int DrawsPerSec = IntFromString(INIParser.GetValue(CONFIG_INI_WINDOW_SETTINGS_SECTION, CONFIG_INI_WINDOW_DRAWS_PER_SEC_KEY, "0"));
 
 		WindowConfig.Dimensions = FVector2D(WindowX, WindowY);
 		WindowConfig.Title = WindowTitle;
+		WindowConfig.DrawsPerSec = DrawsPerSec > 0 ? static_cast<Float32>(DrawsPerSec) : 0.f;
+
+		return true;
+	}
+
+	bool FEngineConfig::ParseHeadlessConfig()
+	{
+		const int Enabled = IntFromString(INIParser.GetValue(CONFIG_INI_HEADLESS_SETTINGS_SECTION, CONFIG_INI_HEADLESS_ENABLED_KEY, "0"));
+		const int Paced = IntFromString(INIParser.GetValue(CONFIG_INI_HEADLESS_SETTINGS_SECTION, CONFIG_INI_HEADLESS_PACED_KEY, "0"));
+		const int MaxUpdateCount = IntFromString(INIParser.GetValue(CONFIG_INI_HEADLESS_SETTINGS_SECTION, CONFIG_INI_HEADLESS_MAX_UPDATE_COUNT_KEY, "0"));
+
+		HeadlessConfig.Enabled = Enabled != 0;
+		HeadlessConfig.Paced = Paced != 0;
+		HeadlessConfig.MaxUpdateCount = MaxUpdateCount > 0 ? static_cast<UInt32>(MaxUpdateCount) : 0;
 
 		return true;
 	}
@@ -4,6 +4,7 @@
 
 #include "Math/Vector2D.h"
 #include "Utility/FileIO/File.h"
+#include "Utility/Misc/Primitives.h"
 #include "Utility/Misc/String.h"
 
 namespace Phoenix
@@ -25,11 +26,52 @@ namespace Phoenix
 			return Title;
 		}
 
+		// Draws are paced to this rate.  Zero paces them to the display's refresh rate.
+		inline Float32 GetDrawsPerSec() const
+		{
+			return DrawsPerSec;
+		}
+
 	private:
 
 		FVector2D Dimensions;
 
 		FString Title;
+
+		Float32 DrawsPerSec{ 0.f };
+	};
+
+	class FHeadlessConfig
+	{
+		friend class FEngineConfig;
+
+	public:
+
+		// Runs the game thread without a window, audio or rendering.
+		inline bool IsEnabled() const
+		{
+			return Enabled;
+		}
+
+		// Paces the fixed steps in real time instead of running them back to back.
+		inline bool IsPaced() const
+		{
+			return Paced;
+		}
+
+		// The game thread shuts down after this many fixed steps.  Zero runs until shut down.
+		inline UInt32 GetMaxUpdateCount() const
+		{
+			return MaxUpdateCount;
+		}
+
+	private:
+
+		bool Enabled{ false };
+
+		bool Paced{ false };
+
+		UInt32 MaxUpdateCount{ 0 };
 	};
 
 	class FEngineConfig
@@ -50,17 +92,26 @@ namespace Phoenix
 			return WindowConfig;
 		}
 
+		inline const FHeadlessConfig& GetHeadlessConfig() const
+		{
+			return HeadlessConfig;
+		}
+
 		bool Read();
 
 	private:
 
 		bool ParseWindowConfig();
 
+		bool ParseHeadlessConfig();
+
 		FFile ConfigFile;
 
 		FINIParser INIParser;
 
 		FWindowConfig WindowConfig;
+
+		FHeadlessConfig HeadlessConfig;
 	};
 
 }
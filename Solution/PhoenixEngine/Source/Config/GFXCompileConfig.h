@@ -34,7 +34,7 @@
 // This flag is used to determine if graphics calls occur on the same thread when QueueRender is called,
 // or on one or more threads that are handled by the gfx engine itself.
 #ifndef PHOENIX_GFX_ENABLE_MULTI_THREADED_RENDERING
-#	define PHOENIX_GFX_ENABLE_MULTI_THREADED_RENDERING 0
+#	define PHOENIX_GFX_ENABLE_MULTI_THREADED_RENDERING 1
 #endif
 
 // This flag is used to determine if certain graphics calls are profiled.
@@ -51,3 +51,10 @@
 #ifndef PHOENIX_GFX_USE_MAX_THREADS_FOR_LOADING
 #	define PHOENIX_GFX_USE_MAX_THREADS_FOR_LOADING 1
 #endif
+
+// This flag is used to determine if gl calls are recorded by FGLRecorder instead of being sent to a gpu,
+// which allows the gfx engine to run on machines without one.  The engine also swaps its window for an
+// FHeadlessWindow, so no display or graphics context is needed either.
+#ifndef PHOENIX_GFX_USE_RECORDING_GL
+#	define PHOENIX_GFX_USE_RECORDING_GL 0
+#endif
@@ -14,6 +14,11 @@
 #define CONFIG_INI_WINDOW_WIDTH_KEY "WindowWidth"
 #define CONFIG_INI_WINDOW_HEIGHT_KEY "WindowHeight"
 #define CONFIG_INI_WINDOW_TITLE_KEY "WindowTitle"
+#define CONFIG_INI_WINDOW_DRAWS_PER_SEC_KEY "DrawsPerSec"
+#define CONFIG_INI_HEADLESS_SETTINGS_SECTION "HeadlessSettings"
+#define CONFIG_INI_HEADLESS_ENABLED_KEY "Enabled"
+#define CONFIG_INI_HEADLESS_PACED_KEY "Paced"
+#define CONFIG_INI_HEADLESS_MAX_UPDATE_COUNT_KEY "MaxUpdateCount"
 
 #pragma endregion
 
@@ -1,14 +1,17 @@
 #include "Stdafx.h"
 #include "Core/Engine.h"
 
+#include "Config/GFXCompileConfig.h"
 #include "Utility/Debug/Debug.h"
 #include "Utility/Debug/Profiler.h"
 #include "Utility/FileIO/Endian.h"
 #include "Utility/Misc/Primitives.h"
 #include "Utility/Misc/Timer.h"
+#include "Utility/Threading/FramePacer.h"
 #include "Utility/Threading/Thread.h"
 #include "Math/Math.h"
 #include "Platform/Window/GenericWindow.h"
+#include "Platform/Window/HeadlessWindow.h"
 #include "Components/Cores/RenderCore.h"
 
 using namespace Phoenix;
@@ -28,6 +31,9 @@ void FEngine::Run(FGameThread::FCreateGameSceneFunc CreateGameSceneFunc)
 	FHighResolutionTimer Timer;
 	Timer.Reset();
 
+	FFramePacer FramePacer;
+	FramePacer.Init(FramesPerSec);
+
 	while (IsRunning)
 	{
 		Timer.Update();
@@ -37,11 +43,13 @@ void FEngine::Run(FGameThread::FCreateGameSceneFunc CreateGameSceneFunc)
 		if (AccumulatedTime >= MaxDeltaTime)
 		{
 			AccumulatedTime = FMathf::Modulo(AccumulatedTime, MaxDeltaTime);
-			Window->ProcessEvents();
-			GamePadUtility.ProcessEvents(EventHandler);
+			if (Window)
+			{
+				Window->ProcessEvents();
+				GamePadUtility.ProcessEvents(EventHandler);
+			}
 
-			OutgoingEvents.AddData(EventHandler.GetEvents());
-			EventHandler.GetEvents().clear();
+			SendEvents(EventHandler.GetEvents());
 			IncomingEvents.GetDataAndClear(ReceivedEvents);
 
 			for (SizeT I = 0; I < ReceivedEvents.size(); ++I)
@@ -53,9 +61,12 @@ void FEngine::Run(FGameThread::FCreateGameSceneFunc CreateGameSceneFunc)
 			ReceivedEvents.clear();
 		}
 
-		NThread::SleepThread(1);
+		FramePacer.WaitForNextFrame();
 	}
 
+	F_Log("Main Thread pacing.  Spin margin: " << FramePacer.GetSpinMarginSeconds() * 1000000.f << "us "
+		<< FramePacer.GetStats());
+
 	DeInit();
 }
 
@@ -69,13 +80,22 @@ void FEngine::Init(FGameThread::FCreateGameSceneFunc CreateGameSceneFunc)
 	FHighResolutionTimer::GetTimeInSeconds();
 	EngineConfig.Read();
 
+	const FHeadlessConfig& HeadlessConfig = EngineConfig.GetHeadlessConfig();
+	F_LogIf(HeadlessConfig.IsEnabled(), "Running headless.  Window, audio and rendering are disabled.");
+
+	if (!HeadlessConfig.IsEnabled())
 	{
 		const FWindowConfig& WindowConfig = EngineConfig.GetWindowConfig();
 
 		const FVector2D& WindowDimensions = WindowConfig.GetDimensions();
 		const FString& WindowTitle = WindowConfig.GetTitle();
 
+#if PHOENIX_GFX_USE_RECORDING_GL
+		// Recorded GL needs no context, so nothing here should require a display either.
+		Window = std::make_shared<FHeadlessWindow>(WindowDimensions.x, WindowDimensions.y, WindowTitle);
+#else
 		Window = std::make_shared<FGenericWindow>(WindowDimensions.x, WindowDimensions.y, WindowTitle);
+#endif
 		Window->SetEventHandler(&EventHandler);
 	}
 
@@ -86,13 +106,24 @@ void FEngine::Init(FGameThread::FCreateGameSceneFunc CreateGameSceneFunc)
 		InitParams.OutgoingEvents = &IncomingEvents;
 		InitParams.IncomingEvents = &OutgoingEvents;
 		InitParams.CreateGameSceneFunc = CreateGameSceneFunc;
+		InitParams.HeadlessConfig = HeadlessConfig;
+
+		// GLFW only answers display queries on the main thread, so the rate is settled here.
+		if (Window)
+		{
+			const Float32 ConfigDrawsPerSec = EngineConfig.GetWindowConfig().GetDrawsPerSec();
+			InitParams.DrawsPerSec = ConfigDrawsPerSec > 0.f ? ConfigDrawsPerSec : static_cast<Float32>(Window->GetRefreshRate());
+		}
 
 		GameThread.Init(InitParams);
 		F_Assert(GameThread.IsValid(), "Game Thread failed to initialize.");
 	}
 
-	GamePadUtility.Init(EventHandler);
-	F_Assert(GamePadUtility.IsValid(), "GamePadUtility failed to initialize.");
+	if (Window)
+	{
+		GamePadUtility.Init(EventHandler);
+		F_Assert(GamePadUtility.IsValid(), "GamePadUtility failed to initialize.");
+	}
 
 	IsRunning = true;
 	F_Assert(IsValid(), "Initialization was successful but this class is not valid.");
@@ -105,7 +136,11 @@ bool FEngine::IsValid() const
 
 void FEngine::DeInit()
 {
-	GamePadUtility.DeInit(EventHandler);
+	if (Window)
+	{
+		GamePadUtility.DeInit(EventHandler);
+	}
+
 	GameThread.ForceShutDown();
 	IsRunning = false;
 	F_LogClose();
@@ -125,3 +160,34 @@ void FEngine::HandleEvent(const FEvent& Event)
 		}
 	}
 }
+
+void FEngine::SendEvents(TVector<FEvent>& Events)
+{
+	SizeT SentCount = 0;
+
+	for (const FEvent& Event : Events)
+	{
+		if (!OutgoingEvents.TryPush(Event))
+		{
+			break;
+		}
+
+		++SentCount;
+	}
+
+	// Whatever did not fit is kept in order and sent again on the next tick.  The ring
+	// stays full for as long as the game thread lags, so that is only reported once.
+	const SizeT DeferredCount = Events.size() - SentCount;
+	if (DeferredCount)
+	{
+		F_LogWarningIf(!DeferredEventCount, "Event ring is full.  Events will be deferred until the game thread catches up.");
+		DeferredEventCount += DeferredCount;
+	}
+	else if (DeferredEventCount)
+	{
+		F_Log("Event ring has room again.  " << DeferredEventCount << " event deferrals in total.");
+		DeferredEventCount = 0;
+	}
+
+	Events.erase(Events.begin(), Events.begin() + SentCount);
+}
@@ -37,10 +37,12 @@ namespace Phoenix
 
 		FGamePadUtility GamePadUtility;
 		FEventHandler EventHandler;
-		TThreadSafeVector<FEvent> OutgoingEvents;
+		FGameThread::FEventRing OutgoingEvents;
 		TThreadSafeVector<FEvent> IncomingEvents;
 
 		bool IsRunning{ false };
+		/*! \brief Events deferred since the ring last filled up, or 0 if it has room. */
+		SizeT DeferredEventCount{ 0 };
 
 		void Init(FGameThread::FCreateGameSceneFunc CreateGameSceneFunc);
 
@@ -50,6 +52,8 @@ namespace Phoenix
 
 		void HandleEvent(const FEvent& Event);
 
+		void SendEvents(TVector<FEvent>& Events);
+
 	};
 }
 
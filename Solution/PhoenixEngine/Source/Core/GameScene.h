@@ -5,6 +5,7 @@
 #include "Components/ComponentStorage.h"
 #include "GameObject/GameObject.h"
 #include "GameObject/GameObjectIdPool.h"
+#include "Utility/Containers/FlatHashMap.h"
 #include "Utility/Misc/Primitives.h"
 
 #include "ECS/ComponentManager.h"
@@ -25,7 +26,7 @@ namespace Phoenix
 			}
 		};
 
-		typedef std::unordered_map<TypeId, std::unique_ptr<BaseCore, CoreDeleter>> CoreArray;
+		typedef TFlatHashMap<TypeId, std::unique_ptr<BaseCore, CoreDeleter>> CoreArray;
 	public:
 		FGameScene();
 
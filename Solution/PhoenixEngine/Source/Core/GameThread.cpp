@@ -7,7 +7,10 @@
 #include "Utility/Debug/Profiler.h"
 #include "Utility/Misc/Algorithm.h"
 #include "Utility/Misc/Allocator.h"
+#include "Utility/Misc/FrameAllocator.h"
+#include "Utility/Misc/MemoryTracker.h"
 #include "Utility/Misc/Timer.h"
+#include "Utility/Threading/FramePacer.h"
 #include "ECS/ComponentManagerImpl.h"
 #include "Math/Math.h"
 #include "Platform/Input/Keys.h"
@@ -17,12 +20,21 @@
 
 using namespace Phoenix;
 
+namespace FGameThreadConstants
+{
+	// The simulation runs at a fixed rate while draws interpolate between its last two
+	// steps, so presentation can run faster than the simulation and stay smooth.
+	const Float32 FramesPerSec = 30.f;
+	/*! \brief Used when neither the config nor the display gives a draw rate. */
+	const Float32 DefaultDrawsPerSec = 60.f;
+}
+
 FGameThread::FGameThread() = default; //to allow fwd declare for unique_ptr
 
 bool FGameThread::FInitParams::IsValid() const
 {
 	const bool Result =
-		Window != nullptr &&
+		(Window != nullptr || HeadlessConfig.IsEnabled()) &&
 		OutgoingEvents != nullptr &&
 		IncomingEvents != nullptr &&
 		CreateGameSceneFunc != nullptr;
@@ -66,11 +78,23 @@ void FGameThread::ThreadRun()
 	F_LogTrace(F_GetProfiler());
 	F_ResetProfiler();
 
-	const Float32 FramesPerSec = 60.f;
-	const Float32 MaxDeltaTime = 1.f / FramesPerSec;
+	if (InitData.HeadlessConfig.IsEnabled())
+	{
+		ThreadRunHeadless();
+	}
+	else
+	{
+		ThreadRunWindowed();
+	}
+
+	ThreadDeInit();
+}
+
+void FGameThread::ThreadRunWindowed()
+{
+	const Float32 MaxDeltaTime = 1.f / FGameThreadConstants::FramesPerSec;
 	const UInt32 MaxUpdateCountPerFrame = 4;
 
-	TThreadSafeVector<FEvent>::ContainerT ReceivedEvents;
 	FUpdateEvent UpdateEvent(0.f);
 
 	Float32 NextFrameProgress = 0.f;
@@ -80,6 +104,12 @@ void FGameThread::ThreadRun()
 	FHighResolutionTimer Timer;
 	Timer.Reset();
 
+	const Float32 DrawsPerSec = InitData.DrawsPerSec > 0.f ? InitData.DrawsPerSec : FGameThreadConstants::DefaultDrawsPerSec;
+
+	FFramePacer FramePacer;
+	FramePacer.Init(DrawsPerSec);
+	F_Log("Game Thread draws are paced to " << DrawsPerSec << " per second.");
+
 	while (IsRunning)
 	{
 		{
@@ -102,21 +132,16 @@ void FGameThread::ThreadRun()
 				if (bIsFirstUpdateThisFrame)
 				{
 					const Float32 AccumTModDeltaT = FMathf::Modulo(AccumulatedTime, MaxDeltaTime);
-
-					UpdateEvent.PreviousFrameTimeS = UpdateEvent.CurrentFrameTimeS;
-					UpdateEvent.CurrentFrameTimeS = UpdateEvent.CurrentTimeS - AccumTModDeltaT;
-					UpdateEvent.DeltaTimeS = MaxDeltaTime;
-
 					NextFrameProgress = AccumTModDeltaT / MaxDeltaTime;
 				}
 
-				InitData.IncomingEvents->GetDataAndClear<false>(ReceivedEvents);
-				ThreadHandleEvents(UpdateEvent, ReceivedEvents);
-
-				GameScene->Update(UpdateEvent, ComponentManagerImpl->ComponentManager);
+				// Each step ends where the time that is still accumulated begins, so events
+				// are applied on the step that covers their time stamp.
+				UpdateEvent.PreviousFrameTimeS = UpdateEvent.CurrentFrameTimeS;
+				UpdateEvent.CurrentFrameTimeS = Timer.GetCachedCurrentTime() - AccumulatedTime;
+				UpdateEvent.DeltaTimeS = MaxDeltaTime;
 
-				ComponentManagerImpl->ComponentManager.UpdateSystems(UpdateEvent);
-				ComponentManagerImpl->ComponentManager.Refresh();
+				ThreadUpdate(UpdateEvent);
 
 				++UpdateCount;
 				const UInt32 MinFramesBeforeWarning = 2;
@@ -137,17 +162,88 @@ void FGameThread::ThreadRun()
 				GFXEngine.SetUpNextRender();
 			}
 
-			// Eliminate spin wait until we actually need the CPU usage.
-			if (UpdateCount == 0)
-			{
-				NThread::SleepThread(1);
-			}
+			GFXEngine.Draw(NextFrameProgress);
 		}
 
+		FramePacer.WaitForNextFrame();
 		F_ResetProfiler();
 	}
 
-	ThreadDeInit();
+	F_Log("Game Thread pacing.  Spin margin: " << FramePacer.GetSpinMarginSeconds() * 1000000.f << "us "
+		<< FramePacer.GetStats());
+}
+
+void FGameThread::ThreadRunHeadless()
+{
+	const FHeadlessConfig& HeadlessConfig = InitData.HeadlessConfig;
+	const Float32 MaxDeltaTime = 1.f / FGameThreadConstants::FramesPerSec;
+	const UInt32 MaxUpdateCount = HeadlessConfig.GetMaxUpdateCount();
+
+	FUpdateEvent UpdateEvent(0.f);
+	UInt32 UpdateCount = 0;
+
+	FFramePacer FramePacer;
+	FramePacer.Init(FGameThreadConstants::FramesPerSec);
+
+	const Float32 StartTimeS = FHighResolutionTimer::GetTimeInSeconds();
+
+	while (IsRunning)
+	{
+		{
+			F_Profile();
+
+			// Simulated time moves forward by exactly one step per update, no matter how
+			// long the update takes, so unpaced runs are deterministic.
+			UpdateEvent.CurrentTimeS = FHighResolutionTimer::GetTimeInSeconds();
+			UpdateEvent.PreviousFrameTimeS = UpdateEvent.CurrentFrameTimeS;
+			UpdateEvent.CurrentFrameTimeS = StartTimeS + (UpdateCount + 1) * MaxDeltaTime;
+			UpdateEvent.DeltaTimeS = MaxDeltaTime;
+
+			ThreadUpdate(UpdateEvent);
+			++UpdateCount;
+		}
+
+		if (MaxUpdateCount && UpdateCount >= MaxUpdateCount)
+		{
+			IsRunning = false;
+		}
+
+		if (HeadlessConfig.IsPaced())
+		{
+			FramePacer.WaitForNextFrame();
+		}
+
+		F_ResetProfiler();
+	}
+
+	const Float32 ElapsedTimeS = FHighResolutionTimer::GetTimeInSeconds() - StartTimeS;
+	const Float32 UpdatesPerSec = ElapsedTimeS > 0.f ? UpdateCount / ElapsedTimeS : 0.f;
+
+	F_Log("Headless run.  Updates: " << UpdateCount << " in " << ElapsedTimeS << "s (" << UpdatesPerSec << " per second)");
+}
+
+void FGameThread::ThreadUpdate(const FUpdateEvent& UpdateEvent)
+{
+	GetScene().StorePreviousTransforms();
+	ThreadHandleEvents(UpdateEvent);
+
+	GameScene->Update(UpdateEvent, ComponentManagerImpl->ComponentManager);
+
+	ComponentManagerImpl->ComponentManager.UpdateSystems(UpdateEvent);
+	ComponentManagerImpl->ComponentManager.Refresh();
+
+	FFrameAllocator::GetThreadAllocator().EndFrame();
+	FMemoryTracker::EndFrame();
+}
+
+FGFXScene& FGameThread::GetScene()
+{
+	if (NullScene)
+	{
+		return *NullScene;
+	}
+
+	return GFXEngine.GetScene();
 }
 
 void FGameThread::ThreadInit()
@@ -155,6 +251,9 @@ void FGameThread::ThreadInit()
 	F_Profile();
 	F_Log("Game Thread ID: " << NThread::GetCallingThreadID());
 
+	const bool IsHeadless = InitData.HeadlessConfig.IsEnabled();
+
+	if (!IsHeadless)
 	{
 		AudioEngine.Init();
 		F_Assert(AudioEngine.IsValid(), "Audio Engine failed to initialize.");
@@ -164,6 +263,13 @@ void FGameThread::ThreadInit()
 		// #FIXME: Init physics here.
 	}
 
+	if (IsHeadless)
+	{
+		NullScene = std::make_unique<FGFXScene>();
+		NullScene->Init(EGFXSceneType::Null);
+		F_Assert(NullScene->IsValid(), "Null scene failed to initialize.");
+	}
+	else
 	{
 		F_Assert(InitData.Window, "Window is null.");
 		FGFXEngine::FInitParams InitParams;
@@ -188,7 +294,7 @@ void FGameThread::ThreadInit()
 		F_ProfileWithMsg("ComponentManager Render System Init");
 		auto& ComponentManager = ComponentManagerImpl->ComponentManager;
 		auto& RenderSystem = ComponentManager.GetSystem<FComponentRegistry::RenderSystem>();
-		RenderSystem.Init(ComponentManager, GFXEngine.GetScene());
+		RenderSystem.Init(ComponentManager, GetScene());
 	}
 	{
 		F_ProfileWithMsg("ComponentManager Systems Init");
@@ -213,7 +319,16 @@ void FGameThread::ThreadDeInit()
 		}
 
 		ComponentManagerImpl->ComponentManager.DeInitSystems();
-		GFXEngine.ForceShutDown();
+
+		if (NullScene)
+		{
+			NullScene->DeInit();
+		}
+		else
+		{
+			GFXEngine.ForceShutDown();
+		}
+
 		// #FIXME: DeInit Physics
 		AudioEngine.DeInit();
 
@@ -222,10 +337,17 @@ void FGameThread::ThreadDeInit()
 
 		InitData.OutgoingEvents->AddEntry(Event);
 		InitData = FInitParams();
+
+		F_Log("Input to simulation latency.  Events: " << EventLatency.EventCount
+			<< " Avg: " << EventLatency.GetAverageLatencyS() * 1000.f << "ms"
+			<< " Max: " << EventLatency.MaxLatencyS * 1000.f << "ms");
+
+		F_Log(FMemoryTracker::GetReport());
+		F_Log("Game Thread frame allocator.  " << FFrameAllocator::GetThreadAllocator().GetStats());
 	}
 
 	// Wait for other systems to be shut down.
-	while (!GFXEngine.IsShutDown())
+	while (!NullScene && !GFXEngine.IsShutDown())
 	{
 		NThread::SleepThread(1);
 	}
@@ -234,45 +356,22 @@ void FGameThread::ThreadDeInit()
 	F_ResetProfiler();
 }
 
-void FGameThread::ThreadHandleEvents(const FUpdateEvent& UpdateEvent, TThreadSafeVector<FEvent>::ContainerT& ReceivedEvents)
+void FGameThread::ThreadHandleEvents(const FUpdateEvent& UpdateEvent)
 {
-#if _DEBUG
-	for (SizeT I = 1, Max = ReceivedEvents.size(); I < Max; ++I)
-	{
-		const FEvent& Event1 = ReceivedEvents[I - 1];
-		const FEvent& Event2 = ReceivedEvents[I];
-		F_Assert(Event1.Info.TimeStamp <= Event2.Info.TimeStamp, "A more recent event's time stamp is invalid.");
-	}
-#endif
+	FGameThread::FEventRing& IncomingEvents = *InitData.IncomingEvents;
+	const Float32 TimeHandledS = FHighResolutionTimer::GetTimeInSeconds();
 
-#if 0 // #FIXME: Not working fully yet.
-	const SizeT Max = ReceivedEvents.size();
-	SizeT EventsHandled = 0;
-	
-	for (SizeT I = 0; I < Max; ++I)
+	// Events that are newer than this step stay in the ring until a later step reaches them.
+	const auto IsDue = [&UpdateEvent](const FEvent& Event)
 	{
-		const FEvent& Event = ReceivedEvents[I];
-		if (Event.Info.TimeStamp <= UpdateEvent.CurrentFrameTimeS)
-		{
-			++EventsHandled;
-			ThreadHandleEvent(Event);
-		}
-
-		break;
-	}
-
-	ReceivedEvents.erase(ReceivedEvents.begin(), ReceivedEvents.begin() + EventsHandled);
-#else
+		return Event.Info.TimeStamp <= UpdateEvent.CurrentFrameTimeS;
+	};
 
-	// #FIXME: Only handle events up to the current time stamp.
-	for (SizeT I = 0; I < ReceivedEvents.size(); ++I)
+	IncomingEvents.PopWhile(IsDue, [this, TimeHandledS](const FEvent& Event)
 	{
-		const FEvent& Event = ReceivedEvents[I];
+		EventLatency.AddSample(TimeHandledS - Event.Info.TimeStamp);
 		ThreadHandleEvent(Event);
-	}
-
-	ReceivedEvents.clear();
-#endif
+	});
 }
 
 void FGameThread::ThreadHandleEvent(const FEvent& Event)
@@ -340,3 +439,16 @@ void FGameThread::ThreadHandleEvent(const FEvent& Event)
 	// #FIXME: Pass it to the main event handler, which 
 	// will then fire off the events as required.
 }
+
+void FGameThread::FEventLatency::AddSample(const Float32 LatencyS)
+{
+	++EventCount;
+	TotalLatencyS += LatencyS;
+	MaxLatencyS = FMathf::Max(MaxLatencyS, LatencyS);
+}
+
+Float32 FGameThread::FEventLatency::GetAverageLatencyS() const
+{
+	const Float32 AverageLatencyS = EventCount ? TotalLatencyS / EventCount : 0.f;
+	return AverageLatencyS;
+}
@@ -1,11 +1,13 @@
 #ifndef PHOENIX_GAME_THREAD_H
 #define PHOENIX_GAME_THREAD_H
 
+#include "Config/EngineConfig.h"
 #include "Utility/Handle/Handle.h"
 #include "Utility/Misc/Function.h"
 #include "Utility/Misc/Memory.h"
 #include "Utility/Misc/Primitives.h"
 #include "Utility/Threading/Atomic.h"
+#include "Utility/Threading/MPSCRingBuffer.h"
 #include "Utility/Threading/Thread.h"
 #include "Utility/Threading/ThreadSafeVector.h"
 #include "Platform/Event/Event.h"
@@ -22,13 +24,17 @@ namespace Phoenix
 	{
 	public:
 		typedef TUniquePtr<FGameScene>(*FCreateGameSceneFunc)();
+		typedef TMPSCRingBuffer<FEvent, 1024> FEventRing;
 
 		struct FInitParams
 		{
 			TSharedPtr<class IWindow> Window;
 			TThreadSafeVector<FEvent>* OutgoingEvents{ nullptr };
-			TThreadSafeVector<FEvent>* IncomingEvents{ nullptr };
+			FEventRing* IncomingEvents{ nullptr };
 			FCreateGameSceneFunc CreateGameSceneFunc{ nullptr };
+			FHeadlessConfig HeadlessConfig;
+			/*! \brief The rate draws are paced to.  Zero uses a default rate. */
+			Float32 DrawsPerSec{ 0.f };
 
 			bool IsValid() const;
 		};
@@ -51,22 +57,43 @@ namespace Phoenix
 
 	protected:
 	private:
+		struct FEventLatency
+		{
+			UInt32 EventCount{ 0 };
+			Float32 TotalLatencyS{ 0.f };
+			Float32 MaxLatencyS{ 0.f };
+
+			void AddSample(const Float32 LatencyS);
+
+			Float32 GetAverageLatencyS() const;
+		};
+
 		FSafeThread Thread;
 		FInitParams InitData;
 		FAudioEngine AudioEngine;
 		FGFXEngine GFXEngine;
+		TUniquePtr<class FGFXScene> NullScene;
 		TUniquePtr<FGameScene> GameScene;
 		TUniquePtr<struct FComponentManagerImpl> ComponentManagerImpl;
 
 		TAtomic<bool> IsRunning{ false };
+		FEventLatency EventLatency;
 
 		void ThreadRun();
 
+		void ThreadRunWindowed();
+
+		void ThreadRunHeadless();
+
+		void ThreadUpdate(const FUpdateEvent& UpdateEvent);
+
+		class FGFXScene& GetScene();
+
 		void ThreadInit();
 
 		void ThreadDeInit();
 
-		void ThreadHandleEvents(const FUpdateEvent& UpdateEvent, TThreadSafeVector<FEvent>::ContainerT& ReceivedEvents);
+		void ThreadHandleEvents(const FUpdateEvent& UpdateEvent);
 
 		void ThreadHandleEvent(const FEvent& Event);
 	};
@@ -7,6 +7,7 @@
 #include "ECS/RequirementBitArrayStorage.h"
 #include "ECS/SystemStorage.h"
 #include "Platform/Event/Event.h"
+#include "Utility/Containers/FrameVector.h"
 #include "Utility/Containers/Vector.h"
 #include "Utility/Debug/Assert.h"
 #include "Utility/Misc/Primitives.h"
@@ -112,7 +113,9 @@ namespace Phoenix
 		SizeT FirstUnusedEntityID { 0 }; //Predicted Size after new entities are created
 
 		TVector<FEntity> Entities;
-		TVector<EntityID> NewEntityList;
+		/*! \brief Entities created since the last Refresh.  It's refilled every step, so it
+		*		uses the frame allocator of the thread that updates the manager. */
+		TFrameVector<EntityID> NewEntityList;
 
 		FRequirementBitArrayStorage RequirementBitArrays; //BitArrays corresponding to each Systems' Requirements
 		FComponentStorage ComponentStorage;
@@ -356,7 +359,10 @@ namespace Phoenix
 		Size = FirstUnusedEntityID = RefreshImpl();
 
 		NotifySystemsEntitesCreated();
-		NewEntityList.clear();
+
+		// Clearing would keep this step's memory, which the frame allocator reuses two
+		// steps from now.
+		NewEntityList = TFrameVector<EntityID>();
 	}
 
 	template<typename TConfig>
@@ -5,10 +5,14 @@
 #include "Utility/Containers/Vector.h"
 #include "Utility/MetaProgramming/For.h"
 #include "Utility/MetaProgramming/Rename.h"
+#include "Utility/Misc/Allocator.h"
 #include "Utility/Misc/Primitives.h"
 
 namespace Phoenix
 {
+	template<typename TComponent>
+	using TComponentVector = TVector<TComponent, TTrackedAlloc<TComponent, EMemoryTag::ECS>>;
+
 	template<typename TConfig>
 	class TComponentStorage
 	{
@@ -18,7 +22,7 @@ namespace Phoenix
 		void Resize(SizeT NewCapacity);
 
 		template<typename TComponent>
-		TVector<TComponent>& GetComponentVector();
+		TComponentVector<TComponent>& GetComponentVector();
 
 		template<typename TComponent>
 		TComponent& GetComponent(SizeT Index);
@@ -42,7 +46,7 @@ namespace Phoenix
 		using ComponentList = typename TConfig::ComponentList;
 
 		template<typename... Ts>
-		using TupleOfVectors = TTuple<TVector<Ts>...>;
+		using TupleOfVectors = TTuple<TComponentVector<Ts>...>;
 
 		using TTupleOfComponentVectors = TRename<ComponentList, TupleOfVectors>;
 
@@ -61,9 +65,9 @@ namespace Phoenix
 
 	template<typename TConfig>
 	template<typename TComponent>
-	TVector<TComponent>& TComponentStorage<TConfig>::GetComponentVector()
+	TComponentVector<TComponent>& TComponentStorage<TConfig>::GetComponentVector()
 	{
-		return std::get<TVector<TComponent>>(TupleOfComponentVectors);
+		return std::get<TComponentVector<TComponent>>(TupleOfComponentVectors);
 	}
 
 	template<typename TConfig>
@@ -2,6 +2,7 @@
 #define PHOENIX_SYSTEM_STORAGE_H
 
 #include "Platform/Event/Event.h"
+#include "Utility/Containers/FrameVector.h"
 #include "Utility/Containers/Tuple.h"
 #include "Utility/Containers/Vector.h"
 #include "Utility/MetaProgramming/For.h"
@@ -15,6 +16,7 @@ namespace Phoenix
 	F_DefineTrait_HasMethod(Update);
 	F_DefineTrait_HasMethod(OnEvent);
 	F_DefineTrait_HasMethod(OnEntityCreated);
+	F_DefineTrait_HasMethod(OnEntitiesCreated);
 	F_DefineTrait_HasMethod(OnEntityDestroyed);
 
 	template<typename TSystemList>
@@ -43,7 +45,7 @@ namespace Phoenix
 		void OnEvent(const FEvent& Event, TComponentManager& ComponentManager);
 
 		template<typename TComponentManager>
-		void OnEntitiesCreated(const TVector<SizeT>& NewEntityList, TComponentManager& ComponentManager);
+		void OnEntitiesCreated(const TFrameVector<SizeT>& NewEntityList, TComponentManager& ComponentManager);
 
 		template<typename TComponentManager>
 		void OnEntityDestroyed(SizeT DestroyedEntity, TComponentManager& ComponentManager);
@@ -98,6 +100,16 @@ namespace Phoenix
 				, TDisableIf<THasMethod_OnEvent<TSystem, FEvent, TComponentManager>::Value, Int32> = 0>
 		void CallOnEventIfDefined(TSystem&, const FEvent&, TComponentManager&);
 
+		//EntitiesCreated
+		template<typename TSystem, typename TComponentManager
+				, TEnableIf<THasMethod_OnEntitiesCreated<TSystem, TFrameVector<SizeT>, TComponentManager>::Value, Int32> = 0>
+		void CallOnEntitiesCreatedIfDefined(TSystem& System, const TFrameVector<SizeT>& NewEntityList, TComponentManager& ComponentManager);
+
+		//Falls back to OnEntityCreated for each new entity
+		template<typename TSystem, typename TComponentManager
+				, TDisableIf<THasMethod_OnEntitiesCreated<TSystem, TFrameVector<SizeT>, TComponentManager>::Value, Int32> = 0>
+		void CallOnEntitiesCreatedIfDefined(TSystem& System, const TFrameVector<SizeT>& NewEntityList, TComponentManager& ComponentManager);
+
 		//EntityCreated
 		template<typename TSystem, typename TComponentManager
 				, TEnableIf<THasMethod_OnEntityCreated<TSystem, SizeT, TComponentManager>::Value, Int32> = 0>
@@ -257,17 +269,33 @@ namespace Phoenix
 
 	template<typename TConfig>
 	template<typename TComponentManager>
-	void TSystemStorage<TConfig>::OnEntitiesCreated(const TVector<SizeT>& NewEntityList, TComponentManager& ComponentManager)
+	void TSystemStorage<TConfig>::OnEntitiesCreated(const TFrameVector<SizeT>& NewEntityList, TComponentManager& ComponentManager)
 	{
 		ForSystems([this, &NewEntityList, &ComponentManager](auto& System)
 					{
-						for (const SizeT NewEntity: NewEntityList)
-						{
-							CallOnEntityCreatedIfDefined(System, NewEntity, ComponentManager);
-						}
+						CallOnEntitiesCreatedIfDefined(System, NewEntityList, ComponentManager);
 					});
 	}
 
+	template<typename TConfig>
+	template<typename TSystem, typename TComponentManager
+			, TEnableIf<THasMethod_OnEntitiesCreated<TSystem, TFrameVector<SizeT>, TComponentManager>::Value, Int32>>
+	void TSystemStorage<TConfig>::CallOnEntitiesCreatedIfDefined(TSystem& System, const TFrameVector<SizeT>& NewEntityList, TComponentManager& ComponentManager)
+	{
+		System.OnEntitiesCreated(NewEntityList, ComponentManager);
+	}
+
+	template<typename TConfig>
+	template<typename TSystem, typename TComponentManager
+			, TDisableIf<THasMethod_OnEntitiesCreated<TSystem, TFrameVector<SizeT>, TComponentManager>::Value, Int32>>
+	void TSystemStorage<TConfig>::CallOnEntitiesCreatedIfDefined(TSystem& System, const TFrameVector<SizeT>& NewEntityList, TComponentManager& ComponentManager)
+	{
+		for (const SizeT NewEntity : NewEntityList)
+		{
+			CallOnEntityCreatedIfDefined(System, NewEntity, ComponentManager);
+		}
+	}
+
 	template<typename TConfig>
 	template<typename TSystem, typename TComponentManager
 			, TEnableIf<THasMethod_OnEntityCreated<TSystem, SizeT, TComponentManager>::Value, Int32>>
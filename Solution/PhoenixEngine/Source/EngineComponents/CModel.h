@@ -11,7 +11,7 @@ namespace Phoenix
 	struct CModel
 	{
 		FString ModelFileName;
-		THandle<FModelInstance> ModelInstance;
+		TThreadSafeHandle<FModelInstance> ModelInstance;
 
 		CModel() = default;
 
@@ -3,6 +3,8 @@
 
 #include "Platform/Event/Event.h"
 #include "Rendering/GFXScene.h"
+#include "Utility/Containers/FrameVector.h"
+#include "Utility/Containers/Vector.h"
 #include "Utility/Misc/Memory.h"
 
 namespace Phoenix
@@ -15,7 +17,7 @@ namespace Phoenix
 		void Init(TComponentManager& ComponentManager, FGFXScene& GFXScene);
 
 		template<typename TComponentManager>
-		void OnEntityCreated(SizeT NewEntity, TComponentManager& ComponentManager);
+		void OnEntitiesCreated(const TFrameVector<SizeT>& NewEntityList, TComponentManager& ComponentManager);
 
 		template<typename TComponentManager>
 		void Update(const FUpdateEvent& UpdateEvent, TComponentManager& ComponentManager);
@@ -29,6 +31,18 @@ namespace Phoenix
 	private:
 		//#TODO Find a better solution to allow access to the GFXScene
 		TRawPtr<FGFXScene> GFXScene;
+
+		// Reused between calls so that creating models doesn't allocate once it's warm.
+		TVector<TThreadSafeHandle<FModelInstance>> NewModelInstances;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Creates the model instances of the renderable entities in Entities.
+		*
+		*	@desc Consecutive entities that share a model are created together through
+		*		FGFXScene::CreateModels.  Entities that were spawned together usually do.
+		*/
+		template<typename TComponentManager>
+		void CreateModelInstances(const TFrameVector<SizeT>& Entities, TComponentManager& ComponentManager);
 	};
 
 
@@ -39,24 +53,19 @@ namespace Phoenix
 		F_AssertFalse(GFXScene.IsValid(), "GFXScene should be null until Init");
 		GFXScene = &InGFXScene;
 
+		TFrameVector<SizeT> Entities;
 		ComponentManager.template ForEntitiesMeetingRequirement<TRequirement>
-			([this](SizeT EntityID, CTransform& Transform, CModel& Model)
+			([&Entities](SizeT EntityID, CTransform&, CModel&)
 		{
-			auto ModelInstance = GFXScene->CreateModel(Model.ModelFileName, FMaterial::CreateDefault());
-
-			F_Assert(ModelInstance.IsValid(), "Model creation failed");
-
-			ModelInstance->SetPosition(Transform.Position);
-			ModelInstance->SetRotation(Transform.Rotation);
-			ModelInstance->SetScale(Transform.Scale);
-
-			Model.ModelInstance = ModelInstance;
+			Entities.push_back(EntityID);
 		});
+
+		CreateModelInstances(Entities, ComponentManager);
 	}
 
 	template<typename TRequirement>
 	template<typename TComponentManager>
-	void SRender<TRequirement>::OnEntityCreated(SizeT NewEntity, TComponentManager& ComponentManager)
+	void SRender<TRequirement>::OnEntitiesCreated(const TFrameVector<SizeT>& NewEntityList, TComponentManager& ComponentManager)
 	{
 		//Init hasn't run yet
 		if (!GFXScene.IsValid())
@@ -66,23 +75,62 @@ namespace Phoenix
 
 		F_Assert(GFXScene->IsValid(), "GFXScene should be valid");
 
-		const bool IsRenderable = ComponentManager.template HasComponent<CModel>(NewEntity)
-			&& ComponentManager.template HasComponent<CTransform>(NewEntity);
+		TFrameVector<SizeT> Renderables;
+		Renderables.reserve(NewEntityList.size());
 
-		if (IsRenderable)
+		for (const SizeT NewEntity : NewEntityList)
+		{
+			const bool IsRenderable = ComponentManager.template HasComponent<CModel>(NewEntity)
+				&& ComponentManager.template HasComponent<CTransform>(NewEntity);
+
+			if (IsRenderable)
+			{
+				Renderables.push_back(NewEntity);
+			}
+		}
+
+		CreateModelInstances(Renderables, ComponentManager);
+	}
+
+	template<typename TRequirement>
+	template<typename TComponentManager>
+	void SRender<TRequirement>::CreateModelInstances(const TFrameVector<SizeT>& Entities, TComponentManager& ComponentManager)
+	{
+		const SizeT EntityCount = Entities.size();
+		SizeT RunStart = 0;
+
+		while (RunStart < EntityCount)
 		{
-			auto& Model = ComponentManager.template GetComponent<CModel>(NewEntity);
-			const auto& Transform = ComponentManager.template GetComponent<CTransform>(NewEntity);
+			const FString& ModelFileName = ComponentManager.template GetComponent<CModel>(Entities[RunStart]).ModelFileName;
+
+			SizeT RunEnd = RunStart + 1;
+			while (RunEnd < EntityCount
+				&& ComponentManager.template GetComponent<CModel>(Entities[RunEnd]).ModelFileName == ModelFileName)
+			{
+				++RunEnd;
+			}
+
+			NewModelInstances.clear();
+			GFXScene->CreateModels(RunEnd - RunStart, ModelFileName, NewModelInstances, FMaterial::CreateDefault());
+			F_Assert(NewModelInstances.size() == RunEnd - RunStart, "Model creation failed");
 
-			auto ModelInstance = GFXScene->CreateModel(Model.ModelFileName, FMaterial::CreateDefault());
-			F_Assert(ModelInstance.IsValid(), "Model creation failed");
+			for (SizeT I = RunStart; I < RunEnd; ++I)
+			{
+				auto& Model = ComponentManager.template GetComponent<CModel>(Entities[I]);
+				const auto& Transform = ComponentManager.template GetComponent<CTransform>(Entities[I]);
 
-			ModelInstance->SetPosition(Transform.Position);
-			ModelInstance->SetRotation(Transform.Rotation);
-			ModelInstance->SetScale(Transform.Scale);
+				TThreadSafeHandle<FModelInstance>& ModelInstance = NewModelInstances[I - RunStart];
+				ModelInstance->SetPosition(Transform.Position);
+				ModelInstance->SetRotation(Transform.Rotation);
+				ModelInstance->SetScale(Transform.Scale);
 
-			Model.ModelInstance = ModelInstance;
+				Model.ModelInstance = std::move(ModelInstance);
+			}
+
+			RunStart = RunEnd;
 		}
+
+		NewModelInstances.clear();
 	}
 
 	template<typename TRequirement>
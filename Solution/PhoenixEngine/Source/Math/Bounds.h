@@ -0,0 +1,107 @@
+#ifndef PHOENIX_BOUNDS_H
+#define PHOENIX_BOUNDS_H
+
+#include <algorithm>
+#include <cmath>
+
+#include "ExternalLib/GLMIncludes.h"
+#include "Utility/Misc/Primitives.h"
+#include "Math/Vector3D.h"
+
+namespace Phoenix
+{
+	//	--------------------------------------------------------------------------------
+	/*! \brief An axis aligned box and a sphere that both enclose the same vertices.
+	*
+	*	@note The sphere is centered on the box, but its radius is the distance to the
+	*		farthest vertex, so it is usually tighter than the box's half diagonal.
+	*/
+	struct FBounds
+	{
+		FVector3D Min{ 0.f };
+		FVector3D Max{ 0.f };
+		FVector3D Center{ 0.f };
+		Float32 Radius{ 0.f };
+	};
+
+	namespace NBounds
+	{
+		//	--------------------------------------------------------------------------------
+		/*! \brief Creates the bounds of interleaved vertex positions.
+		*
+		*	@param Positions - The first component of the first position.
+		*	@param VertexCount - The number of positions.
+		*	@param Stride - The number of components per position.  A stride of 2 is
+		*		treated as XY with a Z of 0.
+		*/
+		inline FBounds Create(const Float32* const Positions, const SizeT VertexCount, const SizeT Stride)
+		{
+			FBounds Bounds;
+			if (!VertexCount)
+			{
+				return Bounds;
+			}
+
+			auto GetPosition = [Positions, Stride](const SizeT I)
+			{
+				const Float32* const Position = Positions + I * Stride;
+				const FVector3D Result(Position[0], Position[1], Stride > 2 ? Position[2] : 0.f);
+				return Result;
+			};
+
+			Bounds.Min = GetPosition(0);
+			Bounds.Max = Bounds.Min;
+
+			for (SizeT I = 1; I < VertexCount; ++I)
+			{
+				const FVector3D Position = GetPosition(I);
+				Bounds.Min = glm::min(Bounds.Min, Position);
+				Bounds.Max = glm::max(Bounds.Max, Position);
+			}
+
+			Bounds.Center = (Bounds.Min + Bounds.Max) * 0.5f;
+
+			Float32 RadiusSq = 0.f;
+			for (SizeT I = 0; I < VertexCount; ++I)
+			{
+				const FVector3D Offset = GetPosition(I) - Bounds.Center;
+				RadiusSq = std::max(RadiusSq, glm::dot(Offset, Offset));
+			}
+
+			Bounds.Radius = std::sqrt(RadiusSq);
+			return Bounds;
+		}
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Creates bounds that enclose both of the given bounds. */
+		inline FBounds Merge(const FBounds& LHS, const FBounds& RHS)
+		{
+			FBounds Bounds;
+			Bounds.Min = glm::min(LHS.Min, RHS.Min);
+			Bounds.Max = glm::max(LHS.Max, RHS.Max);
+
+			const FVector3D Offset = RHS.Center - LHS.Center;
+			const Float32 Distance = glm::length(Offset);
+
+			if (Distance + RHS.Radius <= LHS.Radius)
+			{
+				Bounds.Center = LHS.Center;
+				Bounds.Radius = LHS.Radius;
+			}
+			else if (Distance + LHS.Radius <= RHS.Radius)
+			{
+				Bounds.Center = RHS.Center;
+				Bounds.Radius = RHS.Radius;
+			}
+			else
+			{
+				Bounds.Radius = (Distance + LHS.Radius + RHS.Radius) * 0.5f;
+				Bounds.Center = LHS.Center + Offset * ((Bounds.Radius - LHS.Radius) / Distance);
+			}
+
+			return Bounds;
+		}
+	}
+}
+
+#endif
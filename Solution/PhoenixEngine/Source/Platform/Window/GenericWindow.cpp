@@ -123,6 +123,20 @@ void FGenericWindow::SetSwapInterval(const Int32 Interval)
 	glfwSwapInterval(Interval);
 }
 
+Int32 FGenericWindow::GetRefreshRate() const
+{
+	// Windowed mode windows have no monitor of their own, so they go by the primary one.
+	GLFWmonitor* Monitor = Window ? glfwGetWindowMonitor(Window) : nullptr;
+	if (!Monitor)
+	{
+		Monitor = glfwGetPrimaryMonitor();
+	}
+
+	const GLFWvidmode* const VideoMode = Monitor ? glfwGetVideoMode(Monitor) : nullptr;
+	const Int32 RefreshRate = VideoMode ? VideoMode->refreshRate : 0;
+	return RefreshRate;
+}
+
 void FGenericWindow::OnMinimize()
 {
 	// TODO::Implement me
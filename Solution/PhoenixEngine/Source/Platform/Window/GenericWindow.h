@@ -54,6 +54,8 @@ namespace Phoenix
 
 		virtual void SetSwapInterval(const Int32 Interval) final;
 
+		virtual Int32 GetRefreshRate() const final;
+
 		virtual void SetEventHandler(const TRawPtr<class FEventHandler>& InEventHandler) final;
 		
 	protected:
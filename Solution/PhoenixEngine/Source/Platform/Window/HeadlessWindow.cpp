@@ -0,0 +1,160 @@
+#include "Stdafx.h"
+#include "Platform/Window/HeadlessWindow.h"
+
+#include "Utility/Misc/Timer.h"
+#include "Platform/Event/EventHandler.h"
+
+using namespace Phoenix;
+
+FHeadlessWindow::FHeadlessWindow(int Width, int Height, const FString& WindowTitle)
+{
+	Dimensions = FVector2D(Width, Height);
+	WindowTitleText = WindowTitle;
+
+	Init();
+}
+
+FHeadlessWindow::~FHeadlessWindow()
+{
+
+}
+
+void FHeadlessWindow::Init()
+{
+	bIsHidden = true;
+	bIsMinimized = false;
+	bIsFullScreen = false;
+}
+
+void FHeadlessWindow::Hide()
+{
+	bIsHidden = true;
+}
+
+void FHeadlessWindow::Show()
+{
+	bIsHidden = false;
+}
+
+void FHeadlessWindow::Minimize()
+{
+	if (!bIsMinimized)
+	{
+		bIsMinimized = true;
+		OnMinimize();
+	}
+}
+
+void FHeadlessWindow::Restore()
+{
+	if (bIsMinimized)
+	{
+		bIsMinimized = false;
+		OnRestore();
+	}
+}
+
+void FHeadlessWindow::BufferSwap()
+{
+	// There is no back buffer to present.
+}
+
+void FHeadlessWindow::SetSwapInterval(const Int32)
+{
+	// There is no display to sync to.
+}
+
+Int32 FHeadlessWindow::GetRefreshRate() const
+{
+	// Without a display there is no rate to report, so the game thread falls back to its default.
+	return 0;
+}
+
+void FHeadlessWindow::OnMinimize()
+{
+}
+
+void FHeadlessWindow::OnRestore()
+{
+}
+
+void FHeadlessWindow::SetEventHandler(const TRawPtr<class FEventHandler>& InEventHandler)
+{
+	EventHandler = InEventHandler;
+}
+
+void FHeadlessWindow::SetFullScreen(const bool bFullScreenEnabled)
+{
+	bIsFullScreen = bFullScreenEnabled;
+}
+
+void FHeadlessWindow::ProcessEvents()
+{
+	PollMovementAxes();
+}
+
+void FHeadlessWindow::PollMovementAxes()
+{
+	// Nothing is ever pressed, but listeners still get the same steady stream of axes
+	// that FGenericWindow sends.
+	if (EventHandler.IsValid())
+	{
+		const Float32 TimeStamp = FHighResolutionTimer::GetTimeInSeconds();
+		EventHandler->MovementAxisCallback(0.f, 0.f, TimeStamp);
+	}
+}
+
+void FHeadlessWindow::SetDimensions(const FVector2D& InDimensions)
+{
+	Dimensions = InDimensions;
+}
+
+const FVector2D& FHeadlessWindow::GetDimensions() const
+{
+	return Dimensions;
+}
+
+void FHeadlessWindow::SetPosition(const FVector2D& InPosition)
+{
+	Position = InPosition;
+}
+
+const FVector2D& FHeadlessWindow::GetPosition() const
+{
+	return Position;
+}
+
+void FHeadlessWindow::SetWindowTitle(const FString& InWindowTitleText)
+{
+	WindowTitleText = InWindowTitleText;
+}
+
+const FString& FHeadlessWindow::GetWindowTitle() const
+{
+	return WindowTitleText;
+}
+
+void FHeadlessWindow::SetTaskbarIcon(const FIcon& InIcon)
+{
+	TaskbarIcon = InIcon;
+}
+
+const FIcon& FHeadlessWindow::GetTaskbarIcon() const
+{
+	return TaskbarIcon;
+}
+
+void FHeadlessWindow::SetTitlebarIcon(const FIcon& InIcon)
+{
+	TitlebarIcon = InIcon;
+}
+
+const FIcon& FHeadlessWindow::GetTitlebarIcon() const
+{
+	return TitlebarIcon;
+}
+
+void FHeadlessWindow::SetGraphicsContextCurrent()
+{
+	// The recording GL backend needs no context.
+}
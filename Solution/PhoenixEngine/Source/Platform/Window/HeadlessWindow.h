@@ -0,0 +1,73 @@
+#ifndef PHOENIX_HEADLESS_WINDOW_H
+#define PHOENIX_HEADLESS_WINDOW_H
+
+#include "Utility/Misc/Memory.h"
+#include "Platform/Window/IWindow.h"
+
+namespace Phoenix
+{
+	//	---
+	/*! \brief A window that never creates a display or a graphics context.
+	*	@desc Used in place of FGenericWindow when PHOENIX_GFX_USE_RECORDING_GL is enabled,
+	*		so the engine can start up and render frames on machines without a display or gpu.
+	*		It keeps the state it is given, swaps and context changes do nothing, and it never
+	*		receives input.
+	*/
+	class FHeadlessWindow : public IWindow
+	{
+	public:
+
+		FHeadlessWindow() = delete;
+		FHeadlessWindow(int Width, int Height, const FString& WindowTitle);
+
+		virtual ~FHeadlessWindow();
+
+		virtual void Hide() final;
+		virtual void Show() final;
+
+		virtual void Minimize() final;
+		virtual void Restore() final;
+
+		virtual void OnMinimize() final;
+		virtual void OnRestore() final;
+
+		virtual void SetFullScreen(const bool bFullScreenEnabled) final;
+
+		virtual void ProcessEvents() final;
+
+		virtual void PollMovementAxes() final;
+
+		virtual void SetDimensions(const FVector2D& InDimensions) final;
+		virtual const FVector2D& GetDimensions() const final;
+
+		virtual void SetPosition(const FVector2D& InPosition) final;
+		virtual const FVector2D& GetPosition() const final;
+
+		virtual void SetWindowTitle(const FString& InWindowTitleText) final;
+		virtual const FString& GetWindowTitle() const final;
+
+		virtual void SetTaskbarIcon(const FIcon& InIcon) final;
+		virtual const FIcon& GetTaskbarIcon() const final;
+
+		virtual void SetTitlebarIcon(const FIcon& InIcon) final;
+		virtual const FIcon& GetTitlebarIcon() const final;
+
+		virtual void SetGraphicsContextCurrent() final;
+
+		virtual void BufferSwap() final;
+
+		virtual void SetSwapInterval(const Int32 Interval) final;
+
+		virtual Int32 GetRefreshRate() const final;
+
+		virtual void SetEventHandler(const TRawPtr<class FEventHandler>& InEventHandler) final;
+
+	protected:
+		virtual void Init() final;
+
+	private:
+		TRawPtr<class FEventHandler> EventHandler;
+	};
+}
+
+#endif
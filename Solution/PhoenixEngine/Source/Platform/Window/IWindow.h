@@ -83,6 +83,9 @@ namespace Phoenix
 		virtual void BufferSwap() = 0;
 
 		virtual void SetSwapInterval(const Int32 Interval) = 0;
+
+		// Refresh rate of the display the window is on, or 0 if it isn't known
+		virtual Int32 GetRefreshRate() const = 0;
 		
 		virtual void SetEventHandler(const TRawPtr<class FEventHandler>& InEventHandler) = 0;
 
@@ -0,0 +1,133 @@
+#include "Stdafx.h"
+#include "Rendering/Caches/AssetRequestTable.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Utility/Debug/Assert.h"
+
+using namespace Phoenix;
+
+namespace FAssetRequestTableConstants
+{
+	// Keeps the doubling well inside of Float32's range for assets that never load.
+	const UInt32 MaxBackoffExponent = 16;
+}
+
+void FAssetRequestTable::Init(const FInitParams& InInitParams)
+{
+	F_Assert(InInitParams.InitialBackoff >= 0.f, "The initial backoff cannot be negative.");
+	F_Assert(InInitParams.MaxBackoff >= InInitParams.InitialBackoff, "The max backoff cannot be below the initial backoff.");
+
+	InitParams = InInitParams;
+	Clear();
+	ResetStats();
+}
+
+bool FAssetRequestTable::BeginRequest(const FName& Name, const Float32 Time)
+{
+	FEntry& Entry = Entries[Name];
+
+	if (Entry.State == EAssetRequest::InFlight)
+	{
+		++Stats.Coalesced;
+		return false;
+	}
+
+	if (Entry.State == EAssetRequest::Failed && Time < Entry.RetryTime)
+	{
+		++Stats.Suppressed;
+		return false;
+	}
+
+	Entry.State = EAssetRequest::InFlight;
+	++InFlightCount;
+	++Stats.Started;
+	return true;
+}
+
+void FAssetRequestTable::OnSucceeded(const FName& Name)
+{
+	FEntry* const Entry = FindEntry(Name);
+	F_Assert(Entry, "{ " << Name << " } was never requested.");
+
+	EndRequest(*Entry);
+	Entry->State = EAssetRequest::Succeeded;
+	Entry->FailureCount = 0;
+	Entry->RetryTime = 0.f;
+	++Stats.Succeeded;
+}
+
+void FAssetRequestTable::OnFailed(const FName& Name, const Float32 Time)
+{
+	FEntry* const Entry = FindEntry(Name);
+	F_Assert(Entry, "{ " << Name << " } was never requested.");
+
+	EndRequest(*Entry);
+	Entry->State = EAssetRequest::Failed;
+	++Entry->FailureCount;
+
+	const UInt32 Exponent = std::min(Entry->FailureCount - 1, FAssetRequestTableConstants::MaxBackoffExponent);
+	const Float32 Backoff = std::min(
+		std::ldexp(InitParams.InitialBackoff, static_cast<int>(Exponent)),
+		InitParams.MaxBackoff);
+
+	Entry->RetryTime = Time + Backoff;
+	++Stats.Failed;
+}
+
+EAssetRequest::Value FAssetRequestTable::GetState(const FName& Name) const
+{
+	const FEntry* const Entry = FindEntry(Name);
+	const EAssetRequest::Value State = Entry ? Entry->State : EAssetRequest::None;
+	return State;
+}
+
+UInt32 FAssetRequestTable::GetFailureCount(const FName& Name) const
+{
+	const FEntry* const Entry = FindEntry(Name);
+	const UInt32 FailureCount = Entry ? Entry->FailureCount : 0;
+	return FailureCount;
+}
+
+SizeT FAssetRequestTable::GetInFlightCount() const
+{
+	return InFlightCount;
+}
+
+const FAssetRequestStats& FAssetRequestTable::GetStats() const
+{
+	return Stats;
+}
+
+void FAssetRequestTable::ResetStats()
+{
+	Stats = FAssetRequestStats();
+}
+
+void FAssetRequestTable::Clear()
+{
+	Entries.clear();
+	InFlightCount = 0;
+}
+
+FAssetRequestTable::FEntry* FAssetRequestTable::FindEntry(const FName& Name)
+{
+	auto Iter = Entries.find(Name);
+	FEntry* const Entry = Iter != Entries.end() ? &Iter->second : nullptr;
+	return Entry;
+}
+
+const FAssetRequestTable::FEntry* FAssetRequestTable::FindEntry(const FName& Name) const
+{
+	const auto Iter = Entries.find(Name);
+	const FEntry* const Entry = Iter != Entries.end() ? &Iter->second : nullptr;
+	return Entry;
+}
+
+void FAssetRequestTable::EndRequest(FEntry& Entry)
+{
+	F_Assert(Entry.State == EAssetRequest::InFlight, "Only a request that is in flight can end.");
+	F_Assert(InFlightCount, "A request was in flight, so the count should be non-zero.");
+	--InFlightCount;
+}
@@ -0,0 +1,130 @@
+#ifndef PHOENIX_ASSET_REQUEST_TABLE_H
+#define PHOENIX_ASSET_REQUEST_TABLE_H
+
+#include "Utility/Containers/FlatHashMap.h"
+#include "Utility/Misc/Allocator.h"
+#include "Utility/Misc/Name.h"
+#include "Utility/Misc/Primitives.h"
+
+namespace Phoenix
+{
+	namespace EAssetRequest
+	{
+		typedef UInt8 Type;
+
+		enum Value : Type
+		{
+			None,
+			InFlight,
+			Failed,
+			Succeeded
+		};
+	}
+
+	struct FAssetRequestStats
+	{
+		/*! \brief Loads that were started. */
+		SizeT Started{ 0 };
+		/*! \brief Requests that joined a load that was already in flight. */
+		SizeT Coalesced{ 0 };
+		/*! \brief Requests that were turned away because their last load failed recently. */
+		SizeT Suppressed{ 0 };
+		SizeT Succeeded{ 0 };
+		SizeT Failed{ 0 };
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Tracks the state of every asset load by name.
+	*
+	*	@desc Callers ask for a load with BeginRequest after a cache miss.  Only the
+	*		first request for a name starts a load, every other one joins it until it
+	*		completes.  A failed load is not retried until its backoff has passed, and
+	*		the backoff doubles with each consecutive failure up to a limit.
+	*	@note Only the GFX thread should use this.  Async tasks report their results
+	*		by sending a task back to the GFX thread.
+	*/
+	class FAssetRequestTable
+	{
+	public:
+		struct FInitParams
+		{
+			/*! \brief Seconds to wait before retrying an asset that failed once. */
+			Float32 InitialBackoff{ 1.f };
+			/*! \brief The longest that an asset that keeps failing will wait between retries. */
+			Float32 MaxBackoff{ 60.f };
+		};
+
+		FAssetRequestTable() = default;
+
+		FAssetRequestTable(const FAssetRequestTable&) = delete;
+		FAssetRequestTable& operator=(const FAssetRequestTable&) = delete;
+
+		FAssetRequestTable(FAssetRequestTable&&) = default;
+		FAssetRequestTable& operator=(FAssetRequestTable&&) = default;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Sets the backoff and forgets every request and stat. */
+		void Init(const FInitParams& InitParams);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Requests a load of the given asset.
+		*
+		*	@param Name - The name of the asset.
+		*	@param Time - The current time in seconds.
+		*	@return Returns true if the caller should start the load.  Returns false if
+		*		the load is already in flight, or if it failed and is backing off.
+		*	@note A succeeded asset may be requested again, since it only misses the
+		*		cache once it has been evicted.
+		*/
+		bool BeginRequest(const FName& Name, const Float32 Time);
+
+		void OnSucceeded(const FName& Name);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Records a failed load and schedules the earliest retry.
+		*
+		*	@param Name - The name of the asset.
+		*	@param Time - The current time in seconds.
+		*/
+		void OnFailed(const FName& Name, const Float32 Time);
+
+		EAssetRequest::Value GetState(const FName& Name) const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the number of times in a row the asset has failed to load. */
+		UInt32 GetFailureCount(const FName& Name) const;
+
+		SizeT GetInFlightCount() const;
+
+		const FAssetRequestStats& GetStats() const;
+
+		void ResetStats();
+
+		void Clear();
+
+	protected:
+	private:
+		struct FEntry
+		{
+			EAssetRequest::Value State{ EAssetRequest::None };
+			UInt32 FailureCount{ 0 };
+			Float32 RetryTime{ 0.f };
+		};
+
+		typedef TTrackedAlloc<TPair<const FName, FEntry>, EMemoryTag::Assets> EntriesAllocatorT;
+		typedef TFlatHashMap<FName, FEntry, std::hash<FName>, std::equal_to<FName>, EntriesAllocatorT> EntriesT;
+
+		FInitParams InitParams;
+		EntriesT Entries;
+		SizeT InFlightCount{ 0 };
+		FAssetRequestStats Stats;
+
+		FEntry* FindEntry(const FName& Name);
+
+		const FEntry* FindEntry(const FName& Name) const;
+
+		void EndRequest(FEntry& Entry);
+	};
+}
+
+#endif
@@ -3,6 +3,18 @@
 
 using namespace Phoenix;
 
+namespace FGFXCachesConstants
+{
+	const SizeT ImageBudget = 512 * 1024 * 1024;
+	const SizeT ModelBudget = 256 * 1024 * 1024;
+}
+
+FGFXCaches::FGFXCaches()
+{
+	ImageCache.SetBudget(FGFXCachesConstants::ImageBudget);
+	ModelCache.SetBudget(FGFXCachesConstants::ModelBudget);
+}
+
 FFontCache& FGFXCaches::GetFontCache()
 {
 	return FontCache;
@@ -42,3 +54,11 @@ const FShaderCache& FGFXCaches::GetShaderCache() const
 {
 	return ShaderCache;
 }
+
+void FGFXCaches::Trim()
+{
+	ModelCache.Trim();
+	ImageCache.Trim();
+	FontCache.Trim();
+	ShaderCache.Trim();
+}
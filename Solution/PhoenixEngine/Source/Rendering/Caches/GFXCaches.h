@@ -11,6 +11,8 @@ namespace Phoenix
 	class FGFXCaches
 	{
 	public:
+		FGFXCaches();
+
 		FFontCache& GetFontCache();
 		const FFontCache& GetFontCache() const;
 
@@ -23,6 +25,14 @@ namespace Phoenix
 		FShaderCache& GetShaderCache();
 		const FShaderCache& GetShaderCache() const;
 
+		//	--------------------------------------------------------------------------------
+		/*! \brief Evicts unused items from every cache that is over its budget.
+		*
+		*	@note Models are trimmed before images, so images that only evicted models
+		*		were holding on to can go in the same call.
+		*/
+		void Trim();
+
 	protected:
 	private:
 		FFontCache FontCache;
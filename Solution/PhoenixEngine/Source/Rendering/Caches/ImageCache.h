@@ -7,7 +7,7 @@
 
 namespace Phoenix
 {
-	class FImageCache : public TNamedItemCache<THandle<FImage>> {};
+	class FImageCache : public TNamedItemCache<TThreadSafeHandle<FImage>> {};
 }
 
 #endif
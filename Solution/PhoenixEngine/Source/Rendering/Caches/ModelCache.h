@@ -7,7 +7,7 @@
 
 namespace Phoenix
 {
-	class FModelCache : public TNamedItemCache<THandle<FModel>> {};
+	class FModelCache : public TNamedItemCache<TThreadSafeHandle<FModel>> {};
 }
 
 #endif
@@ -0,0 +1,329 @@
+#include "Stdafx.h"
+#include "Rendering/Culling/FrustumCuller.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX__)
+#	define PHOENIX_FRUSTUM_CULLER_AVX 1
+#	define PHOENIX_FRUSTUM_CULLER_SSE 0
+#	include <immintrin.h>
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#	define PHOENIX_FRUSTUM_CULLER_AVX 0
+#	define PHOENIX_FRUSTUM_CULLER_SSE 1
+#	include <xmmintrin.h>
+#else
+#	define PHOENIX_FRUSTUM_CULLER_AVX 0
+#	define PHOENIX_FRUSTUM_CULLER_SSE 0
+#endif
+
+#include "Utility/Debug/Assert.h"
+#include "Utility/Misc/Memory.h"
+#include "Utility/Threading/AsyncTaskHandler.h"
+#include "Utility/Threading/Atomic.h"
+#include "Utility/Threading/Thread.h"
+
+using namespace Phoenix;
+
+namespace FFrustumCullerInternal
+{
+	//	--------------------------------------------------------------------------------
+	/*! \brief The state that is shared between the threads taking part in one cull.
+	*
+	*	@note Tasks that start after every chunk has been claimed only touch the
+	*		counters, which is why this is kept alive by the tasks rather than by Cull.
+	*/
+	struct FCullJob
+	{
+		const FFrustum* Frustum{ nullptr };
+		const FCullSpheres* Spheres{ nullptr };
+		UInt32* OutIndices{ nullptr };
+		SizeT Count{ 0 };
+		SizeT ChunkSize{ 0 };
+		SizeT ChunkCount{ 0 };
+		TVector<SizeT> ChunkVisibleCounts;
+		TAtomic<SizeT> NextChunk{ 0 };
+		TAtomic<SizeT> CompletedChunks{ 0 };
+
+		void Run()
+		{
+			for (;;)
+			{
+				const SizeT Chunk = NextChunk.fetch_add(1, std::memory_order_relaxed);
+				if (Chunk >= ChunkCount)
+				{
+					return;
+				}
+
+				const SizeT Begin = Chunk * ChunkSize;
+				const SizeT End = std::min(Begin + ChunkSize, Count);
+
+				ChunkVisibleCounts[Chunk] = FFrustumCuller::CullRange(
+					*Frustum, *Spheres, Begin, End, OutIndices + Begin);
+
+				CompletedChunks.fetch_add(1, std::memory_order_release);
+			}
+		}
+	};
+
+	SizeT CullRangeScalar(
+		const FFrustum& Frustum,
+		const FCullSpheres& Spheres,
+		const SizeT Begin,
+		const SizeT End,
+		UInt32* const OutIndices)
+	{
+		SizeT VisibleCount = 0;
+		for (SizeT I = Begin; I < End; ++I)
+		{
+			const FVector3D Center(Spheres.X[I], Spheres.Y[I], Spheres.Z[I]);
+			OutIndices[VisibleCount] = static_cast<UInt32>(I);
+			VisibleCount += Frustum.IsVisible(Center, Spheres.Radius[I]) ? 1 : 0;
+		}
+
+		return VisibleCount;
+	}
+}
+
+void FFrustum::Init(const FMatrix4D& ViewProjection)
+{
+	const FMatrix4D& M = ViewProjection;
+
+	const FVector4D Row0(M[0][0], M[1][0], M[2][0], M[3][0]);
+	const FVector4D Row1(M[0][1], M[1][1], M[2][1], M[3][1]);
+	const FVector4D Row2(M[0][2], M[1][2], M[2][2], M[3][2]);
+	const FVector4D Row3(M[0][3], M[1][3], M[2][3], M[3][3]);
+
+	Planes[EFrustumPlane::Left] = Row3 + Row0;
+	Planes[EFrustumPlane::Right] = Row3 - Row0;
+	Planes[EFrustumPlane::Bottom] = Row3 + Row1;
+	Planes[EFrustumPlane::Top] = Row3 - Row1;
+	Planes[EFrustumPlane::Near] = Row3 + Row2;
+	Planes[EFrustumPlane::Far] = Row3 - Row2;
+
+	for (auto& Plane : Planes)
+	{
+		const Float32 Length = std::sqrt(Plane.x * Plane.x + Plane.y * Plane.y + Plane.z * Plane.z);
+		F_Assert(Length > 0.f, "Degenerate frustum plane.");
+		Plane /= Length;
+	}
+}
+
+bool FFrustum::IsVisible(const FVector3D& Center, const Float32 Radius) const
+{
+	for (const auto& Plane : Planes)
+	{
+		const Float32 Distance = Plane.x * Center.x + Plane.y * Center.y + Plane.z * Center.z + Plane.w;
+		if (Distance < -Radius)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void FCullSpheres::Reserve(const SizeT Capacity)
+{
+	X.reserve(Capacity);
+	Y.reserve(Capacity);
+	Z.reserve(Capacity);
+	Radius.reserve(Capacity);
+}
+
+void FCullSpheres::Add(const FVector3D& Center, const Float32 SphereRadius)
+{
+	X.push_back(Center.x);
+	Y.push_back(Center.y);
+	Z.push_back(Center.z);
+	Radius.push_back(SphereRadius);
+}
+
+void FCullSpheres::Clear()
+{
+	X.clear();
+	Y.clear();
+	Z.clear();
+	Radius.clear();
+}
+
+SizeT FCullSpheres::GetSize() const
+{
+	return X.size();
+}
+
+void FFrustumCuller::Cull(
+	const FFrustum& Frustum,
+	const FCullSpheres& Spheres,
+	TVector<UInt32>& VisibleIndices,
+	FAsyncTaskHandler* const TaskHandler)
+{
+	using namespace FFrustumCullerInternal;
+
+	const SizeT Count = Spheres.GetSize();
+	const SizeT LocalChunkSize = ChunkSize;
+	const SizeT ChunkCount = (Count + LocalChunkSize - 1) / LocalChunkSize;
+
+	// Each chunk writes its visible indices at its own offset, then they're packed together.
+	VisibleIndices.resize(Count);
+
+	Stats.Tested = Count;
+	Stats.Chunks = ChunkCount;
+
+	if (ChunkCount <= 1 || !TaskHandler || !TaskHandler->IsValid())
+	{
+		const SizeT VisibleCount = CullRange(Frustum, Spheres, 0, Count, VisibleIndices.data());
+		VisibleIndices.resize(VisibleCount);
+		Stats.Visible = VisibleCount;
+		return;
+	}
+
+	TSharedPtr<FCullJob> Job = std::make_shared<FCullJob>();
+	Job->Frustum = &Frustum;
+	Job->Spheres = &Spheres;
+	Job->OutIndices = VisibleIndices.data();
+	Job->Count = Count;
+	Job->ChunkSize = LocalChunkSize;
+	Job->ChunkCount = ChunkCount;
+	Job->ChunkVisibleCounts.resize(ChunkCount);
+
+	const SizeT HelperCount = std::min(TaskHandler->GetThreadCount(), ChunkCount - 1);
+
+	FAsyncTasks Tasks;
+	Tasks.reserve(HelperCount);
+
+	for (SizeT I = 0; I < HelperCount; ++I)
+	{
+		Tasks.emplace_back([Job]()
+		{
+			Job->Run();
+		});
+	}
+
+	TaskHandler->AddAsyncTasks(std::move(Tasks));
+
+	Job->Run();
+
+	while (Job->CompletedChunks.load(std::memory_order_acquire) < ChunkCount)
+	{
+		NThread::YieldThread();
+	}
+
+	SizeT VisibleCount = 0;
+	for (SizeT Chunk = 0; Chunk < ChunkCount; ++Chunk)
+	{
+		const SizeT ChunkVisibleCount = Job->ChunkVisibleCounts[Chunk];
+		const SizeT ChunkBegin = Chunk * LocalChunkSize;
+
+		if (ChunkBegin != VisibleCount)
+		{
+			std::memmove(
+				VisibleIndices.data() + VisibleCount,
+				VisibleIndices.data() + ChunkBegin,
+				ChunkVisibleCount * sizeof(UInt32));
+		}
+
+		VisibleCount += ChunkVisibleCount;
+	}
+
+	VisibleIndices.resize(VisibleCount);
+	Stats.Visible = VisibleCount;
+}
+
+SizeT FFrustumCuller::CullRange(
+	const FFrustum& Frustum,
+	const FCullSpheres& Spheres,
+	const SizeT Begin,
+	const SizeT End,
+	UInt32* const OutIndices)
+{
+	F_Assert(Begin <= End && End <= Spheres.GetSize(), "Invalid range [" << Begin << ", " << End << ")");
+
+	SizeT I = Begin;
+	SizeT VisibleCount = 0;
+
+#if PHOENIX_FRUSTUM_CULLER_AVX || PHOENIX_FRUSTUM_CULLER_SSE
+#	if PHOENIX_FRUSTUM_CULLER_AVX
+	typedef __m256 FloatsT;
+	const SizeT Width = 8;
+#		define F_CullLoad _mm256_loadu_ps
+#		define F_CullSet1 _mm256_set1_ps
+#		define F_CullAdd _mm256_add_ps
+#		define F_CullMul _mm256_mul_ps
+#		define F_CullSub _mm256_sub_ps
+#		define F_CullAnd _mm256_and_ps
+#		define F_CullGreaterEqual(A, B) _mm256_cmp_ps(A, B, _CMP_GE_OQ)
+#		define F_CullMoveMask _mm256_movemask_ps
+#	else
+	typedef __m128 FloatsT;
+	const SizeT Width = 4;
+#		define F_CullLoad _mm_loadu_ps
+#		define F_CullSet1 _mm_set1_ps
+#		define F_CullAdd _mm_add_ps
+#		define F_CullMul _mm_mul_ps
+#		define F_CullSub _mm_sub_ps
+#		define F_CullAnd _mm_and_ps
+#		define F_CullGreaterEqual(A, B) _mm_cmpge_ps(A, B)
+#		define F_CullMoveMask _mm_movemask_ps
+#	endif
+
+	FloatsT PlaneX[EFrustumPlane::Count];
+	FloatsT PlaneY[EFrustumPlane::Count];
+	FloatsT PlaneZ[EFrustumPlane::Count];
+	FloatsT PlaneW[EFrustumPlane::Count];
+
+	for (EFrustumPlane::Type P = 0; P < EFrustumPlane::Count; ++P)
+	{
+		PlaneX[P] = F_CullSet1(Frustum.Planes[P].x);
+		PlaneY[P] = F_CullSet1(Frustum.Planes[P].y);
+		PlaneZ[P] = F_CullSet1(Frustum.Planes[P].z);
+		PlaneW[P] = F_CullSet1(Frustum.Planes[P].w);
+	}
+
+	const FloatsT Zero = F_CullSet1(0.f);
+
+	for (; I + Width <= End; I += Width)
+	{
+		const FloatsT X = F_CullLoad(&Spheres.X[I]);
+		const FloatsT Y = F_CullLoad(&Spheres.Y[I]);
+		const FloatsT Z = F_CullLoad(&Spheres.Z[I]);
+		const FloatsT NegativeRadius = F_CullSub(Zero, F_CullLoad(&Spheres.Radius[I]));
+
+		FloatsT Inside = F_CullGreaterEqual(Zero, Zero);
+
+		for (EFrustumPlane::Type P = 0; P < EFrustumPlane::Count; ++P)
+		{
+			FloatsT Distance = F_CullAdd(F_CullMul(PlaneX[P], X), PlaneW[P]);
+			Distance = F_CullAdd(F_CullMul(PlaneY[P], Y), Distance);
+			Distance = F_CullAdd(F_CullMul(PlaneZ[P], Z), Distance);
+			Inside = F_CullAnd(Inside, F_CullGreaterEqual(Distance, NegativeRadius));
+		}
+
+		// Every lane's index is written, but the count only moves past the visible ones.
+		const UInt32 Mask = static_cast<UInt32>(F_CullMoveMask(Inside));
+		for (SizeT Lane = 0; Lane < Width; ++Lane)
+		{
+			OutIndices[VisibleCount] = static_cast<UInt32>(I + Lane);
+			VisibleCount += (Mask >> Lane) & 1;
+		}
+	}
+
+#	undef F_CullLoad
+#	undef F_CullSet1
+#	undef F_CullAdd
+#	undef F_CullMul
+#	undef F_CullSub
+#	undef F_CullAnd
+#	undef F_CullGreaterEqual
+#	undef F_CullMoveMask
+#endif
+
+	VisibleCount += FFrustumCullerInternal::CullRangeScalar(Frustum, Spheres, I, End, OutIndices + VisibleCount);
+	return VisibleCount;
+}
+
+const FFrustumCullerStats& FFrustumCuller::GetStats() const
+{
+	return Stats;
+}
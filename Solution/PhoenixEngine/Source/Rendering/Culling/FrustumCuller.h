@@ -0,0 +1,133 @@
+#ifndef PHOENIX_FRUSTUM_CULLER_H
+#define PHOENIX_FRUSTUM_CULLER_H
+
+#include "Utility/Containers/Array.h"
+#include "Utility/Containers/Vector.h"
+#include "Utility/Misc/Primitives.h"
+#include "Math/Matrix4D.h"
+#include "Math/Vector3D.h"
+#include "Math/Vector4D.h"
+
+namespace Phoenix
+{
+	class FAsyncTaskHandler;
+
+	namespace EFrustumPlane
+	{
+		typedef UInt8 Type;
+
+		enum Value : Type
+		{
+			Left,
+			Right,
+			Bottom,
+			Top,
+			Near,
+			Far,
+			Count
+		};
+	}
+
+	struct FFrustum
+	{
+		/*! \brief Each plane is (Normal, Distance) with the normal pointing into the frustum. */
+		TArray<FVector4D, EFrustumPlane::Count> Planes;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Extracts the planes of a view projection matrix.
+		*
+		*	@note Expects OpenGL's clip space, where depth is in [-1, 1].
+		*/
+		void Init(const FMatrix4D& ViewProjection);
+
+		bool IsVisible(const FVector3D& Center, const Float32 Radius) const;
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief World space bounding spheres, stored as a structure of arrays.
+	*
+	*	@desc Keeping each component in its own array lets the culler test several
+	*		spheres at once with plain vector loads.
+	*/
+	struct FCullSpheres
+	{
+		TVector<Float32> X;
+		TVector<Float32> Y;
+		TVector<Float32> Z;
+		TVector<Float32> Radius;
+
+		void Reserve(const SizeT Capacity);
+
+		void Add(const FVector3D& Center, const Float32 SphereRadius);
+
+		void Clear();
+
+		SizeT GetSize() const;
+	};
+
+	struct FFrustumCullerStats
+	{
+		SizeT Tested{ 0 };
+		SizeT Visible{ 0 };
+		/*! \brief The number of chunks the spheres were split into for the last cull. */
+		SizeT Chunks{ 0 };
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Culls bounding spheres against a frustum.
+	*
+	*	@desc Spheres are tested 8 at a time with AVX or 4 at a time with SSE, with a
+	*		scalar fallback.  Large inputs are split into chunks that the calling
+	*		thread and the task handler's threads claim from a shared counter, so the
+	*		cull never waits on a worker that is busy with something else.
+	*/
+	class FFrustumCuller
+	{
+	public:
+		static const SizeT ChunkSize = 4096;
+
+		FFrustumCuller() = default;
+
+		FFrustumCuller(const FFrustumCuller&) = delete;
+		FFrustumCuller& operator=(const FFrustumCuller&) = delete;
+
+		FFrustumCuller(FFrustumCuller&&) = default;
+		FFrustumCuller& operator=(FFrustumCuller&&) = default;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Finds every sphere that is at least partially inside of the frustum.
+		*
+		*	@param Frustum - The frustum to test against.
+		*	@param Spheres - The spheres to test.
+		*	@param VisibleIndices - Receives the indices of the visible spheres, in
+		*		ascending order.
+		*	@param TaskHandler - Optional.  Its threads help with large inputs.
+		*/
+		void Cull(
+			const FFrustum& Frustum,
+			const FCullSpheres& Spheres,
+			TVector<UInt32>& VisibleIndices,
+			FAsyncTaskHandler* const TaskHandler = nullptr);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Culls the spheres in [Begin, End) on the calling thread.
+		*
+		*	@param OutIndices - Must have room for End - Begin indices.
+		*	@return Returns the number of visible spheres written to OutIndices.
+		*/
+		static SizeT CullRange(
+			const FFrustum& Frustum,
+			const FCullSpheres& Spheres,
+			const SizeT Begin,
+			const SizeT End,
+			UInt32* const OutIndices);
+
+		const FFrustumCullerStats& GetStats() const;
+
+	protected:
+	private:
+		FFrustumCullerStats Stats;
+	};
+}
+
+#endif
@@ -124,33 +124,40 @@ void FGBuffer::DeInit()
 	}
 }
 
-void FGBuffer::EnableWrite()
+void FGBuffer::EnableWrite(FRenderCommandBuffer& Commands) const
 {
 	F_Assert(IsValid(), "This class must be valid");
-	F_GL(GL::BindFramebuffer(EGBuffer::DrawFramebuffer, Framebuffer));
-	F_GL(GL::DrawBuffers(EGBufferTex::Count, &ColorAttachments[0]));
+
+	TArray<UInt32, EGBufferTex::Count> Attachments;
+	for (EGBufferTex::Type I = 0; I < EGBufferTex::Count; ++I)
+	{
+		Attachments[I] = ColorAttachments[I];
+	}
+
+	Commands.BindFramebuffer(EGBuffer::DrawFramebuffer, Framebuffer);
+	Commands.DrawBuffers(EGBufferTex::Count, Attachments.data());
 }
 
-void FGBuffer::DisableWrite()
+void FGBuffer::DisableWrite(FRenderCommandBuffer& Commands) const
 {
 	F_Assert(IsValid(), "This class must be valid");
-	F_GL(GL::BindFramebuffer(EGBuffer::DrawFramebuffer, 0));
+	Commands.BindFramebuffer(EGBuffer::DrawFramebuffer, 0);
 }
 
-void FGBuffer::EnableRead()
+void FGBuffer::EnableRead(FRenderCommandBuffer& Commands) const
 {
 	F_Assert(IsValid(), "This class must be valid");
-	F_GL(GL::BindFramebuffer(EGBuffer::ReadFramebuffer, Framebuffer));
+	Commands.BindFramebuffer(EGBuffer::ReadFramebuffer, Framebuffer);
 }
 
-void FGBuffer::DisableRead()
+void FGBuffer::DisableRead(FRenderCommandBuffer& Commands) const
 {
 	F_Assert(IsValid(), "This class must be valid");
-	F_GL(GL::BindFramebuffer(EGBuffer::ReadFramebuffer, 0));
+	Commands.BindFramebuffer(EGBuffer::ReadFramebuffer, 0);
 }
 
-void FGBuffer::BindTexture(const EGBufferTex::Value Texture)
+void FGBuffer::BindTexture(FRenderCommandBuffer& Commands, const EGBufferTex::Value Texture) const
 {
 	F_Assert(IsValid(), "This class must be valid");
-	F_GL(GL::BindTexture(ETexTarget::T2D, Textures[Texture]));
+	Commands.BindTexture(ETexTarget::T2D, Textures[Texture]);
 }
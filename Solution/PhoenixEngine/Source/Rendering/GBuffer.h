@@ -4,6 +4,7 @@
 #include "Utility/Containers/Array.h"
 #include "Utility/Misc/Primitives.h"
 #include "Rendering/GL/GLInterface.h"
+#include "Rendering/Queue/RenderCommandBuffer.h"
 
 namespace Phoenix
 {
@@ -37,15 +38,15 @@ namespace Phoenix
 
 		void DeInit();
 
-		void EnableWrite();
+		void EnableWrite(FRenderCommandBuffer& Commands) const;
 
-		void DisableWrite();
+		void DisableWrite(FRenderCommandBuffer& Commands) const;
 
-		void EnableRead();
+		void EnableRead(FRenderCommandBuffer& Commands) const;
 
-		void DisableRead();
+		void DisableRead(FRenderCommandBuffer& Commands) const;
 
-		void BindTexture(const EGBufferTex::Value Texture);
+		void BindTexture(FRenderCommandBuffer& Commands, const EGBufferTex::Value Texture) const;
 
 	protected:
 	private:
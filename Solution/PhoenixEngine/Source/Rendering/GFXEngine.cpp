@@ -1,21 +1,31 @@
 #include "Stdafx.h"
 #include "Rendering/GFXEngine.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
 #include "Config/GFXCompileConfig.h"
 #include "ExternalLib/FreeTypeIncludes.h"
 #include "ExternalLib/GLEWIncludes.h"
 #include "ExternalLib/GLIncludes.h"
 #include "Utility/Containers/Array.h"
+#include "Utility/Containers/FlatHashMap.h"
+#include "Utility/Containers/FrameVector.h"
+#include "Utility/Containers/NamedItemCache.h"
 #include "Utility/Containers/PriorityQueue.h"
-#include "Utility/Containers/UnorderedSet.h"
+#include "Utility/Containers/UnorderedMap.h"
 #include "Utility/FileIO/File.h"
 #include "Utility/MetaProgramming/AssertOnCopy.h"
+#include "Utility/Misc/Function.h"
 #include "Utility/Misc/Memory.h"
+#include "Utility/Misc/TLSFHeap.h"
 #include "Utility/Misc/Timer.h"
 #include "Utility/Threading/AsyncTaskHandler.h"
 #include "Utility/Threading/Atomic.h"
 #include "Utility/Threading/ConditionVariable.h"
 #include "Utility/Threading/Thread.h"
+#include "Utility/Threading/TripleBuffer.h"
 #include "Math/Math.h"
 #include "Math/MathCommon.h"
 #include "Math/Matrix3D.h"
@@ -27,22 +37,31 @@
 #include "Rendering/GFXRenderData.h"
 #include "Rendering/GFXScene.h"
 #include "Rendering/GFXUtils.h"
+#include "Rendering/Caches/AssetRequestTable.h"
 #include "Rendering/Caches/GFXCaches.h"
+#include "Rendering/Culling/FrustumCuller.h"
 #include "Rendering/Debug/GFXDebug.h"
 #include "Rendering/Debug/GFXProfiler.h"
 #include "Rendering/GL/GLInterface.h"
+#include "Rendering/GL/GLRecorder.h"
 #include "Rendering/Handles/GFXHandles.h"
 #include "Rendering/Image/Image.h"
 #include "Rendering/Image/ImageProcessor.h"
 #include "Rendering/Model/Model.h"
 #include "Rendering/Model/ModelInstance.h"
 #include "Rendering/Model/ModelProcessor.h"
+#include "Rendering/Queue/InstanceBatcher.h"
+#include "Rendering/Queue/RenderCommandBuffer.h"
+#include "Rendering/Queue/RenderQueue.h"
+#include "Rendering/Queue/RenderStateCache.h"
+#include "Rendering/Queue/SpriteBatcher.h"
 #include "Rendering/Shader/Shader.h"
 #include "Rendering/Shader/ShaderNames.h"
 #include "Rendering/Shader/ShaderUniformNames.h"
 #include "Rendering/Text/Font.h"
 #include "Rendering/Text/FontEngine.h"
 #include "Rendering/Threading/GFXTaskReceiver.h"
+#include "Rendering/Transform/TransformBuilder.h"
 
 #ifndef PHOENIX_GFX_COMPILE_CONFIG
 #	error("Config/GFXCompileConfig.h should be included in this file.")
@@ -51,13 +70,64 @@
 using namespace Phoenix;
 using namespace Phoenix::GL;
 
+namespace FGFXEngineConstants
+{
+	/*! \brief Must match the instance attribute locations of the ModelDeferred vertex shader. */
+	const GLuint InstanceWVPLocation = 3;
+	const GLuint InstanceOriginLocation = 7;
+}
+
 namespace Phoenix
 {
-	typedef std::pair<const FModelInstance*, THandle<FModel>> FModelRenderEntry;
-	typedef std::pair<const FImageInstance*, THandle<FImage>> FImageRenderEntry;
+	typedef std::pair<const FModelInstance*, TThreadSafeHandle<FModel>> FModelRenderEntry;
+	typedef std::pair<const FImageInstance*, TThreadSafeHandle<FImage>> FImageRenderEntry;
+
+	typedef TFrameVector<FModelRenderEntry> FModelRenderList;
+	typedef TFrameVector<FImageRenderEntry> FImageRenderList;
+
+	namespace EGFXPass
+	{
+		typedef UInt8 Type;
+
+		/*! \brief The passes that record their own commands, in the order they're replayed. */
+		enum Value : Type
+		{
+			Models,
+			Images,
+			Text,
+			Count
+		};
+	}
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief The state that is shared between the threads recording one frame's passes.
+	*
+	*	@note Tasks that start after every pass has been claimed only touch the
+	*		counters, which is why this is kept alive by the tasks rather than by
+	*		FGFXHelper::RecordPasses.
+	*/
+	struct FGFXRecordJob
+	{
+		TArray<TFunction<void()>, EGFXPass::Count> Passes;
+		TAtomic<SizeT> NextPass{ 0 };
+		TAtomic<SizeT> CompletedPasses{ 0 };
+
+		void Run()
+		{
+			for (;;)
+			{
+				const SizeT Pass = NextPass.fetch_add(1, std::memory_order_relaxed);
+				if (Pass >= EGFXPass::Count)
+				{
+					return;
+				}
+
+				Passes[Pass]();
 
-	typedef TVector<FModelRenderEntry> FModelRenderList;
-	typedef TVector<FImageRenderEntry> FImageRenderList;
+				CompletedPasses.fetch_add(1, std::memory_order_release);
+			}
+		}
+	};
 
 	struct FGFXEngineInternals
 	{
@@ -71,8 +141,10 @@ namespace Phoenix
 		/*! \brief The function that's used to make the necessary draw calls. */
 		FGFXEngine::DrawFunction DrawFunc{ &FGFXEngine::ThreadEmptyFunction };
 
+#if !PHOENIX_GFX_ENABLE_MULTI_THREADED_RENDERING
 		/*! \brief Contains everything that'll be rendered on screen. */
 		TUniquePtr<FGFXRenderData> RenderData;
+#endif
 		/*! \brief Contains all of the handles for the engine. */
 		TUniquePtr<FGFXHandles> Handles;
 		/*! \brief Contains all of the caches for the engine. */
@@ -83,13 +155,61 @@ namespace Phoenix
 		/*! \brief Contains functonality for streaming in data. */
 		TUniquePtr<FAsyncTaskHandler> TaskHandler;
 		TUniquePtr<FGFXTaskReceiver> MsgReceiver;
-		TUnorderedSet<FString> PendingAsyncTasks;
+		/*! \brief Tracks which assets are loading or have failed, so each is only loaded once at a time. */
+		FAssetRequestTable AssetRequests;
 		FGFXTaskReceiver::FTasks Tasks;
+		/*! \brief The model each synced model instance last resolved to, by the instance's index.
+		*		Holding these keeps the models that are in use pinned in the cache. */
+		TVector<TNamedHandleRef<FModel, FThreadSafeHandlePolicy>> ModelRefs;
+		/*! \brief The image each synced image instance last resolved to, by the instance's index. */
+		TVector<TNamedHandleRef<FImage, FThreadSafeHandlePolicy>> ImageRefs;
 
 		/*! \brief Standard multi-render target buffer for deferred shading. */
 		FGBuffer GBuffer;
 		/*! \brief A full screen quad. */
 		FMesh MeshQuad;
+		/*! \brief Culls model instances before they're drawn. */
+		FFrustumCuller Culler;
+		/*! \brief The world space bounds of the models being culled, kept to reuse its memory. */
+		FCullSpheres CullSpheres;
+		/*! \brief The indices of the models that survived the last cull. */
+		TVector<UInt32> VisibleModels;
+		/*! \brief Builds the matrices of the models being drawn. */
+		FTransformBuilder TransformBuilder;
+		/*! \brief The transforms of the models being drawn, kept to reuse its memory. */
+		FTransforms ModelTransforms;
+		/*! \brief Kept between frames since the model pass may be recorded on a task thread,
+		*		which has no frame allocator that gets reset. */
+		TVector<FMatrix4D> ModelWVPMatrices;
+		/*! \brief Orders the model draws to share as many binds as possible. */
+		FRenderQueue ModelRenderQueue;
+		/*! \brief Orders the image draws by layer, then to share as many binds as possible. */
+		FRenderQueue ImageRenderQueue;
+		/*! \brief Groups model draws that share a mesh and material into instanced draws. */
+		FInstanceBatcher InstanceBatcher;
+		/*! \brief Streams the per-instance data of the model draws to the GPU each frame. */
+		GL::VertexBufferT InstanceBuffer{ 0 };
+		/*! \brief Writes the images into one vertex array and groups them into as few draws as possible. */
+		FSpriteBatcher SpriteBatcher;
+		/*! \brief Reads the sprite vertex buffer's vertices. */
+		GL::VertexArrayT SpriteVertexArray{ 0 };
+		/*! \brief Streams the vertices of the images to the GPU each frame. */
+		GL::VertexBufferT SpriteVertexBuffer{ 0 };
+		/*! \brief The size of each streamed buffer's data store, in bytes. */
+		TFlatHashMap<GL::VertexBufferT, GLsizeiptr> StreamBufferCapacities;
+		/*! \brief The commands each pass recorded for the frame being drawn. */
+		TArray<FRenderCommandBuffer, EGFXPass::Count> PassCommands;
+		/*! \brief The commands of every pass, merged in pass order. */
+		FRenderCommandBuffer FrameCommands;
+		/*! \brief Drops the binds, state changes and uniform uploads that wouldn't change anything. */
+		FRenderStateCache StateCache;
+		/*! \brief The uniform locations the passes set, looked up once the shaders are loaded. */
+		GL::LocationT MDDiffuseMapLocation{ FShader::InvalidUniform };
+		GL::LocationT MDFDiffuseMapLocation{ FShader::InvalidUniform };
+		GL::LocationT I2DDiffuseMapLocation{ FShader::InvalidUniform };
+		GL::LocationT I2DTransformLocation{ FShader::InvalidUniform };
+		/*! \brief The binds, state changes and draws of the frame being drawn. */
+		FRenderStats FrameStats;
 		/*! \brief Contains the ModelDeferred series of shaders. */
 		THandle<FShader> MDShader;
 		/*! \brief Contains the ModelDeferredFinal series of shaders. */
@@ -108,48 +228,62 @@ namespace Phoenix
 		/* GFXThread: N/A, GameThread: Read/Write */
 		/*! \brief Represents the scene that the game thread interacts with. */
 		TUniquePtr<FGFXScene> Scene;
+		/*! \brief Tracks which image instances changed since each render data buffer was set up. */
+		FImageRenderSync ImageSync;
+		/*! \brief Tracks which model instances changed since each render data buffer was set up. */
+		FModelRenderSync ModelSync;
 
 		/* GFXThread: Read/Write, GameThread: Read/Write */
 #if PHOENIX_GFX_ENABLE_MULTI_THREADED_RENDERING
-		/*! \brief Used to lock access to certain data within the engine. */
-		FMutex Mutex;
-		/*! \brief Used to wait until a signal is sent that new data has been passed to the engine. */
-		FConditionVariable ConditionVariable;
-		/*! \brief Represents the grapics state that will be rendered. */
-		TUniquePtr<FGFXRenderData> GameRenderData;
-		/*! \brief Represents the grapics state that is waiting to be rendered. */
-		TUniquePtr<FGFXRenderData> QueuedRenderData;
+		/*! \brief The game thread writes and publishes states, the GFX thread renders the latest one. */
+		TTripleBuffer<FGFXRenderData> RenderDataBuffer;
+		/*! \brief The frame index and progress of the latest draw request, packed by FGFXHelper::PackDrawRequest. */
+		TAtomic<UInt64> DrawRequest{ 0 };
+		/*! \brief Lets the GFX thread sleep while there's nothing new to draw.  The game thread never locks it. */
+		FMutex IdleMutex;
+		/*! \brief Signaled by the game thread after each draw request. */
+		FConditionVariable IdleConditionVariable;
+
+		/* GFXThread: N/A, GameThread: Read/Write */
+		/*! \brief The index given to the next state that's set up for rendering. */
+		UInt32 NextFrameIndex{ 1 };
 #endif
+
+		/* GFXThread: Write, GameThread: Read */
+		/*! \brief Guards LastFrameStats. */
+		mutable FMutex RenderStatsMutex;
+		/*! \brief The stats of the last frame that was drawn. */
+		FRenderStats LastFrameStats;
 	};
 
 	namespace FGFXHelper
 	{
 		bool InitScene(FGFXScene& Scene, const FGFXEngine::FInitParams& InitParams);
 
-		THandle<FImage> LoadAndCacheImage(
+		TThreadSafeHandle<FImage> LoadAndCacheImage(
 			FGFXCaches& GFXCaches,
 			FGFXHandles& GFXHandles,
-			FString&& TexFileName,
+			const FName& ImageFileName,
 			const FChar* const RelativeDirPath,
 			const EPixelFormat::Value PixelFormat);
 
-		THandle<FImage> LoadAndCacheImageGL(
+		TThreadSafeHandle<FImage> LoadAndCacheImageGL(
 			FImageCache& ImageCache,
 			FImageHandles& ImageHandles,
-			FString&& ImageFileName,
+			const FName& ImageFileName,
 			const FImageProcessor& ImageProcessor);
 
-		THandle<FModel> LoadAndCacheModel(
+		TThreadSafeHandle<FModel> LoadAndCacheModel(
 			FGFXCaches& GFXCaches,
 			FGFXHandles& GFXHandles,
-			FString&& ModelFileName,
+			const FName& ModelFileName,
 			const FChar* const RelativeDirPath,
 			const EMeshAttribute::Type MeshAttributes);
 
-		THandle<FModel> LoadAndCacheModelGL(
+		TThreadSafeHandle<FModel> LoadAndCacheModelGL(
 			FGFXCaches& GFXCaches,
 			FGFXHandles& GFXHandles,
-			FString&& ModelFileName,
+			const FName& ModelFileName,
 			const FModelProcessor& ModelProcessor);
 
 		THandle<FShader> LoadAndCacheShader(
@@ -159,17 +293,119 @@ namespace Phoenix
 			const FChar* const RelativeDirPath,
 			const FChar* const ShaderKey);
 
+		//	--------------------------------------------------------------------------------
+		/*! \brief Removes every model that is outside of the view frustum from the list.
+		*
+		*	@note The list keeps its order, so the draws that remain are submitted as before.
+		*/
+		void CullModels(
+			FGFXEngineInternals& Eng,
+			FModelRenderList& ModelRenderList,
+			const FMatrix4D& ViewProjectionMatrix,
+			const Float32 FrameProgress);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Records the commands of every pass into its own buffer.
+		*
+		*	@desc Passes are claimed by the task handler's threads and the calling thread,
+		*		so the frame keeps moving even while every task thread is busy loading.
+		*/
+		void RecordPasses(
+			FGFXEngineInternals& Eng,
+			const FModelRenderList& ModelRenderList,
+			const FImageRenderList& ImageRenderList,
+			const FMatrix4D& ViewProjectionMatrix,
+			const FMatrix4D& OrthoMatrix,
+			const Float32 FrameProgress);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Records the models into the GBuffer, then the GBuffer onto the screen. */
+		void RecordModelPass(
+			FGFXEngineInternals& Eng,
+			FRenderCommandBuffer& Commands,
+			const FModelRenderList& ModelRenderList,
+			const FMatrix4D& ViewProjectionMatrix,
+			const Float32 FrameProgress);
+
+		void RecordImagePass(
+			FGFXEngineInternals& Eng,
+			FRenderCommandBuffer& Commands,
+			const FImageRenderList& ImageRenderList,
+			const FMatrix4D& OrthoMatrix,
+			const Float32 FrameProgress);
+
+		void RecordTextPass(FRenderCommandBuffer& Commands);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Records every mesh of every model in the order of their sort keys.
+		*
+		*	@desc Meshes that share a vertex array and diffuse image are drawn together
+		*		with one instanced draw call.
+		*	@note Expects the deferred shader to already be enabled.
+		*/
 		void RenderModels(
-			const FGFXEngineInternals& Eng,
+			FGFXEngineInternals& Eng,
+			FRenderCommandBuffer& Commands,
 			const FModelRenderList& ModelRenderList,
-			const FMatrix4D& ViewProjectionMatrix);
+			const FMatrix4D& ViewProjectionMatrix,
+			const Float32 FrameProgress);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Records the images in layer order, batching the ones that share a texture.
+		*
+		*	@note Expects the Image2D shader to already be enabled.
+		*/
+		void RenderImages(
+			FGFXEngineInternals& Eng,
+			FRenderCommandBuffer& Commands,
+			const FImageRenderList& ImageRenderList,
+			const Float32 FrameProgress);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Issues the commands that change something, through the state cache.
+		*
+		*	@note The state cache is invalidated first, since anything may have been bound
+		*		since the last replay.  The frame's bind and draw stats are counted here, so
+		*		they only include what was actually issued.
+		*/
+		void ReplayCommands(FGFXEngineInternals& Eng, const FRenderCommandBuffer& Commands);
+
+		void ReplayUniform(const FRenderCommandBuffer& Commands, const FRenderCommand& Command);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Copies data into the buffer bound to Target, orphaning its old data store.
+		*
+		*	@param Capacity - The size of the buffer's data store, in bytes.  Only ever grows.
+		*/
+		void StreamBuffer(
+			const EBuffer::Value Target,
+			GLsizeiptr& Capacity,
+			const GLvoid* const Data,
+			const GLsizeiptr Size);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Points the bound vertex array's instance attributes at a batch's instances.
+		*
+		*	@note Expects the instance buffer to be bound to EBuffer::Array.
+		*/
+		void SetInstanceAttributes(FRenderCommandBuffer& Commands, const UInt32 FirstInstance);
+
+		UInt64 PackDrawRequest(const UInt32 FrameIndex, const Float32 FrameProgress);
+
+		UInt32 GetDrawRequestFrameIndex(const UInt64 DrawRequest);
+
+		Float32 GetDrawRequestFrameProgress(const UInt64 DrawRequest);
 	};
 
 	namespace FGFXAsyncTasks
 	{
-		void ProcessModel(FGFXEngineInternals& Eng, const FString& ModelName);
+		void ProcessModel(FGFXEngineInternals& Eng, const FName& ModelName);
 
-		void ProcessImage(FGFXEngineInternals& Eng, const FString& ImageName);
+		void ProcessImage(FGFXEngineInternals& Eng, const FName& ImageName);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Lets the GFX thread know that an asset failed to load on an async thread. */
+		void ReportFailure(FGFXEngineInternals& Eng, const FName& AssetName);
 	};
 }
 
@@ -195,11 +431,9 @@ void FGFXEngine::Init(const FInitParams& InitParams)
 	F_Assert(!Eng.IsRunning.load(), "GFX Thread is already running.");
 
 	Eng.InitParams = InitParams;
-	Eng.RenderData = std::make_unique<FGFXRenderData>();
 
-#if PHOENIX_GFX_ENABLE_MULTI_THREADED_RENDERING
-	Eng.GameRenderData = std::make_unique<FGFXRenderData>();
-	Eng.QueuedRenderData = std::make_unique<FGFXRenderData>();
+#if !PHOENIX_GFX_ENABLE_MULTI_THREADED_RENDERING
+	Eng.RenderData = std::make_unique<FGFXRenderData>();
 #endif
 
 	Eng.Scene = std::make_unique<FGFXScene>();
@@ -233,8 +467,7 @@ void FGFXEngine::ForceShutDown()
 	Eng.IsRunning = false;
 
 #if PHOENIX_GFX_ENABLE_MULTI_THREADED_RENDERING
-	TUniqueLock<FMutex> Lock(Eng.Mutex);
-	Eng.ConditionVariable.notify_one();
+	Eng.IdleConditionVariable.notify_one();
 #else
 	ThreadDeInit();
 #endif
@@ -256,7 +489,8 @@ void FGFXEngine::SetUpNextRender()
 		auto& Scene = GetScene();
 
 #if PHOENIX_GFX_ENABLE_MULTI_THREADED_RENDERING
-		auto& RenderData = *Eng.GameRenderData;
+		auto& RenderData = Eng.RenderDataBuffer.GetWriteBuffer();
+		RenderData.FrameIndex = Eng.NextFrameIndex++;
 #else
 		auto& RenderData = *Eng.RenderData;
 #endif
@@ -264,26 +498,48 @@ void FGFXEngine::SetUpNextRender()
 		const auto& MIs = Scene.GetModelInstances();
 		const auto& IIs = Scene.GetImageInstances();
 
-		RenderData.PersCam = *Scene.GetPerspectiveCamera();
-		RenderData.OrthoCam = *Scene.GetOrthographicCamera();
+		RenderData.PersCam = *Scene.GetPerspectiveCamera().Lock();
+		RenderData.OrthoCam = *Scene.GetOrthographicCamera().Lock();
+
+		// Each buffer keeps the instances it was last set up with, so only the ones that
+		// changed since then are copied.
+		Scene.CollectRenderChanges(Eng.ImageSync, Eng.ModelSync);
 
-		RenderData.Images = IIs.GetData();
-		RenderData.Models = MIs.GetData();
+		const FRenderSyncStats ImageSyncStats = Eng.ImageSync.Sync(IIs, RenderData.Images, RenderData.ImagesSync);
+		const FRenderSyncStats ModelSyncStats = Eng.ModelSync.Sync(MIs, RenderData.Models, RenderData.ModelsSync);
+		RenderData.HandoffBytes = ImageSyncStats.Bytes + ModelSyncStats.Bytes;
 
 		RenderData.IsReadyForRender = true;
+	}
 
-#if !PHOENIX_GFX_ENABLE_MULTI_THREADED_RENDERING
-		ThreadDraw();
+#if PHOENIX_GFX_ENABLE_MULTI_THREADED_RENDERING
+	Eng.RenderDataBuffer.Publish();
 #endif
-	}
+}
+
+void FGFXEngine::Draw(const Float32 FrameProgress)
+{
+	auto& Eng = Get();
 
-	{
 #if PHOENIX_GFX_ENABLE_MULTI_THREADED_RENDERING
-		TUniqueLock<FMutex> Lock(Eng.Mutex);
-		std::swap(Eng.QueuedRenderData, Eng.GameRenderData);
-		Eng.ConditionVariable.notify_one();
+	// The request refers to the latest published state, which is always visible to the
+	// GFX thread by the time it sees the request.
+	const UInt32 FrameIndex = Eng.NextFrameIndex - 1;
+	Eng.DrawRequest.store(FGFXHelper::PackDrawRequest(FrameIndex, FrameProgress), std::memory_order_release);
+	Eng.IdleConditionVariable.notify_one();
+#else
+	Eng.RenderData->FrameProgress = FrameProgress;
+	ThreadDraw();
 #endif
-	}
+}
+
+FRenderStats FGFXEngine::GetRenderStats() const
+{
+	const auto& Eng = Get();
+	TLockGuard<FMutex> Lock(Eng.RenderStatsMutex);
+
+	const FRenderStats RenderStats = Eng.LastFrameStats;
+	return RenderStats;
 }
 
 FGFXScene& FGFXEngine::GetScene()
@@ -304,16 +560,30 @@ void FGFXEngine::ThreadRun()
 	ThreadInit();
 
 	auto& Eng = Get();
+	UInt64 LastDrawRequest = 0;
 
 	while (Eng.IsRunning)
 	{
-		ThreadDraw();
+		const UInt64 DrawRequest = Eng.DrawRequest.load(std::memory_order_acquire);
 
+		if (DrawRequest == LastDrawRequest)
 		{
-			TUniqueLock<FMutex> Lock(Eng.Mutex);
-			Eng.ConditionVariable.wait(Lock);
-			std::swap(Eng.RenderData, Eng.QueuedRenderData);
+			// A missed signal only delays the next draw by the timeout.
+			const std::chrono::milliseconds IdleTimeout(1);
+			TUniqueLock<FMutex> Lock(Eng.IdleMutex);
+			Eng.IdleConditionVariable.wait_for(Lock, IdleTimeout);
+			continue;
 		}
+
+		LastDrawRequest = DrawRequest;
+		Eng.RenderDataBuffer.Acquire();
+
+		// A state newer than the request has just been published, so it starts at its beginning.
+		FGFXRenderData& RenderData = Eng.RenderDataBuffer.GetReadBuffer();
+		const bool IsRequestForThisFrame = RenderData.FrameIndex == FGFXHelper::GetDrawRequestFrameIndex(DrawRequest);
+		RenderData.FrameProgress = IsRequestForThisFrame ? FGFXHelper::GetDrawRequestFrameProgress(DrawRequest) : 0.f;
+
+		ThreadDraw();
 	}
 
 	ThreadDeInit();
@@ -391,10 +661,12 @@ void FGFXEngine::ThreadInit()
 	Eng.InitParams.Window->SetGraphicsContextCurrent();
 	Eng.InitParams.Window->SetSwapInterval(1);
 
+#if !PHOENIX_GFX_USE_RECORDING_GL
 	glewExperimental = true;
 
 	const bool bGlewFailedToInit = glewInit() != GLEW_OK;
 	F_GFXEngineOnInitError(bGlewFailedToInit, "Failed to initialize GLEW.");
+#endif
 
 	F_GLIgnoreErrors();
 	const bool bAreShadersInit = ThreadInitShaders();
@@ -412,6 +684,32 @@ void FGFXEngine::ThreadInit()
 	Eng.MeshQuad.Init(MeshQuadData, Eng.Caches->GetImageCache());
 	F_GFXEngineOnInitError(!Eng.MeshQuad.IsValid(), "Failed to initialize mesh quad.");
 
+	F_GL(GL::GenBuffers(1, &Eng.InstanceBuffer));
+	F_GFXEngineOnInitError(!Eng.InstanceBuffer, "Failed to initialize instance buffer.");
+
+	{
+		F_GL(GL::GenVertexArrays(1, &Eng.SpriteVertexArray));
+		F_GL(GL::GenBuffers(1, &Eng.SpriteVertexBuffer));
+
+		F_GL(GL::BindVertexArray(Eng.SpriteVertexArray));
+		F_GL(GL::BindBuffer(EBuffer::Array, Eng.SpriteVertexBuffer));
+
+		const GLsizei Stride = sizeof(FSpriteVertex);
+		const GLvoid* const PositionOffset = reinterpret_cast<const GLvoid*>(offsetof(FSpriteVertex, Position));
+		const GLvoid* const TexCoordOffset = reinterpret_cast<const GLvoid*>(offsetof(FSpriteVertex, TexCoord));
+		const GLvoid* const ColorOffset = reinterpret_cast<const GLvoid*>(offsetof(FSpriteVertex, Color));
+
+		F_GL(GL::EnableVertexAttribArray(0));
+		F_GL(GL::VertexAttribPointer(0, 2, EType::Float, EBool::False, Stride, PositionOffset));
+		F_GL(GL::EnableVertexAttribArray(1));
+		F_GL(GL::VertexAttribPointer(1, 2, EType::Float, EBool::False, Stride, TexCoordOffset));
+		F_GL(GL::EnableVertexAttribArray(2));
+		F_GL(GL::VertexAttribPointer(2, 4, EType::Float, EBool::False, Stride, ColorOffset));
+
+		F_GL(GL::BindVertexArray(0));
+	}
+	F_GFXEngineOnInitError(!Eng.SpriteVertexArray || !Eng.SpriteVertexBuffer, "Failed to initialize sprite buffers.");
+
 	Eng.InitParams.Window->Show();
 
 	F_GLDisplayErrors();
@@ -438,9 +736,33 @@ void FGFXEngine::ThreadDeInit()
 	Eng.MDFShader.DeInit();
 	Eng.MDShader.DeInit();
 
+	if (Eng.InstanceBuffer)
+	{
+		F_GL(GL::DeleteBuffers(1, &Eng.InstanceBuffer));
+		Eng.InstanceBuffer = 0;
+	}
+
+	if (Eng.SpriteVertexBuffer)
+	{
+		F_GL(GL::DeleteBuffers(1, &Eng.SpriteVertexBuffer));
+		Eng.SpriteVertexBuffer = 0;
+	}
+
+	// The buffers and programs are gone, and new ones may be given the same IDs.
+	Eng.StreamBufferCapacities.clear();
+	Eng.StateCache.Reset();
+
+	if (Eng.SpriteVertexArray)
+	{
+		F_GL(GL::DeleteVertexArrays(1, &Eng.SpriteVertexArray));
+		Eng.SpriteVertexArray = 0;
+	}
+
 	Eng.MeshQuad.DeInit();
 	Eng.GBuffer.DeInit();
 
+	Eng.ImageRefs.clear();
+	Eng.ModelRefs.clear();
 	Eng.Caches.reset();
 
 	if (Eng.Handles)
@@ -460,7 +782,14 @@ void FGFXEngine::ThreadDeInit()
 		}
 	}
 
-	Eng.PendingAsyncTasks.clear();
+	const FAssetRequestStats& RequestStats = Eng.AssetRequests.GetStats();
+	F_GFXLog("Asset requests.  Started: " << RequestStats.Started
+		<< ", Coalesced: " << RequestStats.Coalesced
+		<< ", Suppressed: " << RequestStats.Suppressed
+		<< ", Succeeded: " << RequestStats.Succeeded
+		<< ", Failed: " << RequestStats.Failed);
+
+	Eng.AssetRequests.Clear();
 	Eng.Tasks.clear();
 
 	if (Eng.MsgReceiver)
@@ -473,6 +802,12 @@ void FGFXEngine::ThreadDeInit()
 		Eng.FontEngine->DeInit();
 	}
 
+	F_GFXLog("GFX Thread frame allocator.  " << FFrameAllocator::GetThreadAllocator().GetStats());
+	F_GFXLog("Asset heap.  " << FTLSFHeap::GetAssetHeap().GetStats());
+
+	const SizeT TrimmedBytes = FTLSFHeap::GetAssetHeap().Trim();
+	F_GFXLog("Asset heap returned " << TrimmedBytes / 1024 << "KB to the OS.");
+
 	Eng.DrawFunc = &FGFXEngine::ThreadEmptyFunction;
 	Eng.InitParams.Window = nullptr;
 	Eng.IsShutDown = true;
@@ -497,18 +832,18 @@ THandle<FFont> FGFXEngine::ThreadLoadAndCacheFont(const FChar* const FontFileNam
 	return Font;
 }
 
-THandle<FImage> FGFXEngine::ThreadLoadAndCacheImage(const FChar* const ImageFileName)
+TThreadSafeHandle<FImage> FGFXEngine::ThreadLoadAndCacheImage(const FChar* const ImageFileName)
 {
 	auto& Eng = Get();
 	F_Assert(ImageFileName, "ImageFileName is null.");
 
-	FString ImageFileNameCopy = ImageFileName;
-	F_Assert(!ImageFileNameCopy.empty(), "The string pointed to by ImageFileName is empty.");
+	const FName ImageName = ImageFileName;
+	F_Assert(!ImageName.IsNone(), "The string pointed to by ImageFileName is empty.");
 
-	THandle<FImage> Image = FGFXHelper::LoadAndCacheImage(
+	TThreadSafeHandle<FImage> Image = FGFXHelper::LoadAndCacheImage(
 		*Eng.Caches,
 		*Eng.Handles,
-		std::move(ImageFileNameCopy),
+		ImageName,
 		EAssetPath::Get(EAssetPath::Textures),
 		EPixelFormat::RGBA);
 
@@ -516,18 +851,18 @@ THandle<FImage> FGFXEngine::ThreadLoadAndCacheImage(const FChar* const ImageFile
 	return Image;
 }
 
-THandle<FModel> FGFXEngine::ThreadLoadAndCacheModel(const FChar* const ModelFileName)
+TThreadSafeHandle<FModel> FGFXEngine::ThreadLoadAndCacheModel(const FChar* const ModelFileName)
 {
 	auto& Eng = Get();
 	F_Assert(ModelFileName, "ModelFileName is null.");
 
-	FString ModelFileNameCopy = ModelFileName;
-	F_Assert(!ModelFileNameCopy.empty(), "The string pointed to by ModelFileName is empty.");
+	const FName ModelName = ModelFileName;
+	F_Assert(!ModelName.IsNone(), "The string pointed to by ModelFileName is empty.");
 
-	THandle<FModel> Model = FGFXHelper::LoadAndCacheModel(
+	TThreadSafeHandle<FModel> Model = FGFXHelper::LoadAndCacheModel(
 		*Eng.Caches,
 		*Eng.Handles,
-		std::move(ModelFileNameCopy),
+		ModelName,
 		EAssetPath::Get(EAssetPath::Models),
 		EMeshAttribute::All);
 
@@ -571,8 +906,20 @@ const FGFXEngineInternals& FGFXEngine::Get() const
 
 void FGFXEngine::ThreadDrawInternal()
 {
-	F_Assert(IsValid(), "This class is invalid.");
+	F_Assert(!IsShutDown(), "This class has been shut down.");
 	ThreadDrawScene();
+
+	auto& Eng = Get();
+
+	// The render lists are gone by now.  The assets that instances use stay pinned
+	// through ModelRefs and ImageRefs, so only unused ones are evicted.
+	Eng.Caches->Trim();
+
+	// Mesh arrays are freed once they're uploaded and when their assets are evicted, so any
+	// arena that's left completely free goes back to the OS instead of waiting for shut down.
+	FTLSFHeap::GetAssetHeap().Trim();
+
+	FFrameAllocator::GetThreadAllocator().EndFrame();
 }
 
 void FGFXEngine::ThreadEmptyFunction()
@@ -638,22 +985,32 @@ bool FGFXEngine::ThreadInitShaders()
 
 	F_GL(GL::BindVertexArray(0));
 	F_GL(GL::DeleteVertexArrays(1, &VertexArray));
+
+	Eng.MDDiffuseMapLocation = Eng.MDShader->GetUniform(EUniform::DiffuseMap);
+	Eng.MDFDiffuseMapLocation = Eng.MDFShader->GetUniform(EUniform::DiffuseMap);
+	Eng.I2DDiffuseMapLocation = Eng.I2DShader->GetUniform(EUniform::DiffuseMap);
+	Eng.I2DTransformLocation = Eng.I2DShader->GetUniform(EUniform::Transform4D);
 	return true;
 }
 
 void FGFXEngine::ThreadDrawScene()
 {
-	F_Assert(IsValid(), "This class is invalid.");
+	F_Assert(!IsShutDown(), "This class has been shut down.");
 	auto& Eng = Get();
+
+#if PHOENIX_GFX_ENABLE_MULTI_THREADED_RENDERING
+	auto& RenderData = Eng.RenderDataBuffer.GetReadBuffer();
+#else
 	auto& RenderData = *Eng.RenderData;
+#endif
 
+	// The latest state is drawn again until a newer one is set up, with only the
+	// interpolation between its previous and current transforms moving forward.
 	if (!RenderData.IsReadyForRender)
 	{
 		return;
 	}
 
-	RenderData.IsReadyForRender = false;
-
 	// #FIXME: Debug only.
 #if 0
 	{
@@ -675,9 +1032,9 @@ void FGFXEngine::ThreadDrawScene()
 	}
 #endif
 
-	const EClearBit::Type EGLClearBits = EClearBit::Color | EClearBit::Depth | EClearBit::Stencil;
 	F_GLDisplayErrors();
-	F_GL(GL::Clear(EGLClearBits));
+	Eng.FrameStats = FRenderStats();
+	Eng.FrameStats.HandoffBytes = RenderData.HandoffBytes;
 
 	const FCamera& PersCam = RenderData.PersCam;
 	const FCamera& OrthoCam = RenderData.OrthoCam;
@@ -690,24 +1047,7 @@ void FGFXEngine::ThreadDrawScene()
 #pragma region Process Completed Tasks
 
 	{
-		if (Eng.Tasks.empty())
-		{
-			Eng.MsgReceiver->RetrieveTasks(Eng.Tasks);
-		}
-
-		if (!Eng.Tasks.empty())
-		{
-			FGFXTaskReceiver::FTask& Task = Eng.Tasks.back();
-			if (Task())
-			{
-				Eng.Tasks.pop_back();
-			}
-			else
-			{
-				F_LogError("Task failed.");
-				Eng.Tasks.clear();
-			}
-		}
+		Eng.MsgReceiver->RunNextTask(Eng.Tasks);
 	}
 
 #pragma endregion
@@ -716,34 +1056,33 @@ void FGFXEngine::ThreadDrawScene()
 
 	FModelRenderList RenderedModels;
 	FAsyncTasks AsyncTasks;
-	TVector<FString> AsyncTaskNames;
+
+	const Float32 RequestTime = FHighResolutionTimer::GetTimeInSeconds();
 
 	{
 		const FModelCache& ModelCache = Eng.Caches->GetModelCache();
+		Eng.ModelRefs.resize(RenderData.Models.size());
 
-		for (const auto& Model : RenderData.Models)
+		for (SizeT I = 0; I < RenderData.Models.size(); ++I)
 		{
+			const auto& Model = RenderData.Models[I];
 			const auto& ModelName = Model.GetModel();
-			THandle<FModel> ModelHandle;
-			ModelHandle = ModelCache.GetItem(ModelName, ModelHandle);
+			const TThreadSafeHandle<FModel>& ModelHandle = Eng.ModelRefs[I].Resolve(ModelName, ModelCache);
 
 			if (ModelHandle.IsValid())
 			{
 				F_Assert(ModelHandle.GetRefCount() > 1, "Model handle should have a ref count of 2 or more.");
-				RenderedModels.emplace_back(std::make_pair(&Model, std::move(ModelHandle)));
+				RenderedModels.emplace_back(std::make_pair(&Model, ModelHandle));
 				continue;
 			}
 
 #pragma region Model Async Load
-			auto Iter = Eng.PendingAsyncTasks.find(ModelName);
-			if (Iter == Eng.PendingAsyncTasks.end())
+			if (Eng.AssetRequests.BeginRequest(ModelName, RequestTime))
 			{
 				AsyncTasks.emplace_back([&Eng, ModelName]()
 				{
 					FGFXAsyncTasks::ProcessModel(Eng, ModelName);
 				});
-
-				AsyncTaskNames.emplace_back(std::move(ModelName));
 			}
 #pragma endregion
 		}
@@ -751,46 +1090,45 @@ void FGFXEngine::ThreadDrawScene()
 
 #pragma endregion
 
+#pragma region Model Culling
+
+	{
+		FGFXHelper::CullModels(Eng, RenderedModels, ViewProjectionMatrix, RenderData.FrameProgress);
+	}
+
+#pragma endregion
+
 #pragma region Image Rendering Set Up
 
 	FImageRenderList RenderedImages;
 
 	{
 		const FImageCache& ImageCache = Eng.Caches->GetImageCache();
+		Eng.ImageRefs.resize(RenderData.Images.size());
 
-		for (const auto& Image : RenderData.Images)
+		for (SizeT I = 0; I < RenderData.Images.size(); ++I)
 		{
+			const auto& Image = RenderData.Images[I];
 			const auto& ImageName = Image.GetImage();
-			THandle<FImage> ImageHandle;
-			ImageHandle = ImageCache.GetItem(ImageName, ImageHandle);
+			const TThreadSafeHandle<FImage>& ImageHandle = Eng.ImageRefs[I].Resolve(ImageName, ImageCache);
 
 			if (ImageHandle.IsValid())
 			{
 				F_Assert(ImageHandle.GetRefCount() > 1, "Image handle should have a ref count of 2 or more.");
-				RenderedImages.emplace_back(std::make_pair(&Image, std::move(ImageHandle)));
+				RenderedImages.emplace_back(std::make_pair(&Image, ImageHandle));
 				continue;
 			}
 
 #pragma region Image Async Load
-			auto Iter = Eng.PendingAsyncTasks.find(ImageName);
-			if (Iter == Eng.PendingAsyncTasks.end())
+			if (Eng.AssetRequests.BeginRequest(ImageName, RequestTime))
 			{
 				AsyncTasks.emplace_back([&Eng, ImageName]()
 				{
 					FGFXAsyncTasks::ProcessImage(Eng, ImageName);
 				});
-
-				AsyncTaskNames.emplace_back(std::move(ImageName));
 			}
 #pragma endregion
 		}
-
-		auto CompareFunc = [](const FImageRenderEntry& LHS, const FImageRenderEntry& RHS)
-		{
-			return LHS.first->GetLayer() > RHS.first->GetLayer();
-		};
-
-		std::sort(RenderedImages.begin(), RenderedImages.end(), CompareFunc);
 	}
 
 #pragma endregion
@@ -798,114 +1136,54 @@ void FGFXEngine::ThreadDrawScene()
 #pragma region Dispatch Tasks
 
 	{
-		for (const auto& AsyncTaskName : AsyncTaskNames)
-		{
-			Eng.PendingAsyncTasks.emplace(std::move(AsyncTaskName));
-		}
-
 		Eng.TaskHandler->AddAsyncTasks(std::move(AsyncTasks));
 	}
 
 #pragma endregion
 
-#pragma region Model Rendering
-	{
-		Eng.GBuffer.EnableWrite();
-		F_GL(GL::Clear(EGLClearBits));
-		F_GL(GL::ActiveTexture(ETex::T0));
-
-		Eng.MDShader->Enable();
-		Eng.MDShader->SetUniform(0, EUniform::DiffuseMap);
-
-		FGFXHelper::RenderModels(Eng, RenderedModels, ViewProjectionMatrix);
+#pragma region Command Recording
 
-		Eng.GBuffer.DisableWrite();
-		Eng.GBuffer.EnableRead();
-
-		Eng.MDFShader->Enable();
-		Eng.MDFShader->SetUniform(0, EUniform::DiffuseMap);
-
-		for (EGBufferTex::Type I = 0; I < EGBufferTex::Count; ++I)
-		{
-			const ETex::Value ActiveTex = static_cast<ETex::Value>(ETex::T0 + I);
-			const EGBufferTex::Value BufferTex = static_cast<EGBufferTex::Value>(I);
-
-			F_GL(GL::ActiveTexture(ActiveTex));
-			Eng.GBuffer.BindTexture(BufferTex);
-		}
-
-		F_GL(GL::Disable(ECapability::DepthTest));
-		F_GL(GL::BindVertexArray(Eng.MeshQuad.GetVertexArray()));
-		F_GL(GL::DrawArrays(EMode::Triangles, 0, Eng.MeshQuad.GetVertexCount()));
-
-		Eng.GBuffer.DisableRead();
+	{
+		FGFXHelper::RecordPasses(
+			Eng,
+			RenderedModels,
+			RenderedImages,
+			ViewProjectionMatrix,
+			OrthoMatrix,
+			RenderData.FrameProgress);
 	}
 
 #pragma endregion
 
-#pragma region Image Rendering
-	{
-		F_GL(GL::ActiveTexture(ETex::T0));
-		F_GL(GL::Enable(ECapability::Blend));
-		F_GL(GL::BlendFunc(EBlend::SrcAlpha, EBlend::OneMinusSrcAlpha));
-
-		Eng.I2DShader->Enable();
-		Eng.I2DShader->SetUniform(OrthoMatrix, EUniform::Transform4D);
-		Eng.I2DShader->SetUniform(0, EUniform::DiffuseMap);
-
-		const GL::LocationT ColorLoc = Eng.I2DShader->GetUniform(EUniform::Color4D);
-		const GL::LocationT PositionLoc = Eng.I2DShader->GetUniform(EUniform::Position2D);
-		const GL::LocationT ScaleLoc = Eng.I2DShader->GetUniform(EUniform::Scale2D);
-		const GL::LocationT FlipLoc = Eng.I2DShader->GetUniform(EUniform::Flip2D);
-		const GL::LocationT ViewRectLoc = Eng.I2DShader->GetUniform(EUniform::ViewRect2D);
+#pragma region Command Replay
 
-		GL::ImageIDT LastBoundImageID = 0;
+	{
+		FRenderCommandBuffer& FrameCommands = Eng.FrameCommands;
+		FrameCommands.Clear();
 
-		for (SizeT I = 0, RISize = RenderedImages.size(); I < RISize; ++I)
+		for (const FRenderCommandBuffer& PassCommands : Eng.PassCommands)
 		{
-			const FImageInstance& I2DInstance = *RenderedImages[I].first;
-			const FImage& ImageResource = RenderedImages[I].second.Get();
-
-			const FVector4D& Color = I2DInstance.GetColor();
-			const FVector2D& Position = I2DInstance.GetPosition();
-			const FVector2D Scale = I2DInstance.GetScale() * ImageResource.GetDimensions();
-			const FVector2D Flip(I2DInstance.GetFlip().x, -I2DInstance.GetFlip().y);
-			const FVector4D& ViewRect = I2DInstance.GetViewRectangle();
-
-			Eng.I2DShader->SetUniform(Color, ColorLoc);
-			Eng.I2DShader->SetUniform(Position, PositionLoc);
-			Eng.I2DShader->SetUniform(Scale, ScaleLoc);
-			Eng.I2DShader->SetUniform(Flip, FlipLoc);
-			Eng.I2DShader->SetUniform(ViewRect, ViewRectLoc);
-
-			const GL::ImageIDT CurrentImageID = ImageResource.GetID();
-			if (LastBoundImageID != CurrentImageID)
-			{
-				LastBoundImageID = CurrentImageID;
-				ImageResource.Enable();
-			}
-
-			F_GL(GL::DrawArrays(EMode::Triangles, 0, Eng.MeshQuad.GetVertexCount()));
+			FrameCommands.Append(PassCommands);
 		}
+
+		FGFXHelper::ReplayCommands(Eng, FrameCommands);
+		Eng.FrameStats.Sprites = static_cast<UInt32>(Eng.SpriteBatcher.GetSpriteCount());
 	}
 
 #pragma endregion
 
-#pragma region Text Rendering
 	{
-		F_GL(GL::PixelStorei(EPixelStorage::UnpackAlignment, 1));
-
-		// #FIXME...
-
-		F_GL(GL::Disable(ECapability::Blend));
-		F_GL(GL::Enable(ECapability::DepthTest));
-		F_GL(GL::PixelStorei(EPixelStorage::UnpackAlignment, 4));
+		TLockGuard<FMutex> Lock(Eng.RenderStatsMutex);
+		Eng.LastFrameStats = Eng.FrameStats;
 	}
-#pragma endregion
 
 	Eng.InitParams.Window->BufferSwap();
 	F_GLDisplayErrors();
 
+#if PHOENIX_GFX_USE_RECORDING_GL
+	FGLRecorder::Get().EndFrame();
+#endif
+
 #if PHOENIX_GFX_MANAGES_A_PROFILER
 	if (F_GFXGetProfiler().HasEntries())
 	{
@@ -939,13 +1217,13 @@ bool FGFXHelper::InitScene(FGFXScene& Scene, const FGFXEngine::FInitParams& Init
 		const FVector3D UpVector = FVector3D(0, 1, 0);
 
 		{
-			auto& PersCam = Scene.GetPerspectiveCamera();
+			TThreadSafeHandle<FCamera> PersCam = Scene.GetPerspectiveCamera().Lock();
 			PersCam->SetPerspective(FOV, AspectRatio, Near, Far);
 			PersCam->SetView(Position, LookAtTarget, UpVector);
 		}
 
 		{
-			auto& OrthoCam = Scene.GetOrthographicCamera();
+			TThreadSafeHandle<FCamera> OrthoCam = Scene.GetOrthographicCamera().Lock();
 			OrthoCam->SetOrthographic(-HalfWidth, HalfWidth, -HalfHeight, HalfHeight);
 		}
 	}
@@ -954,15 +1232,15 @@ bool FGFXHelper::InitScene(FGFXScene& Scene, const FGFXEngine::FInitParams& Init
 	return bIsValid;
 }
 
-THandle<FImage> FGFXHelper::LoadAndCacheImage(
+TThreadSafeHandle<FImage> FGFXHelper::LoadAndCacheImage(
 	FGFXCaches& GFXCaches,
 	FGFXHandles& GFXHandles,
-	FString&& ImageFileName,
+	const FName& ImageFileName,
 	const FChar* const RelativeDirPath,
 	const EPixelFormat::Value PixelFormat)
 {
 	FImageCache& ImageCache = GFXCaches.GetImageCache();
-	THandle<FImage> Image = ImageCache.GetItemCopy(ImageFileName);
+	TThreadSafeHandle<FImage> Image = ImageCache.GetItemCopy(ImageFileName);
 
 	if (Image.IsValid())
 	{
@@ -970,7 +1248,7 @@ THandle<FImage> FGFXHelper::LoadAndCacheImage(
 		return Image;
 	}
 
-	const FString ImageAssetPath = RelativeDirPath + ImageFileName;
+	const FString ImageAssetPath = RelativeDirPath + ImageFileName.GetString();
 
 	FImageProcessor::FLoadParams LoadParams(ImageAssetPath.c_str(), PixelFormat);
 	FImageProcessor ImageProcessor;
@@ -978,17 +1256,17 @@ THandle<FImage> FGFXHelper::LoadAndCacheImage(
 
 	FImageHandles& ImageHandles = GFXHandles.GetImageHandles();
 
-	Image = LoadAndCacheImageGL(ImageCache, ImageHandles, std::move(ImageFileName), ImageProcessor);
+	Image = LoadAndCacheImageGL(ImageCache, ImageHandles, ImageFileName, ImageProcessor);
 	return Image;
 }
 
-THandle<FImage> FGFXHelper::LoadAndCacheImageGL(
+TThreadSafeHandle<FImage> FGFXHelper::LoadAndCacheImageGL(
 	FImageCache& ImageCache,
 	FImageHandles& ImageHandles,
-	FString&& ImageFileName,
+	const FName& ImageFileName,
 	const FImageProcessor& ImageProcessor)
 {
-	THandle<FImage> Image;
+	TThreadSafeHandle<FImage> Image;
 
 	if (!ImageProcessor.IsValid())
 	{
@@ -1009,19 +1287,19 @@ THandle<FImage> FGFXHelper::LoadAndCacheImageGL(
 		return Image;
 	}
 
-	ImageCache.AddEntry(std::move(ImageFileName), THandle<FImage>(Image));
+	ImageCache.AddEntry(ImageFileName, TThreadSafeHandle<FImage>(Image));
 	return Image;
 }
 
-THandle<FModel> FGFXHelper::LoadAndCacheModel(
+TThreadSafeHandle<FModel> FGFXHelper::LoadAndCacheModel(
 	FGFXCaches& GFXCaches,
 	FGFXHandles& GFXHandles,
-	FString&& ModelFileName,
+	const FName& ModelFileName,
 	const FChar* const RelativeDirPath,
 	const EMeshAttribute::Type MeshAttributes)
 {
 	FModelCache& ModelCache = GFXCaches.GetModelCache();
-	THandle<FModel> Model = ModelCache.GetItemCopy(ModelFileName);
+	TThreadSafeHandle<FModel> Model = ModelCache.GetItemCopy(ModelFileName);
 
 	if (Model.IsValid())
 	{
@@ -1029,23 +1307,23 @@ THandle<FModel> FGFXHelper::LoadAndCacheModel(
 		return Model;
 	}
 
-	const FString ModelAssetPath = RelativeDirPath + ModelFileName;
+	const FString ModelAssetPath = RelativeDirPath + ModelFileName.GetString();
 
 	FModelProcessor::FLoadParams LoadParams(ModelAssetPath.c_str(), MeshAttributes);
 	FModelProcessor ModelProcessor;
 	ModelProcessor.Load(LoadParams);
 
-	Model = LoadAndCacheModelGL(GFXCaches, GFXHandles, std::move(ModelFileName), ModelProcessor);
+	Model = LoadAndCacheModelGL(GFXCaches, GFXHandles, ModelFileName, ModelProcessor);
 	return Model;
 }
 
-THandle<FModel> FGFXHelper::LoadAndCacheModelGL(
+TThreadSafeHandle<FModel> FGFXHelper::LoadAndCacheModelGL(
 	FGFXCaches& GFXCaches,
 	FGFXHandles& GFXHandles,
-	FString&& ModelFileName,
+	const FName& ModelFileName,
 	const FModelProcessor& ModelProcessor)
 {
-	THandle<FModel> Model;
+	TThreadSafeHandle<FModel> Model;
 	if (!ModelProcessor.IsValid())
 	{
 		F_GFXLogError("Model processor is missing its mesh data entries.");
@@ -1053,7 +1331,6 @@ THandle<FModel> FGFXHelper::LoadAndCacheModelGL(
 	}
 
 	const FChar* const RelativeTexturesPath = EAssetPath::Get(EAssetPath::Textures);
-	FString TexFileName;
 
 	for (const auto& Mesh : ModelProcessor.GetMeshData())
 	{
@@ -1061,11 +1338,11 @@ THandle<FModel> FGFXHelper::LoadAndCacheModelGL(
 		for (EMeshDataIndex::Type I = 0; I < EMeshDataIndex::Count; ++I)
 		{
 			const EMeshDataIndex::Value MeshDataIndex = static_cast<EMeshDataIndex::Value>(I);
-			TexFileName = Mesh.GetTextureName(MeshDataIndex);
-			THandle<FImage> Image = FGFXHelper::LoadAndCacheImage(
+			const FName TexFileName = Mesh.GetTextureName(MeshDataIndex);
+			TThreadSafeHandle<FImage> Image = FGFXHelper::LoadAndCacheImage(
 				GFXCaches,
 				GFXHandles,
-				std::move(TexFileName),
+				TexFileName,
 				RelativeTexturesPath,
 				EPixelFormat::RGB);
 
@@ -1089,7 +1366,7 @@ THandle<FModel> FGFXHelper::LoadAndCacheModelGL(
 	}
 
 	FModelCache& ModelCache = GFXCaches.GetModelCache();
-	ModelCache.AddEntry(std::move(ModelFileName), THandle<FModel>(Model));
+	ModelCache.AddEntry(ModelFileName, TThreadSafeHandle<FModel>(Model));
 	return Model;
 }
 
@@ -1161,44 +1438,637 @@ THandle<FShader> FGFXHelper::LoadAndCacheShader(
 	return Shader;
 }
 
+void FGFXHelper::CullModels(
+	FGFXEngineInternals& Eng,
+	FModelRenderList& ModelRenderList,
+	const FMatrix4D& ViewProjectionMatrix,
+	const Float32 FrameProgress)
+{
+	F_GFXProfile();
+
+	FFrustum Frustum;
+	Frustum.Init(ViewProjectionMatrix);
+
+	Eng.CullSpheres.Clear();
+	Eng.CullSpheres.Reserve(ModelRenderList.size());
+
+	for (const auto& RenderEntry : ModelRenderList)
+	{
+		const FModelInstance& ModelInstance = *RenderEntry.first;
+		const FBounds& Bounds = RenderEntry.second->GetBounds();
+
+		const FVector3D& Origin = ModelInstance.GetOrigin();
+		const FVector3D Position = ModelInstance.GetInterpolatedPosition(FrameProgress);
+		const FVector3D Scale = ModelInstance.GetInterpolatedScale(FrameProgress);
+		const FQuaternion Rotation = ModelInstance.GetInterpolatedRotation(FrameProgress);
+
+		// The shader scales and rotates about the origin, so the bounds are treated the same way.
+		const FVector3D Center = Position + Origin + Rotation * ((Bounds.Center - Origin) * Scale);
+		const FVector3D AbsScale = glm::abs(Scale);
+		const Float32 Radius = Bounds.Radius * std::max(AbsScale.x, std::max(AbsScale.y, AbsScale.z));
+
+		Eng.CullSpheres.Add(Center, Radius);
+	}
+
+	Eng.Culler.Cull(Frustum, Eng.CullSpheres, Eng.VisibleModels, Eng.TaskHandler.get());
+
+	// Visible indices are ascending, so each entry moves toward the front or stays put.
+	SizeT WriteIndex = 0;
+	for (const UInt32 VisibleIndex : Eng.VisibleModels)
+	{
+		if (WriteIndex != VisibleIndex)
+		{
+			ModelRenderList[WriteIndex] = std::move(ModelRenderList[VisibleIndex]);
+		}
+
+		++WriteIndex;
+	}
+
+	ModelRenderList.erase(ModelRenderList.begin() + WriteIndex, ModelRenderList.end());
+}
+
+void FGFXHelper::RecordPasses(
+	FGFXEngineInternals& Eng,
+	const FModelRenderList& ModelRenderList,
+	const FImageRenderList& ImageRenderList,
+	const FMatrix4D& ViewProjectionMatrix,
+	const FMatrix4D& OrthoMatrix,
+	const Float32 FrameProgress)
+{
+	F_GFXProfile();
+
+	auto& PassCommands = Eng.PassCommands;
+	for (FRenderCommandBuffer& Commands : PassCommands)
+	{
+		Commands.Clear();
+	}
+
+	TSharedPtr<FGFXRecordJob> Job = std::make_shared<FGFXRecordJob>();
+
+	Job->Passes[EGFXPass::Models] = [&]()
+	{
+		RecordModelPass(Eng, PassCommands[EGFXPass::Models], ModelRenderList, ViewProjectionMatrix, FrameProgress);
+	};
+
+	Job->Passes[EGFXPass::Images] = [&]()
+	{
+		RecordImagePass(Eng, PassCommands[EGFXPass::Images], ImageRenderList, OrthoMatrix, FrameProgress);
+	};
+
+	Job->Passes[EGFXPass::Text] = [&]()
+	{
+		RecordTextPass(PassCommands[EGFXPass::Text]);
+	};
+
+	FAsyncTaskHandler* const TaskHandler = Eng.TaskHandler.get();
+	const SizeT HelperCount = TaskHandler && TaskHandler->IsValid()
+		? std::min<SizeT>(TaskHandler->GetThreadCount(), EGFXPass::Count - 1)
+		: 0;
+
+	if (HelperCount)
+	{
+		FAsyncTasks Tasks;
+		Tasks.reserve(HelperCount);
+
+		for (SizeT I = 0; I < HelperCount; ++I)
+		{
+			Tasks.emplace_back([Job]()
+			{
+				Job->Run();
+			});
+		}
+
+		TaskHandler->AddAsyncTasks(std::move(Tasks));
+	}
+
+	Job->Run();
+
+	while (Job->CompletedPasses.load(std::memory_order_acquire) < EGFXPass::Count)
+	{
+		NThread::YieldThread();
+	}
+}
+
+void FGFXHelper::RecordModelPass(
+	FGFXEngineInternals& Eng,
+	FRenderCommandBuffer& Commands,
+	const FModelRenderList& ModelRenderList,
+	const FMatrix4D& ViewProjectionMatrix,
+	const Float32 FrameProgress)
+{
+	const EClearBit::Type ClearBits = EClearBit::Color | EClearBit::Depth | EClearBit::Stencil;
+	Commands.ClearFramebuffer(ClearBits);
+
+	Eng.GBuffer.EnableWrite(Commands);
+	Commands.ClearFramebuffer(ClearBits);
+	Commands.ActiveTexture(ETex::T0);
+
+	Commands.UseProgram(Eng.MDShader->GetProgram());
+	Commands.Uniform(Eng.MDDiffuseMapLocation, 0);
+
+	RenderModels(Eng, Commands, ModelRenderList, ViewProjectionMatrix, FrameProgress);
+
+	Eng.GBuffer.DisableWrite(Commands);
+	Eng.GBuffer.EnableRead(Commands);
+
+	Commands.UseProgram(Eng.MDFShader->GetProgram());
+	Commands.Uniform(Eng.MDFDiffuseMapLocation, 0);
+
+	for (EGBufferTex::Type I = 0; I < EGBufferTex::Count; ++I)
+	{
+		const ETex::Value ActiveTex = static_cast<ETex::Value>(ETex::T0 + I);
+		const EGBufferTex::Value BufferTex = static_cast<EGBufferTex::Value>(I);
+
+		Commands.ActiveTexture(ActiveTex);
+		Eng.GBuffer.BindTexture(Commands, BufferTex);
+	}
+
+	Commands.Disable(ECapability::DepthTest);
+	Commands.BindVertexArray(Eng.MeshQuad.GetVertexArray());
+	Commands.DrawArrays(EMode::Triangles, 0, static_cast<UInt32>(Eng.MeshQuad.GetVertexCount()));
+
+	Eng.GBuffer.DisableRead(Commands);
+}
+
+void FGFXHelper::RecordImagePass(
+	FGFXEngineInternals& Eng,
+	FRenderCommandBuffer& Commands,
+	const FImageRenderList& ImageRenderList,
+	const FMatrix4D& OrthoMatrix,
+	const Float32 FrameProgress)
+{
+	Commands.ActiveTexture(ETex::T0);
+	Commands.Enable(ECapability::Blend);
+	Commands.BlendFunc(EBlend::SrcAlpha, EBlend::OneMinusSrcAlpha);
+
+	Commands.UseProgram(Eng.I2DShader->GetProgram());
+	Commands.Uniform(Eng.I2DTransformLocation, OrthoMatrix);
+	Commands.Uniform(Eng.I2DDiffuseMapLocation, 0);
+
+	RenderImages(Eng, Commands, ImageRenderList, FrameProgress);
+}
+
+void FGFXHelper::RecordTextPass(FRenderCommandBuffer& Commands)
+{
+	Commands.PixelStore(EPixelStorage::UnpackAlignment, 1);
+
+	// #FIXME...
+
+	Commands.Disable(ECapability::Blend);
+	Commands.Enable(ECapability::DepthTest);
+	Commands.PixelStore(EPixelStorage::UnpackAlignment, 4);
+}
+
 void FGFXHelper::RenderModels(
-	const FGFXEngineInternals& Eng,
+	FGFXEngineInternals& Eng,
+	FRenderCommandBuffer& Commands,
 	const FModelRenderList& ModelRenderList,
-	const FMatrix4D& ViewProjectionMatrix)
+	const FMatrix4D& ViewProjectionMatrix,
+	const Float32 FrameProgress)
 {
-	const GL::LocationT WVPMatrixLoc = Eng.MDShader->GetUniform(EUniform::WorldViewProjection4D);
-	const GL::LocationT OriginLoc = Eng.MDShader->GetUniform(EUniform::Origin3D);
+	const GL::ProgramT Program = Eng.MDShader->GetProgram();
+
+	const SizeT ModelCount = ModelRenderList.size();
+
+	FTransforms& Transforms = Eng.ModelTransforms;
+	Transforms.Clear();
+	Transforms.Reserve(ModelCount);
 
 	for (const auto& RenderEntry : ModelRenderList)
 	{
 		const FModelInstance& ModelInstance = *RenderEntry.first;
-		const FModel& Model = RenderEntry.second.Get();
+		Transforms.Add(
+			ModelInstance.GetInterpolatedPosition(FrameProgress),
+			ModelInstance.GetInterpolatedRotation(FrameProgress),
+			ModelInstance.GetInterpolatedScale(FrameProgress));
+	}
 
-		const FVector3D& Origin = ModelInstance.GetOrigin();
-		const FVector3D& Position = ModelInstance.GetPosition();
-		const FVector3D& Scale = ModelInstance.GetScale();
-		const FQuaternion& Rotation = ModelInstance.GetRotation();
+	TVector<FMatrix4D>& WVPMatrices = Eng.ModelWVPMatrices;
+	WVPMatrices.resize(ModelCount);
+	Eng.TransformBuilder.Build(ViewProjectionMatrix, Transforms, nullptr, WVPMatrices.data(), Eng.TaskHandler.get());
+
+	FRenderQueue& RenderQueue = Eng.ModelRenderQueue;
+	RenderQueue.Clear();
+
+	for (SizeT I = 0; I < ModelCount; ++I)
+	{
+		const FModel& Model = ModelRenderList[I].second.Get();
+
+		// A world matrix's last column is its position, so this is the position in clip space.
+		// Normalized device depth is monotonic in distance, which is all the sort needs.
+		const FVector4D& ClipPosition = WVPMatrices[I][3];
+		const Float32 Depth = ClipPosition.w > 0.f ? (ClipPosition.z / ClipPosition.w) * 0.5f + 0.5f : 0.f;
+		const UInt32 DepthBucket = FRenderQueue::GetDepthBucket(Depth);
+
+		const auto& Meshes = Model.GetMeshes();
+		for (SizeT M = 0, MeshCount = Meshes.size(); M < MeshCount; ++M)
+		{
+			const FMesh& Mesh = Meshes[M];
+			const UInt64 Key = FRenderQueue::MakeKey(
+				ERenderPass::Opaque,
+				Program,
+				Mesh.GetDiffuseImage()->GetID(),
+				Mesh.GetVertexArray(),
+				DepthBucket);
+
+			RenderQueue.Add(Key, static_cast<UInt32>(I), static_cast<UInt32>(M));
+		}
+	}
+
+	RenderQueue.Sort();
+
+	// Opaque keys end with depth, so every draw of a mesh and material is already
+	// adjacent.  The full IDs are compared here since the key may have truncated them.
+	FInstanceBatcher& InstanceBatcher = Eng.InstanceBatcher;
+	InstanceBatcher.Clear();
+	InstanceBatcher.Reserve(RenderQueue.GetSize());
+
+	for (const FRenderQueueItem& Item : RenderQueue.GetItems())
+	{
+		const FModelRenderEntry& RenderEntry = ModelRenderList[Item.Index];
+		const FMesh& Mesh = RenderEntry.second->GetMeshes()[Item.SubIndex];
+
+		F_Assert(Mesh.IsValid(), "Mesh vertex array is invalid.");
+		const UInt64 ImageID = Mesh.GetDiffuseImage()->GetID();
+		const UInt64 Group = (ImageID << 32) | Mesh.GetVertexArray();
+
+		const FInstanceData Instance = { WVPMatrices[Item.Index], FVector4D(RenderEntry.first->GetOrigin(), 0.f) };
+		InstanceBatcher.Add(Group, Item.Index, Item.SubIndex, Instance);
+	}
+
+	if (!InstanceBatcher.GetInstanceCount())
+	{
+		return;
+	}
 
-		const FMatrix4D WorldMatrix = NMatrix4D::Create(Position, Scale, Rotation);
-		const FMatrix4D WVPMatrix = ViewProjectionMatrix * WorldMatrix;
-		//FMatrix3D ITWorldMatrix = FMatrix3D(glm::transpose(glm::inverse(WorldMatrix)));
+	const FInstanceBatcher::FInstances& Instances = InstanceBatcher.GetInstances();
+	Commands.StreamBuffer(EBuffer::Array, Eng.InstanceBuffer, Instances.data(), Instances.size() * sizeof(FInstanceData));
 
-		Eng.MDShader->SetUniform(WVPMatrix, WVPMatrixLoc);
-		Eng.MDShader->SetUniform(Origin, OriginLoc);
+	GL::ImageIDT LastImageID = 0;
 
-		for (const auto& Mesh : Model.GetMeshes())
+	for (const FInstanceBatch& Batch : InstanceBatcher.GetBatches())
+	{
+		const FMesh& Mesh = ModelRenderList[Batch.Index].second->GetMeshes()[Batch.SubIndex];
+
+		const FImage& DiffuseImage = Mesh.GetDiffuseImage().Get();
+		if (DiffuseImage.GetID() != LastImageID)
 		{
-			Mesh.GetDiffuseImage()->Enable();
-			F_Assert(Mesh.IsValid(), "Mesh vertex array is invalid.");
-			F_GL(GL::BindVertexArray(Mesh.GetVertexArray()));
-			F_GL(GL::DrawElements(EMode::Triangles, Mesh.GetIndexCount(), Mesh.GetIndexType(), nullptr));
+			F_Assert(DiffuseImage.IsValid(), "Image is invalid.");
+			LastImageID = DiffuseImage.GetID();
+			Commands.BindTexture(ETexTarget::T2D, LastImageID);
 		}
+
+		// Batches never share a vertex array with the batch before them.
+		Commands.BindVertexArray(Mesh.GetVertexArray());
+
+		SetInstanceAttributes(Commands, Batch.FirstInstance);
+
+		Commands.DrawElementsInstanced(
+			EMode::Triangles,
+			static_cast<UInt32>(Mesh.GetIndexCount()),
+			Mesh.GetIndexType(),
+			static_cast<UInt32>(Batch.InstanceCount));
+	}
+
+	Commands.BindVertexArray(0);
+}
+
+void FGFXHelper::RenderImages(
+	FGFXEngineInternals& Eng,
+	FRenderCommandBuffer& Commands,
+	const FImageRenderList& ImageRenderList,
+	const Float32 FrameProgress)
+{
+	// Higher layers are farther away, so they're drawn first.
+	FRenderQueue& RenderQueue = Eng.ImageRenderQueue;
+	RenderQueue.Clear();
+
+	FSpriteBatcher& SpriteBatcher = Eng.SpriteBatcher;
+	SpriteBatcher.Clear();
+	SpriteBatcher.Reserve(ImageRenderList.size());
+
+	const GL::ProgramT Program = Eng.I2DShader->GetProgram();
+
+	for (SizeT I = 0, Size = ImageRenderList.size(); I < Size; ++I)
+	{
+		const UInt64 Key = FRenderQueue::MakeKey(
+			ERenderPass::Transparent,
+			Program,
+			SpriteBatcher.GetTexture(ImageRenderList[I].second->GetID()),
+			0,
+			ImageRenderList[I].first->GetLayer());
+
+		RenderQueue.Add(Key, static_cast<UInt32>(I));
+	}
+
+	RenderQueue.Sort();
+
+	for (const FRenderQueueItem& Item : RenderQueue.GetItems())
+	{
+		const FImageInstance& I2DInstance = *ImageRenderList[Item.Index].first;
+		const FImage& ImageResource = ImageRenderList[Item.Index].second.Get();
+
+		// Images are stored top row first, so they're flipped vertically by default.
+		FSprite Sprite;
+		Sprite.Position = I2DInstance.GetInterpolatedPosition(FrameProgress);
+		Sprite.HalfSize = I2DInstance.GetInterpolatedScale(FrameProgress) * ImageResource.GetDimensions();
+		Sprite.Color = I2DInstance.GetColor();
+		Sprite.Flip = FVector2D(I2DInstance.GetFlip().x, -I2DInstance.GetFlip().y);
+		Sprite.ViewRect = I2DInstance.GetViewRectangle();
+		Sprite.Image = ImageResource.GetID();
+		Sprite.Shader = Program;
+
+		SpriteBatcher.Add(Sprite);
+	}
+
+	if (!SpriteBatcher.GetSpriteCount())
+	{
+		return;
+	}
+
+	const FSpriteBatcher::FVertices& Vertices = SpriteBatcher.GetVertices();
+
+	Commands.BindVertexArray(Eng.SpriteVertexArray);
+	Commands.StreamBuffer(EBuffer::Array, Eng.SpriteVertexBuffer, Vertices.data(), Vertices.size() * sizeof(FSpriteVertex));
+
+	for (const FSpriteBatch& Batch : SpriteBatcher.GetBatches())
+	{
+		F_Assert(Batch.Shader == Program, "Sprites only support the Image2D shader.");
+
+		// Binds of the texture that's already bound are dropped when the commands are replayed.
+		Commands.BindTexture(ETexTarget::T2D, Batch.Texture);
+		Commands.DrawArrays(
+			EMode::Triangles,
+			static_cast<UInt32>(Batch.FirstVertex),
+			static_cast<UInt32>(Batch.VertexCount));
 	}
+
+	Commands.BindVertexArray(0);
 }
 
-void FGFXAsyncTasks::ProcessModel(FGFXEngineInternals& Eng, const FString& ModelName)
+void FGFXHelper::ReplayCommands(FGFXEngineInternals& Eng, const FRenderCommandBuffer& Commands)
 {
-	const FString ModelAssetPath = EAssetPath::Get(EAssetPath::Models) + ModelName;
+	F_GFXProfile();
+
+	FRenderStateCache& StateCache = Eng.StateCache;
+	StateCache.Invalidate();
+	StateCache.ResetStats();
+
+	FRenderStats& Stats = Eng.FrameStats;
+
+	for (const FRenderCommand& Command : Commands.GetCommands())
+	{
+		if (!StateCache.Apply(Commands, Command))
+		{
+			continue;
+		}
+
+		switch (Command.Type)
+		{
+			case ERenderCommand::BindFramebuffer:
+			{
+				F_GL(GL::BindFramebuffer(static_cast<EGBuffer::Value>(Command.Target), Command.Object));
+				break;
+			}
+			case ERenderCommand::DrawBuffers:
+			{
+				const UInt32* const Words = Commands.GetPayload(Command);
+
+				TArray<EAttachment::Value, EGBufferTex::Count> Attachments;
+				F_Assert(Command.Count <= Attachments.size(), "Too many draw buffers.");
+
+				for (UInt32 I = 0; I < Command.Count; ++I)
+				{
+					Attachments[I] = static_cast<EAttachment::Value>(Words[I]);
+				}
+
+				F_GL(GL::DrawBuffers(static_cast<GLsizei>(Command.Count), Attachments.data()));
+				break;
+			}
+			case ERenderCommand::UseProgram:
+			{
+				F_GL(GL::UseProgram(Command.Object));
+				++Stats.ShaderBinds;
+				break;
+			}
+			case ERenderCommand::ActiveTexture:
+			{
+				F_GL(GL::ActiveTexture(static_cast<ETex::Value>(Command.Target)));
+				break;
+			}
+			case ERenderCommand::BindTexture:
+			{
+				F_GL(GL::BindTexture(static_cast<ETexTarget::Value>(Command.Target), Command.Object));
+				++Stats.TextureBinds;
+				break;
+			}
+			case ERenderCommand::BindVertexArray:
+			{
+				F_GL(GL::BindVertexArray(Command.Object));
+				++Stats.VertexArrayBinds;
+				break;
+			}
+			case ERenderCommand::BindBuffer:
+			{
+				F_GL(GL::BindBuffer(static_cast<EBuffer::Value>(Command.Target), Command.Object));
+				break;
+			}
+			case ERenderCommand::StreamBuffer:
+			{
+				const FRenderStream& Stream = Commands.GetStream(Command);
+				StreamBuffer(
+					static_cast<EBuffer::Value>(Command.Target),
+					Eng.StreamBufferCapacities[Command.Object],
+					Stream.Data,
+					static_cast<GLsizeiptr>(Stream.Size));
+				break;
+			}
+			case ERenderCommand::Enable:
+			{
+				F_GL(GL::Enable(static_cast<ECapability::Value>(Command.Target)));
+				++Stats.StateChanges;
+				break;
+			}
+			case ERenderCommand::Disable:
+			{
+				F_GL(GL::Disable(static_cast<ECapability::Value>(Command.Target)));
+				++Stats.StateChanges;
+				break;
+			}
+			case ERenderCommand::BlendFunc:
+			{
+				F_GL(GL::BlendFunc(static_cast<EBlend::Value>(Command.Target), static_cast<EBlend::Value>(Command.Object)));
+				++Stats.StateChanges;
+				break;
+			}
+			case ERenderCommand::PixelStore:
+			{
+				F_GL(GL::PixelStorei(static_cast<EPixelStorage::Value>(Command.Target), static_cast<GLint>(Command.Object)));
+				break;
+			}
+			case ERenderCommand::Uniform:
+			{
+				ReplayUniform(Commands, Command);
+				break;
+			}
+			case ERenderCommand::VertexAttribute:
+			{
+				const UInt32* const Words = Commands.GetPayload(Command);
+				const GLuint Location = Command.Target;
+				const GLvoid* const Offset = reinterpret_cast<const GLvoid*>(static_cast<SizeT>(Words[2]));
+
+				F_GL(GL::EnableVertexAttribArray(Location));
+				F_GL(GL::VertexAttribPointer(
+					Location, static_cast<GLint>(Words[0]), EType::Float, EBool::False, static_cast<GLsizei>(Words[1]), Offset));
+				F_GL(GL::VertexAttribDivisor(Location, Words[3]));
+				break;
+			}
+			case ERenderCommand::ClearFramebuffer:
+			{
+				F_GL(GL::Clear(static_cast<EClearBit::Type>(Command.Target)));
+				break;
+			}
+			case ERenderCommand::DrawArrays:
+			{
+				F_GL(GL::DrawArrays(
+					static_cast<EMode::Value>(Command.Target),
+					static_cast<GLint>(Command.Object),
+					static_cast<GLsizei>(Command.Count)));
+
+				++Stats.DrawCalls;
+				break;
+			}
+			case ERenderCommand::DrawElementsInstanced:
+			{
+				F_GL(GL::DrawElementsInstanced(
+					static_cast<EMode::Value>(Command.Target),
+					static_cast<GLsizei>(Command.Count),
+					static_cast<EType::Value>(Command.Object),
+					nullptr,
+					static_cast<GLsizei>(Command.Extra)));
+
+				++Stats.DrawCalls;
+				Stats.Instances += Command.Extra;
+				break;
+			}
+			default:
+				F_Assert(false, "Invalid command " << static_cast<UInt32>(Command.Type));
+				break;
+		}
+	}
+
+	const FRenderStateCacheStats& CacheStats = StateCache.GetStats();
+	Stats.Commands = CacheStats.Commands;
+	Stats.EliminatedBinds = CacheStats.EliminatedBinds;
+	Stats.EliminatedUniforms = CacheStats.EliminatedUniforms;
+	Stats.EliminatedStateChanges = CacheStats.EliminatedStateChanges;
+}
+
+void FGFXHelper::ReplayUniform(const FRenderCommandBuffer& Commands, const FRenderCommand& Command)
+{
+	const UInt32* const Words = Commands.GetPayload(Command);
+	const GLint Location = static_cast<GLint>(Command.Object);
+
+	if (Command.Target == ERenderUniform::Int)
+	{
+		F_GL(GL::Uniform1i(Location, static_cast<GLint>(Words[0])));
+		return;
+	}
+
+	TArray<GLfloat, FRenderCommandBuffer::MaxUniformWords> Floats;
+	F_Assert(Command.Count <= Floats.size(), "Uniform has too many words.");
+	std::memcpy(Floats.data(), Words, Command.Count * sizeof(GLfloat));
+
+	switch (Command.Target)
+	{
+		case ERenderUniform::Vector2D:
+			F_GL(GL::Uniform2f(Location, Floats[0], Floats[1]));
+			break;
+		case ERenderUniform::Vector3D:
+			F_GL(GL::Uniform3f(Location, Floats[0], Floats[1], Floats[2]));
+			break;
+		case ERenderUniform::Vector4D:
+			F_GL(GL::Uniform4f(Location, Floats[0], Floats[1], Floats[2], Floats[3]));
+			break;
+		case ERenderUniform::Matrix3D:
+			F_GL(GL::UniformMatrix3fv(Location, 1, EBool::False, Floats.data()));
+			break;
+		case ERenderUniform::Matrix4D:
+			F_GL(GL::UniformMatrix4fv(Location, 1, EBool::False, Floats.data()));
+			break;
+		default:
+			F_Assert(false, "Invalid uniform type " << Command.Target);
+			break;
+	}
+}
+
+void FGFXHelper::StreamBuffer(
+	const EBuffer::Value Target,
+	GLsizeiptr& Capacity,
+	const GLvoid* const Data,
+	const GLsizeiptr Size)
+{
+	// The capacity only grows, and by at least double, so the buffer settles after a few frames.
+	if (Size > Capacity)
+	{
+		Capacity = std::max(Size, Capacity * 2);
+	}
+
+	// Respecifying the data store lets the driver hand out fresh memory instead of
+	// waiting for last frame's draws to finish reading the old one.
+	F_GL(GL::BufferData(Target, Capacity, nullptr, EUsage::StreamDraw));
+	F_GL(GL::BufferSubData(Target, 0, Size, Data));
+}
+
+void FGFXHelper::SetInstanceAttributes(FRenderCommandBuffer& Commands, const UInt32 FirstInstance)
+{
+	using namespace FGFXEngineConstants;
+
+	const UInt32 Stride = sizeof(FInstanceData);
+	const SizeT BatchOffset = FirstInstance * sizeof(FInstanceData);
+
+	// A 4x4 matrix attribute takes up one location per column.
+	for (GLuint Column = 0; Column < 4; ++Column)
+	{
+		const GLuint Location = InstanceWVPLocation + Column;
+		const SizeT Offset = BatchOffset + offsetof(FInstanceData, WorldViewProjection) + Column * sizeof(FVector4D);
+
+		Commands.VertexAttribute(Location, 4, Stride, Offset, 1);
+	}
+
+	const SizeT OriginOffset = BatchOffset + offsetof(FInstanceData, Origin);
+	Commands.VertexAttribute(InstanceOriginLocation, 3, Stride, OriginOffset, 1);
+}
+
+UInt64 FGFXHelper::PackDrawRequest(const UInt32 FrameIndex, const Float32 FrameProgress)
+{
+	static_assert(sizeof(Float32) == sizeof(UInt32), "FrameProgress is expected to fit in 32 bits.");
+
+	UInt32 FrameProgressBits = 0;
+	std::memcpy(&FrameProgressBits, &FrameProgress, sizeof(FrameProgressBits));
+
+	const UInt64 DrawRequest = (static_cast<UInt64>(FrameIndex) << 32) | FrameProgressBits;
+	return DrawRequest;
+}
+
+UInt32 FGFXHelper::GetDrawRequestFrameIndex(const UInt64 DrawRequest)
+{
+	const UInt32 FrameIndex = static_cast<UInt32>(DrawRequest >> 32);
+	return FrameIndex;
+}
+
+Float32 FGFXHelper::GetDrawRequestFrameProgress(const UInt64 DrawRequest)
+{
+	const UInt32 FrameProgressBits = static_cast<UInt32>(DrawRequest);
+
+	Float32 FrameProgress = 0.f;
+	std::memcpy(&FrameProgress, &FrameProgressBits, sizeof(FrameProgress));
+	return FrameProgress;
+}
+
+void FGFXAsyncTasks::ProcessModel(FGFXEngineInternals& Eng, const FName& ModelName)
+{
+	const FString ModelAssetPath = EAssetPath::Get(EAssetPath::Models) + ModelName.GetString();
 
 	FModelProcessor::FLoadParams LoadParams(ModelAssetPath.c_str(), EMeshAttribute::All);
 	TAssertOnCopy<FModelProcessor> ModelProcessor;
@@ -1207,6 +2077,7 @@ void FGFXAsyncTasks::ProcessModel(FGFXEngineInternals& Eng, const FString& Model
 	if (!ModelProcessor->IsValid())
 	{
 		F_GFXLogError("Failed async load: { " << ModelAssetPath << " }");
+		ReportFailure(Eng, ModelName);
 		return;
 	}
 
@@ -1240,6 +2111,7 @@ void FGFXAsyncTasks::ProcessModel(FGFXEngineInternals& Eng, const FString& Model
 				if (!ImageProcessor->IsValid())
 				{
 					F_GFXLogError("Failed async load: { " << ImageAssetPath << " }");
+					ReportFailure(Eng, ModelName);
 					return;
 				}
 
@@ -1249,38 +2121,35 @@ void FGFXAsyncTasks::ProcessModel(FGFXEngineInternals& Eng, const FString& Model
 		}
 	}
 
-	const SizeT GFXThreadTasksSize = 2 + ImageProcessors.size();
+	const SizeT GFXThreadTasksSize = 1 + ImageProcessors.size();
 
 	FGFXTaskReceiver::FTasks GFXThreadTasks;
 	GFXThreadTasks.reserve(GFXThreadTasksSize);
 
-	GFXThreadTasks.emplace_back([&Eng, ModelName]()
-	{
-		Eng.PendingAsyncTasks.erase(ModelName);
-		return true;
-	});
-
 	GFXThreadTasks.emplace_back([&Eng, ModelName, MdlProcessor = std::move(ModelProcessor)]()
 	{
 		const FModelCache& ModelCache = Eng.Caches->GetModelCache();
 		if (ModelCache.HasItem(ModelName))
 		{
 			F_LogError("{ " << ModelName << " } has already been cached.");
+			Eng.AssetRequests.OnSucceeded(ModelName);
 			return true;
 		}
 
-		THandle<FModel> Model = FGFXHelper::LoadAndCacheModelGL(
+		TThreadSafeHandle<FModel> Model = FGFXHelper::LoadAndCacheModelGL(
 			*Eng.Caches,
 			*Eng.Handles,
-			FString(ModelName),
+			ModelName,
 			*MdlProcessor);
 
 		if (!Model->IsValid())
 		{
 			F_LogError("Failed to process { " << ModelName << " }");
+			Eng.AssetRequests.OnFailed(ModelName, FHighResolutionTimer::GetTimeInSeconds());
 			return false;
 		}
 
+		Eng.AssetRequests.OnSucceeded(ModelName);
 		return true;
 	});
 
@@ -1295,10 +2164,10 @@ void FGFXAsyncTasks::ProcessModel(FGFXEngineInternals& Eng, const FString& Model
 				return true;
 			}
 
-			THandle<FImage> Image = FGFXHelper::LoadAndCacheImageGL(
+			TThreadSafeHandle<FImage> Image = FGFXHelper::LoadAndCacheImageGL(
 				Eng.Caches->GetImageCache(),
 				Eng.Handles->GetImageHandles(),
-				FString(ImgName),
+				FName(ImgName),
 				*ImgProcessor);
 
 			if (!Image->IsValid())
@@ -1314,9 +2183,9 @@ void FGFXAsyncTasks::ProcessModel(FGFXEngineInternals& Eng, const FString& Model
 	Eng.MsgReceiver->ReceiveTasks(std::move(GFXThreadTasks));
 }
 
-void FGFXAsyncTasks::ProcessImage(FGFXEngineInternals& Eng, const FString& ImageName)
+void FGFXAsyncTasks::ProcessImage(FGFXEngineInternals& Eng, const FName& ImageName)
 {
-	const FString ImageAssetPath = EAssetPath::Get(EAssetPath::Textures) + ImageName;
+	const FString ImageAssetPath = EAssetPath::Get(EAssetPath::Textures) + ImageName.GetString();
 
 	FImageProcessor::FLoadParams LoadParams(ImageAssetPath.c_str(), EPixelFormat::RGBA);
 	TAssertOnCopy<FImageProcessor> ImageProcessor;
@@ -1325,41 +2194,52 @@ void FGFXAsyncTasks::ProcessImage(FGFXEngineInternals& Eng, const FString& Image
 	if (!ImageProcessor->IsValid())
 	{
 		F_GFXLogError("Failed async load: { " << ImageAssetPath << " }");
+		ReportFailure(Eng, ImageName);
 		return;
 	}
 
-	const SizeT GFXThreadTasksSize = 2;
+	const SizeT GFXThreadTasksSize = 1;
 
 	FGFXTaskReceiver::FTasks GFXThreadTasks;
 	GFXThreadTasks.reserve(GFXThreadTasksSize);
 
-	GFXThreadTasks.emplace_back([&Eng, ImageName]()
-	{
-		Eng.PendingAsyncTasks.erase(ImageName);
-		return true;
-	});
-
 	GFXThreadTasks.emplace_back([&Eng, ImageName, ImgProcessor = std::move(ImageProcessor)]()
 	{
 		const FImageCache& ImageCache = Eng.Caches->GetImageCache();
 		if (ImageCache.HasItem(ImageName))
 		{
 			F_LogError("{ " << ImageName << " } has already been cached.");
+			Eng.AssetRequests.OnSucceeded(ImageName);
 			return true;
 		}
 
-		THandle<FImage> Image = FGFXHelper::LoadAndCacheImageGL(
+		TThreadSafeHandle<FImage> Image = FGFXHelper::LoadAndCacheImageGL(
 			Eng.Caches->GetImageCache(),
 			Eng.Handles->GetImageHandles(),
-			FString(ImageName),
+			ImageName,
 			*ImgProcessor);
 
 		if (!Image->IsValid())
 		{
 			F_LogError("Failed to process { " << ImageName << " }");
+			Eng.AssetRequests.OnFailed(ImageName, FHighResolutionTimer::GetTimeInSeconds());
 			return false;
 		}
 
+		Eng.AssetRequests.OnSucceeded(ImageName);
+		return true;
+	});
+
+	Eng.MsgReceiver->ReceiveTasks(std::move(GFXThreadTasks));
+}
+
+void FGFXAsyncTasks::ReportFailure(FGFXEngineInternals& Eng, const FName& AssetName)
+{
+	FGFXTaskReceiver::FTasks GFXThreadTasks;
+
+	GFXThreadTasks.emplace_back([&Eng, AssetName]()
+	{
+		Eng.AssetRequests.OnFailed(AssetName, FHighResolutionTimer::GetTimeInSeconds());
 		return true;
 	});
 
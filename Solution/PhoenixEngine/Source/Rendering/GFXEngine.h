@@ -5,6 +5,7 @@
 #include "Utility/Misc/Memory.h"
 #include "Rendering/Image/Image.h"
 #include "Rendering/Model/Model.h"
+#include "Rendering/Queue/RenderQueue.h"
 #include "Rendering/Text/Font.h"
 
 namespace Phoenix
@@ -38,8 +39,17 @@ namespace Phoenix
 
 		void SetUpNextRender();
 
+		void Draw(const Float32 FrameProgress);
+
 		class FGFXScene& GetScene();
 		const class FGFXScene& GetScene() const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the binds, state changes and draws of the last frame that was drawn.
+		*
+		*	@note This may be called from any thread.
+		*/
+		FRenderStats GetRenderStats() const;
 		
 	protected:
 	private:
@@ -57,9 +67,9 @@ namespace Phoenix
 		
 		THandle<FFont> ThreadLoadAndCacheFont(const FChar* const FontFileName);
 
-		THandle<FImage> ThreadLoadAndCacheImage(const FChar* const ImageFileName);
+		TThreadSafeHandle<FImage> ThreadLoadAndCacheImage(const FChar* const ImageFileName);
 
-		THandle<FModel> ThreadLoadAndCacheModel(const FChar* const ModelFileName);
+		TThreadSafeHandle<FModel> ThreadLoadAndCacheModel(const FChar* const ModelFileName);
 
 		class FGFXHandles& GetHandles();
 		const class FGFXHandles& GetHandles() const;
@@ -4,6 +4,7 @@
 #include "Utility/Containers/Vector.h"
 #include "Utility/Misc/Allocator.h"
 #include "Rendering/Camera.h"
+#include "Rendering/GFXRenderSync.h"
 #include "Rendering/Image/ImageInstance.h"
 #include "Rendering/Model/ModelInstance.h"
 
@@ -15,8 +16,18 @@ namespace Phoenix
 	public:
 		FCamera PersCam;
 		FCamera OrthoCam;
-		TVector<FImageInstance> Images;
-		TVector<FModelInstance> Models;
+		TVector<FImageInstance, TTrackedAlloc<FImageInstance, EMemoryTag::GFX>> Images;
+		TVector<FModelInstance, TTrackedAlloc<FModelInstance, EMemoryTag::GFX>> Models;
+		/*! \brief What Images was last synced to.  Only the instances that changed since then are copied. */
+		FRenderSyncTarget ImagesSync;
+		/*! \brief What Models was last synced to.  Only the instances that changed since then are copied. */
+		FRenderSyncTarget ModelsSync;
+		/*! \brief The bytes of instance data that were copied to set this state up. */
+		UInt64 HandoffBytes{ 0 };
+		/*! \brief Identifies the fixed step this state was set up on.  Only used by multithreaded rendering. */
+		UInt32 FrameIndex{ 0 };
+		/*! \brief How far the render is between the previous and current fixed steps, in [0, 1]. */
+		Float32 FrameProgress{ 0.f };
 		bool IsReadyForRender{ false };
 	};
 }
@@ -0,0 +1,171 @@
+#ifndef PHOENIX_GFX_RENDER_SYNC_H
+#define PHOENIX_GFX_RENDER_SYNC_H
+
+#include <cstring>
+#include <type_traits>
+
+#include "Utility/Containers/Vector.h"
+#include "Utility/Debug/Assert.h"
+#include "Utility/Handle/Handles.h"
+#include "Utility/Misc/Primitives.h"
+
+namespace Phoenix
+{
+	struct FRenderSyncStats
+	{
+		/*! \brief The items that were copied. */
+		UInt32 Items{ 0 };
+		/*! \brief The contiguous runs the items were copied in, one memcpy each. */
+		UInt32 Ranges{ 0 };
+		UInt64 Bytes{ 0 };
+		/*! \brief Whether every item was copied because the copy couldn't be patched. */
+		bool WasFullCopy{ false };
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief What a copy of the items was last synced to.  Kept alongside each copy. */
+	struct FRenderSyncTarget
+	{
+		/*! \brief The handoff the copy was last synced at.  0 if it never was. */
+		UInt32 Handoff{ 0 };
+		/*! \brief The revision of the items at that handoff. */
+		UInt32 Revision{ 0 };
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Keeps copies of a THandles' items up to date by only copying what changed.
+	*
+	*	@desc Collect is called once per handoff.  It records the handoff in which each
+	*		dirty item last changed and clears the item's flag.  Sync then patches a copy
+	*		by copying every run of items that changed since that copy's own last sync,
+	*		so any number of copies, such as the buffers of a TTripleBuffer, can lag
+	*		behind by a different number of handoffs.  When items were released since a
+	*		copy's last sync, the items were moved around, so the whole copy is redone.
+	*	@note T must be trivially copyable and have IsDirty and ClearDirty methods.
+	*		Newly created items must start out dirty.  TPolicy is the items' THandles policy.
+	*/
+	template <class T, class TPolicy = FHandlePolicy>
+	class TRenderSync
+	{
+	public:
+		static_assert(std::is_trivially_copyable<T>::value, "Items are copied with memcpy.");
+
+		typedef THandles<T, TPolicy> ItemsT;
+
+		TRenderSync() = default;
+
+		TRenderSync(const TRenderSync&) = delete;
+		TRenderSync& operator=(const TRenderSync&) = delete;
+
+		TRenderSync(TRenderSync&&) = default;
+		TRenderSync& operator=(TRenderSync&&) = default;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Starts a new handoff and records which items changed since the last one. */
+		void Collect(ItemsT& Items);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Brings a copy of the items up to date with the last Collect.
+		*
+		*	@param Items The items that were last collected.
+		*	@param OutItems The copy.  It's resized to match Items.
+		*	@param Target What OutItems was last synced to.  It's updated.
+		*	@return Returns what was copied.
+		*/
+		template <class TAlloc>
+		FRenderSyncStats Sync(const ItemsT& Items, TVector<T, TAlloc>& OutItems, FRenderSyncTarget& Target) const;
+
+		UInt32 GetHandoff() const;
+
+	protected:
+	private:
+		/*! \brief The handoff each item last changed in, by the item's index. */
+		TVector<UInt32> ChangedHandoffs;
+		UInt32 Handoff{ 0 };
+	};
+
+	template <class T, class TPolicy>
+	void TRenderSync<T, TPolicy>::Collect(ItemsT& Items)
+	{
+		++Handoff;
+
+		const UInt32 LocalHandoff = Handoff;
+		ChangedHandoffs.resize(Items.GetDataSize(), LocalHandoff);
+
+		Items.ForEachDense([this, LocalHandoff](const typename ItemsT::SpanT& Span)
+		{
+			T* const SpanItems = Span.data();
+			UInt32* const SpanChangedHandoffs = ChangedHandoffs.data() + Span.GetDenseIndex(0);
+
+			for (SizeT I = 0; I < Span.size(); ++I)
+			{
+				if (SpanItems[I].IsDirty())
+				{
+					SpanItems[I].ClearDirty();
+					SpanChangedHandoffs[I] = LocalHandoff;
+				}
+			}
+		});
+	}
+
+	template <class T, class TPolicy>
+	template <class TAlloc>
+	FRenderSyncStats TRenderSync<T, TPolicy>::Sync(
+		const ItemsT& Items,
+		TVector<T, TAlloc>& OutItems,
+		FRenderSyncTarget& Target) const
+	{
+		F_Assert(Handoff != 0, "Collect must be called before Sync.");
+		F_Assert(ChangedHandoffs.size() == Items.GetDataSize(), "Items changed since they were collected.");
+
+		FRenderSyncStats Stats;
+
+		const SizeT Count = Items.GetDataSize();
+		const T* const Source = Items.GetData().data();
+
+		const bool CanPatch = Target.Handoff != 0 && Target.Revision == Items.GetRevision();
+		const UInt32 SyncedHandoff = CanPatch ? Target.Handoff : 0;
+
+		// New items are always dirty, so growing never needs anything else copied.
+		OutItems.resize(Count);
+		T* const Dest = OutItems.data();
+
+		SizeT I = 0;
+		while (I < Count)
+		{
+			if (ChangedHandoffs[I] <= SyncedHandoff)
+			{
+				++I;
+				continue;
+			}
+
+			const SizeT First = I;
+			while (I < Count && ChangedHandoffs[I] > SyncedHandoff)
+			{
+				++I;
+			}
+
+			const SizeT RangeSize = I - First;
+			std::memcpy(Dest + First, Source + First, RangeSize * sizeof(T));
+
+			Stats.Items += static_cast<UInt32>(RangeSize);
+			++Stats.Ranges;
+		}
+
+		Stats.Bytes = static_cast<UInt64>(Stats.Items) * sizeof(T);
+		Stats.WasFullCopy = !CanPatch;
+
+		Target.Handoff = Handoff;
+		Target.Revision = Items.GetRevision();
+
+		return Stats;
+	}
+
+	template <class T, class TPolicy>
+	UInt32 TRenderSync<T, TPolicy>::GetHandoff() const
+	{
+		return Handoff;
+	}
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include "Stdafx.h"
 #include "Rendering/GFXScene.h"
 
+#include "Utility/Debug/Assert.h"
 #include "Rendering/GFXEngine.h"
 #include "Rendering/Caches/GFXCaches.h"
 #include "Rendering/Debug/GFXDebug.h"
@@ -13,10 +14,11 @@ FGFXScene::~FGFXScene()
 	DeInit();
 }
 
-void FGFXScene::Init()
+void FGFXScene::Init(const EGFXSceneType::Value InSceneType)
 {
 	DeInit();
 
+	SceneType = InSceneType;
 	PersCam = CreateCamera();
 	OrthoCam = CreateCamera();
 }
@@ -27,6 +29,11 @@ bool FGFXScene::IsValid() const
 	return Result;
 }
 
+EGFXSceneType::Value FGFXScene::GetSceneType() const
+{
+	return SceneType;
+}
+
 void FGFXScene::DeInit()
 {
 	OrthoCam.DeInit();
@@ -42,65 +49,70 @@ void FGFXScene::DeInit()
 #undef F_GFXSceneDebugInstances
 }
 
-void FGFXScene::SetOrthographicCamera(const THandle<FCamera>& Camera)
+void FGFXScene::SetOrthographicCamera(const TThreadSafeHandle<FCamera>& Camera)
 {
 	OrthoCam = Camera;
 }
 
-void FGFXScene::SetPerspectiveCamera(const THandle<FCamera>& Camera)
+void FGFXScene::SetPerspectiveCamera(const TThreadSafeHandle<FCamera>& Camera)
 {
 	PersCam = Camera;
 }
 
-THandle<FCamera>& FGFXScene::GetOrthographicCamera()
-{
-	return OrthoCam;
-}
-
-const THandle<FCamera>& FGFXScene::GetOrthographicCamera() const
+TThreadSafeWeakHandle<FCamera> FGFXScene::GetOrthographicCamera() const
 {
 	return OrthoCam;
 }
 
-THandle<FCamera>& FGFXScene::GetPerspectiveCamera()
-{
-	return PersCam;
-}
-
-const THandle<FCamera>& FGFXScene::GetPerspectiveCamera() const
+TThreadSafeWeakHandle<FCamera> FGFXScene::GetPerspectiveCamera() const
 {
 	return PersCam;
 }
 
-THandle<FCamera> FGFXScene::CreateCamera()
+TThreadSafeHandle<FCamera> FGFXScene::CreateCamera()
 {
-	THandle<FCamera> CameraHandle = CameraHandles.CreateHandle();
+	TThreadSafeHandle<FCamera> CameraHandle = CameraHandles.CreateHandle();
 	return CameraHandle;
 }
 
-THandle<FImageInstance> FGFXScene::CreateImage(
+TThreadSafeHandle<FImageInstance> FGFXScene::CreateImage(
 	const FString& ImageFileName,
-	const EImageInfo::Type ImageInfo)
+	const EImageInfo::Type)
 {
-	THandle<FImageInstance> IIHandle = ImageInstances.CreateHandle();
+	TThreadSafeHandle<FImageInstance> IIHandle = ImageInstances.CreateHandle();
 	IIHandle->SetImage(ImageFileName);
 	return IIHandle;
 }
 
-THandle<FModelInstance> FGFXScene::CreateModel(
+TThreadSafeHandle<FModelInstance> FGFXScene::CreateModel(
 	const FString& ModelFileName,
 	const FMaterial& Material,
-	const EModelInfo::Type ModelInfo)
+	const EModelInfo::Type)
 {
-	THandle<FModelInstance> MIHandle = ModelInstances.CreateHandle();
+	TThreadSafeHandle<FModelInstance> MIHandle = ModelInstances.CreateHandle();
 	MIHandle->SetModel(ModelFileName);
 	MIHandle->SetMaterial(Material);
 	return MIHandle;
 }
 
-THandle<FTextInstance> FGFXScene::CreateText(const FString& FontFileName)
+void FGFXScene::CreateModels(
+	const SizeT Count,
+	const FString& ModelFileName,
+	TVector<TThreadSafeHandle<FModelInstance>>& OutModels,
+	const FMaterial& Material,
+	const EModelInfo::Type)
+{
+	const FName Model(ModelFileName);
+	ModelInstances.EmplaceHandles(Count, [&Model, &Material](FModelInstance& MI, const SizeT)
+	{
+		MI.SetModel(Model);
+		MI.SetMaterial(Material);
+	}, OutModels);
+}
+
+TThreadSafeHandle<FTextInstance> FGFXScene::CreateText(const FString& FontFileName)
 {
-	THandle<FTextInstance> T2DIHandle = TextInstances.CreateHandle();
+	TThreadSafeHandle<FTextInstance> T2DIHandle = TextInstances.CreateHandle();
 	T2DIHandle->SetFont(FontFileName);
 	return T2DIHandle;
 }
@@ -119,3 +131,30 @@ const FTextInstances& FGFXScene::GetTextInstances() const
 {
 	return TextInstances;
 }
+
+void FGFXScene::StorePreviousTransforms()
+{
+	ImageInstances.ForEachDense([](const FImageInstances::SpanT& IIs)
+	{
+		for (FImageInstance& II : IIs)
+		{
+			II.StorePreviousTransform();
+		}
+	});
+
+	ModelInstances.ForEachDense([](const FModelInstances::SpanT& MIs)
+	{
+		for (FModelInstance& MI : MIs)
+		{
+			MI.StorePreviousTransform();
+		}
+	});
+}
+
+void FGFXScene::CollectRenderChanges(FImageRenderSync& ImageSync, FModelRenderSync& ModelSync)
+{
+	F_Assert(SceneType != EGFXSceneType::Null, "Null scenes are never handed to the GFX thread.");
+
+	ImageSync.Collect(ImageInstances);
+	ModelSync.Collect(ModelInstances);
+}
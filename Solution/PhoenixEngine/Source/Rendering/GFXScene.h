@@ -2,10 +2,12 @@
 #define PHOENIX_GFX_SCENE_H
 
 #include "Utility/Containers/Array.h"
+#include "Utility/Containers/Vector.h"
 #include "Utility/Handle/Handles.h"
 #include "Utility/Misc/Memory.h"
 #include "Utility/Misc/Primitives.h"
 #include "Rendering/Camera.h"
+#include "Rendering/GFXRenderSync.h"
 #include "Rendering/GFXTypes.h"
 #include "Rendering/Handles/CameraHandles.h"
 #include "Rendering/Image/ImageInstance.h"
@@ -34,9 +36,27 @@ namespace Phoenix
 		};
 	}
 
-	typedef THandles<FImageInstance> FImageInstances;
-	typedef THandles<FModelInstance> FModelInstances;
-	typedef THandles<FTextInstance> FTextInstances;
+	namespace EGFXSceneType
+	{
+		typedef UInt8 Type;
+
+		enum Value : Type
+		{
+			/*! \brief Every instance that's created is stored and rendered. */
+			Default,
+			/*! \brief Every instance that's created is stored and updated, but nothing renders them. */
+			Null
+		};
+	}
+
+	// The scene belongs to the GFX engine, but game systems create, hold and release its
+	// instances from the game thread.
+	typedef TThreadSafeHandles<FImageInstance> FImageInstances;
+	typedef TThreadSafeHandles<FModelInstance> FModelInstances;
+	typedef TThreadSafeHandles<FTextInstance> FTextInstances;
+
+	typedef TRenderSync<FImageInstance, FThreadSafeHandlePolicy> FImageRenderSync;
+	typedef TRenderSync<FModelInstance, FThreadSafeHandlePolicy> FModelRenderSync;
 
 	class FGFXScene
 	{
@@ -80,9 +100,11 @@ namespace Phoenix
 		//	--------------------------------------------------------------------------------
 		/*! \brief Initializes FGFXScene. 
 		*
+		*	@param SceneType Use EGFXSceneType::Null when nothing will be rendered, such as
+		*		in headless mode.  Instances cost the same to create and update either way.
 		*	@note This is for engine use only.
 		*/
-		void Init();
+		void Init(const EGFXSceneType::Value SceneType = EGFXSceneType::Default);
 
 		//	--------------------------------------------------------------------------------
 		/*! \brief Determines if this class is in a usable state.
@@ -91,6 +113,8 @@ namespace Phoenix
 		*/
 		bool IsValid() const;
 
+		EGFXSceneType::Value GetSceneType() const;
+
 		//	--------------------------------------------------------------------------------
 		/*! \brief Deinitializes FGFXScene.
 		*
@@ -100,43 +124,27 @@ namespace Phoenix
 
 		//	--------------------------------------------------------------------------------
 		/*! \brief Sets the scene's 2D camera. */
-		void SetOrthographicCamera(const THandle<FCamera>& Camera);
+		void SetOrthographicCamera(const TThreadSafeHandle<FCamera>& Camera);
 
 		//	--------------------------------------------------------------------------------
 		/*! \brief Sets the scene's 3D camera. */
-		void SetPerspectiveCamera(const THandle<FCamera>& Camera);
+		void SetPerspectiveCamera(const TThreadSafeHandle<FCamera>& Camera);
 
 		//	--------------------------------------------------------------------------------
 		/*! \brief Gets the scene's 2D camera.
 		*
-		*	@return Returns a handle to a FCamera.
-		*	@note This handle is not guaranteed to be valid.
+		*	@return Returns a weak handle to a FCamera.  The scene keeps its cameras alive,
+		*		so Lock it only while the camera is being used.
 		*/
-		THandle<FCamera>& GetOrthographicCamera();
-
-		//	--------------------------------------------------------------------------------
-		/*! \brief Gets the scene's 2D camera.
-		*
-		*	@return Returns a handle to a FCamera.
-		*	@note This handle is not guaranteed to be valid.
-		*/
-		const THandle<FCamera>& GetOrthographicCamera() const;
+		TThreadSafeWeakHandle<FCamera> GetOrthographicCamera() const;
 
 		//	--------------------------------------------------------------------------------
 		/*! \brief Gets the scene's 3D camera.
 		*
-		*	@return Returns a handle to a FCamera.
-		*	@note This handle is not guaranteed to be valid.
+		*	@return Returns a weak handle to a FCamera.  The scene keeps its cameras alive,
+		*		so Lock it only while the camera is being used.
 		*/
-		THandle<FCamera>& GetPerspectiveCamera();
-
-		//	--------------------------------------------------------------------------------
-		/*! \brief Gets the scene's 3D camera.
-		*
-		*	@return Returns a handle to a FCamera.
-		*	@note This handle is not guaranteed to be valid.
-		*/
-		const THandle<FCamera>& GetPerspectiveCamera() const;
+		TThreadSafeWeakHandle<FCamera> GetPerspectiveCamera() const;
 
 		//	--------------------------------------------------------------------------------
 		/*! \brief Creates a Camera.
@@ -144,7 +152,7 @@ namespace Phoenix
 		*	@return Returns a valid handle to a FCamera.
 		*	@note This handle will always be valid.
 		*/
-		THandle<FCamera> CreateCamera();
+		TThreadSafeHandle<FCamera> CreateCamera();
 
 		//	--------------------------------------------------------------------------------
 		/*! \brief Creates a Image.
@@ -153,7 +161,7 @@ namespace Phoenix
 		*	@example "golemdiffuse.jpg"
 		*	@return Returns a handle to a FImageInstance.  This handle will always be valid.
 		*/
-		THandle<FImageInstance> CreateImage(
+		TThreadSafeHandle<FImageInstance> CreateImage(
 			const FString& ImageFileName,
 			const EImageInfo::Type ImageInfo = EImageInfo::Default);
 
@@ -164,12 +172,28 @@ namespace Phoenix
 		*	@example "golem.pmesh"
 		*	@return Returns a handle to a FModelInstance.  This handle will always be valid.
 		*/
-		THandle<FModelInstance> CreateModel(
+		TThreadSafeHandle<FModelInstance> CreateModel(
 			const FString& ModelFileName,
 			const FMaterial& Material = FMaterial::CreateDefault(),
 			const EModelInfo::Type ModelInfo = EModelInfo::Default);
 
-		THandle<FTextInstance> CreateText(const FString& FontFileName);
+		//	--------------------------------------------------------------------------------
+		/*! \brief Creates Count Models that share a model and material.
+		*
+		*	@param Count The number of models to create.
+		*	@param ModelFileName A string containing the name and extension of the model.
+		*	@param OutModels The handles to the new FModelInstances are appended here.
+		*	@note The instances are created in place with room for all of them reserved
+		*		up front, which is much cheaper than calling CreateModel Count times.
+		*/
+		void CreateModels(
+			const SizeT Count,
+			const FString& ModelFileName,
+			TVector<TThreadSafeHandle<FModelInstance>>& OutModels,
+			const FMaterial& Material = FMaterial::CreateDefault(),
+			const EModelInfo::Type ModelInfo = EModelInfo::Default);
+
+		TThreadSafeHandle<FTextInstance> CreateText(const FString& FontFileName);
 
 		//	--------------------------------------------------------------------------------
 		/*! \brief Gets all of the FImageInstances in the scene.
@@ -192,15 +216,33 @@ namespace Phoenix
 		*/
 		const FTextInstances& GetTextInstances() const;
 
+		//	--------------------------------------------------------------------------------
+		/*! \brief Records the current transform of every instance as the one the next
+		*		fixed step starts from, so that renders can interpolate between steps.
+		*
+		*	@note This is for engine use only.
+		*/
+		void StorePreviousTransforms();
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Starts a handoff to the GFX thread by recording which image and model
+		*		instances changed since the last one.
+		*
+		*	@note This is for engine use only.
+		*/
+		void CollectRenderChanges(FImageRenderSync& ImageSync, FModelRenderSync& ModelSync);
+
 	private:
-		THandle<FCamera> PersCam;
-		THandle<FCamera> OrthoCam;
+		TThreadSafeHandle<FCamera> PersCam;
+		TThreadSafeHandle<FCamera> OrthoCam;
 
 		FImageInstances ImageInstances;
 		FModelInstances ModelInstances;
 		FTextInstances TextInstances;
 
 		FCameraHandles CameraHandles;
+
+		EGFXSceneType::Value SceneType{ EGFXSceneType::Default };
 	};
 }
 
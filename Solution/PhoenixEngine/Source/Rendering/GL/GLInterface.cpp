@@ -1,6 +1,8 @@
 #include "Stdafx.h"
 #include "Rendering/GL/GLInterface.h"
 
+#if !PHOENIX_GFX_USE_RECORDING_GL
+
 #include "Utility/Debug/Assert.h"
 
 namespace Phoenix
@@ -161,6 +163,16 @@ namespace Phoenix
 			glDrawElements(Mode, Count, Type, Indices);
 		}
 
+		void DrawElementsInstanced(
+			const EMode::Value Mode,
+			const GLsizei Count,
+			const EType::Value Type,
+			const GLvoid* const Indices,
+			const GLsizei PrimCount)
+		{
+			glDrawElementsInstanced(Mode, Count, Type, Indices, PrimCount);
+		}
+
 		void Enable(const ECapability::Value Cap)
 		{
 			glEnable(Cap);
@@ -215,6 +227,12 @@ namespace Phoenix
 			glGenVertexArrays(N, Arrays);
 		}
 
+		EError::Type GetError()
+		{
+			const EError::Type Error = glGetError();
+			return Error;
+		}
+
 		void GetProgramiv(const GLuint Program, const EGetProgram::Value PName, GLint& Params)
 		{
 			glGetProgramiv(Program, PName, &Params);
@@ -533,3 +551,5 @@ namespace Phoenix
 		}
 	}
 }
+
+#endif
@@ -106,6 +106,14 @@ namespace Phoenix
 			const EType::Value Type,
 			const GLvoid* const Indices);
 
+		/* Ref: https://www.opengl.org/sdk/docs/man/docbook4/xhtml/glDrawElementsInstanced.xml */
+		void DrawElementsInstanced(
+			const EMode::Value Mode,
+			const GLsizei Count,
+			const EType::Value Type,
+			const GLvoid* const Indices,
+			const GLsizei PrimCount);
+
 		/* Ref: https://www.opengl.org/sdk/docs/man/docbook4/xhtml/glEnable.xml */
 		void Enable(const ECapability::Value Cap);
 
@@ -142,6 +150,9 @@ namespace Phoenix
 		/* Ref: https://www.opengl.org/sdk/docs/man/docbook4/xhtml/glGenVertexArrays.xml */
 		void GenVertexArrays(const GLsizei N, GLuint* const Arrays);
 
+		/* Ref: https://www.opengl.org/sdk/docs/man/docbook4/xhtml/glGetError.xml */
+		EError::Type GetError();
+
 		/* Ref: https://www.opengl.org/sdk/docs/man/docbook4/xhtml/glGetProgram.xml */
 		void GetProgramiv(const GLuint Program, const EGetProgram::Value PName, GLint& Params);
 
@@ -383,7 +394,7 @@ namespace Phoenix
 #	define F_GLDisplayErrors()															\
 		for (UInt32 I_ = 0; I_ < PHOENIX_GFX_DEBUG_GL_MAX_ERROR_MSGS_PER_CALL; ++I_)	\
 		{																				\
-			const GL::EError::Type GLError_ = glGetError();								\
+			const GL::EError::Type GLError_ = GL::GetError();							\
 																						\
 			if (GLError_ == GL::EError::None)											\
 			{																			\
@@ -401,7 +412,7 @@ namespace Phoenix
 #	define F_GLIgnoreErrors()															\
 		for (UInt32 I_ = 0; I_ < PHOENIX_GFX_DEBUG_GL_MAX_ERROR_MSGS_PER_CALL; ++I_)	\
 		{																				\
-			const GL::EError::Type GLError_ = glGetError();								\
+			const GL::EError::Type GLError_ = GL::GetError();							\
 																						\
 			if (GLError_ == GL::EError::None)											\
 			{																			\
@@ -0,0 +1,223 @@
+#include "Stdafx.h"
+#include "Rendering/GL/GLRecorder.h"
+
+#include "Utility/Debug/Assert.h"
+#include "Rendering/GL/GLTypes.h"
+
+using namespace Phoenix;
+
+namespace FGLRecorderInternal
+{
+	UInt64 MakeBindingKey(const EGLCommand::Value Command, const UInt32 TextureUnit, const UInt32 Target)
+	{
+		// Vertex arrays and programs only have one binding point each.
+		const bool bHasTarget = Command != EGLCommand::BindVertexArray && Command != EGLCommand::UseProgram;
+		const UInt64 Unit = Command == EGLCommand::BindTexture ? TextureUnit : 0;
+
+		const UInt64 Key = (static_cast<UInt64>(Command) << 56) | (Unit << 32) | (bHasTarget ? Target : 0);
+		return Key;
+	}
+}
+
+const FChar* EGLCommand::ToString(const Value Command)
+{
+	static_assert(EGLCommand::Count == 15, "This table needs updating.");
+
+	switch (Command)
+	{
+		case EGLCommand::BindBuffer:
+			return "BindBuffer";
+		case EGLCommand::BindFramebuffer:
+			return "BindFramebuffer";
+		case EGLCommand::BindTexture:
+			return "BindTexture";
+		case EGLCommand::BindVertexArray:
+			return "BindVertexArray";
+		case EGLCommand::UseProgram:
+			return "UseProgram";
+		case EGLCommand::Uniform:
+			return "Uniform";
+		case EGLCommand::BufferUpload:
+			return "BufferUpload";
+		case EGLCommand::TextureUpload:
+			return "TextureUpload";
+		case EGLCommand::Draw:
+			return "Draw";
+		case EGLCommand::Clear:
+			return "Clear";
+		case EGLCommand::StateChange:
+			return "StateChange";
+		case EGLCommand::VertexAttribute:
+			return "VertexAttribute";
+		case EGLCommand::Create:
+			return "Create";
+		case EGLCommand::Delete:
+			return "Delete";
+		case EGLCommand::Other:
+			return "Other";
+		default:
+			F_Assert(false, "Invalid command " << static_cast<UInt32>(Command));
+			break;
+	}
+
+	return "";
+}
+
+FGLRecorder& FGLRecorder::Get()
+{
+	// Intentionally never destroyed, since GL objects may still be released at exit.
+	static FGLRecorder* const Recorder = new FGLRecorder();
+	return *Recorder;
+}
+
+void FGLRecorder::Record(const FGLCommand& Command)
+{
+	F_Assert(Command.Type < EGLCommand::Count, "Invalid command " << static_cast<UInt32>(Command.Type));
+
+	++Counts.Commands;
+
+	switch (Command.Type)
+	{
+		case EGLCommand::BindBuffer:
+		case EGLCommand::BindFramebuffer:
+		case EGLCommand::BindTexture:
+		case EGLCommand::BindVertexArray:
+		case EGLCommand::UseProgram:
+			++Counts.Binds;
+			break;
+		case EGLCommand::Uniform:
+			++Counts.UniformUploads;
+			break;
+		case EGLCommand::BufferUpload:
+			Counts.BufferUploadBytes += Command.Bytes;
+			break;
+		case EGLCommand::TextureUpload:
+			Counts.TextureUploadBytes += Command.Bytes;
+			break;
+		case EGLCommand::Draw:
+			++Counts.DrawCalls;
+			Counts.Instances += Command.InstanceCount;
+			break;
+		case EGLCommand::StateChange:
+			++Counts.StateChanges;
+			break;
+		default:
+			break;
+	}
+
+	if (bKeepCommands)
+	{
+		Commands.push_back(Command);
+	}
+}
+
+void FGLRecorder::Bind(const EGLCommand::Value Command, const UInt32 Target, const UInt32 Object)
+{
+	const UInt64 Key = FGLRecorderInternal::MakeBindingKey(Command, ActiveTextureUnit, Target);
+
+	UInt32& BoundObject = Bindings[Key];
+	if (BoundObject == Object)
+	{
+		++Counts.RedundantBinds;
+	}
+
+	BoundObject = Object;
+
+	// The element array buffer is part of a vertex array's state.
+	if (Command == EGLCommand::BindVertexArray)
+	{
+		Bindings.erase(FGLRecorderInternal::MakeBindingKey(EGLCommand::BindBuffer, 0, GL::EBuffer::ElementArray));
+	}
+
+	FGLCommand BindCommand;
+	BindCommand.Type = Command;
+	BindCommand.Target = Target;
+	BindCommand.Object = Object;
+	Record(BindCommand);
+}
+
+void FGLRecorder::SetActiveTexture(const UInt32 Unit)
+{
+	ActiveTextureUnit = Unit;
+
+	FGLCommand Command;
+	Command.Type = EGLCommand::StateChange;
+	Command.Target = Unit;
+	Record(Command);
+}
+
+UInt32 FGLRecorder::CreateObject(const UInt32 Target)
+{
+	const UInt32 Object = NextObject++;
+
+	FGLCommand Command;
+	Command.Type = EGLCommand::Create;
+	Command.Target = Target;
+	Command.Object = Object;
+	Record(Command);
+
+	return Object;
+}
+
+Int32 FGLRecorder::GetUniformLocation(const FChar* const Name)
+{
+	F_Assert(Name, "Name is null.");
+
+	const auto Result = UniformLocations.emplace(Name, static_cast<Int32>(UniformLocations.size()));
+	const Int32 Location = Result.first->second;
+	return Location;
+}
+
+void FGLRecorder::EndFrame()
+{
+	LastFrameCommands.swap(Commands);
+	Commands.clear();
+
+	LastFrameCounts = Counts;
+	Counts = FGLFrameCounts();
+
+	++FrameCount;
+}
+
+void FGLRecorder::Reset()
+{
+	Commands.clear();
+	LastFrameCommands.clear();
+	Counts = FGLFrameCounts();
+	LastFrameCounts = FGLFrameCounts();
+	Bindings.clear();
+	UniformLocations.clear();
+	ActiveTextureUnit = 0;
+	NextObject = 1;
+	FrameCount = 0;
+}
+
+void FGLRecorder::SetKeepCommands(const bool bKeep)
+{
+	bKeepCommands = bKeep;
+}
+
+const FGLRecorder::FCommands& FGLRecorder::GetCommands() const
+{
+	return Commands;
+}
+
+const FGLFrameCounts& FGLRecorder::GetFrameCounts() const
+{
+	return Counts;
+}
+
+const FGLRecorder::FCommands& FGLRecorder::GetLastFrameCommands() const
+{
+	return LastFrameCommands;
+}
+
+const FGLFrameCounts& FGLRecorder::GetLastFrameCounts() const
+{
+	return LastFrameCounts;
+}
+
+UInt32 FGLRecorder::GetFrameCount() const
+{
+	return FrameCount;
+}
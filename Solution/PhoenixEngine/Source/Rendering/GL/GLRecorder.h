@@ -0,0 +1,166 @@
+#ifndef PHOENIX_GL_RECORDER_H
+#define PHOENIX_GL_RECORDER_H
+
+#include "Utility/Containers/FlatHashMap.h"
+#include "Utility/Containers/UnorderedMap.h"
+#include "Utility/Containers/Vector.h"
+#include "Utility/Misc/Primitives.h"
+#include "Utility/Misc/String.h"
+
+namespace Phoenix
+{
+	namespace EGLCommand
+	{
+		typedef UInt8 Type;
+
+		enum Value : Type
+		{
+			BindBuffer,
+			BindFramebuffer,
+			BindTexture,
+			BindVertexArray,
+			UseProgram,
+			Uniform,
+			BufferUpload,
+			TextureUpload,
+			Draw,
+			Clear,
+			/*! \brief Capability toggles, blend functions, viewports and the like. */
+			StateChange,
+			VertexAttribute,
+			Create,
+			Delete,
+			/*! \brief Shader compilation and anything else that isn't tracked separately. */
+			Other,
+			Count
+		};
+
+		const FChar* ToString(const Value Command);
+	}
+
+	struct FGLCommand
+	{
+		EGLCommand::Value Type{ EGLCommand::Other };
+		/*! \brief The GL enum the command applies to, such as a buffer target or draw mode. */
+		UInt32 Target{ 0 };
+		/*! \brief The object that's bound, created or deleted, or the uniform location. */
+		UInt32 Object{ 0 };
+		/*! \brief The number of bytes that are uploaded. */
+		UInt64 Bytes{ 0 };
+		/*! \brief The number of vertices or indices that are drawn, or of uniform elements set. */
+		UInt32 Count{ 0 };
+		/*! \brief The number of instances that are drawn.  1 for draws that aren't instanced. */
+		UInt32 InstanceCount{ 0 };
+	};
+
+	struct FGLFrameCounts
+	{
+		UInt32 Commands{ 0 };
+		UInt32 DrawCalls{ 0 };
+		UInt32 Instances{ 0 };
+		/*! \brief Buffer, framebuffer, texture, vertex array and program binds. */
+		UInt32 Binds{ 0 };
+		/*! \brief Binds of an object that was already bound to the same target. */
+		UInt32 RedundantBinds{ 0 };
+		UInt32 UniformUploads{ 0 };
+		UInt32 StateChanges{ 0 };
+		UInt64 BufferUploadBytes{ 0 };
+		UInt64 TextureUploadBytes{ 0 };
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Stands in for a GPU when PHOENIX_GFX_USE_RECORDING_GL is enabled.
+	*
+	*	@desc Every GL call is recorded as a typed command and counted, objects get
+	*		fake IDs, and queries answer as if everything succeeded.  This lets the
+	*		graphics engine run on machines without a GPU, and lets tests check the
+	*		draws, binds and uploads that a frame produces.
+	*	@note Like a GL context, this is only meant to be used by one thread at a time.
+	*/
+	class FGLRecorder
+	{
+	public:
+		typedef TVector<FGLCommand> FCommands;
+
+		FGLRecorder() = default;
+
+		FGLRecorder(const FGLRecorder&) = delete;
+		FGLRecorder& operator=(const FGLRecorder&) = delete;
+
+		FGLRecorder(FGLRecorder&&) = default;
+		FGLRecorder& operator=(FGLRecorder&&) = default;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the recorder that the recording GL backend sends its calls to. */
+		static FGLRecorder& Get();
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Records a command that isn't a bind.  See Bind for those. */
+		void Record(const FGLCommand& Command);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Records a bind and checks it against what's already bound.
+		*
+		*	@param Command - One of the bind commands.
+		*	@param Target - The target the object is bound to.  Ignored by vertex array
+		*		and program binds, since they only have one.
+		*	@param Object - The object to bind.
+		*/
+		void Bind(const EGLCommand::Value Command, const UInt32 Target, const UInt32 Object);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Sets the texture unit that later texture binds apply to. */
+		void SetActiveTexture(const UInt32 Unit);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Creates a fake object ID.  IDs are never 0 and never reused. */
+		UInt32 CreateObject(const UInt32 Target);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets a fake uniform location that's the same for every use of a name. */
+		Int32 GetUniformLocation(const FChar* const Name);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Moves the current frame's commands and counts to the last frame's. */
+		void EndFrame();
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Forgets every command, count, bind and uniform location, and restarts the IDs. */
+		void Reset();
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Determines whether commands are kept, or only counted.  Kept by default. */
+		void SetKeepCommands(const bool bKeep);
+
+		const FCommands& GetCommands() const;
+
+		const FGLFrameCounts& GetFrameCounts() const;
+
+		const FCommands& GetLastFrameCommands() const;
+
+		const FGLFrameCounts& GetLastFrameCounts() const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the number of frames that have been ended. */
+		UInt32 GetFrameCount() const;
+
+	protected:
+	private:
+		typedef TFlatHashMap<UInt64, UInt32> FBindings;
+		typedef TUnorderedMap<FString, Int32> FUniformLocations;
+
+		FCommands Commands;
+		FCommands LastFrameCommands;
+		FGLFrameCounts Counts;
+		FGLFrameCounts LastFrameCounts;
+		/*! \brief The object bound to each target, keyed by command, texture unit and target. */
+		FBindings Bindings;
+		FUniformLocations UniformLocations;
+		UInt32 ActiveTextureUnit{ 0 };
+		UInt32 NextObject{ 1 };
+		UInt32 FrameCount{ 0 };
+		bool bKeepCommands{ true };
+	};
+}
+
+#endif
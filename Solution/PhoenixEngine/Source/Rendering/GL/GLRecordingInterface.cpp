@@ -0,0 +1,689 @@
+#include "Stdafx.h"
+#include "Rendering/GL/GLInterface.h"
+
+#if PHOENIX_GFX_USE_RECORDING_GL
+
+#include <cstring>
+
+#include "Utility/Debug/Assert.h"
+#include "Rendering/GL/GLRecorder.h"
+
+namespace FGLRecordingInterfaceInternal
+{
+	using namespace Phoenix;
+
+	void Record(
+		const EGLCommand::Value Type,
+		const UInt32 Target = 0,
+		const UInt32 Object = 0,
+		const UInt64 Bytes = 0,
+		const UInt32 Count = 0,
+		const UInt32 InstanceCount = 0)
+	{
+		FGLCommand Command;
+		Command.Type = Type;
+		Command.Target = Target;
+		Command.Object = Object;
+		Command.Bytes = Bytes;
+		Command.Count = Count;
+		Command.InstanceCount = InstanceCount;
+
+		FGLRecorder::Get().Record(Command);
+	}
+
+	void CreateObjects(const UInt32 Target, const GLsizei N, GLuint* const Objects)
+	{
+		F_Assert(N >= 0, "Invalid object count " << N);
+		F_Assert(Objects || !N, "Objects is null.");
+
+		for (GLsizei I = 0; I < N; ++I)
+		{
+			Objects[I] = FGLRecorder::Get().CreateObject(Target);
+		}
+	}
+
+	void DeleteObjects(const UInt32 Target, const GLsizei N, const GLuint* const Objects)
+	{
+		F_Assert(N >= 0, "Invalid object count " << N);
+		F_Assert(Objects || !N, "Objects is null.");
+
+		for (GLsizei I = 0; I < N; ++I)
+		{
+			Record(EGLCommand::Delete, Target, Objects[I]);
+		}
+	}
+
+	UInt64 GetTypeSize(const GL::EType::Value Type)
+	{
+		switch (Type)
+		{
+			case GL::EType::Byte:
+			case GL::EType::UByte:
+				return 1;
+			case GL::EType::Short:
+			case GL::EType::UShort:
+			case GL::EType::HalfFloat:
+				return 2;
+			case GL::EType::Double:
+			case GL::EType::Float32_UInt24_8_Rev:
+				return 8;
+			default:
+				return 4;
+		}
+	}
+
+	UInt64 GetComponentCount(const GL::ETexFormat::Value Format)
+	{
+		switch (Format)
+		{
+			case GL::ETexFormat::RG:
+			case GL::ETexFormat::RGInteger:
+				return 2;
+			case GL::ETexFormat::RGB:
+			case GL::ETexFormat::BGR:
+			case GL::ETexFormat::RGBInteger:
+			case GL::ETexFormat::BGRInteger:
+				return 3;
+			case GL::ETexFormat::RGBA:
+			case GL::ETexFormat::BGRA:
+			case GL::ETexFormat::RGBAInteger:
+			case GL::ETexFormat::BGRAInteger:
+				return 4;
+			default:
+				return 1;
+		}
+	}
+
+	// Packed types already hold every component of a pixel.
+	bool IsPackedType(const GL::EType::Value Type)
+	{
+		switch (Type)
+		{
+			case GL::EType::UShort5_6_5:
+			case GL::EType::UShort4_4_4_4:
+			case GL::EType::UShort5_5_5_1:
+			case GL::EType::Int2_10_10_10_Rev:
+			case GL::EType::UInt24_8:
+			case GL::EType::UInt2_10_10_10_Rev:
+			case GL::EType::UInt5_9_9_9_Rev:
+			case GL::EType::UInt10F_11F_11F_Rev:
+			case GL::EType::Float32_UInt24_8_Rev:
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	void RecordUniform(const GLint Location, const GLsizei Count, const UInt64 ElementSize)
+	{
+		const UInt32 UniformCount = static_cast<UInt32>(Count);
+		Record(EGLCommand::Uniform, 0, static_cast<UInt32>(Location), ElementSize * UniformCount, UniformCount);
+	}
+}
+
+namespace Phoenix
+{
+	namespace GL
+	{
+		using namespace FGLRecordingInterfaceInternal;
+
+		void ActiveTexture(const ETex::Value Texture)
+		{
+			FGLRecorder::Get().SetActiveTexture(Texture);
+		}
+
+		void AttachShader(const GLuint Program, const GLuint)
+		{
+			Record(EGLCommand::Other, 0, Program);
+		}
+
+		void BindBuffer(const EBuffer::Value Target, const GLuint Buffer)
+		{
+			FGLRecorder::Get().Bind(EGLCommand::BindBuffer, Target, Buffer);
+		}
+
+		void BindFramebuffer(const EGBuffer::Value Target, const GLuint Framebuffer)
+		{
+			FGLRecorder::Get().Bind(EGLCommand::BindFramebuffer, Target, Framebuffer);
+		}
+
+		void BindTexture(const ETexTarget::Value Target, const GLuint Texture)
+		{
+			FGLRecorder::Get().Bind(EGLCommand::BindTexture, Target, Texture);
+		}
+
+		void BindVertexArray(const GLuint Array)
+		{
+			FGLRecorder::Get().Bind(EGLCommand::BindVertexArray, 0, Array);
+		}
+
+		void BlendFunc(const EBlend::Value SFactor, const EBlend::Value DFactor)
+		{
+			Record(EGLCommand::StateChange, SFactor, DFactor);
+		}
+
+		void BufferData(
+			const EBuffer::Value Target,
+			const GLsizeiptr Size,
+			const GLvoid* Data,
+			const EUsage::Value)
+		{
+			// Respecifying the data store without data only allocates.
+			const UInt64 Bytes = Data ? static_cast<UInt64>(Size) : 0;
+			Record(EGLCommand::BufferUpload, Target, 0, Bytes);
+		}
+
+		void BufferSubData(
+			const EBuffer::Value Target,
+			const GLintptr,
+			const GLsizeiptr Size,
+			const GLvoid* const)
+		{
+			Record(EGLCommand::BufferUpload, Target, 0, static_cast<UInt64>(Size));
+		}
+
+		EGBufferStatus::Value CheckFramebufferStatus(const EGBuffer::Value Target)
+		{
+			Record(EGLCommand::Other, Target);
+			return EGBufferStatus::Complete;
+		}
+
+		void Clear(const EClearBit::Type ClearMask)
+		{
+			Record(EGLCommand::Clear, ClearMask);
+		}
+
+		void ClearColor(const GLclampf, const GLclampf, const GLclampf, const GLclampf)
+		{
+			Record(EGLCommand::StateChange);
+		}
+
+		void CompileShader(const GLuint Shader)
+		{
+			Record(EGLCommand::Other, 0, Shader);
+		}
+
+		GLuint CreateProgram()
+		{
+			const GLuint Program = FGLRecorder::Get().CreateObject(GL_PROGRAM);
+			return Program;
+		}
+
+		GLuint CreateShader(const EShader::Value ShaderType)
+		{
+			const GLuint Shader = FGLRecorder::Get().CreateObject(ShaderType);
+			return Shader;
+		}
+
+		void DeleteBuffers(const GLsizei N, const GLuint* const Buffers)
+		{
+			DeleteObjects(GL_BUFFER, N, Buffers);
+		}
+
+		void DeleteFramebuffers(const GLsizei N, const GLuint* const Framebuffers)
+		{
+			DeleteObjects(GL_FRAMEBUFFER, N, Framebuffers);
+		}
+
+		void DeleteProgram(const GLuint Program)
+		{
+			DeleteObjects(GL_PROGRAM, 1, &Program);
+		}
+
+		void DeleteShader(const GLuint Shader)
+		{
+			DeleteObjects(GL_SHADER, 1, &Shader);
+		}
+
+		void DeleteTextures(const GLsizei N, const GLuint* const Textures)
+		{
+			DeleteObjects(GL_TEXTURE, N, Textures);
+		}
+
+		void DeleteVertexArrays(const GLsizei N, const GLuint* const Arrays)
+		{
+			DeleteObjects(GL_VERTEX_ARRAY, N, Arrays);
+		}
+
+		void Disable(const ECapability::Value Cap)
+		{
+			Record(EGLCommand::StateChange, Cap);
+		}
+
+		void DrawArrays(
+			const EMode::Value Mode,
+			const GLint,
+			const GLsizei Count)
+		{
+			Record(EGLCommand::Draw, Mode, 0, 0, static_cast<UInt32>(Count), 1);
+		}
+
+		void DrawArraysInstanced(
+			const EMode::Value Mode,
+			const GLint,
+			const GLsizei Count,
+			const GLsizei PrimCount)
+		{
+			Record(EGLCommand::Draw, Mode, 0, 0, static_cast<UInt32>(Count), static_cast<UInt32>(PrimCount));
+		}
+
+		void DrawBuffers(const GLsizei N, const EAttachment::Value* const)
+		{
+			Record(EGLCommand::StateChange, 0, 0, 0, static_cast<UInt32>(N));
+		}
+
+		void DrawElements(
+			const EMode::Value Mode,
+			const GLsizei Count,
+			const EType::Value,
+			const GLvoid* const)
+		{
+			Record(EGLCommand::Draw, Mode, 0, 0, static_cast<UInt32>(Count), 1);
+		}
+
+		void DrawElementsInstanced(
+			const EMode::Value Mode,
+			const GLsizei Count,
+			const EType::Value,
+			const GLvoid* const,
+			const GLsizei PrimCount)
+		{
+			Record(EGLCommand::Draw, Mode, 0, 0, static_cast<UInt32>(Count), static_cast<UInt32>(PrimCount));
+		}
+
+		void Enable(const ECapability::Value Cap)
+		{
+			Record(EGLCommand::StateChange, Cap);
+		}
+
+		void EnableVertexAttribArray(const GLuint Index)
+		{
+			Record(EGLCommand::VertexAttribute, 0, Index);
+		}
+
+		void FramebufferTexture2D(
+			const EGBuffer::Value,
+			const EAttachment::Value Attachment,
+			const ETexTarget::Value,
+			const GLuint Texture,
+			const GLint)
+		{
+			Record(EGLCommand::Other, Attachment, Texture);
+		}
+
+		void GenerateMipmap(const ETexTarget::Value Target)
+		{
+			Record(EGLCommand::Other, Target);
+		}
+
+		void GenFramebuffers(const GLsizei N, GLuint* const Textures)
+		{
+			CreateObjects(GL_FRAMEBUFFER, N, Textures);
+		}
+
+		void GenTextures(const GLsizei N, GLuint* const Textures)
+		{
+			CreateObjects(GL_TEXTURE, N, Textures);
+		}
+
+		void GetProgramInfoLog(
+			const GLuint,
+			const GLsizei MaxLength,
+			GLsizei* const Length,
+			GLchar* const InfoLog)
+		{
+			if (Length)
+			{
+				*Length = 0;
+			}
+
+			if (InfoLog && MaxLength > 0)
+			{
+				InfoLog[0] = '\0';
+			}
+		}
+
+		void GenBuffers(const GLsizei BufferCount, GLuint* const Buffers)
+		{
+			CreateObjects(GL_BUFFER, BufferCount, Buffers);
+		}
+
+		void GenVertexArrays(const GLsizei N, GLuint* const Arrays)
+		{
+			CreateObjects(GL_VERTEX_ARRAY, N, Arrays);
+		}
+
+		EError::Type GetError()
+		{
+			return EError::None;
+		}
+
+		void GetProgramiv(const GLuint, const EGetProgram::Value PName, GLint& Params)
+		{
+			// Every program links and validates, and has no info log.
+			const bool bIsStatus = PName == EGetProgram::LinkStatus || PName == EGetProgram::ValidateStatus;
+			Params = bIsStatus ? GL_TRUE : 0;
+		}
+
+		void GetShaderInfoLog(
+			const GLuint,
+			GLchar* const InfoLog,
+			const GLsizei MaxLength,
+			GLsizei& WrittenLength)
+		{
+			F_Assert(InfoLog, "InfoLog must not be null.");
+			F_Assert(WrittenLength == 0, "This value must be initialized 0 by default.");
+
+			if (MaxLength > 0)
+			{
+				InfoLog[0] = '\0';
+			}
+		}
+
+		void GetShaderiv(const GLuint, const EShaderData::Value ShaderData, GLint& OutResult)
+		{
+			F_Assert(OutResult == 0, "This value must be initialized to 0 by default.");
+
+			// Every shader compiles, and has no info log.
+			OutResult = ShaderData == EShaderData::CompileStatus ? GL_TRUE : 0;
+		}
+
+		const GLubyte* GetString(const EGLInfo::Value Name)
+		{
+			const GLubyte* const Str = reinterpret_cast<const GLubyte*>(Name == EGLInfo::Extensions ? "" : "Recording");
+			return Str;
+		}
+
+		GLint GetUniformLocation(const GLuint, const GLchar* const Name)
+		{
+			const GLint UniformLocation = FGLRecorder::Get().GetUniformLocation(Name);
+			return UniformLocation;
+		}
+
+		void LinkProgram(const GLuint Program)
+		{
+			Record(EGLCommand::Other, 0, Program);
+		}
+
+		void PixelStoref(const EPixelStorage::Value PName, const GLfloat)
+		{
+			Record(EGLCommand::StateChange, PName);
+		}
+
+		void PixelStorei(const EPixelStorage::Value PName, const GLint)
+		{
+			Record(EGLCommand::StateChange, PName);
+		}
+
+		void ShaderSource(const GLuint Shader, const GLchar* Code)
+		{
+			const UInt64 Bytes = Code ? std::strlen(Code) : 0;
+			Record(EGLCommand::Other, 0, Shader, Bytes);
+		}
+
+		void TexImage2D(
+			const ETexTarget::Value Target,
+			const GLint,
+			const ETexGLFormat::Value,
+			const GLsizei Width,
+			const GLsizei Height,
+			const ETexFormat::Value Format,
+			const EType::Value Type,
+			const GLvoid* const Data)
+		{
+			const UInt64 PixelSize = IsPackedType(Type) ? GetTypeSize(Type) : GetTypeSize(Type) * GetComponentCount(Format);
+			const UInt64 Bytes = Data ? PixelSize * static_cast<UInt64>(Width) * static_cast<UInt64>(Height) : 0;
+			Record(EGLCommand::TextureUpload, Target, 0, Bytes);
+		}
+
+		void TexParameterf(
+			const ETexTarget::Value,
+			const ETexParameter::Value PName,
+			const GLfloat)
+		{
+			Record(EGLCommand::StateChange, PName);
+		}
+
+		void TexParameteri(
+			const ETexTarget::Value,
+			const ETexParameter::Value PName,
+			const GLint)
+		{
+			Record(EGLCommand::StateChange, PName);
+		}
+
+		void Uniform1f(const GLint Location, const GLfloat)
+		{
+			RecordUniform(Location, 1, sizeof(GLfloat));
+		}
+
+		void Uniform2f(const GLint Location, const GLfloat, const GLfloat)
+		{
+			RecordUniform(Location, 1, 2 * sizeof(GLfloat));
+		}
+
+		void Uniform3f(
+			const GLint Location,
+			const GLfloat,
+			const GLfloat,
+			const GLfloat)
+		{
+			RecordUniform(Location, 1, 3 * sizeof(GLfloat));
+		}
+
+		void Uniform4f(
+			const GLint Location,
+			const GLfloat,
+			const GLfloat,
+			const GLfloat,
+			const GLfloat)
+		{
+			RecordUniform(Location, 1, 4 * sizeof(GLfloat));
+		}
+
+		void Uniform1i(const GLint Location, const GLint)
+		{
+			RecordUniform(Location, 1, sizeof(GLint));
+		}
+
+		void Uniform2i(const GLint Location, const GLint, const GLint)
+		{
+			RecordUniform(Location, 1, 2 * sizeof(GLint));
+		}
+
+		void Uniform3i(
+			const GLint Location,
+			const GLint,
+			const GLint,
+			const GLint)
+		{
+			RecordUniform(Location, 1, 3 * sizeof(GLint));
+		}
+
+		void Uniform4i(
+			const GLint Location,
+			const GLint,
+			const GLint,
+			const GLint,
+			const GLint)
+		{
+			RecordUniform(Location, 1, 4 * sizeof(GLint));
+		}
+
+		void Uniform1fv(
+			const GLint Location,
+			const GLsizei Count,
+			const GLfloat* const)
+		{
+			RecordUniform(Location, Count, sizeof(GLfloat));
+		}
+
+		void Uniform2fv(
+			const GLint Location,
+			const GLsizei Count,
+			const GLfloat* const)
+		{
+			RecordUniform(Location, Count, 2 * sizeof(GLfloat));
+		}
+
+		void Uniform3fv(
+			const GLint Location,
+			const GLsizei Count,
+			const GLfloat* const)
+		{
+			RecordUniform(Location, Count, 3 * sizeof(GLfloat));
+		}
+
+		void Uniform4fv(
+			const GLint Location,
+			const GLsizei Count,
+			const GLfloat* const)
+		{
+			RecordUniform(Location, Count, 4 * sizeof(GLfloat));
+		}
+
+		void Uniform1iv(
+			const GLint Location,
+			const GLsizei Count,
+			const GLint* const)
+		{
+			RecordUniform(Location, Count, sizeof(GLint));
+		}
+
+		void Uniform2iv(
+			const GLint Location,
+			const GLsizei Count,
+			const GLint* const)
+		{
+			RecordUniform(Location, Count, 2 * sizeof(GLint));
+		}
+
+		void Uniform3iv(
+			const GLint Location,
+			const GLsizei Count,
+			const GLint* const)
+		{
+			RecordUniform(Location, Count, 3 * sizeof(GLint));
+		}
+
+		void Uniform4iv(
+			const GLint Location,
+			const GLsizei Count,
+			const GLint* const)
+		{
+			RecordUniform(Location, Count, 4 * sizeof(GLint));
+		}
+
+		void Uniform1uiv(
+			const GLint Location,
+			const GLsizei Count,
+			const GLuint* const)
+		{
+			RecordUniform(Location, Count, sizeof(GLuint));
+		}
+
+		void Uniform2uiv(
+			const GLint Location,
+			const GLsizei Count,
+			const GLuint* const)
+		{
+			RecordUniform(Location, Count, 2 * sizeof(GLuint));
+		}
+
+		void Uniform3uiv(
+			const GLint Location,
+			const GLsizei Count,
+			const GLuint* const)
+		{
+			RecordUniform(Location, Count, 3 * sizeof(GLuint));
+		}
+
+		void Uniform4uiv(
+			const GLint Location,
+			const GLsizei Count,
+			const GLuint* const)
+		{
+			RecordUniform(Location, Count, 4 * sizeof(GLuint));
+		}
+
+		void UniformMatrix2fv(
+			const GLint Location,
+			const GLsizei Count,
+			const EBool::Value,
+			const GLfloat* const)
+		{
+			RecordUniform(Location, Count, 4 * sizeof(GLfloat));
+		}
+
+		void UniformMatrix3fv(
+			const GLint Location,
+			const GLsizei Count,
+			const EBool::Value,
+			const GLfloat* const)
+		{
+			RecordUniform(Location, Count, 9 * sizeof(GLfloat));
+		}
+
+		void UniformMatrix4fv(
+			const GLint Location,
+			const GLsizei Count,
+			const EBool::Value,
+			const GLfloat* const)
+		{
+			RecordUniform(Location, Count, 16 * sizeof(GLfloat));
+		}
+
+		void UseProgram(const GLuint Program)
+		{
+			FGLRecorder::Get().Bind(EGLCommand::UseProgram, 0, Program);
+		}
+
+		void ValidateProgram(const GLuint Program)
+		{
+			Record(EGLCommand::Other, 0, Program);
+		}
+
+		void VertexAttribDivisor(const GLuint Index, const GLuint)
+		{
+			Record(EGLCommand::VertexAttribute, 0, Index);
+		}
+
+		void VertexAttribPointer(
+			const GLuint Index,
+			const GLint,
+			const EType::Value Type,
+			const EBool::Value,
+			const GLsizei,
+			const GLvoid* const)
+		{
+			Record(EGLCommand::VertexAttribute, Type, Index);
+		}
+
+		void VertexAttribIPointer(
+			const GLuint Index,
+			const GLint,
+			const EType::Value Type,
+			const GLsizei,
+			const GLvoid* const)
+		{
+			Record(EGLCommand::VertexAttribute, Type, Index);
+		}
+
+		void VertexAttribLPointer(
+			const GLuint Index,
+			const GLint,
+			const EType::Value Type,
+			const GLsizei,
+			const GLvoid* const)
+		{
+			Record(EGLCommand::VertexAttribute, Type, Index);
+		}
+
+		void Viewport(const GLint, const GLint, const GLsizei, const GLsizei)
+		{
+			Record(EGLCommand::StateChange);
+		}
+	}
+}
+
+#endif
@@ -6,7 +6,7 @@
 
 namespace Phoenix
 {
-	class FCameraHandles : public THandles<FCamera> {};
+	class FCameraHandles : public TThreadSafeHandles<FCamera> {};
 }
 
 #endif
@@ -6,7 +6,7 @@
 
 namespace Phoenix
 {
-	class FImageHandles : public THandles<FImage> {};
+	class FImageHandles : public TThreadSafeHandles<FImage> {};
 }
 
 #endif
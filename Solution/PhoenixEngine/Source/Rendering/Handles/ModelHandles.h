@@ -6,7 +6,7 @@
 
 namespace Phoenix
 {
-	class FModelHandles : public THandles<FModel> {};
+	class FModelHandles : public TThreadSafeHandles<FModel> {};
 }
 
 #endif
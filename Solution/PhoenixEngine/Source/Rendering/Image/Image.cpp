@@ -105,6 +105,7 @@ void FImage::Init(const FInitParams& InitParams)
 
 	Width = ImageData.Width;
 	Height = ImageData.Height;
+	PixelFormat = ImageData.PixelFormat;
 
 	F_Assert(IsValid(), "Initialization succeeded but this class is invalid.");
 }
@@ -155,6 +156,17 @@ EPixelFormat::Value FImage::GetPixelFormat()
 	return PixelFormat;
 }
 
+SizeT FImage::GetMemorySize() const
+{
+	// EPixelFormat values match their channel counts, and every channel is a byte.
+	const SizeT ChannelCount = static_cast<SizeT>(PixelFormat);
+	const SizeT BaseSize = static_cast<SizeT>(Width) * Height * ChannelCount;
+
+	// A full mipmap chain adds a third on top of the base level.
+	const SizeT MemorySize = BaseSize + BaseSize / 3;
+	return MemorySize;
+}
+
 void FImage::PostMoveReset()
 {
 	ID = 0;
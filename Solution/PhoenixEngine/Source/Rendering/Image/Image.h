@@ -48,6 +48,10 @@ namespace Phoenix
 
 		EPixelFormat::Value GetPixelFormat();
 
+		//	--------------------------------------------------------------------------------
+		/*! \brief Estimates the size of the texture and its mipmaps in bytes. */
+		SizeT GetMemorySize() const;
+
 	protected:
 	private:
 		GL::ImageIDT ID{ 0 };
@@ -6,66 +6,73 @@ using namespace Phoenix;
 void FImageInstance::SetColor(const FVector4D& InColor)
 {
 	Color = InColor;
+	Dirty = true;
 }
 
 void FImageInstance::SetColor(const Float32 R, const Float32 G, const Float32 B, const Float32 A)
 {
 	Color = FVector4D(R, G, B, A);
+	Dirty = true;
 }
 
 void FImageInstance::SetFlip(const FVector2D& InFlip)
 {
 	Flip = InFlip;
+	Dirty = true;
 }
 
 void FImageInstance::SetFlip(const Float32 XFlip, const Float32 YFlip)
 {
 	Flip = FVector2D(XFlip, YFlip);
+	Dirty = true;
 }
 
-void FImageInstance::SetImage(const FString& InImage)
+void FImageInstance::SetImage(const FName& InImage)
 {
 	Image = InImage;
-}
-
-void FImageInstance::SetImage(FString&& InImage)
-{
-	Image = std::move(InImage);
+	Dirty = true;
 }
 
 void FImageInstance::SetLayer(const UInt32 InLayer)
 {
 	Layer = InLayer;
+	Dirty = true;
 }
 
 void FImageInstance::SetPosition(const FVector2D& InPosition)
 {
 	Position = InPosition;
+	Dirty = true;
 }
 
 void FImageInstance::SetPosition(const Float32 X, const Float32 Y)
 {
 	Position = FVector2D(X, Y);
+	Dirty = true;
 }
 
 void FImageInstance::SetScale(const FVector2D& InScale)
 {
 	Scale = InScale;
+	Dirty = true;
 }
 
 void FImageInstance::SetScale(const Float32 X, const Float32 Y)
 {
 	Scale = FVector2D(X, Y);
+	Dirty = true;
 }
 
 void FImageInstance::SetViewRect(const FVector4D& InViewRect)
 {
 	ViewRect = InViewRect;
+	Dirty = true;
 }
 
 void FImageInstance::SetViewRect(const Float32 X, const Float32 Y, const Float32 Width, const Float32 Height)
 {
 	ViewRect = FVector4D(X, Y, Width, Height);
+	Dirty = true;
 }
 
 const FVector4D& FImageInstance::GetColor() const
@@ -78,7 +85,7 @@ const FVector2D& FImageInstance::GetFlip() const
 	return Flip;
 }
 
-const FString& FImageInstance::GetImage() const
+const FName& FImageInstance::GetImage() const
 {
 	return Image;
 }
@@ -101,4 +108,29 @@ const FVector2D& FImageInstance::GetScale() const
 const FVector4D& FImageInstance::GetViewRectangle() const
 {
 	return ViewRect;
-}
\ No newline at end of file
+}
+
+void FImageInstance::StorePreviousTransform()
+{
+	// Only an image that moved during the last step renders differently after this.
+	if (!HasPreviousTransform || PreviousPosition != Position || PreviousScale != Scale)
+	{
+		Dirty = true;
+	}
+
+	PreviousPosition = Position;
+	PreviousScale = Scale;
+	HasPreviousTransform = true;
+}
+
+FVector2D FImageInstance::GetInterpolatedPosition(const Float32 FrameProgress) const
+{
+	const FVector2D Result = HasPreviousTransform ? glm::mix(PreviousPosition, Position, FrameProgress) : Position;
+	return Result;
+}
+
+FVector2D FImageInstance::GetInterpolatedScale(const Float32 FrameProgress) const
+{
+	const FVector2D Result = HasPreviousTransform ? glm::mix(PreviousScale, Scale, FrameProgress) : Scale;
+	return Result;
+}
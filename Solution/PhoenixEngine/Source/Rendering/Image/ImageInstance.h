@@ -1,8 +1,8 @@
 #ifndef PHOENIX_IMAGE_INSTANCE_H
 #define PHOENIX_IMAGE_INSTANCE_H
 
+#include "Utility/Misc/Name.h"
 #include "Utility/Misc/Primitives.h"
-#include "Utility/Misc/String.h"
 #include "Math/Vector2D.h"
 #include "Math/Vector4D.h"
 
@@ -17,8 +17,7 @@ namespace Phoenix
 		void SetFlip(const FVector2D& Flip);
 		void SetFlip(const Float32 XFlip, const Float32 YFlip);
 
-		void SetImage(const FString& Image);
-		void SetImage(FString&& Image);
+		void SetImage(const FName& Image);
 
 		void SetLayer(const UInt32 Layer);
 
@@ -33,21 +32,65 @@ namespace Phoenix
 
 		const FVector4D& GetColor() const;
 		const FVector2D& GetFlip() const;
-		const FString& GetImage() const;
+		const FName& GetImage() const;
 		UInt32 GetLayer() const;
 		const FVector2D& GetPosition() const;
 		const FVector2D& GetScale() const;
 		const FVector4D& GetViewRectangle() const;
 
+		//	--------------------------------------------------------------------------------
+		/*! \brief Records the current position and scale as the ones the next fixed step starts from.
+		*
+		*	@note This is for engine use only.
+		*/
+		void StorePreviousTransform();
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Blends the previous fixed step's position or scale toward the current one.
+		*
+		*	@param FrameProgress How far the render is into the next fixed step, in [0, 1].
+		*	@note If no previous transform has been stored yet, the current one is returned.
+		*/
+		FVector2D GetInterpolatedPosition(const Float32 FrameProgress) const;
+		FVector2D GetInterpolatedScale(const Float32 FrameProgress) const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Checks whether the image changed since it was last handed to the GFX thread.
+		*
+		*	@note This is for engine use only.  New instances start out dirty.
+		*/
+		bool IsDirty() const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Marks the image as handed to the GFX thread.
+		*
+		*	@note This is for engine use only.
+		*/
+		void ClearDirty();
+
 	private:
 		FVector4D Color{ 1.f, 1.f, 1.f, 1.f };
 		FVector2D Position{ 0.f, 0.f };
 		FVector2D Scale{ 1.f, 1.f };
 		FVector2D Flip{ 1.f, 1.f };
 		FVector4D ViewRect{ 0.f, 0.f, 1.f, 1.f };
+		FVector2D PreviousPosition{ 0.f, 0.f };
+		FVector2D PreviousScale{ 1.f, 1.f };
 		UInt32 Layer{ 0 };
-		FString Image;
+		bool HasPreviousTransform{ false };
+		bool Dirty{ true };
+		FName Image;
 	};
+
+	inline bool FImageInstance::IsDirty() const
+	{
+		return Dirty;
+	}
+
+	inline void FImageInstance::ClearDirty()
+	{
+		Dirty = false;
+	}
 }
 
 #endif
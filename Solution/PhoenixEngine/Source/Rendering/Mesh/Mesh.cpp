@@ -15,6 +15,8 @@ FMesh::FMesh(FMesh&& RHS)
 	, IndexCount(RHS.IndexCount)
 	, IndexTSize(RHS.IndexTSize)
 	, VertexCount(RHS.VertexCount)
+	, MemorySize(RHS.MemorySize)
+	, Bounds(RHS.Bounds)
 	, DiffuseImage(std::move(RHS.DiffuseImage))
 	, NormalImage(std::move(RHS.NormalImage))
 {
@@ -36,6 +38,8 @@ FMesh& FMesh::operator=(FMesh&& RHS)
 	IndexCount = RHS.IndexCount;
 	IndexTSize = RHS.IndexTSize;
 	VertexCount = RHS.VertexCount;
+	MemorySize = RHS.MemorySize;
+	Bounds = RHS.Bounds;
 	DiffuseImage = std::move(RHS.DiffuseImage);
 	NormalImage = std::move(RHS.NormalImage);
 
@@ -58,6 +62,8 @@ void FMesh::Init(const FMeshData& MeshData, const FImageCache& ImageCache)
 	
 	DeInit();
 
+	Bounds = MeshData.Bounds;
+
 	F_GL(GL::GenVertexArrays(1, &VertexArray));
 	F_GL(GL::GenBuffers(1, &VertexBuffer));
 
@@ -78,6 +84,7 @@ void FMesh::Init(const FMeshData& MeshData, const FImageCache& ImageCache)
 
 		F_GL(GL::BindBuffer(EBuffer::Array, VertexArray));
 		F_GL(GL::BufferData(EBuffer::Array, TotalSize, nullptr, EUsage::StaticDraw));
+		MemorySize = TotalSize;
 
 		GLuint CurrentIndex = 0;
 
@@ -111,6 +118,7 @@ void FMesh::Init(const FMeshData& MeshData, const FImageCache& ImageCache)
 		F_GL(GL::GenBuffers(1, &ElementBuffer));
 		F_GL(GL::BindBuffer(EBuffer::ElementArray, ElementBuffer));
 		F_GL(GL::BufferData(EBuffer::ElementArray, Size, &MeshData.Indices[0], EUsage::StaticDraw));
+		MemorySize += Size;
 
 		IndexCount = Size / MeshData.IndexTSize;
 		IndexTSize = MeshData.IndexTSize;
@@ -159,6 +167,8 @@ void FMesh::DeInit()
 	IndexCount = 0;
 	IndexTSize = 0;
 	VertexCount = 0;
+	MemorySize = 0;
+	Bounds = FBounds();
 	DiffuseImage.DeInit();
 	NormalImage.DeInit();
 }
@@ -234,11 +244,21 @@ EMeshAttribute::Type FMesh::GetValidImages() const
 	return MeshAttrib;
 }
 
-const THandle<FImage>& FMesh::GetDiffuseImage() const
+const TThreadSafeHandle<FImage>& FMesh::GetDiffuseImage() const
 {
 	return DiffuseImage;
 }
 
+SizeT FMesh::GetMemorySize() const
+{
+	return MemorySize;
+}
+
+const FBounds& FMesh::GetBounds() const
+{
+	return Bounds;
+}
+
 void FMesh::PostMoveReset()
 {
 	VertexArray = 0;
@@ -247,6 +267,8 @@ void FMesh::PostMoveReset()
 	IndexCount = 0;
 	IndexTSize = 0;
 	VertexCount = 0;
+	MemorySize = 0;
+	Bounds = FBounds();
 	DiffuseImage.DeInit();
 	NormalImage.DeInit();
 }
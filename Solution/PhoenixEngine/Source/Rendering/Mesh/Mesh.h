@@ -4,6 +4,7 @@
 #include "ExternalLib/GLIncludes.h"
 #include "Utility/Handle/Handle.h"
 #include "Utility/Misc/Primitives.h"
+#include "Math/Bounds.h"
 #include "Rendering/GL/GLInterface.h"
 #include "Rendering/Image/Image.h"
 #include "Rendering/Mesh/MeshData.h"
@@ -43,7 +44,16 @@ namespace Phoenix
 
 		EMeshAttribute::Type GetValidImages() const;
 
-		const THandle<FImage>& GetDiffuseImage() const;
+		const TThreadSafeHandle<FImage>& GetDiffuseImage() const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the size of the mesh's vertex and index buffers in bytes.
+		*
+		*	@note The mesh's images are cached on their own, so they aren't counted.
+		*/
+		SizeT GetMemorySize() const;
+
+		const FBounds& GetBounds() const;
 		
 	private:
 		GL::VertexArrayT VertexArray{ 0 };
@@ -52,8 +62,10 @@ namespace Phoenix
 		GL::IndexCountT IndexCount{ 0 };
 		FMeshData::IndexTSizeT IndexTSize{ 0 };
 		FMeshData::VertexCountT VertexCount{ 0 };
-		THandle<FImage> DiffuseImage;
-		THandle<FImage> NormalImage;
+		SizeT MemorySize{ 0 };
+		FBounds Bounds;
+		TThreadSafeHandle<FImage> DiffuseImage;
+		TThreadSafeHandle<FImage> NormalImage;
 
 		void PostMoveReset();
 	};
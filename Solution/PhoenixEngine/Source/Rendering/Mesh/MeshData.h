@@ -2,8 +2,10 @@
 
 #include "ExternalLib/GLIncludes.h"
 #include "Utility/Containers/Array.h"
+#include "Utility/Containers/AssetVector.h"
 #include "Utility/Containers/Vector.h"
 #include "Utility/Debug/Assert.h"
+#include "Math/Bounds.h"
 #include "Math/Vector2D.h"
 #include "Rendering/Image/ImageData.h"
 
@@ -72,15 +74,17 @@ namespace Phoenix
 		typedef UInt16 TexNameIndexT;
 
 		EMeshAttribute::Type MeshAttrib{ EMeshAttribute::None };
-		TVector<PositionT> Positions;
-		TVector<NormalT> Normals;
-		TVector<UVCoordT> UVCoords;
-		TVector<IndexT> Indices;
+		TAssetVector<PositionT> Positions;
+		TAssetVector<NormalT> Normals;
+		TAssetVector<UVCoordT> UVCoords;
+		TAssetVector<IndexT> Indices;
 		IndexTSizeT IndexTSize{ 0 };
 		EMeshPositionType::Value PositionType{ EMeshPositionType::None };
 		VertexCountT VertexCount{ 0 };
 		TVector<FChar> TextureNames;
 		TArray<TexNameIndexT, EMeshDataIndex::Count> TexNameIndices;
+		/*! \brief Computed from Positions whenever a model is loaded, so it isn't serialized. */
+		FBounds Bounds;
 
 		FMeshData()
 		{
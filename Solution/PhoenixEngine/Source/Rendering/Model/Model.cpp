@@ -22,6 +22,8 @@ void FModel::Init(const FMeshData::FEntries& MeshDataEntries, const FImageCache&
 	{
 		const FMeshData& MeshData = MeshDataEntries[I];
 		Meshes[I].Init(MeshData, ImageCache);
+
+		Bounds = I ? NBounds::Merge(Bounds, MeshData.Bounds) : MeshData.Bounds;
 	}
 }
 
@@ -41,9 +43,26 @@ bool FModel::IsValid() const
 void FModel::DeInit()
 {
 	Meshes.clear();
+	Bounds = FBounds();
 }
 
 const FModel::FMeshes& FModel::GetMeshes() const
 {
 	return Meshes;
 }
+
+SizeT FModel::GetMemorySize() const
+{
+	SizeT MemorySize = 0;
+	for (const auto& Mesh : Meshes)
+	{
+		MemorySize += Mesh.GetMemorySize();
+	}
+
+	return MemorySize;
+}
+
+const FBounds& FModel::GetBounds() const
+{
+	return Bounds;
+}
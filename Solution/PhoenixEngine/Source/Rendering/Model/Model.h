@@ -3,6 +3,7 @@
 
 #include "Utility/Containers/Vector.h"
 #include "Utility/Misc/String.h"
+#include "Math/Bounds.h"
 #include "Rendering/Mesh/Mesh.h"
 #include "Rendering/Mesh/MeshData.h"
 
@@ -29,8 +30,17 @@ namespace Phoenix
 
 		const FMeshes& GetMeshes() const;
 
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the size of every mesh's vertex and index buffers in bytes. */
+		SizeT GetMemorySize() const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the model space bounds that enclose every mesh. */
+		const FBounds& GetBounds() const;
+
 	private:
 		FMeshes Meshes;
+		FBounds Bounds;
 	};
 }
 
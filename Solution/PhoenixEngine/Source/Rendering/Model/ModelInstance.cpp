@@ -6,36 +6,37 @@ using namespace Phoenix;
 void FModelInstance::SetMaterial(const FMaterial& InMaterial)
 {
 	Material = InMaterial;
+	Dirty = true;
 }
 
-void FModelInstance::SetModel(const FString& InModel)
+void FModelInstance::SetModel(const FName& InModel)
 {
 	Model = InModel;
-}
-
-void FModelInstance::SetModel(FString&& InModel)
-{
-	Model = std::move(InModel);
+	Dirty = true;
 }
 
 void FModelInstance::SetOrigin(const FVector3D& InOrigin)
 {
 	Origin = InOrigin;
+	Dirty = true;
 }
 
 void FModelInstance::SetPosition(const FVector3D& InPosition)
 {
 	Position = InPosition;
+	Dirty = true;
 }
 
 void FModelInstance::SetRotation(const FQuaternion& InRotation)
 {
 	Rotation = InRotation;
+	Dirty = true;
 }
 
 void FModelInstance::SetScale(const FVector3D& InScale)
 {
 	Scale = InScale;
+	Dirty = true;
 }
 
 const FMaterial& FModelInstance::GetMaterial() const
@@ -43,7 +44,7 @@ const FMaterial& FModelInstance::GetMaterial() const
 	return Material;
 }
 
-const FString& FModelInstance::GetModel() const
+const FName& FModelInstance::GetModel() const
 {
 	return Model;
 }
@@ -67,3 +68,35 @@ const FVector3D& FModelInstance::GetScale() const
 {
 	return Scale;
 }
+
+void FModelInstance::StorePreviousTransform()
+{
+	// Only a model that moved during the last step renders differently after this.
+	if (!HasPreviousTransform || PreviousPosition != Position || PreviousRotation != Rotation || PreviousScale != Scale)
+	{
+		Dirty = true;
+	}
+
+	PreviousPosition = Position;
+	PreviousRotation = Rotation;
+	PreviousScale = Scale;
+	HasPreviousTransform = true;
+}
+
+FVector3D FModelInstance::GetInterpolatedPosition(const Float32 FrameProgress) const
+{
+	const FVector3D Result = HasPreviousTransform ? glm::mix(PreviousPosition, Position, FrameProgress) : Position;
+	return Result;
+}
+
+FQuaternion FModelInstance::GetInterpolatedRotation(const Float32 FrameProgress) const
+{
+	const FQuaternion Result = HasPreviousTransform ? glm::slerp(PreviousRotation, Rotation, FrameProgress) : Rotation;
+	return Result;
+}
+
+FVector3D FModelInstance::GetInterpolatedScale(const Float32 FrameProgress) const
+{
+	const FVector3D Result = HasPreviousTransform ? glm::mix(PreviousScale, Scale, FrameProgress) : Scale;
+	return Result;
+}
@@ -1,8 +1,8 @@
 #ifndef PHOENIX_MODEL_INSTANCE_H
 #define PHOENIX_MODEL_INSTANCE_H
 
+#include "Utility/Misc/Name.h"
 #include "Utility/Misc/Primitives.h"
-#include "Utility/Misc/String.h"
 #include "Math/Quaternion.h"
 #include "Math/Vector3D.h"
 #include "Rendering/Material.h"
@@ -13,28 +13,73 @@ namespace Phoenix
 	{
 	public:
 		void SetMaterial(const FMaterial& Material);
-		void SetModel(const FString& Model);
-		void SetModel(FString&& Model);
+		void SetModel(const FName& Model);
 		void SetOrigin(const FVector3D& Origin);
 		void SetPosition(const FVector3D& Position);
 		void SetRotation(const FQuaternion& Rotation);
 		void SetScale(const FVector3D& Scale);
 
 		const FMaterial& GetMaterial() const;
-		const FString& GetModel() const;
+		const FName& GetModel() const;
 		const FVector3D& GetOrigin() const;
 		const FVector3D& GetPosition() const;
 		const FQuaternion& GetRotation() const;
 		const FVector3D& GetScale() const;
 
+		//	--------------------------------------------------------------------------------
+		/*! \brief Records the current transform as the one the next fixed step starts from.
+		*
+		*	@note This is for engine use only.
+		*/
+		void StorePreviousTransform();
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Blends the previous fixed step's transform toward the current one.
+		*
+		*	@param FrameProgress How far the render is into the next fixed step, in [0, 1].
+		*	@note If no previous transform has been stored yet, the current one is returned.
+		*/
+		FVector3D GetInterpolatedPosition(const Float32 FrameProgress) const;
+		FQuaternion GetInterpolatedRotation(const Float32 FrameProgress) const;
+		FVector3D GetInterpolatedScale(const Float32 FrameProgress) const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Checks whether the model changed since it was last handed to the GFX thread.
+		*
+		*	@note This is for engine use only.  New instances start out dirty.
+		*/
+		bool IsDirty() const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Marks the model as handed to the GFX thread.
+		*
+		*	@note This is for engine use only.
+		*/
+		void ClearDirty();
+
 	private:
 		FVector3D Origin;
 		FVector3D Position;
 		FVector3D Scale{ 1.f };
 		FQuaternion Rotation;
-		FString Model;
+		FVector3D PreviousPosition;
+		FVector3D PreviousScale{ 1.f };
+		FQuaternion PreviousRotation;
+		bool HasPreviousTransform{ false };
+		bool Dirty{ true };
+		FName Model;
 		FMaterial Material;
 	};
+
+	inline bool FModelInstance::IsDirty() const
+	{
+		return Dirty;
+	}
+
+	inline void FModelInstance::ClearDirty()
+	{
+		Dirty = false;
+	}
 }
 
 #endif
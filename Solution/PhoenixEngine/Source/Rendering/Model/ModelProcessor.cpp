@@ -3,6 +3,7 @@
 
 #include "ExternalLib/AssimpIncludes.h"
 #include "ExternalLib/FBXIncludes.h"
+#include "Utility/Containers/InlineVector.h"
 #include "Utility/Containers/Vector.h"
 #include "Utility/Debug/Assert.h"
 #include "Utility/FileIO/Endian.h"
@@ -73,12 +74,12 @@ namespace Phoenix
 		static void OnMeshEntriesLoaded(FMeshData::FEntries& MeshEntries, const FModelProcessor::FLoadParams& LoadParams);
 		static void ProcessOriginOffset(FMeshData::FEntries& MeshEntries, const FVector3D& OriginOffset);
 		static void ProcessSize(FMeshData::FEntries& MeshEntries, const Float32 NormalizedSize);
+		static void ProcessBounds(FMeshData::FEntries& MeshEntries);
 	};
 }
 
 using namespace Phoenix;
 
-const SizeT FModelProcessor::DefaultNodeCapacity = 32;
 const SizeT FModelProcessor::DefaultMeshEntriesCapacity = 16;
 
 const UInt8 FModelProcessorHelper::FloatsPerVertex = 3;
@@ -203,9 +204,7 @@ void FModelProcessor::LoadFBX(const FLoadParams& LoadParams)
 	FBXImporter = nullptr;
 
 	TRawPtr<FbxNode> RootFBXNode = FBXScene->GetRootNode();
-	TVector<TRawPtr<FbxNode>> FBXNodes;
-
-	FBXNodes.reserve(FModelProcessor::DefaultNodeCapacity);
+	TInlineVector<TRawPtr<FbxNode>, FModelProcessor::DefaultNodeCapacity> FBXNodes;
 
 	if (RootFBXNode.IsValid())
 	{
@@ -317,9 +316,8 @@ void FModelProcessor::LoadMisc(const FLoadParams& LoadParams)
 
 	const aiScene& AISceneRef = *AIScene;
 
-	TVector<const aiNode*> AINodes;
+	TInlineVector<const aiNode*, FModelProcessor::DefaultNodeCapacity> AINodes;
 
-	AINodes.reserve(FModelProcessor::DefaultNodeCapacity);
 	AINodes.push_back(AISceneRef.mRootNode);
 
 	for (SizeT I = 0; I < AINodes.size(); ++I)
@@ -964,6 +962,7 @@ void FModelProcessorHelper::OnMeshEntriesLoaded(
 {
 	FModelProcessorHelper::ProcessOriginOffset(MeshEntries, LoadParams.OriginOffset);
 	FModelProcessorHelper::ProcessSize(MeshEntries, LoadParams.NormalizedSize);
+	FModelProcessorHelper::ProcessBounds(MeshEntries);
 	F_GFXLog("Model created: " << NString::ExtractFileName(LoadParams.File));
 }
 
@@ -1020,3 +1019,16 @@ void FModelProcessorHelper::ProcessSize(FMeshData::FEntries& MeshEntries, const
 		}
 	}
 }
+
+void FModelProcessorHelper::ProcessBounds(FMeshData::FEntries& MeshEntries)
+{
+	for (auto& MeshEntry : MeshEntries)
+	{
+		const SizeT Stride = MeshEntry.PositionType != EMeshPositionType::None
+			? static_cast<SizeT>(MeshEntry.PositionType)
+			: FModelProcessorHelper::FloatsPerVertex;
+
+		const SizeT VertexCount = MeshEntry.Positions.size() / Stride;
+		MeshEntry.Bounds = NBounds::Create(MeshEntry.Positions.data(), VertexCount, Stride);
+	}
+}
@@ -57,7 +57,7 @@ namespace Phoenix
 		const FMeshData::FEntries& GetMeshData() const;
 
 	private:
-		static const SizeT DefaultNodeCapacity;
+		static const SizeT DefaultNodeCapacity = 32;
 		static const SizeT DefaultMeshEntriesCapacity;
 
 		typedef void(FModelProcessor::*FLoadFunction)(const FLoadParams& LoadParams);
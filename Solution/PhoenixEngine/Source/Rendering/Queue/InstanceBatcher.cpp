@@ -0,0 +1,50 @@
+#include "Stdafx.h"
+#include "Rendering/Queue/InstanceBatcher.h"
+
+#include "Utility/Debug/Assert.h"
+
+using namespace Phoenix;
+
+void FInstanceBatcher::Reserve(const SizeT InstanceCapacity)
+{
+	Instances.reserve(InstanceCapacity);
+}
+
+void FInstanceBatcher::Add(
+	const UInt64 Group,
+	const UInt32 Index,
+	const UInt32 SubIndex,
+	const FInstanceData& Instance)
+{
+	const SizeT InstanceCount = Instances.size();
+	F_Assert(InstanceCount < TNumericLimits<UInt32>::max(), "Too many instances.");
+
+	if (Batches.empty() || Batches.back().Group != Group)
+	{
+		Batches.push_back({ Group, Index, SubIndex, static_cast<UInt32>(InstanceCount), 0 });
+	}
+
+	++Batches.back().InstanceCount;
+	Instances.push_back(Instance);
+}
+
+void FInstanceBatcher::Clear()
+{
+	Batches.clear();
+	Instances.clear();
+}
+
+const FInstanceBatcher::FBatches& FInstanceBatcher::GetBatches() const
+{
+	return Batches;
+}
+
+const FInstanceBatcher::FInstances& FInstanceBatcher::GetInstances() const
+{
+	return Instances;
+}
+
+SizeT FInstanceBatcher::GetInstanceCount() const
+{
+	return Instances.size();
+}
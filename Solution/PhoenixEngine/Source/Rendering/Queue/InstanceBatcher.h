@@ -0,0 +1,94 @@
+#ifndef PHOENIX_INSTANCE_BATCHER_H
+#define PHOENIX_INSTANCE_BATCHER_H
+
+#include "Utility/Containers/Vector.h"
+#include "Utility/Misc/Primitives.h"
+#include "Math/Matrix4D.h"
+#include "Math/Vector4D.h"
+
+namespace Phoenix
+{
+	//	--------------------------------------------------------------------------------
+	/*! \brief The per-instance vertex attributes of an instanced model draw.
+	*
+	*	@note This is uploaded to the GPU as is, so its layout must match the instance
+	*		attributes that are declared by the model shaders.
+	*/
+	struct FInstanceData
+	{
+		FMatrix4D WorldViewProjection;
+		/*! \brief The instance's pivot.  The w component is unused. */
+		FVector4D Origin;
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief A run of instances that can be drawn with a single instanced draw call. */
+	struct FInstanceBatch
+	{
+		/*! \brief Identifies what every instance in the batch shares, such as a mesh and material. */
+		UInt64 Group;
+		/*! \brief The Index of the first instance that was added to the batch. */
+		UInt32 Index;
+		/*! \brief The SubIndex of the first instance that was added to the batch. */
+		UInt32 SubIndex;
+		/*! \brief The offset of the batch's first instance in the instance data. */
+		UInt32 FirstInstance;
+		UInt32 InstanceCount;
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Packs instances into batches that each become one instanced draw call.
+	*
+	*	@desc Instances are added in draw order, and each one that has the same group as
+	*		the one before it joins that instance's batch.  The instance data of every
+	*		batch is stored contiguously, so it can be uploaded with one copy and each
+	*		batch can be drawn from its offset.
+	*	@note Instances should be sorted by group first, which is what FRenderQueue's
+	*		opaque keys do, since a group that is interrupted starts a new batch.
+	*/
+	class FInstanceBatcher
+	{
+	public:
+		typedef TVector<FInstanceBatch> FBatches;
+		typedef TVector<FInstanceData> FInstances;
+
+		FInstanceBatcher() = default;
+
+		FInstanceBatcher(const FInstanceBatcher&) = delete;
+		FInstanceBatcher& operator=(const FInstanceBatcher&) = delete;
+
+		FInstanceBatcher(FInstanceBatcher&&) = default;
+		FInstanceBatcher& operator=(FInstanceBatcher&&) = default;
+
+		void Reserve(const SizeT InstanceCapacity);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Adds an instance to the last batch, or to a new batch if its group differs.
+		*
+		*	@param Group - Instances can only share a batch if their groups are equal.
+		*	@param Index - Identifies what to draw, such as an index into a render list.
+		*	@param SubIndex - Identifies a part of what to draw, such as one of a model's meshes.
+		*	@param Instance - The instance's vertex attributes.
+		*/
+		void Add(
+			const UInt64 Group,
+			const UInt32 Index,
+			const UInt32 SubIndex,
+			const FInstanceData& Instance);
+
+		void Clear();
+
+		const FBatches& GetBatches() const;
+
+		const FInstances& GetInstances() const;
+
+		SizeT GetInstanceCount() const;
+
+	protected:
+	private:
+		FBatches Batches;
+		FInstances Instances;
+	};
+}
+
+#endif
@@ -0,0 +1,326 @@
+#include "Stdafx.h"
+#include "Rendering/Queue/RenderCommandBuffer.h"
+
+#include <cstring>
+
+#include "Utility/Debug/Assert.h"
+
+using namespace Phoenix;
+
+namespace FRenderCommandBufferInternal
+{
+	bool HasPayload(const ERenderCommand::Value Command)
+	{
+		const bool Result = Command == ERenderCommand::DrawBuffers
+			|| Command == ERenderCommand::Uniform
+			|| Command == ERenderCommand::VertexAttribute;
+
+		return Result;
+	}
+
+	UInt32 ToWord(const Int32 Value)
+	{
+		UInt32 Word = 0;
+		std::memcpy(&Word, &Value, sizeof(Word));
+		return Word;
+	}
+}
+
+const FChar* ERenderCommand::ToString(const Value Command)
+{
+	static_assert(ERenderCommand::Count == 17, "This table needs updating.");
+
+	switch (Command)
+	{
+		case ERenderCommand::BindFramebuffer:
+			return "BindFramebuffer";
+		case ERenderCommand::DrawBuffers:
+			return "DrawBuffers";
+		case ERenderCommand::UseProgram:
+			return "UseProgram";
+		case ERenderCommand::ActiveTexture:
+			return "ActiveTexture";
+		case ERenderCommand::BindTexture:
+			return "BindTexture";
+		case ERenderCommand::BindVertexArray:
+			return "BindVertexArray";
+		case ERenderCommand::BindBuffer:
+			return "BindBuffer";
+		case ERenderCommand::StreamBuffer:
+			return "StreamBuffer";
+		case ERenderCommand::Enable:
+			return "Enable";
+		case ERenderCommand::Disable:
+			return "Disable";
+		case ERenderCommand::BlendFunc:
+			return "BlendFunc";
+		case ERenderCommand::PixelStore:
+			return "PixelStore";
+		case ERenderCommand::Uniform:
+			return "Uniform";
+		case ERenderCommand::VertexAttribute:
+			return "VertexAttribute";
+		case ERenderCommand::ClearFramebuffer:
+			return "ClearFramebuffer";
+		case ERenderCommand::DrawArrays:
+			return "DrawArrays";
+		case ERenderCommand::DrawElementsInstanced:
+			return "DrawElementsInstanced";
+		default:
+			F_Assert(false, "Invalid command " << static_cast<UInt32>(Command));
+			break;
+	}
+
+	return "";
+}
+
+void FRenderCommandBuffer::BindFramebuffer(const UInt32 Target, const UInt32 Framebuffer)
+{
+	AddCommand(ERenderCommand::BindFramebuffer, Target, Framebuffer);
+}
+
+void FRenderCommandBuffer::DrawBuffers(const UInt32 BufferCount, const UInt32* const Buffers)
+{
+	F_Assert(Buffers || BufferCount == 0, "Buffers is null.");
+	AddPayloadCommand(ERenderCommand::DrawBuffers, 0, 0, Buffers, BufferCount);
+}
+
+void FRenderCommandBuffer::UseProgram(const UInt32 Program)
+{
+	AddCommand(ERenderCommand::UseProgram, 0, Program);
+}
+
+void FRenderCommandBuffer::ActiveTexture(const UInt32 Unit)
+{
+	AddCommand(ERenderCommand::ActiveTexture, Unit);
+}
+
+void FRenderCommandBuffer::BindTexture(const UInt32 Target, const UInt32 Texture)
+{
+	AddCommand(ERenderCommand::BindTexture, Target, Texture);
+}
+
+void FRenderCommandBuffer::BindVertexArray(const UInt32 VertexArray)
+{
+	AddCommand(ERenderCommand::BindVertexArray, 0, VertexArray);
+}
+
+void FRenderCommandBuffer::BindBuffer(const UInt32 Target, const UInt32 Buffer)
+{
+	AddCommand(ERenderCommand::BindBuffer, Target, Buffer);
+}
+
+void FRenderCommandBuffer::StreamBuffer(
+	const UInt32 Target,
+	const UInt32 Buffer,
+	const void* const Data,
+	const SizeT Size)
+{
+	F_Assert(Data || Size == 0, "Data is null.");
+
+	// The bind is recorded on its own so that it can be dropped when it's redundant.
+	BindBuffer(Target, Buffer);
+
+	FRenderStream Stream;
+	Stream.Data = Data;
+	Stream.Size = Size;
+
+	AddCommand(ERenderCommand::StreamBuffer, Target, Buffer, 0, static_cast<UInt32>(Streams.size()));
+	Streams.push_back(Stream);
+}
+
+void FRenderCommandBuffer::Enable(const UInt32 Capability)
+{
+	AddCommand(ERenderCommand::Enable, Capability);
+}
+
+void FRenderCommandBuffer::Disable(const UInt32 Capability)
+{
+	AddCommand(ERenderCommand::Disable, Capability);
+}
+
+void FRenderCommandBuffer::BlendFunc(const UInt32 Source, const UInt32 Destination)
+{
+	AddCommand(ERenderCommand::BlendFunc, Source, Destination);
+}
+
+void FRenderCommandBuffer::PixelStore(const UInt32 Parameter, const Int32 Value)
+{
+	AddCommand(ERenderCommand::PixelStore, Parameter, FRenderCommandBufferInternal::ToWord(Value));
+}
+
+void FRenderCommandBuffer::Uniform(const Int32 Location, const Int32 Integer)
+{
+	AddUniform(Location, ERenderUniform::Int, &Integer, 1);
+}
+
+void FRenderCommandBuffer::Uniform(const Int32 Location, const FVector2D& Vector2D)
+{
+	AddUniform(Location, ERenderUniform::Vector2D, &Vector2D[0], 2);
+}
+
+void FRenderCommandBuffer::Uniform(const Int32 Location, const FVector3D& Vector3D)
+{
+	AddUniform(Location, ERenderUniform::Vector3D, &Vector3D[0], 3);
+}
+
+void FRenderCommandBuffer::Uniform(const Int32 Location, const FVector4D& Vector4D)
+{
+	AddUniform(Location, ERenderUniform::Vector4D, &Vector4D[0], 4);
+}
+
+void FRenderCommandBuffer::Uniform(const Int32 Location, const FMatrix3D& Matrix3D)
+{
+	AddUniform(Location, ERenderUniform::Matrix3D, &Matrix3D[0][0], 9);
+}
+
+void FRenderCommandBuffer::Uniform(const Int32 Location, const FMatrix4D& Matrix4D)
+{
+	AddUniform(Location, ERenderUniform::Matrix4D, &Matrix4D[0][0], 16);
+}
+
+void FRenderCommandBuffer::VertexAttribute(
+	const UInt32 Location,
+	const UInt32 Components,
+	const UInt32 Stride,
+	const SizeT Offset,
+	const UInt32 Divisor)
+{
+	F_Assert(Components >= 1 && Components <= 4, "Invalid component count " << Components);
+	F_Assert(Offset <= TNumericLimits<UInt32>::max(), "Offset " << Offset << " doesn't fit in a command.");
+
+	const UInt32 Words[] = { Components, Stride, static_cast<UInt32>(Offset), Divisor };
+	AddPayloadCommand(ERenderCommand::VertexAttribute, Location, 0, Words, 4);
+}
+
+void FRenderCommandBuffer::ClearFramebuffer(const UInt32 Mask)
+{
+	AddCommand(ERenderCommand::ClearFramebuffer, Mask);
+}
+
+void FRenderCommandBuffer::DrawArrays(const UInt32 Mode, const UInt32 First, const UInt32 VertexCount)
+{
+	AddCommand(ERenderCommand::DrawArrays, Mode, First, VertexCount);
+}
+
+void FRenderCommandBuffer::DrawElementsInstanced(
+	const UInt32 Mode,
+	const UInt32 IndexCount,
+	const UInt32 IndexType,
+	const UInt32 InstanceCount)
+{
+	AddCommand(ERenderCommand::DrawElementsInstanced, Mode, IndexType, IndexCount, InstanceCount);
+}
+
+void FRenderCommandBuffer::Append(const FRenderCommandBuffer& Other)
+{
+	using namespace FRenderCommandBufferInternal;
+
+	const UInt32 PayloadOffset = static_cast<UInt32>(Payload.size());
+	const UInt32 StreamOffset = static_cast<UInt32>(Streams.size());
+
+	Commands.reserve(Commands.size() + Other.Commands.size());
+
+	for (FRenderCommand Command : Other.Commands)
+	{
+		if (HasPayload(Command.Type))
+		{
+			Command.Extra += PayloadOffset;
+		}
+		else if (Command.Type == ERenderCommand::StreamBuffer)
+		{
+			Command.Extra += StreamOffset;
+		}
+
+		Commands.push_back(Command);
+	}
+
+	Payload.insert(Payload.end(), Other.Payload.begin(), Other.Payload.end());
+	Streams.insert(Streams.end(), Other.Streams.begin(), Other.Streams.end());
+}
+
+void FRenderCommandBuffer::Clear()
+{
+	Commands.clear();
+	Payload.clear();
+	Streams.clear();
+}
+
+SizeT FRenderCommandBuffer::GetSize() const
+{
+	return Commands.size();
+}
+
+const FRenderCommandBuffer::FCommands& FRenderCommandBuffer::GetCommands() const
+{
+	return Commands;
+}
+
+const UInt32* FRenderCommandBuffer::GetPayload(const FRenderCommand& Command) const
+{
+	F_Assert(FRenderCommandBufferInternal::HasPayload(Command.Type),
+		ERenderCommand::ToString(Command.Type) << " commands have no payload.");
+	F_Assert(Command.Extra + Command.Count <= Payload.size(), "Payload is out of range.");
+
+	return Payload.data() + Command.Extra;
+}
+
+const FRenderStream& FRenderCommandBuffer::GetStream(const FRenderCommand& Command) const
+{
+	F_Assert(Command.Type == ERenderCommand::StreamBuffer, "Only StreamBuffer commands have streams.");
+	F_Assert(Command.Extra < Streams.size(), "Stream is out of range.");
+
+	return Streams[Command.Extra];
+}
+
+void FRenderCommandBuffer::AddCommand(
+	const ERenderCommand::Value Type,
+	const UInt32 Target,
+	const UInt32 Object,
+	const UInt32 Count,
+	const UInt32 Extra)
+{
+	FRenderCommand Command;
+	Command.Type = Type;
+	Command.Target = Target;
+	Command.Object = Object;
+	Command.Count = Count;
+	Command.Extra = Extra;
+
+	Commands.push_back(Command);
+}
+
+void FRenderCommandBuffer::AddPayloadCommand(
+	const ERenderCommand::Value Type,
+	const UInt32 Target,
+	const UInt32 Object,
+	const void* const Data,
+	const UInt32 WordCount)
+{
+	const SizeT Offset = Payload.size();
+	Payload.resize(Offset + WordCount);
+
+	if (WordCount)
+	{
+		std::memcpy(Payload.data() + Offset, Data, WordCount * sizeof(UInt32));
+	}
+
+	AddCommand(Type, Target, Object, WordCount, static_cast<UInt32>(Offset));
+}
+
+void FRenderCommandBuffer::AddUniform(
+	const Int32 Location,
+	const ERenderUniform::Value UniformType,
+	const void* const Data,
+	const UInt32 WordCount)
+{
+	static_assert(sizeof(Float32) == sizeof(UInt32), "Uniforms are stored as 32-bit words.");
+	F_Assert(WordCount <= MaxUniformWords, "Uniforms may take up at most " << MaxUniformWords << " words.");
+
+	AddPayloadCommand(
+		ERenderCommand::Uniform,
+		UniformType,
+		FRenderCommandBufferInternal::ToWord(Location),
+		Data,
+		WordCount);
+}
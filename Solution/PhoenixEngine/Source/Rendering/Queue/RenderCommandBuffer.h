@@ -0,0 +1,231 @@
+#ifndef PHOENIX_RENDER_COMMAND_BUFFER_H
+#define PHOENIX_RENDER_COMMAND_BUFFER_H
+
+#include "Utility/Containers/Vector.h"
+#include "Utility/Misc/Primitives.h"
+#include "Math/Matrix3D.h"
+#include "Math/Matrix4D.h"
+#include "Math/Vector2D.h"
+#include "Math/Vector3D.h"
+#include "Math/Vector4D.h"
+
+namespace Phoenix
+{
+	namespace ERenderCommand
+	{
+		typedef UInt8 Type;
+
+		enum Value : Type
+		{
+			BindFramebuffer,
+			DrawBuffers,
+			UseProgram,
+			ActiveTexture,
+			BindTexture,
+			BindVertexArray,
+			BindBuffer,
+			/*! \brief Replaces the data of the buffer bound to a target. */
+			StreamBuffer,
+			Enable,
+			Disable,
+			BlendFunc,
+			PixelStore,
+			Uniform,
+			/*! \brief Enables an instanced vertex attribute and points it into the bound buffer. */
+			VertexAttribute,
+			ClearFramebuffer,
+			DrawArrays,
+			DrawElementsInstanced,
+			Count
+		};
+
+		const FChar* ToString(const Value Command);
+	}
+
+	namespace ERenderUniform
+	{
+		typedef UInt8 Type;
+
+		enum Value : Type
+		{
+			Int,
+			Vector2D,
+			Vector3D,
+			Vector4D,
+			Matrix3D,
+			Matrix4D
+		};
+	}
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief A recorded command.  What each member means depends on the command.
+	*
+	*	@desc Targets, objects and enums are the backend's own values.  Commands with
+	*		more arguments than fit here keep them in the buffer's payload, in which
+	*		case Count is the number of words and Extra is the offset of the first.
+	*/
+	struct FRenderCommand
+	{
+		ERenderCommand::Value Type{ ERenderCommand::Count };
+		UInt32 Target{ 0 };
+		UInt32 Object{ 0 };
+		UInt32 Count{ 0 };
+		UInt32 Extra{ 0 };
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Data that a StreamBuffer command uploads.
+	*
+	*	@note The data isn't copied, so it must stay alive until the buffer is replayed.
+	*/
+	struct FRenderStream
+	{
+		const void* Data{ nullptr };
+		SizeT Size{ 0 };
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Records the binds, state changes, uploads and draws of a pass so that they
+	*		can be issued later, usually on another thread.
+	*
+	*	@desc Nothing is sent to the GPU while recording, so any thread may record its
+	*		own buffer.  Buffers are merged with Append and replayed on the thread that
+	*		owns the GL context, through a FRenderStateCache that drops whatever would
+	*		not change the bound state.
+	*/
+	class FRenderCommandBuffer
+	{
+	public:
+		typedef TVector<FRenderCommand> FCommands;
+		typedef TVector<UInt32> FPayload;
+		typedef TVector<FRenderStream> FStreams;
+
+		/*! \brief The most words a uniform may take up. */
+		static const UInt32 MaxUniformWords = 16;
+
+		FRenderCommandBuffer() = default;
+
+		FRenderCommandBuffer(const FRenderCommandBuffer&) = delete;
+		FRenderCommandBuffer& operator=(const FRenderCommandBuffer&) = delete;
+
+		FRenderCommandBuffer(FRenderCommandBuffer&&) = default;
+		FRenderCommandBuffer& operator=(FRenderCommandBuffer&&) = default;
+
+		void BindFramebuffer(const UInt32 Target, const UInt32 Framebuffer);
+
+		void DrawBuffers(const UInt32 BufferCount, const UInt32* const Buffers);
+
+		void UseProgram(const UInt32 Program);
+
+		void ActiveTexture(const UInt32 Unit);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Binds a texture to the unit set by the last ActiveTexture. */
+		void BindTexture(const UInt32 Target, const UInt32 Texture);
+
+		void BindVertexArray(const UInt32 VertexArray);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Binds a buffer.
+		*
+		*	@note Element array binds belong to the bound vertex array, so they're forgotten
+		*		whenever the vertex array changes.
+		*/
+		void BindBuffer(const UInt32 Target, const UInt32 Buffer);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Binds a buffer and replaces its data.
+		*
+		*	@param Data - Isn't copied.  It must stay alive until the buffer is replayed.
+		*/
+		void StreamBuffer(const UInt32 Target, const UInt32 Buffer, const void* const Data, const SizeT Size);
+
+		void Enable(const UInt32 Capability);
+
+		void Disable(const UInt32 Capability);
+
+		void BlendFunc(const UInt32 Source, const UInt32 Destination);
+
+		void PixelStore(const UInt32 Parameter, const Int32 Value);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Sets a uniform of the program set by the last UseProgram. */
+		void Uniform(const Int32 Location, const Int32 Integer);
+		void Uniform(const Int32 Location, const FVector2D& Vector2D);
+		void Uniform(const Int32 Location, const FVector3D& Vector3D);
+		void Uniform(const Int32 Location, const FVector4D& Vector4D);
+		void Uniform(const Int32 Location, const FMatrix3D& Matrix3D);
+		void Uniform(const Int32 Location, const FMatrix4D& Matrix4D);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Enables an attribute and points it at float data in the bound array buffer.
+		*
+		*	@param Components - The number of floats per element, from 1 to 4.
+		*	@param Stride - The bytes between the starts of consecutive elements.
+		*	@param Offset - The offset of the first element, in bytes.
+		*	@param Divisor - The instances each element is used for.  0 for per vertex data.
+		*/
+		void VertexAttribute(
+			const UInt32 Location,
+			const UInt32 Components,
+			const UInt32 Stride,
+			const SizeT Offset,
+			const UInt32 Divisor);
+
+		void ClearFramebuffer(const UInt32 Mask);
+
+		void DrawArrays(const UInt32 Mode, const UInt32 First, const UInt32 VertexCount);
+
+		void DrawElementsInstanced(
+			const UInt32 Mode,
+			const UInt32 IndexCount,
+			const UInt32 IndexType,
+			const UInt32 InstanceCount);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Appends the commands of another buffer, as if they were recorded here. */
+		void Append(const FRenderCommandBuffer& Other);
+
+		void Clear();
+
+		SizeT GetSize() const;
+
+		const FCommands& GetCommands() const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the payload words of a command that keeps its arguments there. */
+		const UInt32* GetPayload(const FRenderCommand& Command) const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the data of a StreamBuffer command. */
+		const FRenderStream& GetStream(const FRenderCommand& Command) const;
+
+	protected:
+	private:
+		FCommands Commands;
+		FPayload Payload;
+		FStreams Streams;
+
+		void AddCommand(
+			const ERenderCommand::Value Type,
+			const UInt32 Target,
+			const UInt32 Object = 0,
+			const UInt32 Count = 0,
+			const UInt32 Extra = 0);
+
+		void AddPayloadCommand(
+			const ERenderCommand::Value Type,
+			const UInt32 Target,
+			const UInt32 Object,
+			const void* const Data,
+			const UInt32 WordCount);
+
+		void AddUniform(
+			const Int32 Location,
+			const ERenderUniform::Value UniformType,
+			const void* const Data,
+			const UInt32 WordCount);
+	};
+}
+
+#endif
@@ -0,0 +1,174 @@
+#include "Stdafx.h"
+#include "Rendering/Queue/RenderQueue.h"
+
+#include <algorithm>
+
+#include "Utility/Containers/Array.h"
+#include "Utility/Debug/Assert.h"
+
+using namespace Phoenix;
+
+namespace FRenderQueueConstants
+{
+	const UInt64 PassBits = 2;
+	const UInt64 ShaderBits = 8;
+	const UInt64 MaterialBits = 16;
+	const UInt64 MeshBits = 16;
+	const UInt64 DepthBits = 22;
+
+	const UInt64 PassShift = 64 - PassBits;
+
+	const UInt64 RadixBits = 8;
+	const SizeT RadixSize = 1 << RadixBits;
+	const SizeT RadixPasses = 64 / RadixBits;
+}
+
+namespace FRenderQueueInternal
+{
+	UInt64 Mask(const UInt64 Value, const UInt64 Bits)
+	{
+		const UInt64 Result = Value & ((1ull << Bits) - 1);
+		return Result;
+	}
+}
+
+UInt64 FRenderQueue::MakeKey(
+	const ERenderPass::Value Pass,
+	const UInt32 Shader,
+	const UInt32 Material,
+	const UInt32 Mesh,
+	const UInt32 InDepthBucket)
+{
+	using namespace FRenderQueueConstants;
+	using FRenderQueueInternal::Mask;
+
+	static_assert(PassBits + ShaderBits + MaterialBits + MeshBits + DepthBits == 64, "Key fields must fill 64 bits.");
+	static_assert(ERenderPass::Count <= (1 << PassBits), "Not enough pass bits.");
+	F_Assert(Pass < ERenderPass::Count, "Invalid pass " << static_cast<UInt32>(Pass));
+
+	const UInt64 DepthBucket = std::min(InDepthBucket, GetMaxDepthBucket());
+
+	UInt64 Key = static_cast<UInt64>(Pass) << PassShift;
+
+	if (Pass == ERenderPass::Transparent)
+	{
+		const UInt64 InvertedDepth = Mask(~DepthBucket, DepthBits);
+
+		Key |= InvertedDepth << (ShaderBits + MaterialBits + MeshBits);
+		Key |= Mask(Shader, ShaderBits) << (MaterialBits + MeshBits);
+		Key |= Mask(Material, MaterialBits) << MeshBits;
+		Key |= Mask(Mesh, MeshBits);
+	}
+	else
+	{
+		Key |= Mask(Shader, ShaderBits) << (MaterialBits + MeshBits + DepthBits);
+		Key |= Mask(Material, MaterialBits) << (MeshBits + DepthBits);
+		Key |= Mask(Mesh, MeshBits) << DepthBits;
+		Key |= DepthBucket;
+	}
+
+	return Key;
+}
+
+UInt32 FRenderQueue::GetDepthBucket(const Float32 Depth)
+{
+	// Written so that NaN fails both comparisons and lands in the nearest bucket.
+	const Float32 ClampedDepth = Depth > 0.f ? (Depth < 1.f ? Depth : 1.f) : 0.f;
+	const UInt32 DepthBucket = static_cast<UInt32>(ClampedDepth * static_cast<Float32>(GetMaxDepthBucket()));
+	return DepthBucket;
+}
+
+UInt32 FRenderQueue::GetMaxDepthBucket()
+{
+	const UInt32 MaxDepthBucket = static_cast<UInt32>((1ull << FRenderQueueConstants::DepthBits) - 1);
+	return MaxDepthBucket;
+}
+
+ERenderPass::Value FRenderQueue::GetPass(const UInt64 Key)
+{
+	const ERenderPass::Value Pass = static_cast<ERenderPass::Value>(Key >> FRenderQueueConstants::PassShift);
+	return Pass;
+}
+
+void FRenderQueue::Reserve(const SizeT Capacity)
+{
+	Items.reserve(Capacity);
+	ScratchItems.reserve(Capacity);
+}
+
+void FRenderQueue::Add(const UInt64 Key, const UInt32 Index, const UInt32 SubIndex)
+{
+	Items.push_back({ Key, Index, SubIndex });
+}
+
+void FRenderQueue::Sort()
+{
+	using namespace FRenderQueueConstants;
+
+	const SizeT Size = Items.size();
+	if (Size < 2)
+	{
+		return;
+	}
+
+	typedef TArray<TArray<SizeT, RadixSize>, RadixPasses> FHistograms;
+
+	// Every pass's histogram is built in one read of the keys.
+	FHistograms Histograms;
+	for (auto& Histogram : Histograms)
+	{
+		Histogram.fill(0);
+	}
+
+	for (const FRenderQueueItem& Item : Items)
+	{
+		for (SizeT Pass = 0; Pass < RadixPasses; ++Pass)
+		{
+			++Histograms[Pass][(Item.Key >> (Pass * RadixBits)) & (RadixSize - 1)];
+		}
+	}
+
+	ScratchItems.resize(Size);
+
+	for (SizeT Pass = 0; Pass < RadixPasses; ++Pass)
+	{
+		auto& Histogram = Histograms[Pass];
+
+		const UInt64 FirstDigit = (Items[0].Key >> (Pass * RadixBits)) & (RadixSize - 1);
+		if (Histogram[FirstDigit] == Size)
+		{
+			continue;
+		}
+
+		SizeT Offset = 0;
+		for (SizeT& Count : Histogram)
+		{
+			const SizeT DigitCount = Count;
+			Count = Offset;
+			Offset += DigitCount;
+		}
+
+		for (const FRenderQueueItem& Item : Items)
+		{
+			const SizeT Digit = (Item.Key >> (Pass * RadixBits)) & (RadixSize - 1);
+			ScratchItems[Histogram[Digit]++] = Item;
+		}
+
+		Items.swap(ScratchItems);
+	}
+}
+
+void FRenderQueue::Clear()
+{
+	Items.clear();
+}
+
+const FRenderQueue::FItems& FRenderQueue::GetItems() const
+{
+	return Items;
+}
+
+SizeT FRenderQueue::GetSize() const
+{
+	return Items.size();
+}
@@ -0,0 +1,129 @@
+#ifndef PHOENIX_RENDER_QUEUE_H
+#define PHOENIX_RENDER_QUEUE_H
+
+#include "Utility/Containers/Vector.h"
+#include "Utility/Misc/Primitives.h"
+
+namespace Phoenix
+{
+	namespace ERenderPass
+	{
+		typedef UInt8 Type;
+
+		enum Value : Type
+		{
+			Opaque,
+			Transparent,
+			Count
+		};
+	}
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief The GL work that was submitted during one frame. */
+	struct FRenderStats
+	{
+		UInt32 DrawCalls{ 0 };
+		/*! \brief The instances drawn by instanced draw calls. */
+		UInt32 Instances{ 0 };
+		/*! \brief The sprites drawn by batched draw calls. */
+		UInt32 Sprites{ 0 };
+		UInt32 ShaderBinds{ 0 };
+		UInt32 TextureBinds{ 0 };
+		UInt32 VertexArrayBinds{ 0 };
+		/*! \brief Capability toggles and blend function changes. */
+		UInt32 StateChanges{ 0 };
+		/*! \brief The bytes of instance data the game thread copied to set up the state being drawn. */
+		UInt64 HandoffBytes{ 0 };
+		/*! \brief The recorded commands that were replayed, including the eliminated ones. */
+		UInt32 Commands{ 0 };
+		/*! \brief Redundant framebuffer, program, texture, vertex array and buffer binds that were dropped. */
+		UInt32 EliminatedBinds{ 0 };
+		/*! \brief Uniform uploads that were dropped because the program already had the value. */
+		UInt32 EliminatedUniforms{ 0 };
+		UInt32 EliminatedStateChanges{ 0 };
+	};
+
+	struct FRenderQueueItem
+	{
+		UInt64 Key;
+		/*! \brief Identifies what to draw, such as an index into a render list. */
+		UInt32 Index;
+		/*! \brief Identifies a part of what to draw, such as one of a model's meshes. */
+		UInt32 SubIndex;
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Orders draws by a 64-bit key so that draws that share state are adjacent.
+	*
+	*	@desc Opaque keys are ordered by pass, shader, material, mesh and then depth, so
+	*		binds are shared as much as possible and ties are drawn front to back.
+	*		Transparent keys put depth right after the pass so they're drawn back to
+	*		front, and only share binds within a depth bucket.
+	*	@note IDs that don't fit in their field are truncated, which can only make
+	*		unrelated draws adjacent.  It never changes the pass or depth order.
+	*/
+	class FRenderQueue
+	{
+	public:
+		typedef TVector<FRenderQueueItem> FItems;
+
+		FRenderQueue() = default;
+
+		FRenderQueue(const FRenderQueue&) = delete;
+		FRenderQueue& operator=(const FRenderQueue&) = delete;
+
+		FRenderQueue(FRenderQueue&&) = default;
+		FRenderQueue& operator=(FRenderQueue&&) = default;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Packs a sort key.
+		*
+		*	@param Pass - Draws are ordered by pass first.
+		*	@param Shader - Usually the shader's program ID.
+		*	@param Material - Usually the ID of the material's texture.
+		*	@param Mesh - Usually the mesh's vertex array ID.
+		*	@param DepthBucket - Where 0 is nearest to the camera.  See GetDepthBucket.
+		*/
+		static UInt64 MakeKey(
+			const ERenderPass::Value Pass,
+			const UInt32 Shader,
+			const UInt32 Material,
+			const UInt32 Mesh,
+			const UInt32 DepthBucket);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Quantizes a depth in [0, 1] to a depth bucket.  Clamped. */
+		static UInt32 GetDepthBucket(const Float32 Depth);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the farthest depth bucket.  Larger buckets are clamped to it. */
+		static UInt32 GetMaxDepthBucket();
+
+		static ERenderPass::Value GetPass(const UInt64 Key);
+
+		void Reserve(const SizeT Capacity);
+
+		void Add(const UInt64 Key, const UInt32 Index, const UInt32 SubIndex = 0);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Sorts the items by key with a stable LSD radix sort.
+		*
+		*	@note Bytes that are the same in every key are skipped, which is common since
+		*		most frames only use a few passes and shaders.
+		*/
+		void Sort();
+
+		void Clear();
+
+		const FItems& GetItems() const;
+
+		SizeT GetSize() const;
+
+	protected:
+	private:
+		FItems Items;
+		FItems ScratchItems;
+	};
+}
+
+#endif
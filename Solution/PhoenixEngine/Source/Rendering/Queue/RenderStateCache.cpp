@@ -0,0 +1,209 @@
+#include "Stdafx.h"
+#include "Rendering/Queue/RenderStateCache.h"
+
+#include <algorithm>
+
+#include "Utility/Debug/Assert.h"
+#include "Rendering/GL/GLTypes.h"
+
+using namespace Phoenix;
+
+namespace FRenderStateCacheInternal
+{
+	UInt64 MakeStateKey(const ERenderCommand::Value Command, const UInt32 TextureUnit, const UInt32 Target)
+	{
+		const UInt64 Key = (static_cast<UInt64>(Command) << 56) | (static_cast<UInt64>(TextureUnit) << 32) | Target;
+		return Key;
+	}
+
+	UInt64 MakeUniformKey(const UInt32 Program, const UInt32 Location)
+	{
+		const UInt64 Key = (static_cast<UInt64>(Program) << 32) | Location;
+		return Key;
+	}
+}
+
+UInt32 FRenderStateCacheStats::GetEliminated() const
+{
+	const UInt32 Result = EliminatedBinds + EliminatedUniforms + EliminatedStateChanges;
+	return Result;
+}
+
+bool FRenderStateCache::Apply(const FRenderCommandBuffer& Buffer, const FRenderCommand& Command)
+{
+	using FRenderStateCacheInternal::MakeStateKey;
+
+	++Stats.Commands;
+
+	bool bIssue = true;
+	UInt32* EliminatedCount = nullptr;
+
+	switch (Command.Type)
+	{
+		case ERenderCommand::BindFramebuffer:
+		case ERenderCommand::BindBuffer:
+		{
+			bIssue = SetState(MakeStateKey(Command.Type, 0, Command.Target), Command.Object);
+			EliminatedCount = &Stats.EliminatedBinds;
+			break;
+		}
+		case ERenderCommand::UseProgram:
+		{
+			bIssue = SetState(MakeStateKey(Command.Type, 0, 0), Command.Object);
+			EliminatedCount = &Stats.EliminatedBinds;
+			break;
+		}
+		case ERenderCommand::BindVertexArray:
+		{
+			bIssue = SetState(MakeStateKey(Command.Type, 0, 0), Command.Object);
+			EliminatedCount = &Stats.EliminatedBinds;
+
+			// The element array buffer is part of a vertex array's state.
+			if (bIssue)
+			{
+				States.erase(MakeStateKey(ERenderCommand::BindBuffer, 0, GL::EBuffer::ElementArray));
+			}
+			break;
+		}
+		case ERenderCommand::ActiveTexture:
+		{
+			bIssue = SetState(MakeStateKey(Command.Type, 0, 0), Command.Target);
+			EliminatedCount = &Stats.EliminatedStateChanges;
+			break;
+		}
+		case ERenderCommand::BindTexture:
+		{
+			// Without a known unit the bind can't be tracked, so it's issued as is.
+			UInt64 Unit = 0;
+			if (FindState(MakeStateKey(ERenderCommand::ActiveTexture, 0, 0), Unit))
+			{
+				bIssue = SetState(MakeStateKey(Command.Type, static_cast<UInt32>(Unit), Command.Target), Command.Object);
+				EliminatedCount = &Stats.EliminatedBinds;
+			}
+			break;
+		}
+		case ERenderCommand::Enable:
+		case ERenderCommand::Disable:
+		{
+			const UInt64 bEnabled = Command.Type == ERenderCommand::Enable ? 1 : 0;
+			bIssue = SetState(MakeStateKey(ERenderCommand::Enable, 0, Command.Target), bEnabled);
+			EliminatedCount = &Stats.EliminatedStateChanges;
+			break;
+		}
+		case ERenderCommand::BlendFunc:
+		{
+			const UInt64 Factors = (static_cast<UInt64>(Command.Target) << 32) | Command.Object;
+			bIssue = SetState(MakeStateKey(Command.Type, 0, 0), Factors);
+			EliminatedCount = &Stats.EliminatedStateChanges;
+			break;
+		}
+		case ERenderCommand::PixelStore:
+		{
+			bIssue = SetState(MakeStateKey(Command.Type, 0, Command.Target), Command.Object);
+			EliminatedCount = &Stats.EliminatedStateChanges;
+			break;
+		}
+		case ERenderCommand::Uniform:
+		{
+			bIssue = SetUniform(Buffer, Command);
+			EliminatedCount = &Stats.EliminatedUniforms;
+			break;
+		}
+		default:
+			break;
+	}
+
+	if (bIssue)
+	{
+		++Stats.Issued;
+	}
+	else
+	{
+		F_Assert(EliminatedCount, ERenderCommand::ToString(Command.Type) << " commands are never eliminated.");
+		++*EliminatedCount;
+	}
+
+	return bIssue;
+}
+
+void FRenderStateCache::Invalidate()
+{
+	States.clear();
+}
+
+void FRenderStateCache::Reset()
+{
+	States.clear();
+	UniformValues.clear();
+}
+
+void FRenderStateCache::ResetStats()
+{
+	Stats = FRenderStateCacheStats();
+}
+
+const FRenderStateCacheStats& FRenderStateCache::GetStats() const
+{
+	return Stats;
+}
+
+bool FRenderStateCache::SetState(const UInt64 Key, const UInt64 Value)
+{
+	const auto Result = States.try_emplace(Key, Value);
+	if (Result.second)
+	{
+		return true;
+	}
+
+	UInt64& State = Result.first->second;
+	if (State == Value)
+	{
+		return false;
+	}
+
+	State = Value;
+	return true;
+}
+
+bool FRenderStateCache::FindState(const UInt64 Key, UInt64& OutValue) const
+{
+	const auto It = States.find(Key);
+	if (It == States.end())
+	{
+		return false;
+	}
+
+	OutValue = It->second;
+	return true;
+}
+
+bool FRenderStateCache::SetUniform(const FRenderCommandBuffer& Buffer, const FRenderCommand& Command)
+{
+	using namespace FRenderStateCacheInternal;
+
+	// Without a known program there's nothing to tie the value to.
+	UInt64 Program = 0;
+	if (!FindState(MakeStateKey(ERenderCommand::UseProgram, 0, 0), Program))
+	{
+		return true;
+	}
+
+	F_Assert(Command.Count <= FRenderCommandBuffer::MaxUniformWords, "Uniform has too many words.");
+	const UInt32* const Words = Buffer.GetPayload(Command);
+
+	FUniformValue& Value = UniformValues[MakeUniformKey(static_cast<UInt32>(Program), Command.Object)];
+
+	const bool bIsSame = Value.Type == Command.Target
+		&& Value.Count == Command.Count
+		&& std::equal(Words, Words + Command.Count, Value.Words.begin());
+
+	if (bIsSame)
+	{
+		return false;
+	}
+
+	Value.Type = Command.Target;
+	Value.Count = Command.Count;
+	std::copy(Words, Words + Command.Count, Value.Words.begin());
+	return true;
+}
@@ -0,0 +1,104 @@
+#ifndef PHOENIX_RENDER_STATE_CACHE_H
+#define PHOENIX_RENDER_STATE_CACHE_H
+
+#include "Utility/Containers/Array.h"
+#include "Utility/Containers/FlatHashMap.h"
+#include "Utility/Misc/Primitives.h"
+#include "Rendering/Queue/RenderCommandBuffer.h"
+
+namespace Phoenix
+{
+	struct FRenderStateCacheStats
+	{
+		/*! \brief The commands that were applied. */
+		UInt32 Commands{ 0 };
+		/*! \brief The commands that had to be issued. */
+		UInt32 Issued{ 0 };
+		/*! \brief Framebuffer, program, texture, vertex array and buffer binds that were dropped. */
+		UInt32 EliminatedBinds{ 0 };
+		UInt32 EliminatedUniforms{ 0 };
+		/*! \brief Active texture, capability, blend function and pixel store changes that were dropped. */
+		UInt32 EliminatedStateChanges{ 0 };
+
+		UInt32 GetEliminated() const;
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Shadows the state that recorded commands set, so that commands which
+	*		wouldn't change it are dropped instead of issued.
+	*
+	*	@desc Bound objects and render state are only known from the commands that
+	*		were applied since the last Invalidate, so it must be called whenever the
+	*		state may have been changed some other way, such as by asset uploads.
+	*		Uniform values belong to their programs and nothing but replays sets them,
+	*		so they're kept until Reset and a uniform is only uploaded again once its
+	*		value changes.
+	*	@note Draw buffers, uploads, vertex attributes, clears and draws are always issued.
+	*/
+	class FRenderStateCache
+	{
+	public:
+		FRenderStateCache() = default;
+
+		FRenderStateCache(const FRenderStateCache&) = delete;
+		FRenderStateCache& operator=(const FRenderStateCache&) = delete;
+
+		FRenderStateCache(FRenderStateCache&&) = default;
+		FRenderStateCache& operator=(FRenderStateCache&&) = default;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Applies a command to the shadowed state.
+		*
+		*	@param Buffer - The buffer the command was recorded in.
+		*	@param Command - The command.
+		*	@return Returns true if the command has to be issued, or false if it's redundant.
+		*/
+		bool Apply(const FRenderCommandBuffer& Buffer, const FRenderCommand& Command);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Forgets every bound object and render state, but keeps uniform values. */
+		void Invalidate();
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Forgets everything, including uniform values.
+		*
+		*	@note Must be called when programs are deleted, since their IDs may be reused.
+		*/
+		void Reset();
+
+		void ResetStats();
+
+		const FRenderStateCacheStats& GetStats() const;
+
+	protected:
+	private:
+		struct FUniformValue
+		{
+			UInt32 Type{ 0 };
+			UInt32 Count{ 0 };
+			TArray<UInt32, FRenderCommandBuffer::MaxUniformWords> Words;
+		};
+
+		typedef TFlatHashMap<UInt64, UInt64> FStates;
+		typedef TFlatHashMap<UInt64, FUniformValue> FUniformValues;
+
+		/*! \brief Bound objects and render state, keyed by command, texture unit and target. */
+		FStates States;
+		/*! \brief Keyed by program and location. */
+		FUniformValues UniformValues;
+		FRenderStateCacheStats Stats;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Sets a shadowed state.
+		*
+		*	@return Returns true if the state was unknown or had a different value.
+		*/
+		bool SetState(const UInt64 Key, const UInt64 Value);
+
+		bool FindState(const UInt64 Key, UInt64& OutValue) const;
+
+		bool SetUniform(const FRenderCommandBuffer& Buffer, const FRenderCommand& Command);
+	};
+}
+
+#endif
@@ -0,0 +1,109 @@
+#include "Stdafx.h"
+#include "Rendering/Queue/SpriteBatcher.h"
+
+#include "Utility/Debug/Assert.h"
+
+using namespace Phoenix;
+
+namespace FSpriteBatcherConstants
+{
+	/*! \brief The corners of a sprite in the same order as FMeshData::CreateQuadMesh. */
+	const FVector2D Corners[FSpriteBatcher::VerticesPerSprite] =
+	{
+		{ -1.f, -1.f }, { 1.f, -1.f }, { 1.f, 1.f },
+		{ -1.f, -1.f }, { 1.f, 1.f }, { -1.f, 1.f }
+	};
+}
+
+void FSpriteBatcher::Reserve(const SizeT SpriteCapacity)
+{
+	Vertices.reserve(SpriteCapacity * VerticesPerSprite);
+}
+
+void FSpriteBatcher::Add(const FSprite& Sprite)
+{
+	const UInt32 LocalVerticesPerSprite = VerticesPerSprite;
+	const SizeT VertexCount = Vertices.size();
+	F_Assert(VertexCount + LocalVerticesPerSprite <= TNumericLimits<UInt32>::max(), "Too many sprites.");
+
+	UInt32 Texture = Sprite.Image;
+	FVector4D TexRect = Sprite.ViewRect;
+
+	const auto Iter = AtlasRegions.find(Sprite.Image);
+	if (Iter != AtlasRegions.end())
+	{
+		const FSpriteAtlasRegion& Region = Iter->second;
+		Texture = Region.Texture;
+		TexRect = FVector4D(
+			Region.Rect.x + Sprite.ViewRect.x * Region.Rect.z,
+			Region.Rect.y + Sprite.ViewRect.y * Region.Rect.w,
+			Sprite.ViewRect.z * Region.Rect.z,
+			Sprite.ViewRect.w * Region.Rect.w);
+	}
+
+	if (Batches.empty() || Batches.back().Texture != Texture || Batches.back().Shader != Sprite.Shader)
+	{
+		Batches.push_back({ Texture, Sprite.Shader, static_cast<UInt32>(VertexCount), 0 });
+	}
+
+	Batches.back().VertexCount += LocalVerticesPerSprite;
+
+	// The sprite shrinks with its view rect so that texels keep their size on screen.
+	const FVector2D HalfSize(Sprite.HalfSize.x * Sprite.ViewRect.z, Sprite.HalfSize.y * Sprite.ViewRect.w);
+	const FVector2D TexOrigin(TexRect.x, TexRect.y);
+	const FVector2D TexSize(TexRect.z, TexRect.w);
+	const FVector2D Half(0.5f, 0.5f);
+
+	for (const FVector2D& Corner : FSpriteBatcherConstants::Corners)
+	{
+		// Flipping mirrors each sprite within its own rect, not within the whole texture.
+		const FVector2D LocalTexCoord = Corner * Half + Half;
+		const FVector2D FlippedTexCoord = (LocalTexCoord - Half) * Sprite.Flip + Half;
+
+		const FSpriteVertex Vertex = { Sprite.Position + Corner * HalfSize, TexOrigin + FlippedTexCoord * TexSize, Sprite.Color };
+		Vertices.push_back(Vertex);
+	}
+}
+
+void FSpriteBatcher::Clear()
+{
+	Batches.clear();
+	Vertices.clear();
+}
+
+void FSpriteBatcher::SetAtlasRegion(const UInt32 Image, const FSpriteAtlasRegion& Region)
+{
+	AtlasRegions[Image] = Region;
+}
+
+void FSpriteBatcher::RemoveAtlasRegion(const UInt32 Image)
+{
+	AtlasRegions.erase(Image);
+}
+
+void FSpriteBatcher::ClearAtlasRegions()
+{
+	AtlasRegions.clear();
+}
+
+UInt32 FSpriteBatcher::GetTexture(const UInt32 Image) const
+{
+	const auto Iter = AtlasRegions.find(Image);
+	const UInt32 Texture = Iter != AtlasRegions.end() ? Iter->second.Texture : Image;
+	return Texture;
+}
+
+const FSpriteBatcher::FBatches& FSpriteBatcher::GetBatches() const
+{
+	return Batches;
+}
+
+const FSpriteBatcher::FVertices& FSpriteBatcher::GetVertices() const
+{
+	return Vertices;
+}
+
+SizeT FSpriteBatcher::GetSpriteCount() const
+{
+	return Vertices.size() / VerticesPerSprite;
+}
@@ -0,0 +1,135 @@
+#ifndef PHOENIX_SPRITE_BATCHER_H
+#define PHOENIX_SPRITE_BATCHER_H
+
+#include "Utility/Containers/FlatHashMap.h"
+#include "Utility/Containers/Vector.h"
+#include "Utility/Misc/Primitives.h"
+#include "Math/Vector2D.h"
+#include "Math/Vector4D.h"
+
+namespace Phoenix
+{
+	//	--------------------------------------------------------------------------------
+	/*! \brief A vertex of a batched sprite.
+	*
+	*	@note This is uploaded to the GPU as is, so its layout must match the vertex
+	*		attributes that are declared by the Image2D vertex shader.
+	*/
+	struct FSpriteVertex
+	{
+		FVector2D Position;
+		FVector2D TexCoord;
+		FVector4D Color;
+	};
+
+	struct FSprite
+	{
+		/*! \brief The center of the sprite. */
+		FVector2D Position{ 0.f, 0.f };
+		/*! \brief Half of the sprite's width and height when its view rect is the whole image. */
+		FVector2D HalfSize{ 1.f, 1.f };
+		FVector4D Color{ 1.f, 1.f, 1.f, 1.f };
+		/*! \brief A negative component mirrors the sprite's texture coordinates on that axis. */
+		FVector2D Flip{ 1.f, 1.f };
+		/*! \brief The part of the image that's shown, as (X, Y, Width, Height) in texture coordinates. */
+		FVector4D ViewRect{ 0.f, 0.f, 1.f, 1.f };
+		/*! \brief The ID of the sprite's image. */
+		UInt32 Image{ 0 };
+		/*! \brief The ID of the program that draws the sprite. */
+		UInt32 Shader{ 0 };
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Where an image was packed in an atlas. */
+	struct FSpriteAtlasRegion
+	{
+		/*! \brief The ID of the atlas texture. */
+		UInt32 Texture{ 0 };
+		/*! \brief The image's rectangle in the atlas, as (X, Y, Width, Height) in texture coordinates. */
+		FVector4D Rect{ 0.f, 0.f, 1.f, 1.f };
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief A run of sprites that can be drawn with a single draw call. */
+	struct FSpriteBatch
+	{
+		/*! \brief The ID of the texture that every sprite in the batch samples. */
+		UInt32 Texture;
+		UInt32 Shader;
+		UInt32 FirstVertex;
+		UInt32 VertexCount;
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Writes sprites into one vertex array and splits it into as few draws as possible.
+	*
+	*	@desc Sprites are added in draw order, and each one that has the same texture and
+	*		shader as the one before it joins that sprite's batch.  Since a batch's
+	*		vertices are drawn in order, a change in layer doesn't need a new batch.
+	*		Images that are registered as atlas regions are drawn with their atlas'
+	*		texture, so sprites from the same atlas share a batch.
+	*	@note Sprites should be sorted by layer and then texture first, which is what
+	*		FRenderQueue's transparent keys do if they're given GetTexture's result.
+	*/
+	class FSpriteBatcher
+	{
+	public:
+		typedef TVector<FSpriteBatch> FBatches;
+		typedef TVector<FSpriteVertex> FVertices;
+
+		static const UInt32 VerticesPerSprite = 6;
+
+		FSpriteBatcher() = default;
+
+		FSpriteBatcher(const FSpriteBatcher&) = delete;
+		FSpriteBatcher& operator=(const FSpriteBatcher&) = delete;
+
+		FSpriteBatcher(FSpriteBatcher&&) = default;
+		FSpriteBatcher& operator=(FSpriteBatcher&&) = default;
+
+		void Reserve(const SizeT SpriteCapacity);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Writes a sprite's vertices, starting a new batch if its texture or shader differs. */
+		void Add(const FSprite& Sprite);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Clears the batches and vertices.  Atlas regions are kept. */
+		void Clear();
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Makes an image draw from a region of an atlas texture instead of its own texture.
+		*
+		*	@param Image - The ID of the image that was packed.
+		*	@param Region - Where the image was packed.
+		*/
+		void SetAtlasRegion(const UInt32 Image, const FSpriteAtlasRegion& Region);
+
+		void RemoveAtlasRegion(const UInt32 Image);
+
+		void ClearAtlasRegions();
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the ID of the texture an image is drawn with.
+		*
+		*	@return Returns the atlas' texture if the image is in one, otherwise the image itself.
+		*/
+		UInt32 GetTexture(const UInt32 Image) const;
+
+		const FBatches& GetBatches() const;
+
+		const FVertices& GetVertices() const;
+
+		SizeT GetSpriteCount() const;
+
+	protected:
+	private:
+		typedef TFlatHashMap<UInt32, FSpriteAtlasRegion> FAtlasRegions;
+
+		FBatches Batches;
+		FVertices Vertices;
+		FAtlasRegions AtlasRegions;
+	};
+}
+
+#endif
@@ -104,6 +104,11 @@ void FShader::Disable()
 	F_GL(GL::UseProgram(0));
 }
 
+GL::ProgramT FShader::GetProgram() const
+{
+	return Program;
+}
+
 GL::LocationT FShader::GetUniform(const GLchar* const Name) const
 {
 	F_Assert(Name, "UniformName is null.");
@@ -107,6 +107,8 @@ namespace Phoenix
 
 		void Disable();
 
+		GL::ProgramT GetProgram() const;
+
 		GL::LocationT GetUniform(const GLchar* const Name) const;
 
 		void SetUniform(const GLint Integer, const GLchar* const Name);
@@ -1,7 +1,7 @@
 #ifndef PHOENIX_FONT_H
 #define PHOENIX_FONT_H
 
-#include "Utility/Containers/UnorderedMap.h"
+#include "Utility/Containers/FlatHashMap.h"
 #include "Utility/Containers/Vector.h"
 #include "Utility/Misc/Memory.h"
 #include "Utility/Misc/Primitives.h"
@@ -110,11 +110,11 @@ namespace Phoenix
 		struct FEntry
 		{
 			TVector<FImage> Atlases;
-			TUnorderedMap<UInt64, FFontChar> Chars;
+			TFlatHashMap<UInt64, FFontChar> Chars;
 		};
 
 		FT_FaceRec_* FTFace{ nullptr };
-		TUnorderedMap<FontPixelSizeT, FEntry> Entries;
+		TFlatHashMap<FontPixelSizeT, FEntry> Entries;
 
 		void PostMoveReset();
 	};
@@ -51,3 +51,24 @@ void FGFXTaskReceiver::RetrieveTasks(FTasks& Tasks)
 	Tasks = std::move(NextTaskSet);
 	TasksQueue.pop();
 }
+
+void FGFXTaskReceiver::RunNextTask(FTasks& Tasks)
+{
+	if (Tasks.empty())
+	{
+		RetrieveTasks(Tasks);
+	}
+
+	if (Tasks.empty())
+	{
+		return;
+	}
+
+	FTask Task = std::move(Tasks.back());
+	Tasks.pop_back();
+
+	if (!Task())
+	{
+		F_LogError("Task failed.");
+	}
+}
@@ -11,7 +11,7 @@ namespace Phoenix
 	class FGFXTaskReceiver
 	{
 	public:
-		typedef TFunction<bool()> FTask;
+		typedef TInlineFunction<bool()> FTask;
 		typedef TVector<FTask> FTasks;
 
 		FGFXTaskReceiver() = default;
@@ -33,6 +33,15 @@ namespace Phoenix
 		void ReceiveTasks(FTasks&& Tasks);
 
 		void RetrieveTasks(FTasks& Tasks);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Runs the last task in Tasks, retrieving the next set first if Tasks is empty.
+		*
+		*	@note A task that fails is removed like any other.  Each task reports its own
+		*		asset's result, so the rest of its set must still run or their requests
+		*		would never complete.
+		*/
+		void RunNextTask(FTasks& Tasks);
 		
 	private:
 		typedef TQueue<FTasks> FTasksQueue;
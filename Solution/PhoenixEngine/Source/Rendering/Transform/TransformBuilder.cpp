@@ -0,0 +1,432 @@
+#include "Stdafx.h"
+#include "Rendering/Transform/TransformBuilder.h"
+
+#include <algorithm>
+
+#if defined(__AVX__)
+#	define PHOENIX_TRANSFORM_BUILDER_AVX 1
+#	define PHOENIX_TRANSFORM_BUILDER_SSE 0
+#	include <immintrin.h>
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#	define PHOENIX_TRANSFORM_BUILDER_AVX 0
+#	define PHOENIX_TRANSFORM_BUILDER_SSE 1
+#	include <xmmintrin.h>
+#else
+#	define PHOENIX_TRANSFORM_BUILDER_AVX 0
+#	define PHOENIX_TRANSFORM_BUILDER_SSE 0
+#endif
+
+#include "Utility/Debug/Assert.h"
+#include "Utility/Misc/Memory.h"
+#include "Utility/Threading/AsyncTaskHandler.h"
+#include "Utility/Threading/Atomic.h"
+#include "Utility/Threading/Thread.h"
+#include "Math/Vector4D.h"
+
+using namespace Phoenix;
+
+namespace FTransformBuilderInternal
+{
+	//	--------------------------------------------------------------------------------
+	/*! \brief The state that is shared between the threads taking part in one build.
+	*
+	*	@note Tasks that start after every chunk has been claimed only touch the
+	*		counters, which is why this is kept alive by the tasks rather than by Build.
+	*/
+	struct FTransformJob
+	{
+		const FMatrix4D* ViewProjection{ nullptr };
+		const FTransforms* Transforms{ nullptr };
+		FMatrix4D* OutWorld{ nullptr };
+		FMatrix4D* OutWVP{ nullptr };
+		SizeT Count{ 0 };
+		SizeT ChunkSize{ 0 };
+		SizeT ChunkCount{ 0 };
+		TAtomic<SizeT> NextChunk{ 0 };
+		TAtomic<SizeT> CompletedChunks{ 0 };
+
+		void Run()
+		{
+			for (;;)
+			{
+				const SizeT Chunk = NextChunk.fetch_add(1, std::memory_order_relaxed);
+				if (Chunk >= ChunkCount)
+				{
+					return;
+				}
+
+				const SizeT Begin = Chunk * ChunkSize;
+				const SizeT End = std::min(Begin + ChunkSize, Count);
+
+				FTransformBuilder::BuildRange(*ViewProjection, *Transforms, Begin, End, OutWorld, OutWVP);
+
+				CompletedChunks.fetch_add(1, std::memory_order_release);
+			}
+		}
+	};
+
+	void BuildRangeScalar(
+		const FMatrix4D& ViewProjection,
+		const FTransforms& Transforms,
+		const SizeT Begin,
+		const SizeT End,
+		FMatrix4D* const OutWorld,
+		FMatrix4D* const OutWVP)
+	{
+		for (SizeT I = Begin; I < End; ++I)
+		{
+			const Float32 X = Transforms.RotationX[I];
+			const Float32 Y = Transforms.RotationY[I];
+			const Float32 Z = Transforms.RotationZ[I];
+			const Float32 W = Transforms.RotationW[I];
+
+			const Float32 XX = X * X * 2.f;
+			const Float32 YY = Y * Y * 2.f;
+			const Float32 ZZ = Z * Z * 2.f;
+			const Float32 XY = X * Y * 2.f;
+			const Float32 XZ = X * Z * 2.f;
+			const Float32 YZ = Y * Z * 2.f;
+			const Float32 WX = W * X * 2.f;
+			const Float32 WY = W * Y * 2.f;
+			const Float32 WZ = W * Z * 2.f;
+
+			const Float32 SX = Transforms.ScaleX[I];
+			const Float32 SY = Transforms.ScaleY[I];
+			const Float32 SZ = Transforms.ScaleZ[I];
+
+			FMatrix4D World;
+			World[0] = FVector4D((1.f - (YY + ZZ)) * SX, (XY + WZ) * SX, (XZ - WY) * SX, 0.f);
+			World[1] = FVector4D((XY - WZ) * SY, (1.f - (XX + ZZ)) * SY, (YZ + WX) * SY, 0.f);
+			World[2] = FVector4D((XZ + WY) * SZ, (YZ - WX) * SZ, (1.f - (XX + YY)) * SZ, 0.f);
+			World[3] = FVector4D(Transforms.PositionX[I], Transforms.PositionY[I], Transforms.PositionZ[I], 1.f);
+
+			if (OutWorld)
+			{
+				OutWorld[I] = World;
+			}
+
+			if (OutWVP)
+			{
+				OutWVP[I] = ViewProjection * World;
+			}
+		}
+	}
+
+#if PHOENIX_TRANSFORM_BUILDER_AVX
+	//	--------------------------------------------------------------------------------
+	/*! \brief Writes column Column of the 8 matrices starting at Out[I].
+	*
+	*	@param R0 - Row 0 of the column, one lane per matrix.  Likewise for R1 to R3.
+	*/
+	void StoreColumn(
+		FMatrix4D* const Out,
+		const SizeT I,
+		const SizeT Column,
+		const __m256 R0,
+		const __m256 R1,
+		const __m256 R2,
+		const __m256 R3)
+	{
+		const __m256 T0 = _mm256_unpacklo_ps(R0, R1);
+		const __m256 T1 = _mm256_unpackhi_ps(R0, R1);
+		const __m256 T2 = _mm256_unpacklo_ps(R2, R3);
+		const __m256 T3 = _mm256_unpackhi_ps(R2, R3);
+
+		// Each holds the columns of lanes N and N + 4 in its low and high halves.
+		const __m256 C0 = _mm256_shuffle_ps(T0, T2, _MM_SHUFFLE(1, 0, 1, 0));
+		const __m256 C1 = _mm256_shuffle_ps(T0, T2, _MM_SHUFFLE(3, 2, 3, 2));
+		const __m256 C2 = _mm256_shuffle_ps(T1, T3, _MM_SHUFFLE(1, 0, 1, 0));
+		const __m256 C3 = _mm256_shuffle_ps(T1, T3, _MM_SHUFFLE(3, 2, 3, 2));
+
+		_mm_storeu_ps(&Out[I + 0][Column][0], _mm256_castps256_ps128(C0));
+		_mm_storeu_ps(&Out[I + 1][Column][0], _mm256_castps256_ps128(C1));
+		_mm_storeu_ps(&Out[I + 2][Column][0], _mm256_castps256_ps128(C2));
+		_mm_storeu_ps(&Out[I + 3][Column][0], _mm256_castps256_ps128(C3));
+		_mm_storeu_ps(&Out[I + 4][Column][0], _mm256_extractf128_ps(C0, 1));
+		_mm_storeu_ps(&Out[I + 5][Column][0], _mm256_extractf128_ps(C1, 1));
+		_mm_storeu_ps(&Out[I + 6][Column][0], _mm256_extractf128_ps(C2, 1));
+		_mm_storeu_ps(&Out[I + 7][Column][0], _mm256_extractf128_ps(C3, 1));
+	}
+#elif PHOENIX_TRANSFORM_BUILDER_SSE
+	//	--------------------------------------------------------------------------------
+	/*! \brief Writes column Column of the 4 matrices starting at Out[I].
+	*
+	*	@param R0 - Row 0 of the column, one lane per matrix.  Likewise for R1 to R3.
+	*/
+	void StoreColumn(
+		FMatrix4D* const Out,
+		const SizeT I,
+		const SizeT Column,
+		const __m128 R0,
+		const __m128 R1,
+		const __m128 R2,
+		const __m128 R3)
+	{
+		const __m128 T0 = _mm_unpacklo_ps(R0, R1);
+		const __m128 T1 = _mm_unpackhi_ps(R0, R1);
+		const __m128 T2 = _mm_unpacklo_ps(R2, R3);
+		const __m128 T3 = _mm_unpackhi_ps(R2, R3);
+
+		_mm_storeu_ps(&Out[I + 0][Column][0], _mm_movelh_ps(T0, T2));
+		_mm_storeu_ps(&Out[I + 1][Column][0], _mm_movehl_ps(T2, T0));
+		_mm_storeu_ps(&Out[I + 2][Column][0], _mm_movelh_ps(T1, T3));
+		_mm_storeu_ps(&Out[I + 3][Column][0], _mm_movehl_ps(T3, T1));
+	}
+#endif
+}
+
+void FTransforms::Reserve(const SizeT Capacity)
+{
+	PositionX.reserve(Capacity);
+	PositionY.reserve(Capacity);
+	PositionZ.reserve(Capacity);
+	RotationX.reserve(Capacity);
+	RotationY.reserve(Capacity);
+	RotationZ.reserve(Capacity);
+	RotationW.reserve(Capacity);
+	ScaleX.reserve(Capacity);
+	ScaleY.reserve(Capacity);
+	ScaleZ.reserve(Capacity);
+}
+
+void FTransforms::Add(const FVector3D& Position, const FQuaternion& Rotation, const FVector3D& Scale)
+{
+	PositionX.push_back(Position.x);
+	PositionY.push_back(Position.y);
+	PositionZ.push_back(Position.z);
+	RotationX.push_back(Rotation.x);
+	RotationY.push_back(Rotation.y);
+	RotationZ.push_back(Rotation.z);
+	RotationW.push_back(Rotation.w);
+	ScaleX.push_back(Scale.x);
+	ScaleY.push_back(Scale.y);
+	ScaleZ.push_back(Scale.z);
+}
+
+void FTransforms::Clear()
+{
+	PositionX.clear();
+	PositionY.clear();
+	PositionZ.clear();
+	RotationX.clear();
+	RotationY.clear();
+	RotationZ.clear();
+	RotationW.clear();
+	ScaleX.clear();
+	ScaleY.clear();
+	ScaleZ.clear();
+}
+
+SizeT FTransforms::GetSize() const
+{
+	return PositionX.size();
+}
+
+void FTransformBuilder::Build(
+	const FMatrix4D& ViewProjection,
+	const FTransforms& Transforms,
+	FMatrix4D* const OutWorld,
+	FMatrix4D* const OutWVP,
+	FAsyncTaskHandler* const TaskHandler)
+{
+	using namespace FTransformBuilderInternal;
+
+	const SizeT Count = Transforms.GetSize();
+	const SizeT LocalChunkSize = ChunkSize;
+	const SizeT ChunkCount = (Count + LocalChunkSize - 1) / LocalChunkSize;
+
+	// Helpers beyond the spare hardware threads would only time slice with the calling thread.
+	const SizeT HardwareThreadCount = NThread::GetHardwareThreadCount();
+	const SizeT SpareThreadCount = HardwareThreadCount > 1 ? HardwareThreadCount - 1 : 0;
+
+	const bool bShouldRunInParallel = Count >= MinParallelCount
+		&& ChunkCount > 1
+		&& SpareThreadCount > 0
+		&& TaskHandler
+		&& TaskHandler->IsValid();
+
+	const SizeT HelperCount = bShouldRunInParallel
+		? std::min({ TaskHandler->GetThreadCount(), SpareThreadCount, ChunkCount - 1 })
+		: 0;
+
+	Stats.Built = Count;
+
+	if (HelperCount == 0)
+	{
+		Stats.Chunks = std::min<SizeT>(ChunkCount, 1);
+		Stats.Threads = 1;
+
+		BuildRange(ViewProjection, Transforms, 0, Count, OutWorld, OutWVP);
+		return;
+	}
+
+	Stats.Chunks = ChunkCount;
+	Stats.Threads = HelperCount + 1;
+
+	TSharedPtr<FTransformJob> Job = std::make_shared<FTransformJob>();
+	Job->ViewProjection = &ViewProjection;
+	Job->Transforms = &Transforms;
+	Job->OutWorld = OutWorld;
+	Job->OutWVP = OutWVP;
+	Job->Count = Count;
+	Job->ChunkSize = LocalChunkSize;
+	Job->ChunkCount = ChunkCount;
+
+	FAsyncTasks Tasks;
+	Tasks.reserve(HelperCount);
+
+	for (SizeT I = 0; I < HelperCount; ++I)
+	{
+		Tasks.emplace_back([Job]()
+		{
+			Job->Run();
+		});
+	}
+
+	TaskHandler->AddAsyncTasks(std::move(Tasks));
+
+	Job->Run();
+
+	while (Job->CompletedChunks.load(std::memory_order_acquire) < ChunkCount)
+	{
+		NThread::YieldThread();
+	}
+}
+
+void FTransformBuilder::BuildRange(
+	const FMatrix4D& ViewProjection,
+	const FTransforms& Transforms,
+	const SizeT Begin,
+	const SizeT End,
+	FMatrix4D* const OutWorld,
+	FMatrix4D* const OutWVP)
+{
+	F_Assert(Begin <= End && End <= Transforms.GetSize(), "Invalid range [" << Begin << ", " << End << ")");
+
+	SizeT I = Begin;
+
+#if PHOENIX_TRANSFORM_BUILDER_AVX || PHOENIX_TRANSFORM_BUILDER_SSE
+#	if PHOENIX_TRANSFORM_BUILDER_AVX
+	typedef __m256 FloatsT;
+	const SizeT Width = 8;
+#		define F_TransformLoad _mm256_loadu_ps
+#		define F_TransformSet1 _mm256_set1_ps
+#		define F_TransformAdd _mm256_add_ps
+#		define F_TransformMul _mm256_mul_ps
+#		define F_TransformSub _mm256_sub_ps
+#	else
+	typedef __m128 FloatsT;
+	const SizeT Width = 4;
+#		define F_TransformLoad _mm_loadu_ps
+#		define F_TransformSet1 _mm_set1_ps
+#		define F_TransformAdd _mm_add_ps
+#		define F_TransformMul _mm_mul_ps
+#		define F_TransformSub _mm_sub_ps
+#	endif
+
+	// ViewProjection's elements, broadcast, by [Column][Row].
+	FloatsT VP[4][4];
+	for (SizeT Column = 0; Column < 4; ++Column)
+	{
+		for (SizeT Row = 0; Row < 4; ++Row)
+		{
+			VP[Column][Row] = F_TransformSet1(ViewProjection[Column][Row]);
+		}
+	}
+
+	const FloatsT Zero = F_TransformSet1(0.f);
+	const FloatsT One = F_TransformSet1(1.f);
+	const FloatsT Two = F_TransformSet1(2.f);
+
+	for (; I + Width <= End; I += Width)
+	{
+		const FloatsT X = F_TransformLoad(&Transforms.RotationX[I]);
+		const FloatsT Y = F_TransformLoad(&Transforms.RotationY[I]);
+		const FloatsT Z = F_TransformLoad(&Transforms.RotationZ[I]);
+		const FloatsT W = F_TransformLoad(&Transforms.RotationW[I]);
+
+		const FloatsT X2 = F_TransformMul(X, Two);
+		const FloatsT Y2 = F_TransformMul(Y, Two);
+		const FloatsT Z2 = F_TransformMul(Z, Two);
+
+		const FloatsT XX = F_TransformMul(X, X2);
+		const FloatsT YY = F_TransformMul(Y, Y2);
+		const FloatsT ZZ = F_TransformMul(Z, Z2);
+		const FloatsT XY = F_TransformMul(X, Y2);
+		const FloatsT XZ = F_TransformMul(X, Z2);
+		const FloatsT YZ = F_TransformMul(Y, Z2);
+		const FloatsT WX = F_TransformMul(W, X2);
+		const FloatsT WY = F_TransformMul(W, Y2);
+		const FloatsT WZ = F_TransformMul(W, Z2);
+
+		const FloatsT SX = F_TransformLoad(&Transforms.ScaleX[I]);
+		const FloatsT SY = F_TransformLoad(&Transforms.ScaleY[I]);
+		const FloatsT SZ = F_TransformLoad(&Transforms.ScaleZ[I]);
+
+		// The world matrices' elements by [Column][Row].  Row 3 is 0 0 0 1.
+		FloatsT World[4][3];
+		World[0][0] = F_TransformMul(F_TransformSub(One, F_TransformAdd(YY, ZZ)), SX);
+		World[0][1] = F_TransformMul(F_TransformAdd(XY, WZ), SX);
+		World[0][2] = F_TransformMul(F_TransformSub(XZ, WY), SX);
+		World[1][0] = F_TransformMul(F_TransformSub(XY, WZ), SY);
+		World[1][1] = F_TransformMul(F_TransformSub(One, F_TransformAdd(XX, ZZ)), SY);
+		World[1][2] = F_TransformMul(F_TransformAdd(YZ, WX), SY);
+		World[2][0] = F_TransformMul(F_TransformAdd(XZ, WY), SZ);
+		World[2][1] = F_TransformMul(F_TransformSub(YZ, WX), SZ);
+		World[2][2] = F_TransformMul(F_TransformSub(One, F_TransformAdd(XX, YY)), SZ);
+		World[3][0] = F_TransformLoad(&Transforms.PositionX[I]);
+		World[3][1] = F_TransformLoad(&Transforms.PositionY[I]);
+		World[3][2] = F_TransformLoad(&Transforms.PositionZ[I]);
+
+		if (OutWorld)
+		{
+			for (SizeT Column = 0; Column < 4; ++Column)
+			{
+				FTransformBuilderInternal::StoreColumn(
+					OutWorld, I, Column,
+					World[Column][0], World[Column][1], World[Column][2], Column == 3 ? One : Zero);
+			}
+		}
+
+		if (OutWVP)
+		{
+			for (SizeT Column = 0; Column < 4; ++Column)
+			{
+				FloatsT WVP[4];
+				for (SizeT Row = 0; Row < 4; ++Row)
+				{
+					FloatsT Sum = F_TransformMul(VP[0][Row], World[Column][0]);
+					Sum = F_TransformAdd(Sum, F_TransformMul(VP[1][Row], World[Column][1]));
+					Sum = F_TransformAdd(Sum, F_TransformMul(VP[2][Row], World[Column][2]));
+					WVP[Row] = Column == 3 ? F_TransformAdd(Sum, VP[3][Row]) : Sum;
+				}
+
+				FTransformBuilderInternal::StoreColumn(OutWVP, I, Column, WVP[0], WVP[1], WVP[2], WVP[3]);
+			}
+		}
+	}
+
+#	undef F_TransformLoad
+#	undef F_TransformSet1
+#	undef F_TransformAdd
+#	undef F_TransformMul
+#	undef F_TransformSub
+#endif
+
+	FTransformBuilderInternal::BuildRangeScalar(ViewProjection, Transforms, I, End, OutWorld, OutWVP);
+}
+
+void FTransformBuilder::SetMinParallelCount(const SizeT Count)
+{
+	MinParallelCount = Count;
+}
+
+SizeT FTransformBuilder::GetMinParallelCount() const
+{
+	return MinParallelCount;
+}
+
+const FTransformBuilderStats& FTransformBuilder::GetStats() const
+{
+	return Stats;
+}
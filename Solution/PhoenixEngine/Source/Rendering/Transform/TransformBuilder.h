@@ -0,0 +1,138 @@
+#ifndef PHOENIX_TRANSFORM_BUILDER_H
+#define PHOENIX_TRANSFORM_BUILDER_H
+
+#include "Utility/Containers/Vector.h"
+#include "Utility/Misc/Primitives.h"
+#include "Math/Matrix4D.h"
+#include "Math/Quaternion.h"
+#include "Math/Vector3D.h"
+
+namespace Phoenix
+{
+	class FAsyncTaskHandler;
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Positions, rotations and scales, stored as a structure of arrays.
+	*
+	*	@desc Keeping each component in its own array lets the builder load the same
+	*		component of several transforms at once with plain vector loads.
+	*/
+	struct FTransforms
+	{
+		TVector<Float32> PositionX;
+		TVector<Float32> PositionY;
+		TVector<Float32> PositionZ;
+		TVector<Float32> RotationX;
+		TVector<Float32> RotationY;
+		TVector<Float32> RotationZ;
+		TVector<Float32> RotationW;
+		TVector<Float32> ScaleX;
+		TVector<Float32> ScaleY;
+		TVector<Float32> ScaleZ;
+
+		void Reserve(const SizeT Capacity);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Adds a transform.
+		*
+		*	@note Rotation is expected to be normalized.
+		*/
+		void Add(const FVector3D& Position, const FQuaternion& Rotation, const FVector3D& Scale);
+
+		void Clear();
+
+		SizeT GetSize() const;
+	};
+
+	struct FTransformBuilderStats
+	{
+		SizeT Built{ 0 };
+		/*! \brief The number of chunks the transforms were split into for the last build. */
+		SizeT Chunks{ 0 };
+		/*! \brief The number of threads, including the calling thread, that took part in the last build. */
+		SizeT Threads{ 0 };
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Turns transforms into world and world view projection matrices.
+	*
+	*	@desc Each world matrix is translation * rotation * scale.  Transforms are built
+	*		8 at a time with AVX or 4 at a time with SSE, with a scalar fallback, and
+	*		written straight into column major matrices.  Large inputs are split into
+	*		chunks that the calling thread and the task handler's threads claim from a
+	*		shared counter, the same way FFrustumCuller splits its spheres.
+	*
+	*	@note Waking the task handler's threads only pays for itself on large inputs, and
+	*		never when there are no spare hardware threads for them to run on.
+	*/
+	class FTransformBuilder
+	{
+	public:
+		static const SizeT ChunkSize = 4096;
+
+		/*! \brief Inputs with fewer transforms than this are built on the calling thread.
+		*
+		*	@note This is a conservative default rather than a measured crossover. The rendering
+		*		tests' transform benchmark logs where parallel builds start to win on the
+		*		machine running them, so tune it with SetMinParallelCount from that.
+		*/
+		static const SizeT DefaultMinParallelCount = 32768;
+
+		FTransformBuilder() = default;
+
+		FTransformBuilder(const FTransformBuilder&) = delete;
+		FTransformBuilder& operator=(const FTransformBuilder&) = delete;
+
+		FTransformBuilder(FTransformBuilder&&) = default;
+		FTransformBuilder& operator=(FTransformBuilder&&) = default;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Builds the matrices of every transform.
+		*
+		*	@param ViewProjection - Multiplied with each world matrix to make its WVP matrix.
+		*	@param Transforms - The transforms to build.
+		*	@param OutWorld - Optional.  Must have room for one matrix per transform.
+		*	@param OutWVP - Optional.  Must have room for one matrix per transform.
+		*	@param TaskHandler - Optional.  Its threads help with inputs of at least
+		*		GetMinParallelCount transforms, one per spare hardware thread.
+		*/
+		void Build(
+			const FMatrix4D& ViewProjection,
+			const FTransforms& Transforms,
+			FMatrix4D* const OutWorld,
+			FMatrix4D* const OutWVP,
+			FAsyncTaskHandler* const TaskHandler = nullptr);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Builds the matrices of the transforms in [Begin, End) on the calling thread.
+		*
+		*	@param OutWorld - Optional.  Matrix I is written to OutWorld[I].
+		*	@param OutWVP - Optional.  Matrix I is written to OutWVP[I].
+		*/
+		static void BuildRange(
+			const FMatrix4D& ViewProjection,
+			const FTransforms& Transforms,
+			const SizeT Begin,
+			const SizeT End,
+			FMatrix4D* const OutWorld,
+			FMatrix4D* const OutWVP);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Sets how many transforms an input needs before Build uses the task handler.
+		*
+		*	@note The default is DefaultMinParallelCount.
+		*/
+		void SetMinParallelCount(const SizeT Count);
+
+		SizeT GetMinParallelCount() const;
+
+		const FTransformBuilderStats& GetStats() const;
+
+	protected:
+	private:
+		FTransformBuilderStats Stats;
+		SizeT MinParallelCount{ DefaultMinParallelCount };
+	};
+}
+
+#endif
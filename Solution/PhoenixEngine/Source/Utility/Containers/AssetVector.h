@@ -0,0 +1,14 @@
+#ifndef PHOENIX_ASSET_VECTOR_H
+#define PHOENIX_ASSET_VECTOR_H
+
+#include "Utility/Containers/Vector.h"
+#include "Utility/Misc/Allocator.h"
+
+namespace Phoenix
+{
+	//! Vector for bulk asset data that lives on the asset heap.  See FTLSFHeap::GetAssetHeap.
+	template <class T>
+	using TAssetVector = TVector<T, TAssetAlloc<T>>;
+}
+
+#endif
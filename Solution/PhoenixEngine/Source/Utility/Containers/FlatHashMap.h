@@ -0,0 +1,158 @@
+#ifndef PHOENIX_FLAT_HASH_MAP_H
+#define PHOENIX_FLAT_HASH_MAP_H
+
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#include "Utility/Containers/FlatHashTable.h"
+#include "Utility/Debug/Assert.h"
+
+namespace Phoenix
+{
+	//	--------------------------------------------------------------------------------
+	/*! \brief A flat hash map with the interface of TUnorderedMap.
+	*
+	*	@desc See TFlatHashTable.  Prefer this over TUnorderedMap unless something needs
+	*		pointers to elements to survive later inserts.
+	*/
+	template <class Key, class Value, class THash = std::hash<Key>, class TKeyEqual = std::equal_to<Key>,
+		class TAllocator = std::allocator<std::pair<const Key, Value>>>
+	class TFlatHashMap : public TFlatHashTable<TFlatHashMapPolicy<Key, Value>, THash, TKeyEqual, TAllocator>
+	{
+		typedef TFlatHashTable<TFlatHashMapPolicy<Key, Value>, THash, TKeyEqual, TAllocator> BaseT;
+
+	public:
+		typedef Value mapped_type;
+		typedef typename BaseT::iterator iterator;
+		typedef typename BaseT::const_iterator const_iterator;
+
+		template <class K>
+		using TKeyArg = typename BaseT::template TKeyArg<K>;
+
+		using BaseT::BaseT;
+
+		TFlatHashMap() = default;
+
+		Value& operator[](const Key& InKey);
+
+		Value& operator[](Key&& InKey);
+
+		template <class K = Key>
+		Value& at(const TKeyArg<K>& InKey);
+
+		template <class K = Key>
+		const Value& at(const TKeyArg<K>& InKey) const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Constructs a value from Args only if InKey isn't already in the map. */
+		template <class... TArgs>
+		std::pair<iterator, bool> try_emplace(const Key& InKey, TArgs&&... Args);
+
+		template <class... TArgs>
+		std::pair<iterator, bool> try_emplace(Key&& InKey, TArgs&&... Args);
+
+		template <class TValue>
+		std::pair<iterator, bool> insert_or_assign(const Key& InKey, TValue&& InValue);
+
+		template <class TValue>
+		std::pair<iterator, bool> insert_or_assign(Key&& InKey, TValue&& InValue);
+
+		using BaseT::insert;
+	};
+
+	template <class Key, class Value, class THash, class TKeyEqual, class TAllocator>
+	Value& TFlatHashMap<Key, Value, THash, TKeyEqual, TAllocator>::operator[](const Key& InKey)
+	{
+		Value& Result = try_emplace(InKey).first->second;
+		return Result;
+	}
+
+	template <class Key, class Value, class THash, class TKeyEqual, class TAllocator>
+	Value& TFlatHashMap<Key, Value, THash, TKeyEqual, TAllocator>::operator[](Key&& InKey)
+	{
+		Value& Result = try_emplace(std::move(InKey)).first->second;
+		return Result;
+	}
+
+	template <class Key, class Value, class THash, class TKeyEqual, class TAllocator>
+	template <class K>
+	Value& TFlatHashMap<Key, Value, THash, TKeyEqual, TAllocator>::at(const TKeyArg<K>& InKey)
+	{
+		const iterator It = this->template find<K>(InKey);
+		F_Assert(It != this->end(), "Key is not in the map.");
+
+		return It->second;
+	}
+
+	template <class Key, class Value, class THash, class TKeyEqual, class TAllocator>
+	template <class K>
+	const Value& TFlatHashMap<Key, Value, THash, TKeyEqual, TAllocator>::at(const TKeyArg<K>& InKey) const
+	{
+		const const_iterator It = this->template find<K>(InKey);
+		F_Assert(It != this->end(), "Key is not in the map.");
+
+		return It->second;
+	}
+
+	template <class Key, class Value, class THash, class TKeyEqual, class TAllocator>
+	template <class... TArgs>
+	std::pair<typename TFlatHashMap<Key, Value, THash, TKeyEqual, TAllocator>::iterator, bool>
+		TFlatHashMap<Key, Value, THash, TKeyEqual, TAllocator>::try_emplace(const Key& InKey, TArgs&&... Args)
+	{
+		const std::pair<SizeT, bool> Result = this->FindOrPrepareInsert(InKey);
+		if (!Result.second)
+		{
+			this->ConstructAt(Result.first, std::piecewise_construct,
+				std::forward_as_tuple(InKey), std::forward_as_tuple(std::forward<TArgs>(Args)...));
+		}
+
+		return std::make_pair(this->MakeIterator(Result.first), !Result.second);
+	}
+
+	template <class Key, class Value, class THash, class TKeyEqual, class TAllocator>
+	template <class... TArgs>
+	std::pair<typename TFlatHashMap<Key, Value, THash, TKeyEqual, TAllocator>::iterator, bool>
+		TFlatHashMap<Key, Value, THash, TKeyEqual, TAllocator>::try_emplace(Key&& InKey, TArgs&&... Args)
+	{
+		const std::pair<SizeT, bool> Result = this->FindOrPrepareInsert(InKey);
+		if (!Result.second)
+		{
+			this->ConstructAt(Result.first, std::piecewise_construct,
+				std::forward_as_tuple(std::move(InKey)), std::forward_as_tuple(std::forward<TArgs>(Args)...));
+		}
+
+		return std::make_pair(this->MakeIterator(Result.first), !Result.second);
+	}
+
+	template <class Key, class Value, class THash, class TKeyEqual, class TAllocator>
+	template <class TValue>
+	std::pair<typename TFlatHashMap<Key, Value, THash, TKeyEqual, TAllocator>::iterator, bool>
+		TFlatHashMap<Key, Value, THash, TKeyEqual, TAllocator>::insert_or_assign(const Key& InKey, TValue&& InValue)
+	{
+		std::pair<iterator, bool> Result = try_emplace(InKey, std::forward<TValue>(InValue));
+		if (!Result.second)
+		{
+			Result.first->second = std::forward<TValue>(InValue);
+		}
+
+		return Result;
+	}
+
+	template <class Key, class Value, class THash, class TKeyEqual, class TAllocator>
+	template <class TValue>
+	std::pair<typename TFlatHashMap<Key, Value, THash, TKeyEqual, TAllocator>::iterator, bool>
+		TFlatHashMap<Key, Value, THash, TKeyEqual, TAllocator>::insert_or_assign(Key&& InKey, TValue&& InValue)
+	{
+		std::pair<iterator, bool> Result = try_emplace(std::move(InKey), std::forward<TValue>(InValue));
+		if (!Result.second)
+		{
+			Result.first->second = std::forward<TValue>(InValue);
+		}
+
+		return Result;
+	}
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef PHOENIX_FLAT_HASH_SET_H
+#define PHOENIX_FLAT_HASH_SET_H
+
+#include <functional>
+#include <memory>
+
+#include "Utility/Containers/FlatHashTable.h"
+
+namespace Phoenix
+{
+	//	--------------------------------------------------------------------------------
+	/*! \brief A flat hash set with the interface of TUnorderedSet.
+	*
+	*	@desc See TFlatHashTable.  Prefer this over TUnorderedSet unless something needs
+	*		pointers to elements to survive later inserts.
+	*/
+	template <class Key, class THash = std::hash<Key>, class TKeyEqual = std::equal_to<Key>,
+		class TAllocator = std::allocator<Key>>
+	class TFlatHashSet : public TFlatHashTable<TFlatHashSetPolicy<Key>, THash, TKeyEqual, TAllocator>
+	{
+		typedef TFlatHashTable<TFlatHashSetPolicy<Key>, THash, TKeyEqual, TAllocator> BaseT;
+
+	public:
+		using BaseT::BaseT;
+
+		TFlatHashSet() = default;
+	};
+}
+
+#endif
@@ -0,0 +1,1063 @@
+#ifndef PHOENIX_FLAT_HASH_TABLE_H
+#define PHOENIX_FLAT_HASH_TABLE_H
+
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define PHOENIX_FLAT_HASH_SSE2 1
+#	include <emmintrin.h>
+#else
+#	define PHOENIX_FLAT_HASH_SSE2 0
+#endif
+
+#if _WIN32
+#	include <intrin.h>
+#endif
+
+#include "Utility/Debug/Assert.h"
+#include "Utility/MetaProgramming/HasInnerType.h"
+#include "Utility/Misc/Primitives.h"
+#include "Utility/Misc/TypeTraits.h"
+
+namespace Phoenix
+{
+	F_DefineTrait_HasInnerType(is_transparent);
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief The control bytes of 16 consecutive slots, matched all at once.
+	*
+	*	@desc A full slot's control byte holds 7 bits of its hash, so one compare filters
+	*		out nearly every slot whose key can't match.  Empty and deleted slots have the
+	*		sign bit set.  Uses SSE2 when it's available and plain loops otherwise.
+	*/
+	class FFlatHashGroup
+	{
+	public:
+		static const SizeT Width = 16;
+		static const Int8 Empty = -128;
+		static const Int8 Deleted = -2;
+
+		explicit FFlatHashGroup(const Int8* const Controls);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets a bit mask of the slots whose control byte equals H2. */
+		UInt32 Match(const Int8 H2) const;
+
+		UInt32 MatchEmpty() const;
+
+		UInt32 MatchEmptyOrDeleted() const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the index of the lowest set bit.  Mask must not be zero. */
+		static SizeT GetLowestBit(const UInt32 Mask);
+
+	private:
+#if PHOENIX_FLAT_HASH_SSE2
+		__m128i Controls;
+#else
+		Int8 Controls[Width];
+#endif
+	};
+
+#if PHOENIX_FLAT_HASH_SSE2
+	inline FFlatHashGroup::FFlatHashGroup(const Int8* const InControls)
+		: Controls(_mm_loadu_si128(reinterpret_cast<const __m128i*>(InControls)))
+	{
+	}
+
+	inline UInt32 FFlatHashGroup::Match(const Int8 H2) const
+	{
+		const UInt32 Mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(H2), Controls));
+		return Mask;
+	}
+
+	inline UInt32 FFlatHashGroup::MatchEmpty() const
+	{
+		const UInt32 Mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(Empty), Controls));
+		return Mask;
+	}
+
+	inline UInt32 FFlatHashGroup::MatchEmptyOrDeleted() const
+	{
+		const UInt32 Mask = _mm_movemask_epi8(Controls);
+		return Mask;
+	}
+#else
+	inline FFlatHashGroup::FFlatHashGroup(const Int8* const InControls)
+	{
+		std::memcpy(Controls, InControls, Width);
+	}
+
+	inline UInt32 FFlatHashGroup::Match(const Int8 H2) const
+	{
+		UInt32 Mask = 0;
+		for (SizeT I = 0; I < Width; ++I)
+		{
+			Mask |= static_cast<UInt32>(Controls[I] == H2) << I;
+		}
+
+		return Mask;
+	}
+
+	inline UInt32 FFlatHashGroup::MatchEmpty() const
+	{
+		return Match(Empty);
+	}
+
+	inline UInt32 FFlatHashGroup::MatchEmptyOrDeleted() const
+	{
+		UInt32 Mask = 0;
+		for (SizeT I = 0; I < Width; ++I)
+		{
+			Mask |= static_cast<UInt32>(Controls[I] < 0) << I;
+		}
+
+		return Mask;
+	}
+#endif
+
+	inline SizeT FFlatHashGroup::GetLowestBit(const UInt32 Mask)
+	{
+#if _WIN32
+		unsigned long Index = 0;
+		_BitScanForward(&Index, Mask);
+		return Index;
+#else
+		return __builtin_ctz(Mask);
+#endif
+	}
+
+	template <bool IsTransparent>
+	struct TFlatHashKeyArg
+	{
+		template <class K, class KeyType>
+		using Type = KeyType;
+	};
+
+	// An alias straight to K, unlike std::conditional, keeps K deducible.
+	template <>
+	struct TFlatHashKeyArg<true>
+	{
+		template <class K, class KeyType>
+		using Type = K;
+	};
+
+	template <class Key, class Value>
+	struct TFlatHashMapPolicy
+	{
+		typedef Key KeyT;
+		typedef std::pair<const Key, Value> ValueT;
+
+		static const Key& GetKey(const ValueT& Slot)
+		{
+			return Slot.first;
+		}
+	};
+
+	template <class Key>
+	struct TFlatHashSetPolicy
+	{
+		typedef Key KeyT;
+		typedef Key ValueT;
+
+		static const Key& GetKey(const ValueT& Slot)
+		{
+			return Slot;
+		}
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief An open addressing hash table in the style of SwissTable.
+	*
+	*	@desc Values are stored inline in one slot array, next to an array of one control
+	*		byte per slot.  Lookups probe whole groups of control bytes at a time, and only
+	*		compare keys whose 7 bit hash fragment matches.  Growth doubles the capacity
+	*		and keeps the load at or below 7/8.  Erased slots become tombstones until the
+	*		next rehash.
+	*	@note Unlike the std containers, inserting may move every element, so pointers and
+	*		iterators are only stable until the next insert.  If both THash and TKeyEqual
+	*		define is_transparent, lookups accept any type they do, such as a string literal
+	*		for FString keys.  Use TFlatHashMap or TFlatHashSet rather than this directly.
+	*/
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	class TFlatHashTable
+	{
+	public:
+		typedef typename TPolicy::KeyT key_type;
+		typedef typename TPolicy::ValueT value_type;
+		typedef SizeT size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef THash hasher;
+		typedef TKeyEqual key_equal;
+		typedef TAllocator allocator_type;
+		typedef value_type& reference;
+		typedef const value_type& const_reference;
+
+		static const bool IsTransparent = THasInnerType_is_transparent<THash>::Value
+			&& THasInnerType_is_transparent<TKeyEqual>::Value;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief The key type taken by lookups, which is deduced only when IsTransparent. */
+		template <class K>
+		using TKeyArg = typename TFlatHashKeyArg<IsTransparent>::template Type<K, key_type>;
+
+		template <bool IsConst>
+		class TIterator
+		{
+		public:
+			typedef std::forward_iterator_tag iterator_category;
+			typedef typename TFlatHashTable::value_type value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef typename std::conditional<IsConst, const value_type*, value_type*>::type pointer;
+			typedef typename std::conditional<IsConst, const value_type&, value_type&>::type reference;
+
+			TIterator() = default;
+
+			template <bool IsOtherConst, TEnableIf<IsConst && !IsOtherConst, Int32> = 0>
+			TIterator(const TIterator<IsOtherConst>& RHS)
+				: GroupControl(RHS.GroupControl)
+				, ControlEnd(RHS.ControlEnd)
+				, GroupSlot(RHS.GroupSlot)
+				, Slot(RHS.Slot)
+				, Used(RHS.Used)
+			{
+			}
+
+			reference operator*() const
+			{
+				return *Slot;
+			}
+
+			pointer operator->() const
+			{
+				return Slot;
+			}
+
+			TIterator& operator++()
+			{
+				Used &= Used - 1;
+				SkipToUsed();
+				return *this;
+			}
+
+			TIterator operator++(int)
+			{
+				TIterator Result = *this;
+				++*this;
+				return Result;
+			}
+
+			friend bool operator==(const TIterator& LHS, const TIterator& RHS)
+			{
+				return LHS.Slot == RHS.Slot;
+			}
+
+			friend bool operator!=(const TIterator& LHS, const TIterator& RHS)
+			{
+				return LHS.Slot != RHS.Slot;
+			}
+
+		private:
+			friend class TFlatHashTable;
+
+			template <bool>
+			friend class TIterator;
+
+			const Int8* GroupControl{ nullptr };
+			const Int8* ControlEnd{ nullptr };
+			pointer GroupSlot{ nullptr };
+			pointer Slot{ nullptr };
+
+			//	--------------------------------------------------------------------------------
+			/*! \brief The used slots in the current group, from the current slot on. */
+			UInt32 Used{ 0 };
+
+			//	--------------------------------------------------------------------------------
+			/*! \brief Points at the slot Offset into the group, which must be used unless it's the end. */
+			TIterator(const Int8* const InGroupControl, const Int8* const InControlEnd, pointer InGroupSlot, const SizeT Offset)
+				: GroupControl(InGroupControl)
+				, ControlEnd(InControlEnd)
+				, GroupSlot(InGroupSlot)
+				, Slot(InGroupSlot + Offset)
+			{
+				// Left unused by lookups that never advance, so the compiler drops the load.
+				if (GroupControl != ControlEnd)
+				{
+					Used = GetUsed(GroupControl) & (~0u << Offset);
+				}
+			}
+
+			static UInt32 GetUsed(const Int8* const Controls)
+			{
+				const UInt32 Result = ~FFlatHashGroup(Controls).MatchEmptyOrDeleted() & 0xFFFF;
+				return Result;
+			}
+
+			void SkipToUsed()
+			{
+				// Groups start at multiples of the group width, so the last one ends exactly at
+				// ControlEnd.  Walking bit masks avoids a branch on every slot.
+				while (!Used && GroupControl != ControlEnd)
+				{
+					GroupControl += FFlatHashGroup::Width;
+					GroupSlot += FFlatHashGroup::Width;
+
+					if (GroupControl != ControlEnd)
+					{
+						Used = GetUsed(GroupControl);
+					}
+				}
+
+				Slot = Used ? GroupSlot + FFlatHashGroup::GetLowestBit(Used) : GroupSlot;
+			}
+		};
+
+		typedef TIterator<false> iterator;
+		typedef TIterator<true> const_iterator;
+
+		TFlatHashTable() = default;
+
+		explicit TFlatHashTable(const SizeT BucketCount, const THash& Hash = THash(),
+			const TKeyEqual& KeyEqual = TKeyEqual(), const TAllocator& Allocator = TAllocator());
+
+		TFlatHashTable(std::initializer_list<value_type> Values);
+
+		TFlatHashTable(const TFlatHashTable& RHS);
+		TFlatHashTable& operator=(const TFlatHashTable& RHS);
+
+		TFlatHashTable(TFlatHashTable&& RHS);
+		TFlatHashTable& operator=(TFlatHashTable&& RHS);
+
+		~TFlatHashTable();
+
+		iterator begin();
+		const_iterator begin() const;
+		const_iterator cbegin() const;
+
+		iterator end();
+		const_iterator end() const;
+		const_iterator cend() const;
+
+		bool empty() const;
+
+		SizeT size() const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the number of slots, which is always zero or a power of two. */
+		SizeT bucket_count() const;
+
+		Float32 load_factor() const;
+
+		Float32 max_load_factor() const;
+
+		void clear();
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Makes room for Count elements so that inserting them won't rehash. */
+		void reserve(const SizeT Count);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Rebuilds the table with at least BucketCount slots, dropping any tombstones. */
+		void rehash(const SizeT BucketCount);
+
+		std::pair<iterator, bool> insert(const value_type& Value);
+
+		std::pair<iterator, bool> insert(value_type&& Value);
+
+		template <class TInputIterator>
+		void insert(TInputIterator First, TInputIterator Last);
+
+		void insert(std::initializer_list<value_type> Values);
+
+		template <class... TArgs>
+		std::pair<iterator, bool> emplace(TArgs&&... Args);
+
+		iterator erase(const_iterator Position);
+
+		iterator erase(iterator Position);
+
+		template <class K = key_type>
+		SizeT erase(const TKeyArg<K>& Key);
+
+		template <class K = key_type>
+		iterator find(const TKeyArg<K>& Key);
+
+		template <class K = key_type>
+		const_iterator find(const TKeyArg<K>& Key) const;
+
+		template <class K = key_type>
+		SizeT count(const TKeyArg<K>& Key) const;
+
+		template <class K = key_type>
+		bool contains(const TKeyArg<K>& Key) const;
+
+		void swap(TFlatHashTable& RHS);
+
+		hasher hash_function() const;
+
+		key_equal key_eq() const;
+
+		allocator_type get_allocator() const;
+
+	protected:
+		//	--------------------------------------------------------------------------------
+		/*! \brief Finds Key's slot, or claims an empty one for it that the caller must construct.
+		*
+		*	@return Returns the slot's index and whether Key was already in the table.
+		*/
+		template <class K>
+		std::pair<SizeT, bool> FindOrPrepareInsert(const K& Key);
+
+		template <class... TArgs>
+		void ConstructAt(const SizeT Index, TArgs&&... Args);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Makes an iterator to a used slot, or to the end if Index is the capacity. */
+		iterator MakeIterator(const SizeT Index);
+
+		const_iterator MakeIterator(const SizeT Index) const;
+
+	private:
+		typedef std::allocator_traits<TAllocator> AllocTraitsT;
+		typedef typename AllocTraitsT::template rebind_alloc<value_type> SlotAllocT;
+		typedef typename AllocTraitsT::template rebind_alloc<Int8> ControlAllocT;
+		typedef std::allocator_traits<SlotAllocT> SlotTraitsT;
+		typedef std::allocator_traits<ControlAllocT> ControlTraitsT;
+
+		Int8* Controls{ nullptr };
+		value_type* Slots{ nullptr };
+		SizeT Capacity{ 0 };
+		SizeT Size{ 0 };
+		SizeT GrowthLeft{ 0 };
+
+		THash Hash;
+		TKeyEqual KeyEqual;
+		SlotAllocT SlotAlloc;
+		ControlAllocT ControlAlloc;
+
+		static SizeT GetMaxLoad(const SizeT InCapacity);
+
+		static SizeT GetCapacityFor(const SizeT Count);
+
+		static SizeT MixHash(const SizeT Value);
+
+		template <class K>
+		SizeT HashKey(const K& Key) const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the index of Key's slot, or Capacity if it isn't in the table. */
+		template <class K>
+		SizeT FindIndex(const K& Key, const SizeT KeyHash) const;
+
+		SizeT FindInsertIndex(const SizeT KeyHash) const;
+
+		void SetControl(const SizeT Index, const Int8 Control);
+
+		void EraseAt(const SizeT Index);
+
+		void Resize(const SizeT NewCapacity);
+
+		void DestroyAndDeallocate();
+	};
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::TFlatHashTable(const SizeT BucketCount,
+		const THash& InHash, const TKeyEqual& InKeyEqual, const TAllocator& Allocator)
+		: Hash(InHash)
+		, KeyEqual(InKeyEqual)
+		, SlotAlloc(Allocator)
+		, ControlAlloc(Allocator)
+	{
+		if (BucketCount)
+		{
+			rehash(BucketCount);
+		}
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::TFlatHashTable(std::initializer_list<value_type> Values)
+	{
+		insert(Values);
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::TFlatHashTable(const TFlatHashTable& RHS)
+		: Hash(RHS.Hash)
+		, KeyEqual(RHS.KeyEqual)
+		, SlotAlloc(SlotTraitsT::select_on_container_copy_construction(RHS.SlotAlloc))
+		, ControlAlloc(ControlTraitsT::select_on_container_copy_construction(RHS.ControlAlloc))
+	{
+		reserve(RHS.size());
+		insert(RHS.begin(), RHS.end());
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>&
+		TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::operator=(const TFlatHashTable& RHS)
+	{
+		if (this != &RHS)
+		{
+			TFlatHashTable Copy(RHS);
+			swap(Copy);
+		}
+
+		return *this;
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::TFlatHashTable(TFlatHashTable&& RHS)
+		: Controls(RHS.Controls)
+		, Slots(RHS.Slots)
+		, Capacity(RHS.Capacity)
+		, Size(RHS.Size)
+		, GrowthLeft(RHS.GrowthLeft)
+		, Hash(std::move(RHS.Hash))
+		, KeyEqual(std::move(RHS.KeyEqual))
+		, SlotAlloc(std::move(RHS.SlotAlloc))
+		, ControlAlloc(std::move(RHS.ControlAlloc))
+	{
+		RHS.Controls = nullptr;
+		RHS.Slots = nullptr;
+		RHS.Capacity = 0;
+		RHS.Size = 0;
+		RHS.GrowthLeft = 0;
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>&
+		TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::operator=(TFlatHashTable&& RHS)
+	{
+		if (this != &RHS)
+		{
+			DestroyAndDeallocate();
+
+			TFlatHashTable Moved(std::move(RHS));
+			swap(Moved);
+		}
+
+		return *this;
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::~TFlatHashTable()
+	{
+		DestroyAndDeallocate();
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	typename TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::iterator
+		TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::begin()
+	{
+		iterator Result = MakeIterator(0);
+		Result.SkipToUsed();
+		return Result;
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	typename TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::const_iterator
+		TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::begin() const
+	{
+		const_iterator Result = MakeIterator(0);
+		Result.SkipToUsed();
+		return Result;
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	typename TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::const_iterator
+		TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::cbegin() const
+	{
+		return begin();
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	typename TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::iterator
+		TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::end()
+	{
+		return MakeIterator(Capacity);
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	typename TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::const_iterator
+		TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::end() const
+	{
+		return MakeIterator(Capacity);
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	typename TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::const_iterator
+		TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::cend() const
+	{
+		return end();
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	bool TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::empty() const
+	{
+		return Size == 0;
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	SizeT TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::size() const
+	{
+		return Size;
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	SizeT TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::bucket_count() const
+	{
+		return Capacity;
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	Float32 TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::load_factor() const
+	{
+		const Float32 Result = Capacity ? static_cast<Float32>(Size) / static_cast<Float32>(Capacity) : 0.f;
+		return Result;
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	Float32 TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::max_load_factor() const
+	{
+		return 7.f / 8.f;
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	void TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::clear()
+	{
+		if (!Capacity)
+		{
+			return;
+		}
+
+		for (SizeT I = 0; I < Capacity; ++I)
+		{
+			if (Controls[I] >= 0)
+			{
+				SlotTraitsT::destroy(SlotAlloc, Slots + I);
+			}
+		}
+
+		std::memset(Controls, FFlatHashGroup::Empty, Capacity + FFlatHashGroup::Width - 1);
+		Size = 0;
+		GrowthLeft = GetMaxLoad(Capacity);
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	void TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::reserve(const SizeT Count)
+	{
+		const SizeT NewCapacity = GetCapacityFor(Count);
+		if (Count && NewCapacity > Capacity)
+		{
+			Resize(NewCapacity);
+		}
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	void TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::rehash(const SizeT BucketCount)
+	{
+		SizeT NewCapacity = GetCapacityFor(Size);
+		while (NewCapacity < BucketCount)
+		{
+			NewCapacity *= 2;
+		}
+
+		if (NewCapacity != Capacity || GrowthLeft != GetMaxLoad(Capacity) - Size)
+		{
+			Resize(NewCapacity);
+		}
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	std::pair<typename TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::iterator, bool>
+		TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::insert(const value_type& Value)
+	{
+		const std::pair<SizeT, bool> Result = FindOrPrepareInsert(TPolicy::GetKey(Value));
+		if (!Result.second)
+		{
+			ConstructAt(Result.first, Value);
+		}
+
+		return std::make_pair(MakeIterator(Result.first), !Result.second);
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	std::pair<typename TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::iterator, bool>
+		TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::insert(value_type&& Value)
+	{
+		const std::pair<SizeT, bool> Result = FindOrPrepareInsert(TPolicy::GetKey(Value));
+		if (!Result.second)
+		{
+			ConstructAt(Result.first, std::move(Value));
+		}
+
+		return std::make_pair(MakeIterator(Result.first), !Result.second);
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	template <class TInputIterator>
+	void TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::insert(TInputIterator First, TInputIterator Last)
+	{
+		for (; First != Last; ++First)
+		{
+			insert(*First);
+		}
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	void TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::insert(std::initializer_list<value_type> Values)
+	{
+		reserve(Size + Values.size());
+		insert(Values.begin(), Values.end());
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	template <class... TArgs>
+	std::pair<typename TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::iterator, bool>
+		TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::emplace(TArgs&&... Args)
+	{
+		// The key is only known once the value exists, so it's built on the stack first.
+		value_type Value(std::forward<TArgs>(Args)...);
+		return insert(std::move(Value));
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	typename TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::iterator
+		TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::erase(const_iterator Position)
+	{
+		const SizeT Index = Position.Slot - Slots;
+		EraseAt(Index);
+
+		iterator Result = MakeIterator(Index);
+		Result.SkipToUsed();
+		return Result;
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	typename TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::iterator
+		TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::erase(iterator Position)
+	{
+		return erase(const_iterator(Position));
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	template <class K>
+	SizeT TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::erase(const TKeyArg<K>& Key)
+	{
+		const SizeT Index = FindIndex(Key, HashKey(Key));
+		if (Index == Capacity)
+		{
+			return 0;
+		}
+
+		EraseAt(Index);
+		return 1;
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	template <class K>
+	typename TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::iterator
+		TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::find(const TKeyArg<K>& Key)
+	{
+		return MakeIterator(FindIndex(Key, HashKey(Key)));
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	template <class K>
+	typename TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::const_iterator
+		TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::find(const TKeyArg<K>& Key) const
+	{
+		return MakeIterator(FindIndex(Key, HashKey(Key)));
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	template <class K>
+	SizeT TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::count(const TKeyArg<K>& Key) const
+	{
+		return contains<K>(Key) ? 1 : 0;
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	template <class K>
+	bool TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::contains(const TKeyArg<K>& Key) const
+	{
+		return FindIndex(Key, HashKey(Key)) != Capacity;
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	void TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::swap(TFlatHashTable& RHS)
+	{
+		using std::swap;
+		swap(Controls, RHS.Controls);
+		swap(Slots, RHS.Slots);
+		swap(Capacity, RHS.Capacity);
+		swap(Size, RHS.Size);
+		swap(GrowthLeft, RHS.GrowthLeft);
+		swap(Hash, RHS.Hash);
+		swap(KeyEqual, RHS.KeyEqual);
+		swap(SlotAlloc, RHS.SlotAlloc);
+		swap(ControlAlloc, RHS.ControlAlloc);
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	typename TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::hasher
+		TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::hash_function() const
+	{
+		return Hash;
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	typename TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::key_equal
+		TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::key_eq() const
+	{
+		return KeyEqual;
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	typename TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::allocator_type
+		TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::get_allocator() const
+	{
+		return allocator_type(SlotAlloc);
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	template <class K>
+	std::pair<SizeT, bool> TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::FindOrPrepareInsert(const K& Key)
+	{
+		const SizeT KeyHash = HashKey(Key);
+
+		const SizeT FoundIndex = FindIndex(Key, KeyHash);
+		if (FoundIndex != Capacity)
+		{
+			return std::make_pair(FoundIndex, true);
+		}
+
+		SizeT Index = Capacity ? FindInsertIndex(KeyHash) : 0;
+
+		// Reusing a tombstone doesn't use up any growth.
+		if (!Capacity || (!GrowthLeft && Controls[Index] == FFlatHashGroup::Empty))
+		{
+			// Out of growth but well under the max load means the rest is tombstones, which
+			// a rehash at the same size clears without doubling the memory.
+			const bool IsMostlyTombstones = Size * 32 <= Capacity * 25;
+			Resize(!Capacity ? FFlatHashGroup::Width : IsMostlyTombstones ? Capacity : Capacity * 2);
+
+			Index = FindInsertIndex(KeyHash);
+		}
+
+		if (Controls[Index] == FFlatHashGroup::Empty)
+		{
+			--GrowthLeft;
+		}
+
+		SetControl(Index, static_cast<Int8>(KeyHash & 0x7F));
+		++Size;
+
+		return std::make_pair(Index, false);
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	template <class... TArgs>
+	void TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::ConstructAt(const SizeT Index, TArgs&&... Args)
+	{
+		SlotTraitsT::construct(SlotAlloc, Slots + Index, std::forward<TArgs>(Args)...);
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	typename TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::iterator
+		TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::MakeIterator(const SizeT Index)
+	{
+		const SizeT GroupIndex = Index & ~(FFlatHashGroup::Width - 1);
+		return iterator(Controls + GroupIndex, Controls + Capacity, Slots + GroupIndex, Index - GroupIndex);
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	typename TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::const_iterator
+		TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::MakeIterator(const SizeT Index) const
+	{
+		const SizeT GroupIndex = Index & ~(FFlatHashGroup::Width - 1);
+		return const_iterator(Controls + GroupIndex, Controls + Capacity, Slots + GroupIndex, Index - GroupIndex);
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	SizeT TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::GetMaxLoad(const SizeT InCapacity)
+	{
+		return InCapacity - InCapacity / 8;
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	SizeT TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::GetCapacityFor(const SizeT Count)
+	{
+		SizeT Result = FFlatHashGroup::Width;
+		while (GetMaxLoad(Result) < Count)
+		{
+			Result *= 2;
+		}
+
+		return Result;
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	SizeT TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::MixHash(const SizeT Value)
+	{
+		// std::hash is the identity for integers, so the bits are spread before they're split.
+		UInt64 Mixed = static_cast<UInt64>(Value);
+		Mixed ^= Mixed >> 33;
+		Mixed *= 0xFF51AFD7ED558CCDull;
+		Mixed ^= Mixed >> 33;
+
+		return static_cast<SizeT>(Mixed);
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	template <class K>
+	SizeT TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::HashKey(const K& Key) const
+	{
+		return MixHash(Hash(Key));
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	template <class K>
+	SizeT TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::FindIndex(const K& Key, const SizeT KeyHash) const
+	{
+		if (!Size)
+		{
+			return Capacity;
+		}
+
+		// The low 7 bits go in the control byte and the rest pick where probing starts.
+		const Int8 H2 = static_cast<Int8>(KeyHash & 0x7F);
+		const SizeT Mask = Capacity - 1;
+		SizeT Position = (KeyHash >> 7) & Mask;
+
+		for (SizeT Step = FFlatHashGroup::Width; ; Step += FFlatHashGroup::Width)
+		{
+			const FFlatHashGroup Group(Controls + Position);
+
+			for (UInt32 Matches = Group.Match(H2); Matches; Matches &= Matches - 1)
+			{
+				const SizeT Index = (Position + FFlatHashGroup::GetLowestBit(Matches)) & Mask;
+				if (KeyEqual(TPolicy::GetKey(Slots[Index]), Key))
+				{
+					return Index;
+				}
+			}
+
+			// Probing for a key never passes an empty slot when it's inserted.
+			if (Group.MatchEmpty())
+			{
+				return Capacity;
+			}
+
+			Position = (Position + Step) & Mask;
+		}
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	SizeT TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::FindInsertIndex(const SizeT KeyHash) const
+	{
+		const SizeT Mask = Capacity - 1;
+		SizeT Position = (KeyHash >> 7) & Mask;
+
+		for (SizeT Step = FFlatHashGroup::Width; ; Step += FFlatHashGroup::Width)
+		{
+			const FFlatHashGroup Group(Controls + Position);
+
+			const UInt32 Matches = Group.MatchEmptyOrDeleted();
+			if (Matches)
+			{
+				const SizeT Index = (Position + FFlatHashGroup::GetLowestBit(Matches)) & Mask;
+				return Index;
+			}
+
+			Position = (Position + Step) & Mask;
+		}
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	void TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::SetControl(const SizeT Index, const Int8 Control)
+	{
+		Controls[Index] = Control;
+
+		// The first group is cloned past the end, so a group can be loaded at any index.
+		if (Index < FFlatHashGroup::Width - 1)
+		{
+			Controls[Capacity + Index] = Control;
+		}
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	void TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::EraseAt(const SizeT Index)
+	{
+		F_Assert(Index < Capacity && Controls[Index] >= 0, "Erasing an empty slot.");
+
+		SlotTraitsT::destroy(SlotAlloc, Slots + Index);
+		SetControl(Index, FFlatHashGroup::Deleted);
+		--Size;
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	void TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::Resize(const SizeT NewCapacity)
+	{
+		F_Assert(NewCapacity && (NewCapacity & (NewCapacity - 1)) == 0, "Capacity must be a power of two.");
+		F_Assert(GetMaxLoad(NewCapacity) >= Size, "Capacity is too small.");
+
+		Int8* const OldControls = Controls;
+		value_type* const OldSlots = Slots;
+		const SizeT OldCapacity = Capacity;
+
+		const SizeT ControlCount = NewCapacity + FFlatHashGroup::Width - 1;
+		Controls = ControlTraitsT::allocate(ControlAlloc, ControlCount);
+		Slots = SlotTraitsT::allocate(SlotAlloc, NewCapacity);
+		Capacity = NewCapacity;
+		GrowthLeft = GetMaxLoad(NewCapacity) - Size;
+
+		std::memset(Controls, FFlatHashGroup::Empty, ControlCount);
+
+		for (SizeT I = 0; I < OldCapacity; ++I)
+		{
+			if (OldControls[I] < 0)
+			{
+				continue;
+			}
+
+			const SizeT KeyHash = HashKey(TPolicy::GetKey(OldSlots[I]));
+			const SizeT Index = FindInsertIndex(KeyHash);
+
+			SetControl(Index, static_cast<Int8>(KeyHash & 0x7F));
+			SlotTraitsT::construct(SlotAlloc, Slots + Index, std::move(OldSlots[I]));
+			SlotTraitsT::destroy(SlotAlloc, OldSlots + I);
+		}
+
+		if (OldCapacity)
+		{
+			ControlTraitsT::deallocate(ControlAlloc, OldControls, OldCapacity + FFlatHashGroup::Width - 1);
+			SlotTraitsT::deallocate(SlotAlloc, OldSlots, OldCapacity);
+		}
+	}
+
+	template <class TPolicy, class THash, class TKeyEqual, class TAllocator>
+	void TFlatHashTable<TPolicy, THash, TKeyEqual, TAllocator>::DestroyAndDeallocate()
+	{
+		if (!Capacity)
+		{
+			return;
+		}
+
+		clear();
+
+		ControlTraitsT::deallocate(ControlAlloc, Controls, Capacity + FFlatHashGroup::Width - 1);
+		SlotTraitsT::deallocate(SlotAlloc, Slots, Capacity);
+
+		Controls = nullptr;
+		Slots = nullptr;
+		Capacity = 0;
+		GrowthLeft = 0;
+	}
+}
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef PHOENIX_FRAME_VECTOR_H
+#define PHOENIX_FRAME_VECTOR_H
+
+#include "Utility/Containers/Vector.h"
+#include "Utility/Misc/FrameAllocator.h"
+
+namespace Phoenix
+{
+	//! Vector for data that's rebuilt every frame.  See TFrameAlloc for its lifetime rules.
+	template <class T>
+	using TFrameVector = TVector<T, TFrameAlloc<T>>;
+}
+
+#endif
@@ -0,0 +1,532 @@
+#ifndef PHOENIX_INLINE_VECTOR_H
+#define PHOENIX_INLINE_VECTOR_H
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Utility/Debug/Assert.h"
+#include "Utility/Misc/Primitives.h"
+
+namespace Phoenix
+{
+	//	--------------------------------------------------------------------------------
+	/*! \brief A vector that stores up to N elements inside itself before using the heap.
+	*
+	*	@desc Meant for small temporaries whose usual size is known, such as lists built
+	*		during a single call.  Growing past N moves every element to a heap buffer,
+	*		which is kept until the vector is destroyed.  Otherwise it acts like TVector.
+	*	@note Moving a vector that's still inline moves its elements one by one, so it
+	*		costs up to N element moves rather than a pointer swap.
+	*/
+	template <class T, SizeT N, class TAllocator = std::allocator<T>>
+	class TInlineVector
+	{
+		static_assert(N > 0, "Inline capacity must be greater than zero.");
+
+	public:
+		typedef T value_type;
+		typedef SizeT size_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef T& reference;
+		typedef const T& const_reference;
+		typedef T* pointer;
+		typedef const T* const_pointer;
+		typedef T* iterator;
+		typedef const T* const_iterator;
+		typedef TAllocator allocator_type;
+
+		static const SizeT InlineCapacity = N;
+
+		TInlineVector() = default;
+
+		explicit TInlineVector(const SizeT Count);
+
+		TInlineVector(const SizeT Count, const T& Value);
+
+		TInlineVector(std::initializer_list<T> Values);
+
+		TInlineVector(const TInlineVector& RHS);
+		TInlineVector& operator=(const TInlineVector& RHS);
+
+		TInlineVector(TInlineVector&& RHS);
+		TInlineVector& operator=(TInlineVector&& RHS);
+
+		~TInlineVector();
+
+		iterator begin();
+		const_iterator begin() const;
+		const_iterator cbegin() const;
+
+		iterator end();
+		const_iterator end() const;
+		const_iterator cend() const;
+
+		T& operator[](const SizeT Index);
+
+		const T& operator[](const SizeT Index) const;
+
+		T& front();
+
+		const T& front() const;
+
+		T& back();
+
+		const T& back() const;
+
+		T* data();
+
+		const T* data() const;
+
+		bool empty() const;
+
+		SizeT size() const;
+
+		SizeT capacity() const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Checks whether the elements are still stored inside the vector itself. */
+		bool IsInline() const;
+
+		void reserve(const SizeT NewCapacity);
+
+		void resize(const SizeT NewSize);
+
+		void resize(const SizeT NewSize, const T& Value);
+
+		void clear();
+
+		void push_back(const T& Value);
+
+		void push_back(T&& Value);
+
+		template <class... TArgs>
+		T& emplace_back(TArgs&&... Args);
+
+		void pop_back();
+
+		iterator erase(const_iterator Position);
+
+		iterator erase(const_iterator First, const_iterator Last);
+
+		bool operator==(const TInlineVector& RHS) const;
+
+		bool operator!=(const TInlineVector& RHS) const;
+
+	private:
+		typedef std::allocator_traits<TAllocator> AllocTraitsT;
+
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type InlineData[N];
+		T* Data{ reinterpret_cast<T*>(InlineData) };
+		SizeT Size{ 0 };
+		SizeT Capacity{ N };
+		TAllocator Allocator;
+
+		T* GetInlineData();
+
+		void Grow(const SizeT MinCapacity);
+
+		void DestroyRange(T* const First, T* const Last);
+
+		void MoveFrom(TInlineVector& RHS);
+	};
+
+	template <class T, SizeT N, class TAllocator>
+	TInlineVector<T, N, TAllocator>::TInlineVector(const SizeT Count)
+	{
+		resize(Count);
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	TInlineVector<T, N, TAllocator>::TInlineVector(const SizeT Count, const T& Value)
+	{
+		resize(Count, Value);
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	TInlineVector<T, N, TAllocator>::TInlineVector(std::initializer_list<T> Values)
+	{
+		reserve(Values.size());
+		for (const T& Value : Values)
+		{
+			push_back(Value);
+		}
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	TInlineVector<T, N, TAllocator>::TInlineVector(const TInlineVector& RHS)
+		: Allocator(AllocTraitsT::select_on_container_copy_construction(RHS.Allocator))
+	{
+		reserve(RHS.Size);
+		std::uninitialized_copy(RHS.begin(), RHS.end(), Data);
+		Size = RHS.Size;
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	TInlineVector<T, N, TAllocator>& TInlineVector<T, N, TAllocator>::operator=(const TInlineVector& RHS)
+	{
+		if (this == &RHS)
+		{
+			return *this;
+		}
+
+		clear();
+		reserve(RHS.Size);
+		std::uninitialized_copy(RHS.begin(), RHS.end(), Data);
+		Size = RHS.Size;
+
+		return *this;
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	TInlineVector<T, N, TAllocator>::TInlineVector(TInlineVector&& RHS)
+		: Allocator(std::move(RHS.Allocator))
+	{
+		MoveFrom(RHS);
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	TInlineVector<T, N, TAllocator>& TInlineVector<T, N, TAllocator>::operator=(TInlineVector&& RHS)
+	{
+		if (this == &RHS)
+		{
+			return *this;
+		}
+
+		clear();
+		if (!IsInline())
+		{
+			AllocTraitsT::deallocate(Allocator, Data, Capacity);
+			Data = GetInlineData();
+			Capacity = N;
+		}
+
+		Allocator = std::move(RHS.Allocator);
+		MoveFrom(RHS);
+
+		return *this;
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	TInlineVector<T, N, TAllocator>::~TInlineVector()
+	{
+		clear();
+		if (!IsInline())
+		{
+			AllocTraitsT::deallocate(Allocator, Data, Capacity);
+		}
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	typename TInlineVector<T, N, TAllocator>::iterator TInlineVector<T, N, TAllocator>::begin()
+	{
+		return Data;
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	typename TInlineVector<T, N, TAllocator>::const_iterator TInlineVector<T, N, TAllocator>::begin() const
+	{
+		return Data;
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	typename TInlineVector<T, N, TAllocator>::const_iterator TInlineVector<T, N, TAllocator>::cbegin() const
+	{
+		return Data;
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	typename TInlineVector<T, N, TAllocator>::iterator TInlineVector<T, N, TAllocator>::end()
+	{
+		return Data + Size;
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	typename TInlineVector<T, N, TAllocator>::const_iterator TInlineVector<T, N, TAllocator>::end() const
+	{
+		return Data + Size;
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	typename TInlineVector<T, N, TAllocator>::const_iterator TInlineVector<T, N, TAllocator>::cend() const
+	{
+		return Data + Size;
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	T& TInlineVector<T, N, TAllocator>::operator[](const SizeT Index)
+	{
+		F_Assert(Index < Size, "Index " << Index << " is out of range of " << Size << ".");
+		return Data[Index];
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	const T& TInlineVector<T, N, TAllocator>::operator[](const SizeT Index) const
+	{
+		F_Assert(Index < Size, "Index " << Index << " is out of range of " << Size << ".");
+		return Data[Index];
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	T& TInlineVector<T, N, TAllocator>::front()
+	{
+		return (*this)[0];
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	const T& TInlineVector<T, N, TAllocator>::front() const
+	{
+		return (*this)[0];
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	T& TInlineVector<T, N, TAllocator>::back()
+	{
+		return (*this)[Size - 1];
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	const T& TInlineVector<T, N, TAllocator>::back() const
+	{
+		return (*this)[Size - 1];
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	T* TInlineVector<T, N, TAllocator>::data()
+	{
+		return Data;
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	const T* TInlineVector<T, N, TAllocator>::data() const
+	{
+		return Data;
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	bool TInlineVector<T, N, TAllocator>::empty() const
+	{
+		return Size == 0;
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	SizeT TInlineVector<T, N, TAllocator>::size() const
+	{
+		return Size;
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	SizeT TInlineVector<T, N, TAllocator>::capacity() const
+	{
+		return Capacity;
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	bool TInlineVector<T, N, TAllocator>::IsInline() const
+	{
+		return Data == reinterpret_cast<const T*>(InlineData);
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	void TInlineVector<T, N, TAllocator>::reserve(const SizeT NewCapacity)
+	{
+		if (NewCapacity > Capacity)
+		{
+			Grow(NewCapacity);
+		}
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	void TInlineVector<T, N, TAllocator>::resize(const SizeT NewSize)
+	{
+		if (NewSize < Size)
+		{
+			DestroyRange(Data + NewSize, Data + Size);
+			Size = NewSize;
+			return;
+		}
+
+		reserve(NewSize);
+		for (; Size < NewSize; ++Size)
+		{
+			AllocTraitsT::construct(Allocator, Data + Size);
+		}
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	void TInlineVector<T, N, TAllocator>::resize(const SizeT NewSize, const T& Value)
+	{
+		if (NewSize < Size)
+		{
+			DestroyRange(Data + NewSize, Data + Size);
+			Size = NewSize;
+			return;
+		}
+
+		while (Size < NewSize)
+		{
+			push_back(Value);
+		}
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	void TInlineVector<T, N, TAllocator>::clear()
+	{
+		DestroyRange(Data, Data + Size);
+		Size = 0;
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	void TInlineVector<T, N, TAllocator>::push_back(const T& Value)
+	{
+		emplace_back(Value);
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	void TInlineVector<T, N, TAllocator>::push_back(T&& Value)
+	{
+		emplace_back(std::move(Value));
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	template <class... TArgs>
+	T& TInlineVector<T, N, TAllocator>::emplace_back(TArgs&&... Args)
+	{
+		if (Size < Capacity)
+		{
+			AllocTraitsT::construct(Allocator, Data + Size, std::forward<TArgs>(Args)...);
+			++Size;
+			return back();
+		}
+
+		// The arguments may refer to an element, so the new element is built before the
+		// old ones are moved out from under them.
+		const SizeT NewCapacity = Capacity * 2;
+		T* const NewData = AllocTraitsT::allocate(Allocator, NewCapacity);
+		AllocTraitsT::construct(Allocator, NewData + Size, std::forward<TArgs>(Args)...);
+
+		std::uninitialized_copy(std::make_move_iterator(Data), std::make_move_iterator(Data + Size), NewData);
+		DestroyRange(Data, Data + Size);
+
+		if (!IsInline())
+		{
+			AllocTraitsT::deallocate(Allocator, Data, Capacity);
+		}
+
+		Data = NewData;
+		Capacity = NewCapacity;
+		++Size;
+
+		return back();
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	void TInlineVector<T, N, TAllocator>::pop_back()
+	{
+		F_Assert(Size, "Vector is empty.");
+
+		--Size;
+		AllocTraitsT::destroy(Allocator, Data + Size);
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	typename TInlineVector<T, N, TAllocator>::iterator TInlineVector<T, N, TAllocator>::erase(const_iterator Position)
+	{
+		return erase(Position, Position + 1);
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	typename TInlineVector<T, N, TAllocator>::iterator
+		TInlineVector<T, N, TAllocator>::erase(const_iterator First, const_iterator Last)
+	{
+		F_Assert(First >= begin() && First <= Last && Last <= end(), "Erased range is invalid.");
+
+		T* const Begin = Data + (First - Data);
+		T* const NewEnd = std::move(Data + (Last - Data), end(), Begin);
+
+		DestroyRange(NewEnd, end());
+		Size = NewEnd - Data;
+
+		return Begin;
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	bool TInlineVector<T, N, TAllocator>::operator==(const TInlineVector& RHS) const
+	{
+		const bool Result = Size == RHS.Size && std::equal(begin(), end(), RHS.begin());
+		return Result;
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	bool TInlineVector<T, N, TAllocator>::operator!=(const TInlineVector& RHS) const
+	{
+		return !(*this == RHS);
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	T* TInlineVector<T, N, TAllocator>::GetInlineData()
+	{
+		return reinterpret_cast<T*>(InlineData);
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	void TInlineVector<T, N, TAllocator>::Grow(const SizeT MinCapacity)
+	{
+		SizeT NewCapacity = Capacity * 2;
+		if (NewCapacity < MinCapacity)
+		{
+			NewCapacity = MinCapacity;
+		}
+
+		T* const NewData = AllocTraitsT::allocate(Allocator, NewCapacity);
+
+		std::uninitialized_copy(std::make_move_iterator(Data), std::make_move_iterator(Data + Size), NewData);
+		DestroyRange(Data, Data + Size);
+
+		if (!IsInline())
+		{
+			AllocTraitsT::deallocate(Allocator, Data, Capacity);
+		}
+
+		Data = NewData;
+		Capacity = NewCapacity;
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	void TInlineVector<T, N, TAllocator>::DestroyRange(T* const First, T* const Last)
+	{
+		for (T* Iter = First; Iter != Last; ++Iter)
+		{
+			AllocTraitsT::destroy(Allocator, Iter);
+		}
+	}
+
+	template <class T, SizeT N, class TAllocator>
+	void TInlineVector<T, N, TAllocator>::MoveFrom(TInlineVector& RHS)
+	{
+		F_Assert(IsInline() && !Size, "Vector should be empty and inline before being moved into.");
+
+		if (!RHS.IsInline())
+		{
+			// A heap buffer is simply taken over.
+			Data = RHS.Data;
+			Size = RHS.Size;
+			Capacity = RHS.Capacity;
+
+			RHS.Data = RHS.GetInlineData();
+			RHS.Size = 0;
+			RHS.Capacity = N;
+			return;
+		}
+
+		std::uninitialized_copy(std::make_move_iterator(RHS.begin()), std::make_move_iterator(RHS.end()), Data);
+		Size = RHS.Size;
+		RHS.clear();
+	}
+}
+
+#endif
@@ -5,8 +5,8 @@
 
 namespace Phoenix
 {
-	template <class Key, class T>
-	using TMap = std::map<Key, T>;
+	template <class Key, class T, class TCompare = std::less<Key>, class TAllocator = std::allocator<std::pair<const Key, T>>>
+	using TMap = std::map<Key, T, TCompare, TAllocator>;
 }
 
 #endif
@@ -2,23 +2,141 @@
 #define PHOENIX_NAMED_ITEM_CACHE_H
 
 #include "Utility/Containers/Array.h"
-#include "Utility/Containers/UnorderedMap.h"
+#include "Utility/Containers/FlatHashMap.h"
+#include "Utility/Containers/Vector.h"
 #include "Utility/Debug/Debug.h"
 #include "Utility/Handle/Handles.h"
+#include "Utility/MetaProgramming/HasMethod.h"
+#include "Utility/Misc/Allocator.h"
+#include "Utility/Misc/Name.h"
 #include "Utility/Misc/Primitives.h"
+#include "Utility/Misc/TypeTraits.h"
 
 namespace Phoenix
 {
+	F_DefineTrait_HasMethod(GetMemorySize);
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Describes items to TNamedItemCache.
+	*
+	*	@desc GetSize estimates how many bytes an item keeps alive.  Types with a
+	*		GetMemorySize() method report that, and everything else reports its sizeof.
+	*		IsPinned tells the cache that something besides the cache still uses the
+	*		item, so it must not be evicted.
+	*	@note Specialize this for types that need something else.
+	*/
 	template <class T>
+	struct TNamedItemCacheTraits
+	{
+		template <class TItem, TEnableIf<THasMethod_GetMemorySize<TItem>::Value, Int32> = 0>
+		static SizeT GetSize(const TItem& Item)
+		{
+			const SizeT Size = Item.GetMemorySize();
+			return Size;
+		}
+
+		template <class TItem, TDisableIf<THasMethod_GetMemorySize<TItem>::Value, Int32> = 0>
+		static SizeT GetSize(const TItem&)
+		{
+			return sizeof(TItem);
+		}
+
+		static bool IsPinned(const T&)
+		{
+			return false;
+		}
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Cached handles are sized by the item they refer to, and are pinned while
+	*		any handle besides the cache's own refers to it.
+	*/
+	template <class T, class TPolicy>
+	struct TNamedItemCacheTraits<THandle<T, TPolicy>>
+	{
+		static SizeT GetSize(const THandle<T, TPolicy>& Handle)
+		{
+			const SizeT Size = Handle.IsValid() ? TNamedItemCacheTraits<T>::GetSize(*Handle) : 0;
+			return Size;
+		}
+
+		static bool IsPinned(const THandle<T, TPolicy>& Handle)
+		{
+			const bool Result = Handle.IsValid() && Handle.GetRefCount() > 1;
+			return Result;
+		}
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Remembers the handle that a name last resolved to in a TNamedItemCache.
+	*
+	*	@desc Resolve only looks the name up when it differs from the last one, or when
+	*		the last lookup missed, so resolving the same name every frame is an integer
+	*		compare.  The handle is held in between, which pins its item in the cache.
+	*/
+	template <class T, class TPolicy = FHandlePolicy>
+	struct TNamedHandleRef
+	{
+		typedef THandle<T, TPolicy> HandleT;
+
+		FName Name;
+		HandleT Handle;
+
+		template <class TCache>
+		const HandleT& Resolve(const FName& InName, const TCache& Cache);
+	};
+
+	template <class T, class TPolicy>
+	template <class TCache>
+	const THandle<T, TPolicy>& TNamedHandleRef<T, TPolicy>::Resolve(const FName& InName, const TCache& Cache)
+	{
+		if (Name != InName || !Handle.IsValid())
+		{
+			const HandleT DefaultHandle;
+			Name = InName;
+			Handle = Cache.GetItem(InName, DefaultHandle);
+		}
+
+		return Handle;
+	}
+
+	struct FNamedItemCacheStats
+	{
+		UInt64 Hits{ 0 };
+		UInt64 Misses{ 0 };
+		UInt64 Evictions{ 0 };
+		UInt64 EvictedBytes{ 0 };
+		SizeT ItemCount{ 0 };
+		SizeT UsedBytes{ 0 };
+		SizeT BudgetBytes{ 0 };
+
+		Float32 GetHitRate() const
+		{
+			const UInt64 Lookups = Hits + Misses;
+			const Float32 HitRate = Lookups ? static_cast<Float32>(Hits) / Lookups : 0.f;
+			return HitRate;
+		}
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Maps names to items, such as handles to loaded assets.
+	*
+	*	@desc Every item's size is estimated through TTraits when it is added.  When the
+	*		sizes add up to more than the budget, items are evicted in CLOCK order: items
+	*		that were looked up since the hand last passed them get a second chance, and
+	*		pinned items are skipped.  The budget is unlimited by default.
+	*	@note Keys are FNames, so lookups hash and compare integers rather than strings.
+	*/
+	template <class T, class TTraits = TNamedItemCacheTraits<T>>
 	class TNamedItemCache
 	{
 	public:
-		typedef FString KeyT;
+		typedef FName KeyT;
 		typedef T ValueT;
 
 		bool AddEntry(const KeyT& Key, const ValueT& Value);
 
-		bool AddEntry(KeyT&& Key, ValueT&& Value);
+		bool AddEntry(const KeyT& Key, ValueT&& Value);
 
 		void Clear();
 
@@ -38,83 +156,132 @@ namespace Phoenix
 
 		bool RemoveItem(const KeyT& Key);
 
+		//	--------------------------------------------------------------------------------
+		/*! \brief Sets how many bytes the items may add up to, and evicts down to it. */
+		void SetBudget(const SizeT BudgetBytes);
+
+		SizeT GetBudget() const;
+
+		SizeT GetUsedBytes() const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Evicts unpinned items until the cache fits its budget again.
+		*
+		*	@return Returns the number of items that were evicted.
+		*	@note Adding an item trims the cache, but items that were pinned at the time
+		*		are only evicted by a later trim.
+		*/
+		SizeT Trim();
+
+		const FNamedItemCacheStats& GetStats() const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Zeroes the hit, miss and eviction counters. */
+		void ResetStats();
+
 	protected:
 	private:
-		typedef TUnorderedMap<KeyT, ValueT> ItemsT;
-
-		ItemsT Items;
+		struct FEntry
+		{
+			KeyT Key;
+			ValueT Value;
+			SizeT Size;
+			mutable bool WasReferenced;
+
+			FEntry(const KeyT& InKey, ValueT&& InValue, const SizeT InSize)
+				: Key(InKey)
+				, Value(std::move(InValue))
+				, Size(InSize)
+				, WasReferenced(true)
+			{
+			}
+		};
+
+		typedef TTrackedAlloc<TPair<const KeyT, SizeT>, EMemoryTag::Assets> IndicesAllocatorT;
+		typedef TFlatHashMap<KeyT, SizeT, std::hash<KeyT>, std::equal_to<KeyT>, IndicesAllocatorT> IndicesT;
+		typedef TVector<FEntry, TTrackedAlloc<FEntry, EMemoryTag::Assets>> EntriesT;
+
+		IndicesT Indices;
+		EntriesT Entries;
+		SizeT ClockHand{ 0 };
+		SizeT Budget{ TNumericLimits<SizeT>::max() };
+		mutable FNamedItemCacheStats Stats;
+
+		void AddEntryInternal(const KeyT& Key, ValueT&& Value);
+
+		const FEntry* FindEntry(const KeyT& Key) const;
+
+		void RemoveEntry(const SizeT Index);
 	};
 
-	template <class T>
-	bool TNamedItemCache<T>::AddEntry(const KeyT& Key, const ValueT& Value)
+	template <class T, class TTraits>
+	bool TNamedItemCache<T, TTraits>::AddEntry(const KeyT& Key, const ValueT& Value)
 	{
-		F_Assert(Key.size(), "Key has a size of zero.");
+		F_Assert(!Key.IsNone(), "Key is empty.");
+
+		if (Indices.find(Key) != Indices.end())
+		{
+			return false;
+		}
 
-		const auto Pair = Items.emplace(Key, Value);
-		const bool WasEntryAdded = Pair.second;
-		return WasEntryAdded;
+		ValueT Copy = Value;
+		AddEntryInternal(Key, std::move(Copy));
+		return true;
 	}
 
-	template <class T>
-	bool TNamedItemCache<T>::AddEntry(KeyT&& Key, ValueT&& Value)
+	template <class T, class TTraits>
+	bool TNamedItemCache<T, TTraits>::AddEntry(const KeyT& Key, ValueT&& Value)
 	{
-		F_Assert(Key.size(), "Key has a size of zero.");
+		F_Assert(!Key.IsNone(), "Key is empty.");
 
-		const auto Iter = Items.find(Key);
-		if (Iter != Items.end())
+		if (Indices.find(Key) != Indices.end())
 		{
 			return false;
 		}
 
-		const auto Pair = Items.emplace(std::move(Key), std::move(Value));
-		const bool WasEntryAdded = Pair.second;
-		return WasEntryAdded;
+		AddEntryInternal(Key, std::move(Value));
+		return true;
 	}
 
-	template <class T>
-	void TNamedItemCache<T>::Clear()
+	template <class T, class TTraits>
+	void TNamedItemCache<T, TTraits>::Clear()
 	{
-		Items.clear();
+		Indices.clear();
+		Entries.clear();
+		ClockHand = 0;
+		Stats.UsedBytes = 0;
 	}
 
-	template <class T>
-	T* TNamedItemCache<T>::GetItem(const KeyT& Key)
+	template <class T, class TTraits>
+	T* TNamedItemCache<T, TTraits>::GetItem(const KeyT& Key)
 	{
-		F_Assert(Key.size(), "Key has a size of zero.");
-
-		const auto Iter = Items.find(Key);
-		const bool WasItemFound = Iter != Items.end();
-
-		if (WasItemFound)
+		const FEntry* const Entry = FindEntry(Key);
+		if (Entry)
 		{
-			T* const Value = &Iter->second;
+			T* const Value = const_cast<T*>(&Entry->Value);
 			return Value;
 		}
 
 		return nullptr;
 	}
 
-	template <class T>
-	const T* TNamedItemCache<T>::GetItem(const KeyT& Key) const
+	template <class T, class TTraits>
+	const T* TNamedItemCache<T, TTraits>::GetItem(const KeyT& Key) const
 	{
-		F_Assert(Key.size(), "Key has a size of zero.");
-
-		const auto Iter = Items.find(Key);
-		const bool WasItemFound = Iter != Items.end();
-
-		if (WasItemFound)
+		const FEntry* const Entry = FindEntry(Key);
+		if (Entry)
 		{
-			const T* const Value = &Iter->second;
+			const T* const Value = &Entry->Value;
 			return Value;
 		}
 
 		return nullptr;
 	}
 
-	template <class T>
-	T& TNamedItemCache<T>::GetItem(const KeyT& Key, T& DefaultReturnValue)
+	template <class T, class TTraits>
+	T& TNamedItemCache<T, TTraits>::GetItem(const KeyT& Key, T& DefaultReturnValue)
 	{
-		F_Assert(Key.size(), "Key has a size of zero.");
+		F_Assert(!Key.IsNone(), "Key is empty.");
 
 		T* Result = GetItem(Key);
 		if (!Result)
@@ -125,10 +292,10 @@ namespace Phoenix
 		return *Result;
 	}
 
-	template <class T>
-	const T& TNamedItemCache<T>::GetItem(const KeyT& Key, const T& DefaultReturnValue) const
+	template <class T, class TTraits>
+	const T& TNamedItemCache<T, TTraits>::GetItem(const KeyT& Key, const T& DefaultReturnValue) const
 	{
-		F_Assert(Key.size(), "Key has a size of zero.");
+		F_Assert(!Key.IsNone(), "Key is empty.");
 
 		const T* const Result = GetItem(Key);
 		if (!Result)
@@ -139,8 +306,8 @@ namespace Phoenix
 		return *Result;
 	}
 
-	template <class T>
-	T TNamedItemCache<T>::GetItemCopy(const KeyT& Key)
+	template <class T, class TTraits>
+	T TNamedItemCache<T, TTraits>::GetItemCopy(const KeyT& Key)
 	{
 		T* Item = GetItem(Key);
 		if (!Item)
@@ -152,33 +319,165 @@ namespace Phoenix
 		return *Item;
 	}
 
-	template <class T>
-	bool TNamedItemCache<T>::HasItem(const KeyT& Key) const
+	template <class T, class TTraits>
+	bool TNamedItemCache<T, TTraits>::HasItem(const KeyT& Key) const
 	{
-		F_Assert(Key.size(), "Key has a size of zero.");
+		F_Assert(!Key.IsNone(), "Key is empty.");
 
-		const auto Iter = Items.find(Key);
-		const bool WasItemFound = Iter != Items.end();
+		const auto Iter = Indices.find(Key);
+		const bool WasItemFound = Iter != Indices.end();
 		return WasItemFound;
 	}
 
-	template <class T>
-	SizeT TNamedItemCache<T>::GetItemCount() const
+	template <class T, class TTraits>
+	SizeT TNamedItemCache<T, TTraits>::GetItemCount() const
 	{
-		const SizeT ItemCount = Items.size();
+		const SizeT ItemCount = Entries.size();
 		return ItemCount;
 	}
 
-	template <class T>
-	bool TNamedItemCache<T>::RemoveItem(const KeyT& Key)
+	template <class T, class TTraits>
+	bool TNamedItemCache<T, TTraits>::RemoveItem(const KeyT& Key)
+	{
+		F_Assert(!Key.IsNone(), "Key is empty.");
+
+		const auto Iter = Indices.find(Key);
+		if (Iter == Indices.end())
+		{
+			return false;
+		}
+
+		RemoveEntry(Iter->second);
+		return true;
+	}
+
+	template <class T, class TTraits>
+	void TNamedItemCache<T, TTraits>::SetBudget(const SizeT BudgetBytes)
+	{
+		Budget = BudgetBytes;
+		Trim();
+	}
+
+	template <class T, class TTraits>
+	SizeT TNamedItemCache<T, TTraits>::GetBudget() const
+	{
+		return Budget;
+	}
+
+	template <class T, class TTraits>
+	SizeT TNamedItemCache<T, TTraits>::GetUsedBytes() const
 	{
-		F_Assert(Key.size(), "Key has a size of zero.");
+		return Stats.UsedBytes;
+	}
+
+	template <class T, class TTraits>
+	SizeT TNamedItemCache<T, TTraits>::Trim()
+	{
+		SizeT EvictionCount = 0;
 
-		const auto Iter = Items.erase(Key);
-		const bool WasItemRemoved = Iter == 1;
-		return WasItemRemoved;
+		// Two full sweeps without an eviction means every remaining item is pinned, since
+		// the first sweep clears every reference bit.
+		SizeT StepsWithoutEviction = 0;
+		while (Stats.UsedBytes > Budget && StepsWithoutEviction < Entries.size() * 2)
+		{
+			if (ClockHand >= Entries.size())
+			{
+				ClockHand = 0;
+			}
+
+			FEntry& Entry = Entries[ClockHand];
+			if (TTraits::IsPinned(Entry.Value))
+			{
+				++ClockHand;
+				++StepsWithoutEviction;
+				continue;
+			}
+
+			if (Entry.WasReferenced)
+			{
+				Entry.WasReferenced = false;
+				++ClockHand;
+				++StepsWithoutEviction;
+				continue;
+			}
+
+			++Stats.Evictions;
+			Stats.EvictedBytes += Entry.Size;
+
+			// The last entry is moved under the hand, so the hand stays put.
+			RemoveEntry(ClockHand);
+			StepsWithoutEviction = 0;
+			++EvictionCount;
+		}
+
+		return EvictionCount;
+	}
+
+	template <class T, class TTraits>
+	const FNamedItemCacheStats& TNamedItemCache<T, TTraits>::GetStats() const
+	{
+		Stats.ItemCount = Entries.size();
+		Stats.BudgetBytes = Budget;
+		return Stats;
+	}
+
+	template <class T, class TTraits>
+	void TNamedItemCache<T, TTraits>::ResetStats()
+	{
+		Stats.Hits = 0;
+		Stats.Misses = 0;
+		Stats.Evictions = 0;
+		Stats.EvictedBytes = 0;
+	}
+
+	template <class T, class TTraits>
+	void TNamedItemCache<T, TTraits>::AddEntryInternal(const KeyT& Key, ValueT&& Value)
+	{
+		const SizeT Size = TTraits::GetSize(Value);
+
+		Indices.emplace(Key, Entries.size());
+		Entries.emplace_back(Key, std::move(Value), Size);
+		Stats.UsedBytes += Size;
+
+		Trim();
+	}
+
+	template <class T, class TTraits>
+	const typename TNamedItemCache<T, TTraits>::FEntry* TNamedItemCache<T, TTraits>::FindEntry(const KeyT& Key) const
+	{
+		F_Assert(!Key.IsNone(), "Key is empty.");
+
+		const auto Iter = Indices.find(Key);
+		if (Iter == Indices.end())
+		{
+			++Stats.Misses;
+			return nullptr;
+		}
+
+		++Stats.Hits;
+
+		const FEntry* const Entry = &Entries[Iter->second];
+		Entry->WasReferenced = true;
+		return Entry;
+	}
+
+	template <class T, class TTraits>
+	void TNamedItemCache<T, TTraits>::RemoveEntry(const SizeT Index)
+	{
+		F_Assert(Index < Entries.size(), "Index " << Index << " is out of range.");
+
+		Stats.UsedBytes -= Entries[Index].Size;
+		Indices.erase(Entries[Index].Key);
+
+		const SizeT LastIndex = Entries.size() - 1;
+		if (Index != LastIndex)
+		{
+			Entries[Index] = std::move(Entries[LastIndex]);
+			Indices[Entries[Index].Key] = Index;
+		}
+
+		Entries.pop_back();
 	}
 }
 
 #endif
-
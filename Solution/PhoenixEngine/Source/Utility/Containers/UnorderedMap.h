@@ -5,8 +5,9 @@
 
 namespace Phoenix
 {
-	template <class Key, class Value>
-	using TUnorderedMap = std::unordered_map<Key, Value>;
+	template <class Key, class Value, class THash = std::hash<Key>, class TKeyEqual = std::equal_to<Key>,
+		class TAllocator = std::allocator<std::pair<const Key, Value>>>
+	using TUnorderedMap = std::unordered_map<Key, Value, THash, TKeyEqual, TAllocator>;
 }
 
 #endif
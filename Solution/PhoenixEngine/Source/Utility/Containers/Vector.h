@@ -5,8 +5,8 @@
 
 namespace Phoenix
 {
-	template <class T>
-	using TVector = std::vector<T>;
+	template <class T, class TAllocator = std::allocator<T>>
+	using TVector = std::vector<T, TAllocator>;
 }
 
 #endif
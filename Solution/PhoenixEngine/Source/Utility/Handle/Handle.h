@@ -4,13 +4,22 @@
 #include "Utility/Debug/Debug.h"
 #include "Utility/Handle/HandleData.h"
 #include "Utility/Misc/Primitives.h"
+#include "Utility/Threading/Mutex.h"
 
 namespace Phoenix
 {
-	template <class T>
+	template <class T, class TPolicy>
+	class TWeakHandle;
+
+	template <class T, class TPolicy = FHandlePolicy>
 	class THandle
 	{
+		friend class TWeakHandle<T, TPolicy>;
+
 	public:
+		typedef THandlesData<T, TPolicy> HandlesDataT;
+		typedef THandleItemData<TPolicy> ItemDataT;
+
 		THandle() = default;
 
 		THandle(const THandle&);
@@ -21,7 +30,12 @@ namespace Phoenix
 
 		~THandle();
 
-		void Init(THandlesData<T>* InHandleData, const SizeT InHIDataIndex);
+		//	--------------------------------------------------------------------------------
+		/*! \brief Points this handle at an item whose reference count already includes it.
+		*
+		*	@note This is for THandles and TWeakHandle use only.
+		*/
+		void Init(HandlesDataT* InHandleData, ItemDataT* InItemData, const UInt32 InGeneration);
 
 		bool IsValid() const;
 
@@ -29,6 +43,13 @@ namespace Phoenix
 
 		SizeT GetRefCount() const;
 
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the generation of the item this handle refers to.
+		*
+		*	@note Together with the item it identifies one lifetime of an item slot.
+		*/
+		UInt32 GetGeneration() const;
+
 		T& Get();
 
 		const T& Get() const;
@@ -43,36 +64,35 @@ namespace Phoenix
 
 	protected:
 	private:
-		THandlesData<T>* HandleData{ nullptr };
-		SizeT HIDataIndex{ 0 };
-
-		template <bool AssertValidRefCount = true>
-		THandleItemData& GetHandleItemData();
+		HandlesDataT* HandleData{ nullptr };
+		ItemDataT* ItemData{ nullptr };
+		UInt32 Generation{ 0 };
 
 		template <bool AssertValidRefCount = true>
-		const THandleItemData& GetHandleItemData() const;
-
-		SizeT& GetRefCountReference();
+		ItemDataT& GetItemData() const;
 
-		const SizeT& GetRefCountReference() const;
+		void Release();
 
 		void PostMoveReset();
 	};
 
 	template <class T>
-	THandle<T>::THandle(const THandle<T>& RHS)
+	using TThreadSafeHandle = THandle<T, FThreadSafeHandlePolicy>;
+
+	template <class T, class TPolicy>
+	THandle<T, TPolicy>::THandle(const THandle<T, TPolicy>& RHS)
 		: HandleData(RHS.HandleData)
-		, HIDataIndex(RHS.HIDataIndex)
+		, ItemData(RHS.ItemData)
+		, Generation(RHS.Generation)
 	{
 		if (HandleData)
 		{
-			SizeT& RefCount = GetRefCountReference();
-			++RefCount;
+			TPolicy::FetchAdd(ItemData->State, 1);
 		}
 	}
 
-	template <class T>
-	THandle<T>& THandle<T>::operator=(const THandle<T>& RHS)
+	template <class T, class TPolicy>
+	THandle<T, TPolicy>& THandle<T, TPolicy>::operator=(const THandle<T, TPolicy>& RHS)
 	{
 		if (this == &RHS)
 		{
@@ -82,27 +102,28 @@ namespace Phoenix
 		DeInit();
 
 		HandleData = RHS.HandleData;
-		HIDataIndex = RHS.HIDataIndex;
+		ItemData = RHS.ItemData;
+		Generation = RHS.Generation;
 
 		if (HandleData)
 		{
-			SizeT& RefCount = GetRefCountReference();
-			++RefCount;
+			TPolicy::FetchAdd(ItemData->State, 1);
 		}
 
 		return *this;
 	}
 
-	template <class T>
-	THandle<T>::THandle(THandle<T>&& RHS)
+	template <class T, class TPolicy>
+	THandle<T, TPolicy>::THandle(THandle<T, TPolicy>&& RHS)
 		: HandleData(RHS.HandleData)
-		, HIDataIndex(RHS.HIDataIndex)
+		, ItemData(RHS.ItemData)
+		, Generation(RHS.Generation)
 	{
 		RHS.PostMoveReset();
 	}
 
-	template <class T>
-	THandle<T>& THandle<T>::operator=(THandle<T>&& RHS)
+	template <class T, class TPolicy>
+	THandle<T, TPolicy>& THandle<T, TPolicy>::operator=(THandle<T, TPolicy>&& RHS)
 	{
 		if (this == &RHS)
 		{
@@ -112,190 +133,177 @@ namespace Phoenix
 		DeInit();
 
 		HandleData = RHS.HandleData;
-		HIDataIndex = RHS.HIDataIndex;
+		ItemData = RHS.ItemData;
+		Generation = RHS.Generation;
 
 		RHS.PostMoveReset();
 		return *this;
 	}
 
-	template <class T>
-	THandle<T>::~THandle()
+	template <class T, class TPolicy>
+	THandle<T, TPolicy>::~THandle()
 	{
 		DeInit();
 	}
 
-	template <class T>
-	bool THandle<T>::IsValid() const
+	template <class T, class TPolicy>
+	bool THandle<T, TPolicy>::IsValid() const
 	{
 		const bool Result = HandleData != nullptr;
 		return Result;
 	}
 
-	template <class T>
-	void THandle<T>::DeInit()
+	template <class T, class TPolicy>
+	void THandle<T, TPolicy>::DeInit()
 	{
 		if (!HandleData)
 		{
 			return;
 		}
 
-		SizeT& ReferenceCount = GetRefCountReference();
+		const UInt64 PreviousState = TPolicy::FetchSub(ItemData->State, 1);
+		const UInt32 PreviousRefCount = ItemDataT::GetRefCount(PreviousState);
 
-		F_Assert(ReferenceCount > 0, "When HandleData is not null, ReferenceCount should be at least 1.");
-		--ReferenceCount;
+		F_Assert(PreviousRefCount > 0, "When HandleData is not null, ReferenceCount should be at least 1.");
+		F_Assert(ItemDataT::GetGeneration(PreviousState) == Generation,
+			"Handle of generation " << Generation << " refers to an item of generation "
+			<< ItemDataT::GetGeneration(PreviousState));
 
-		if (ReferenceCount == 0)
+		if (PreviousRefCount == 1)
 		{
-			F_Assert(HandleData->Data.size(), "A non-zero size was expected.");
-
-			THandleItemData& HIData = GetHandleItemData<false>();
-
-			const SizeT CurrentDataIndex = HIData.DataIndex;
-			const SizeT LastDataIndex = HandleData->Data.size() - 1;
-
-			F_Assert(CurrentDataIndex <= LastDataIndex,
-				CurrentDataIndex << " is higher than the container size of " << LastDataIndex);
-
-			F_DebugCode(bool IsIndexFree = false);
-			if (CurrentDataIndex != LastDataIndex)
-			{
-				HandleData->Data[CurrentDataIndex] = std::move(HandleData->Data[LastDataIndex]);
-				const SizeT HIDataSize = HandleData->HIData.size();
-
-				for (SizeT I = 0; I < HIDataSize; ++I)
-				{
-					THandleItemData& Item = HandleData->HIData[I];
-
-					const bool ItemWasInLastSlot = Item.DataIndex == LastDataIndex;
-					if (ItemWasInLastSlot)
-					{
-						F_DebugCode(F_Assert(!IsIndexFree, "Index is being set twice."));
-						F_DebugCode(IsIndexFree = true);
-
-						HandleData->HIData[HIDataIndex] = THandleItemData();
-						Item.DataIndex = CurrentDataIndex;
-						F_DebugCode(continue);
-						break;
-					}
-				}
-			}
-
-			HandleData->UnusedHIData.push_back(HIDataIndex);
-			HandleData->Data.pop_back();
+			Release();
 		}
 
-		HandleData = nullptr;
-		HIDataIndex = 0;
+		PostMoveReset();
 	}
 
-	template <class T>
-	T& THandle<T>::Get()
+	template <class T, class TPolicy>
+	void THandle<T, TPolicy>::Release()
 	{
-		THandleItemData& HIData = GetHandleItemData();
-		T& Item = HandleData->Data[HIData.DataIndex];
-		return Item;
+		TLockGuard<typename TPolicy::LockT> Guard(HandleData->Lock);
+
+		F_Assert(HandleData->Data.size(), "A non-zero size was expected.");
+
+		const SizeT CurrentDataIndex = ItemData->DataIndex;
+		const SizeT LastDataIndex = HandleData->Data.size() - 1;
+
+		F_Assert(CurrentDataIndex <= LastDataIndex,
+			CurrentDataIndex << " is higher than the container size of " << LastDataIndex);
+
+		F_Assert(HandleData->DataToItemData[CurrentDataIndex] == ItemData,
+			"Data index " << CurrentDataIndex << " does not map back to its handle.");
+
+		if (CurrentDataIndex != LastDataIndex)
+		{
+			ItemDataT* const MovedItemData = HandleData->DataToItemData[LastDataIndex];
+
+			HandleData->Data[CurrentDataIndex] = std::move(HandleData->Data[LastDataIndex]);
+			HandleData->DataToItemData[CurrentDataIndex] = MovedItemData;
+			MovedItemData->DataIndex = CurrentDataIndex;
+		}
+
+		// Bumping the generation makes every weak handle to this item stale, before the
+		// item data can be handed out again.
+		ItemData->DataIndex = TNumericLimits<SizeT>::max();
+		TPolicy::Store(ItemData->State, ItemDataT::MakeState(Generation + 1, 0));
+
+		HandleData->UnusedItemData.push_back(ItemData);
+		HandleData->DataToItemData.pop_back();
+		HandleData->Data.pop_back();
+		++HandleData->Revision;
 	}
 
-	template <class T>
-	SizeT THandle<T>::GetRefCount() const
+	template <class T, class TPolicy>
+	T& THandle<T, TPolicy>::Get()
+	{
+		ItemDataT& Item = GetItemData();
+		T& Result = HandleData->Data[Item.DataIndex];
+		return Result;
+	}
+
+	template <class T, class TPolicy>
+	SizeT THandle<T, TPolicy>::GetRefCount() const
 	{
-		const SizeT RefCount = GetRefCountReference();
+		const ItemDataT& Item = GetItemData<false>();
+		const SizeT RefCount = ItemDataT::GetRefCount(TPolicy::Load(Item.State));
 		return RefCount;
 	}
 
-	template <class T>
-	const T& THandle<T>::Get() const
+	template <class T, class TPolicy>
+	UInt32 THandle<T, TPolicy>::GetGeneration() const
 	{
-		const THandleItemData& HIData = GetHandleItemData();
-		T& Item = HandleData->Data[HIData.DataIndex];
-		return Item;
+		return Generation;
 	}
 
-	template <class T>
-	T& THandle<T>::operator*()
+	template <class T, class TPolicy>
+	const T& THandle<T, TPolicy>::Get() const
+	{
+		const ItemDataT& Item = GetItemData();
+		const T& Result = HandleData->Data[Item.DataIndex];
+		return Result;
+	}
+
+	template <class T, class TPolicy>
+	T& THandle<T, TPolicy>::operator*()
 	{
 		T& Item = Get();
 		return Item;
 	}
 
-	template <class T>
-	const T& THandle<T>::operator*() const
+	template <class T, class TPolicy>
+	const T& THandle<T, TPolicy>::operator*() const
 	{
 		const T& Item = Get();
 		return Item;
 	}
 
-	template <class T>
-	T* THandle<T>::operator->()
+	template <class T, class TPolicy>
+	T* THandle<T, TPolicy>::operator->()
 	{
-		THandleItemData& HIData = GetHandleItemData();
-		T* const Item = &HandleData->Data[HIData.DataIndex];
+		T* const Item = &Get();
 		return Item;
 	}
 
-	template <class T>
-	const T* THandle<T>::operator->() const
+	template <class T, class TPolicy>
+	const T* THandle<T, TPolicy>::operator->() const
 	{
-		const THandleItemData& HIData = GetHandleItemData();
-		const T* const Item = &HandleData->Data[HIData.DataIndex];
+		const T* const Item = &Get();
 		return Item;
 	}
 
-	template <class T>
-	void THandle<T>::Init(THandlesData<T>* InHandleData, const SizeT InHIDataIndex)
+	template <class T, class TPolicy>
+	void THandle<T, TPolicy>::Init(HandlesDataT* InHandleData, ItemDataT* InItemData, const UInt32 InGeneration)
 	{
 		DeInit();
 
 		F_Assert(InHandleData, "InHandleData is null.");
-		F_Assert(InHIDataIndex < InHandleData->HIData.size(),
-			"ID of " << InHIDataIndex << " is too large for container size of " << InHandleData->HIData.size());
+		F_Assert(InItemData, "InItemData is null.");
 
 		HandleData = InHandleData;
-		HIDataIndex = InHIDataIndex;
-	}
-
-	template <class T>
-	template <bool AssertValidRefCount>
-	THandleItemData& THandle<T>::GetHandleItemData()
-	{
-		F_Assert(IsValid(), "Handle is not valid.");
-		THandleItemData& HIData = HandleData->HIData[HIDataIndex];
-		F_AssertIf(HIData.RefCount > 0, "Invalid reference count of " << HIData.RefCount, AssertValidRefCount);
-
-		return HIData;
+		ItemData = InItemData;
+		Generation = InGeneration;
 	}
 
-	template <class T>
+	template <class T, class TPolicy>
 	template <bool AssertValidRefCount>
-	const THandleItemData& THandle<T>::GetHandleItemData() const
-	{
-		F_Assert(IsValid(), "Handle is not valid.");
-		const THandleItemData& HIData = HandleData->HIData[HIDataIndex];
-		F_AssertIf(HIData.RefCount > 0, "Invalid reference count of " << HIData.RefCount, AssertValidRefCount);
-
-		return HIData;
-	}
-
-	template <class T>
-	SizeT& THandle<T>::GetRefCountReference()
-	{
-		F_Assert(IsValid(), "Handle is not valid.");
-		THandleItemData& HIData = HandleData->HIData[HIDataIndex];
-		return HIData.RefCount;
-	}
-
-	template <class T>
-	const SizeT& THandle<T>::GetRefCountReference() const
+	THandleItemData<TPolicy>& THandle<T, TPolicy>::GetItemData() const
 	{
 		F_Assert(IsValid(), "Handle is not valid.");
-		const THandleItemData& HIData = HandleData->HIData[HIDataIndex];
-		return HIData.RefCount;
+		const UInt64 State = TPolicy::Load(ItemData->State);
+		F_AssertIf(ItemDataT::GetRefCount(State) > 0,
+			"Invalid reference count of " << ItemDataT::GetRefCount(State), AssertValidRefCount);
+		F_AssertIf(ItemDataT::GetGeneration(State) == Generation,
+			"Stale handle of generation " << Generation << ", the item is now at generation "
+			<< ItemDataT::GetGeneration(State), AssertValidRefCount);
+
+		return *ItemData;
 	}
 
-	template <class T>
-	void THandle<T>::PostMoveReset()
+	template <class T, class TPolicy>
+	void THandle<T, TPolicy>::PostMoveReset()
 	{
 		HandleData = nullptr;
-		HIDataIndex = 0;
+		ItemData = nullptr;
+		Generation = 0;
 	}
 }
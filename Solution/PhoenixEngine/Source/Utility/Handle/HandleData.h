@@ -1,26 +1,185 @@
 #pragma once
 
 #include "Utility/Containers/Vector.h"
+#include "Utility/Misc/Allocator.h"
+#include "Utility/Misc/Memory.h"
 #include "Utility/Misc/Primitives.h"
+#include "Utility/Threading/Atomic.h"
+#include "Utility/Threading/Mutex.h"
 
 namespace Phoenix
 {
+	//	--------------------------------------------------------------------------------
+	/*! \brief Stands in for FMutex when handles never leave the thread that owns them. */
+	struct FHandleNullLock
+	{
+		void lock() {}
+		void unlock() {}
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief The default handle policy.  Reference counts are plain integers, so every
+	*		copy and release of a handle must happen on one thread.
+	*/
+	struct FHandlePolicy
+	{
+		typedef UInt64 StateT;
+		typedef FHandleNullLock LockT;
+
+		static UInt64 Load(const StateT& State)
+		{
+			return State;
+		}
+
+		static void Store(StateT& State, const UInt64 Value)
+		{
+			State = Value;
+		}
+
+		static UInt64 FetchAdd(StateT& State, const UInt64 Value)
+		{
+			const UInt64 Previous = State;
+			State += Value;
+			return Previous;
+		}
+
+		static UInt64 FetchSub(StateT& State, const UInt64 Value)
+		{
+			const UInt64 Previous = State;
+			State -= Value;
+			return Previous;
+		}
+
+		static bool CompareExchange(StateT& State, UInt64& Expected, const UInt64 Desired)
+		{
+			if (State != Expected)
+			{
+				Expected = State;
+				return false;
+			}
+
+			State = Desired;
+			return true;
+		}
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief A handle policy whose reference counts and generations are atomic.
+	*
+	*	@desc Handles may be copied, released and validated from any thread.  Creating
+	*		an item and removing it after its last release take the container's lock.
+	*	@note Only the bookkeeping is thread safe.  The items themselves are swapped
+	*		around as others are released, so reads of an item must still be ordered
+	*		against releases the same way the rest of the game and GFX data is.
+	*/
+	struct FThreadSafeHandlePolicy
+	{
+		typedef TAtomic<UInt64> StateT;
+		typedef FMutex LockT;
+
+		static UInt64 Load(const StateT& State)
+		{
+			return State.load(std::memory_order_acquire);
+		}
+
+		static void Store(StateT& State, const UInt64 Value)
+		{
+			State.store(Value, std::memory_order_release);
+		}
+
+		static UInt64 FetchAdd(StateT& State, const UInt64 Value)
+		{
+			return State.fetch_add(Value, std::memory_order_relaxed);
+		}
+
+		static UInt64 FetchSub(StateT& State, const UInt64 Value)
+		{
+			return State.fetch_sub(Value, std::memory_order_acq_rel);
+		}
+
+		static bool CompareExchange(StateT& State, UInt64& Expected, const UInt64 Desired)
+		{
+			return State.compare_exchange_weak(Expected, Desired, std::memory_order_acquire);
+		}
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Per item bookkeeping that every handle to the item points at.
+	*
+	*	@desc The generation and the reference count share one word, so a weak handle
+	*		can check that its item is alive and take a reference in a single step.
+	*		The generation is bumped whenever the item is released, which makes every
+	*		handle that was made before the release detectably stale.
+	*	@note These are allocated in blocks that never move, so handles may point at
+	*		them directly while more items are created.
+	*/
+	template <class TPolicy>
 	struct THandleItemData
 	{
+		static const UInt64 RefCountMask = 0xFFFFFFFFull;
+		static const UInt64 GenerationShift = 32;
+
 		SizeT DataIndex{ TNumericLimits<SizeT>::max() };
-		SizeT RefCount{ 0 };
+		typename TPolicy::StateT State{ 0 };
+
+		static UInt64 MakeState(const UInt32 Generation, const UInt32 RefCount)
+		{
+			const UInt64 Result = (static_cast<UInt64>(Generation) << GenerationShift) | RefCount;
+			return Result;
+		}
+
+		static UInt32 GetGeneration(const UInt64 State)
+		{
+			const UInt32 Result = static_cast<UInt32>(State >> GenerationShift);
+			return Result;
+		}
+
+		static UInt32 GetRefCount(const UInt64 State)
+		{
+			const UInt32 Result = static_cast<UInt32>(State & RefCountMask);
+			return Result;
+		}
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief As many item datas as fit in the largest FPoolAlloc size class. */
+	template <class TPolicy>
+	struct THandleItemBlock
+	{
+		typedef THandleItemData<TPolicy> ItemDataT;
+
+		static const SizeT Size = FPoolAlloc::MaxBlockSize / sizeof(ItemDataT);
+
+		ItemDataT Items[Size];
 	};
 
-	template <class T>
+	template <class T, class TPolicy = FHandlePolicy>
 	struct THandlesData
 	{
+		typedef THandleItemData<TPolicy> ItemDataT;
+		typedef THandleItemBlock<TPolicy> ItemBlockT;
+
+		static_assert(FPoolAlloc::IsPoolable<ItemBlockT>(), "Item blocks should come from the pools.");
+
+		static const SizeT ItemBlockSize = ItemBlockT::Size;
+
 		typedef TVector<T> DataT;
-		typedef TVector<THandleItemData> HIDataT;
-		typedef TVector<SizeT> UnusedHIDataT;
+		typedef TVector<TUniquePtr<ItemBlockT, FAllocDeleter>> ItemBlocksT;
+		typedef TVector<ItemDataT*> ItemDataPtrsT;
 
 		DataT Data;
-		HIDataT HIData;
-		UnusedHIDataT UnusedHIData;
+
+		ItemBlocksT ItemBlocks;
+		SizeT ItemDataCount{ 0 };
+		ItemDataPtrsT UnusedItemData;
+
+		// Parallel to Data.  Holds the item data that points at each element, so the
+		// element that is swapped into a released slot can be redirected without a search.
+		ItemDataPtrsT DataToItemData;
+
+		// Bumped whenever an item is released, since that moves the last item into its slot.
+		UInt32 Revision{ 0 };
+
+		typename TPolicy::LockT Lock;
 	};
 }
-
@@ -1,16 +1,68 @@
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+
+#include "Utility/Debug/Assert.h"
 #include "Utility/Debug/Debug.h"
 #include "Utility/Handle/Handle.h"
 #include "Utility/Handle/HandleData.h"
+#include "Utility/Handle/WeakHandle.h"
+#include "Utility/Threading/Mutex.h"
 
 namespace Phoenix
 {
-	template <class T>
+	//	--------------------------------------------------------------------------------
+	/*! \brief A contiguous run of the items in a THandles, along with the handle slot
+	*		of each item.
+	*
+	*	@desc Items are laid out densely, so consumers can walk or copy them as a plain
+	*		array and only go through GetWeakHandle when they need to refer back to one.
+	*	@note A span is only valid until an item is created or released.
+	*/
+	template <class TItem, class TPolicy>
+	class TDenseHandleSpan
+	{
+	public:
+		typedef std::remove_const_t<TItem> ValueT;
+		typedef TWeakHandle<ValueT, TPolicy> WeakHandleT;
+		typedef THandlesData<ValueT, TPolicy> HandlesDataT;
+
+		TDenseHandleSpan(HandlesDataT* InHandleData, TItem* const InData, const SizeT InOffset, const SizeT InSize);
+
+		TItem* begin() const;
+
+		TItem* end() const;
+
+		TItem* data() const;
+
+		SizeT size() const;
+
+		TItem& operator[](const SizeT Index) const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the index into THandles::GetData of an item in this span. */
+		SizeT GetDenseIndex(const SizeT Index) const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets a weak handle to an item in this span, without taking a reference. */
+		WeakHandleT GetWeakHandle(const SizeT Index) const;
+
+	private:
+		HandlesDataT* HandleData;
+		TItem* Data;
+		SizeT Offset;
+		SizeT Size;
+	};
+
+	template <class T, class TPolicy = FHandlePolicy>
 	class THandles
 	{
 	public:
-		typedef THandle<T> HandleT;
+		typedef THandle<T, TPolicy> HandleT;
+		typedef TWeakHandle<T, TPolicy> WeakHandleT;
+		typedef TDenseHandleSpan<T, TPolicy> SpanT;
+		typedef TDenseHandleSpan<const T, TPolicy> ConstSpanT;
 
 		THandles() = default;
 
@@ -20,84 +72,316 @@ namespace Phoenix
 		THandles(THandles&&) = delete;
 		THandles& operator=(THandles&&) = delete;
 
+		//	--------------------------------------------------------------------------------
+		/*! \brief Creates an item in place and returns the only handle to it.
+		*
+		*	@param Args Arguments passed to T's constructor.
+		*/
 		template <class... Arguments>
-		THandle<T> CreateHandle(Arguments&&... Args);
+		HandleT CreateHandle(Arguments&&... Args);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Creates Count default constructed items in place, then lets Init set up
+		*		each one.
+		*
+		*	@param Count The number of items to create.
+		*	@param Init Called as Init(T& Item, SizeT Index) for every new item, where
+		*		Index counts from 0 to Count.
+		*	@param OutHandles The handles to the new items are appended here, in order.
+		*	@note Storage for every item is reserved up front, so the items are never moved
+		*		while they are being created.  Init must not create or release items in
+		*		this THandles.
+		*/
+		template <class TInit>
+		void EmplaceHandles(const SizeT Count, TInit&& Init, TVector<HandleT>& OutHandles);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Makes room for Count items in total, so that creating up to that many
+		*		items never reallocates.
+		*/
+		void Reserve(const SizeT Count);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Hands the items to Func as contiguous spans.
+		*
+		*	@param Func Called as Func(SpanT Span) for every span, in item order.
+		*	@param MaxSpanSize The largest number of items passed in one span.  By default
+		*		every item is passed in a single span.
+		*	@note Func must not create or release items in this THandles.
+		*/
+		template <class TFunc>
+		void ForEachDense(TFunc&& Func, const SizeT MaxSpanSize = TNumericLimits<SizeT>::max());
+
+		template <class TFunc>
+		void ForEachDense(TFunc&& Func, const SizeT MaxSpanSize = TNumericLimits<SizeT>::max()) const;
 
 		const TVector<T>& GetData() const;
 
 		SizeT GetDataSize() const;
 
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets a number that changes whenever items are moved around.
+		*
+		*	@desc Releasing an item moves the last item into its slot, so anything that
+		*		mirrors GetData by index is stale once this changes.  Creating items only
+		*		appends to GetData, so it leaves this unchanged.
+		*/
+		UInt32 GetRevision() const;
+
 		T& operator[](const SizeT Index);
 
 		const T& operator[](const SizeT Index) const;
 
 	protected:
 	private:
-		THandlesData<T> HandlesData;
+		typedef THandlesData<T, TPolicy> HandlesDataT;
+		typedef THandleItemData<TPolicy> ItemDataT;
+
+		HandlesDataT HandlesData;
+
+		void ReserveItemData(const SizeT Count);
+
+		ItemDataT* AcquireItemData();
+
+		HandleT AddHandleForLastItem();
 	};
 
 	template <class T>
+	using TThreadSafeHandles = THandles<T, FThreadSafeHandlePolicy>;
+
+	template <class TItem, class TPolicy>
+	TDenseHandleSpan<TItem, TPolicy>::TDenseHandleSpan(
+		HandlesDataT* InHandleData,
+		TItem* const InData,
+		const SizeT InOffset,
+		const SizeT InSize)
+		: HandleData(InHandleData)
+		, Data(InData)
+		, Offset(InOffset)
+		, Size(InSize)
+	{
+	}
+
+	template <class TItem, class TPolicy>
+	TItem* TDenseHandleSpan<TItem, TPolicy>::begin() const
+	{
+		return Data;
+	}
+
+	template <class TItem, class TPolicy>
+	TItem* TDenseHandleSpan<TItem, TPolicy>::end() const
+	{
+		return Data + Size;
+	}
+
+	template <class TItem, class TPolicy>
+	TItem* TDenseHandleSpan<TItem, TPolicy>::data() const
+	{
+		return Data;
+	}
+
+	template <class TItem, class TPolicy>
+	SizeT TDenseHandleSpan<TItem, TPolicy>::size() const
+	{
+		return Size;
+	}
+
+	template <class TItem, class TPolicy>
+	TItem& TDenseHandleSpan<TItem, TPolicy>::operator[](const SizeT Index) const
+	{
+		F_Assert(Index < Size, "Index " << Index << " is out of range for a span of " << Size);
+		return Data[Index];
+	}
+
+	template <class TItem, class TPolicy>
+	SizeT TDenseHandleSpan<TItem, TPolicy>::GetDenseIndex(const SizeT Index) const
+	{
+		const SizeT DenseIndex = Offset + Index;
+		return DenseIndex;
+	}
+
+	template <class TItem, class TPolicy>
+	TWeakHandle<std::remove_const_t<TItem>, TPolicy> TDenseHandleSpan<TItem, TPolicy>::GetWeakHandle(const SizeT Index) const
+	{
+		F_Assert(Index < Size, "Index " << Index << " is out of range for a span of " << Size);
+
+		typedef THandleItemData<TPolicy> ItemDataT;
+		ItemDataT* const ItemData = HandleData->DataToItemData[Offset + Index];
+
+		const UInt32 Generation = ItemDataT::GetGeneration(TPolicy::Load(ItemData->State));
+		const WeakHandleT WeakHandle(HandleData, ItemData, Generation);
+		return WeakHandle;
+	}
+
+	template <class T, class TPolicy>
 	template <class... Arguments>
-	THandle<T> THandles<T>::CreateHandle(Arguments&&... Args)
+	THandle<T, TPolicy> THandles<T, TPolicy>::CreateHandle(Arguments&&... Args)
+	{
+		TLockGuard<typename TPolicy::LockT> Guard(HandlesData.Lock);
+
+		HandlesData.Data.emplace_back(std::forward<Arguments>(Args)...);
+
+		HandleT Handle = AddHandleForLastItem();
+		return Handle;
+	}
+
+	template <class T, class TPolicy>
+	template <class TInit>
+	void THandles<T, TPolicy>::EmplaceHandles(const SizeT Count, TInit&& Init, TVector<HandleT>& OutHandles)
 	{
-		THandle<T> Handle;
-		
-		const SizeT DataIndex = HandlesData.Data.size();
-		HandlesData.Data.push_back(T(std::forward<Arguments>(Args)...));
+		TLockGuard<typename TPolicy::LockT> Guard(HandlesData.Lock);
+
+		const SizeT NewSize = HandlesData.Data.size() + Count;
+		HandlesData.Data.reserve(NewSize);
+		HandlesData.DataToItemData.reserve(NewSize);
 
-		const SizeT UnusedHIDataSize = HandlesData.UnusedHIData.size();
+		const SizeT UnusedItemDataSize = HandlesData.UnusedItemData.size();
+		const SizeT NewItemDataCount = Count > UnusedItemDataSize ? Count - UnusedItemDataSize : 0;
+		ReserveItemData(HandlesData.ItemDataCount + NewItemDataCount);
 
-		const bool CanReuseHIData = UnusedHIDataSize != 0;
-		if (CanReuseHIData)
+		OutHandles.reserve(OutHandles.size() + Count);
+
+		for (SizeT I = 0; I < Count; ++I)
 		{
-			const SizeT HIDataIndex = HandlesData.UnusedHIData[UnusedHIDataSize - 1];
-			HandlesData.UnusedHIData.pop_back();
-			
-			THandleItemData& ReusedHIData = HandlesData.HIData[HIDataIndex];
-			
-			ReusedHIData.DataIndex = DataIndex;
-			ReusedHIData.RefCount = 1;
-
-			Handle.Init(&HandlesData, HIDataIndex);
-			return Handle;
+			HandlesData.Data.emplace_back();
+			Init(HandlesData.Data.back(), I);
+
+			OutHandles.emplace_back(AddHandleForLastItem());
 		}
+	}
 
-		THandleItemData NewHIData;
+	template <class T, class TPolicy>
+	void THandles<T, TPolicy>::Reserve(const SizeT Count)
+	{
+		TLockGuard<typename TPolicy::LockT> Guard(HandlesData.Lock);
 
-		NewHIData.DataIndex = DataIndex;
-		NewHIData.RefCount = 1;
+		HandlesData.Data.reserve(Count);
+		HandlesData.DataToItemData.reserve(Count);
+		ReserveItemData(Count);
+	}
 
-		const SizeT HIDataIndex = HandlesData.HIData.size();
-		HandlesData.HIData.emplace_back(std::move(NewHIData));
+	template <class T, class TPolicy>
+	template <class TFunc>
+	void THandles<T, TPolicy>::ForEachDense(TFunc&& Func, const SizeT MaxSpanSize)
+	{
+		F_Assert(MaxSpanSize > 0, "Spans must hold at least one item.");
 
-		Handle.Init(&HandlesData, HIDataIndex);
-		return Handle;
+		const SizeT DataSize = HandlesData.Data.size();
+		for (SizeT Offset = 0; Offset < DataSize; Offset += MaxSpanSize)
+		{
+			const SizeT SpanSize = std::min(MaxSpanSize, DataSize - Offset);
+			const SpanT Span(&HandlesData, HandlesData.Data.data() + Offset, Offset, SpanSize);
+			Func(Span);
+		}
 	}
 
-	template <class T>
-	const TVector<T>& THandles<T>::GetData() const
+	template <class T, class TPolicy>
+	template <class TFunc>
+	void THandles<T, TPolicy>::ForEachDense(TFunc&& Func, const SizeT MaxSpanSize) const
+	{
+		F_Assert(MaxSpanSize > 0, "Spans must hold at least one item.");
+
+		// Spans only need the handle data to make weak handles, which never change it.
+		HandlesDataT* const SpanHandlesData = const_cast<HandlesDataT*>(&HandlesData);
+
+		const SizeT DataSize = HandlesData.Data.size();
+		for (SizeT Offset = 0; Offset < DataSize; Offset += MaxSpanSize)
+		{
+			const SizeT SpanSize = std::min(MaxSpanSize, DataSize - Offset);
+			const ConstSpanT Span(SpanHandlesData, HandlesData.Data.data() + Offset, Offset, SpanSize);
+			Func(Span);
+		}
+	}
+
+	template <class T, class TPolicy>
+	const TVector<T>& THandles<T, TPolicy>::GetData() const
 	{
 		return HandlesData.Data;
 	}
 
-	template <class T>
-	SizeT THandles<T>::GetDataSize() const
+	template <class T, class TPolicy>
+	SizeT THandles<T, TPolicy>::GetDataSize() const
 	{
 		const SizeT DataSize = HandlesData.Data.size();
 		return DataSize;
 	}
 
-	template <class T>
-	T& THandles<T>::operator[](const SizeT Index)
+	template <class T, class TPolicy>
+	UInt32 THandles<T, TPolicy>::GetRevision() const
+	{
+		return HandlesData.Revision;
+	}
+
+	template <class T, class TPolicy>
+	T& THandles<T, TPolicy>::operator[](const SizeT Index)
 	{
 		T& Item = HandlesData.Data[Index];
 		return Item;
 	}
 
-	template <class T>
-	const T& THandles<T>::operator[](const SizeT Index) const
+	template <class T, class TPolicy>
+	const T& THandles<T, TPolicy>::operator[](const SizeT Index) const
 	{
 		const T& Item = HandlesData.Data[Index];
 		return Item;
 	}
+
+	template <class T, class TPolicy>
+	void THandles<T, TPolicy>::ReserveItemData(const SizeT Count)
+	{
+		const SizeT BlockSize = HandlesDataT::ItemBlockSize;
+		const SizeT BlockCount = (Count + BlockSize - 1) / BlockSize;
+
+		HandlesData.UnusedItemData.reserve(Count);
+		HandlesData.ItemBlocks.reserve(BlockCount);
+
+		while (HandlesData.ItemBlocks.size() < BlockCount)
+		{
+			HandlesData.ItemBlocks.emplace_back(FAlloc::New<typename HandlesDataT::ItemBlockT>());
+		}
+	}
+
+	template <class T, class TPolicy>
+	THandleItemData<TPolicy>* THandles<T, TPolicy>::AcquireItemData()
+	{
+		const SizeT UnusedItemDataSize = HandlesData.UnusedItemData.size();
+
+		const bool CanReuseItemData = UnusedItemDataSize != 0;
+		if (CanReuseItemData)
+		{
+			ItemDataT* const ReusedItemData = HandlesData.UnusedItemData[UnusedItemDataSize - 1];
+			HandlesData.UnusedItemData.pop_back();
+			return ReusedItemData;
+		}
+
+		const SizeT BlockSize = HandlesDataT::ItemBlockSize;
+		const SizeT BlockIndex = HandlesData.ItemDataCount / BlockSize;
+		const SizeT IndexInBlock = HandlesData.ItemDataCount % BlockSize;
+
+		if (BlockIndex == HandlesData.ItemBlocks.size())
+		{
+			HandlesData.ItemBlocks.emplace_back(FAlloc::New<typename HandlesDataT::ItemBlockT>());
+		}
+
+		++HandlesData.ItemDataCount;
+
+		ItemDataT* const NewItemData = &HandlesData.ItemBlocks[BlockIndex]->Items[IndexInBlock];
+		return NewItemData;
+	}
+
+	template <class T, class TPolicy>
+	THandle<T, TPolicy> THandles<T, TPolicy>::AddHandleForLastItem()
+	{
+		HandleT Handle;
+
+		ItemDataT* const ItemData = AcquireItemData();
+		const UInt32 Generation = ItemDataT::GetGeneration(TPolicy::Load(ItemData->State));
+
+		ItemData->DataIndex = HandlesData.Data.size() - 1;
+		TPolicy::Store(ItemData->State, ItemDataT::MakeState(Generation, 1));
+		HandlesData.DataToItemData.push_back(ItemData);
+
+		Handle.Init(&HandlesData, ItemData, Generation);
+		return Handle;
+	}
 }
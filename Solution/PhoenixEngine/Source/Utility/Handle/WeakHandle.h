@@ -0,0 +1,205 @@
+#pragma once
+
+#include "Utility/Debug/Assert.h"
+#include "Utility/Handle/Handle.h"
+#include "Utility/Handle/HandleData.h"
+#include "Utility/Misc/Primitives.h"
+
+namespace Phoenix
+{
+	//	--------------------------------------------------------------------------------
+	/*! \brief Refers to an item created by THandles without keeping it alive.
+	*
+	*	@desc Remembers the generation of the item it was made from.  The item's
+	*		generation changes when its last THandle is released, so checking whether
+	*		the item still exists is one load and compare, without a lock or a search.
+	*	@note With FThreadSafeHandlePolicy, use Lock rather than TryGet when the item
+	*		may be released on another thread while it is being used.
+	*/
+	template <class T, class TPolicy = FHandlePolicy>
+	class TWeakHandle
+	{
+	public:
+		typedef THandle<T, TPolicy> HandleT;
+		typedef THandlesData<T, TPolicy> HandlesDataT;
+		typedef THandleItemData<TPolicy> ItemDataT;
+
+		TWeakHandle() = default;
+
+		TWeakHandle(const HandleT& Handle);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Refers to an item by its item data and generation.
+		*
+		*	@note This is for THandles use only.
+		*/
+		TWeakHandle(HandlesDataT* InHandleData, ItemDataT* InItemData, const UInt32 InGeneration);
+
+		TWeakHandle& operator=(const HandleT& Handle);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Determines if the item this refers to is still alive.
+		*
+		*	@return Returns false if this was never set or the item has been released.
+		*/
+		bool IsValid() const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Takes a reference to the item, if it is still alive.
+		*
+		*	@return Returns a valid THandle to the item, or an invalid one if the item
+		*		has been released.
+		*/
+		HandleT Lock() const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the item without taking a reference.
+		*
+		*	@return Returns the item, or nullptr if the item has been released.
+		*/
+		T* TryGet();
+
+		const T* TryGet() const;
+
+		UInt32 GetGeneration() const;
+
+		void Reset();
+
+		bool operator==(const TWeakHandle& RHS) const;
+
+		bool operator!=(const TWeakHandle& RHS) const;
+
+	private:
+		HandlesDataT* HandleData{ nullptr };
+		ItemDataT* ItemData{ nullptr };
+		UInt32 Generation{ 0 };
+	};
+
+	template <class T>
+	using TThreadSafeWeakHandle = TWeakHandle<T, FThreadSafeHandlePolicy>;
+
+	template <class T, class TPolicy>
+	TWeakHandle<T, TPolicy>::TWeakHandle(const HandleT& Handle)
+		: HandleData(Handle.HandleData)
+		, ItemData(Handle.ItemData)
+		, Generation(Handle.Generation)
+	{
+	}
+
+	template <class T, class TPolicy>
+	TWeakHandle<T, TPolicy>::TWeakHandle(HandlesDataT* InHandleData, ItemDataT* InItemData, const UInt32 InGeneration)
+		: HandleData(InHandleData)
+		, ItemData(InItemData)
+		, Generation(InGeneration)
+	{
+	}
+
+	template <class T, class TPolicy>
+	TWeakHandle<T, TPolicy>& TWeakHandle<T, TPolicy>::operator=(const HandleT& Handle)
+	{
+		HandleData = Handle.HandleData;
+		ItemData = Handle.ItemData;
+		Generation = Handle.Generation;
+		return *this;
+	}
+
+	template <class T, class TPolicy>
+	bool TWeakHandle<T, TPolicy>::IsValid() const
+	{
+		if (!ItemData)
+		{
+			return false;
+		}
+
+		const UInt64 State = TPolicy::Load(ItemData->State);
+		const bool Result = ItemDataT::GetGeneration(State) == Generation
+			&& ItemDataT::GetRefCount(State) > 0;
+
+		return Result;
+	}
+
+	template <class T, class TPolicy>
+	THandle<T, TPolicy> TWeakHandle<T, TPolicy>::Lock() const
+	{
+		HandleT Handle;
+
+		if (!ItemData)
+		{
+			return Handle;
+		}
+
+		// The generation and reference count are swapped as one word, so a reference is
+		// only taken if the item was alive and of this generation at that moment.
+		UInt64 State = TPolicy::Load(ItemData->State);
+		for (;;)
+		{
+			const bool IsAlive = ItemDataT::GetGeneration(State) == Generation
+				&& ItemDataT::GetRefCount(State) > 0;
+
+			if (!IsAlive)
+			{
+				return Handle;
+			}
+
+			if (TPolicy::CompareExchange(ItemData->State, State, State + 1))
+			{
+				break;
+			}
+		}
+
+		Handle.Init(HandleData, ItemData, Generation);
+		return Handle;
+	}
+
+	template <class T, class TPolicy>
+	T* TWeakHandle<T, TPolicy>::TryGet()
+	{
+		if (!IsValid())
+		{
+			return nullptr;
+		}
+
+		T* const Item = &HandleData->Data[ItemData->DataIndex];
+		return Item;
+	}
+
+	template <class T, class TPolicy>
+	const T* TWeakHandle<T, TPolicy>::TryGet() const
+	{
+		if (!IsValid())
+		{
+			return nullptr;
+		}
+
+		const T* const Item = &HandleData->Data[ItemData->DataIndex];
+		return Item;
+	}
+
+	template <class T, class TPolicy>
+	UInt32 TWeakHandle<T, TPolicy>::GetGeneration() const
+	{
+		return Generation;
+	}
+
+	template <class T, class TPolicy>
+	void TWeakHandle<T, TPolicy>::Reset()
+	{
+		HandleData = nullptr;
+		ItemData = nullptr;
+		Generation = 0;
+	}
+
+	template <class T, class TPolicy>
+	bool TWeakHandle<T, TPolicy>::operator==(const TWeakHandle& RHS) const
+	{
+		const bool Result = ItemData == RHS.ItemData && Generation == RHS.Generation;
+		return Result;
+	}
+
+	template <class T, class TPolicy>
+	bool TWeakHandle<T, TPolicy>::operator!=(const TWeakHandle& RHS) const
+	{
+		const bool Result = !(*this == RHS);
+		return Result;
+	}
+}
@@ -3,20 +3,20 @@
 
 #include <memory>
 #include <new>
+#include <utility>
 
 #include "Utility/Debug/Assert.h"
 #include "Utility/Debug/Debug.h"
+#include "Utility/Misc/MemoryTracker.h"
+#include "Utility/Misc/PoolAllocator.h"
 #include "Utility/Misc/Primitives.h"
+#include "Utility/Misc/TLSFHeap.h"
 
 namespace Phoenix
 {
 	template <class T>
 	using TAlloc = std::allocator<T>;
 
-	// #FIXME: Implement the tracking functionality for use with the STL.
-	template <class T>
-	using TTrackedAlloc = TAlloc<T>;
-
 	struct FRawAlloc
 	{
 		static void* New(SizeT Size);
@@ -44,6 +44,73 @@ namespace Phoenix
 		operator delete(Data);
 	}
 
+	//	--------------------------------------------------------------------------------
+	/*! \brief STL allocator that records its allocations against a memory tag.
+	*
+	*	@note Stateless, so any two instances with the same tag can free each other's memory.
+	*		Small allocations are served by FPoolAlloc.
+	*/
+	template <class T, EMemoryTag::Value Tag = EMemoryTag::Misc>
+	class TTrackedAlloc
+	{
+	public:
+		typedef T value_type;
+
+		template <class U>
+		struct rebind
+		{
+			typedef TTrackedAlloc<U, Tag> other;
+		};
+
+		TTrackedAlloc() = default;
+
+		template <class U>
+		TTrackedAlloc(const TTrackedAlloc<U, Tag>&);
+
+		T* allocate(const SizeT Count);
+
+		void deallocate(T* const Data, const SizeT Count);
+	};
+
+	template <class T, EMemoryTag::Value Tag>
+	template <class U>
+	TTrackedAlloc<T, Tag>::TTrackedAlloc(const TTrackedAlloc<U, Tag>&)
+	{
+	}
+
+	template <class T, EMemoryTag::Value Tag>
+	T* TTrackedAlloc<T, Tag>::allocate(const SizeT Count)
+	{
+		static_assert(alignof(T) <= FPoolAlloc::BlockAlignment, "T is over aligned for the pools.");
+
+		const SizeT Size = sizeof(T) * Count;
+		FMemoryTracker::RecordAlloc(Tag, Size);
+
+		T* const Data = static_cast<T*>(FPoolAlloc::Allocate(Size));
+		return Data;
+	}
+
+	template <class T, EMemoryTag::Value Tag>
+	void TTrackedAlloc<T, Tag>::deallocate(T* const Data, const SizeT Count)
+	{
+		const SizeT Size = sizeof(T) * Count;
+		FMemoryTracker::RecordFree(Tag, Size);
+
+		FPoolAlloc::Free(Data, Size);
+	}
+
+	template <class T, class U, EMemoryTag::Value Tag>
+	bool operator==(const TTrackedAlloc<T, Tag>&, const TTrackedAlloc<U, Tag>&)
+	{
+		return true;
+	}
+
+	template <class T, class U, EMemoryTag::Value Tag>
+	bool operator!=(const TTrackedAlloc<T, Tag>&, const TTrackedAlloc<U, Tag>&)
+	{
+		return false;
+	}
+
 	namespace EAlignment
 	{
 		typedef SizeT Type;
@@ -92,6 +159,15 @@ namespace Phoenix
 
 		static void Delete(void* const Data);
 
+		//	--------------------------------------------------------------------------------
+		/*! \brief Allocates long lived asset data, such as mesh arrays, from the asset heap.
+		*
+		*	@note Must be released with DeleteAsset.  See FTLSFHeap::GetAssetHeap.
+		*/
+		static void* NewAsset(const SizeT Size, const EAlignment::Value Alignment);
+
+		static void DeleteAsset(void* const Data);
+
 	private:
 		struct FPtrValues
 		{
@@ -161,11 +237,93 @@ namespace Phoenix
 		FRawAlloc::Delete(PtrValues.DataPtr);
 	}
 
+	inline void* FRawAlignedAlloc::NewAsset(const SizeT Size, const EAlignment::Value Alignment)
+	{
+		F_Assert(Size, "Size should be greater than zero.");
+		F_Assert(EAlignment::IsValid(Alignment), "Alignment is invalid.");
+
+		void* const Data = FTLSFHeap::GetAssetHeap().Allocate(Size, Alignment);
+
+		F_Assert(Data, "Memory allocation failed.");
+		return Data;
+	}
+
+	inline void FRawAlignedAlloc::DeleteAsset(void* const Data)
+	{
+		F_Assert(Data, "Data is null.");
+		FTLSFHeap::GetAssetHeap().Free(Data);
+	}
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief STL allocator for asset data, served by FRawAlignedAlloc::NewAsset.
+	*
+	*	@note Stateless.  Allocations are recorded against EMemoryTag::Assets.
+	*/
+	template <class T>
+	class TAssetAlloc
+	{
+	public:
+		typedef T value_type;
+
+		TAssetAlloc() = default;
+
+		template <class U>
+		TAssetAlloc(const TAssetAlloc<U>&);
+
+		T* allocate(const SizeT Count);
+
+		void deallocate(T* const Data, const SizeT Count);
+	};
+
+	template <class T>
+	template <class U>
+	TAssetAlloc<T>::TAssetAlloc(const TAssetAlloc<U>&)
+	{
+	}
+
+	template <class T>
+	T* TAssetAlloc<T>::allocate(const SizeT Count)
+	{
+		static_assert(alignof(T) <= EAlignment::Align16, "T is over aligned for the asset heap.");
+
+		const SizeT Size = sizeof(T) * Count;
+		FMemoryTracker::RecordAlloc(EMemoryTag::Assets, Size);
+
+		T* const Data = static_cast<T*>(FRawAlignedAlloc::NewAsset(Size, EAlignment::Align16));
+		return Data;
+	}
+
+	template <class T>
+	void TAssetAlloc<T>::deallocate(T* const Data, const SizeT Count)
+	{
+		FMemoryTracker::RecordFree(EMemoryTag::Assets, sizeof(T) * Count);
+
+		FRawAlignedAlloc::DeleteAsset(Data);
+	}
+
+	template <class T, class U>
+	bool operator==(const TAssetAlloc<T>&, const TAssetAlloc<U>&)
+	{
+		return true;
+	}
+
+	template <class T, class U>
+	bool operator!=(const TAssetAlloc<T>&, const TAssetAlloc<U>&)
+	{
+		return false;
+	}
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Allocates objects and arrays on the heap.
+	*
+	*	@note New serves small, non polymorphic types from FPoolAlloc, so its objects
+	*		must be released through Delete rather than the delete operator.
+	*/
 	struct FAlloc
 	{
 	public:
-		template <class T>
-		static T* New();
+		template <class T, class... TArgs>
+		static T* New(TArgs&&... Args);
 
 		template <class T>
 		static T* NewArray(const SizeT Size);
@@ -183,10 +341,19 @@ namespace Phoenix
 		static void SafeDeleteArray(T*& Data);
 	};
 
-	template <class T>
-	T* FAlloc::New()
+	template <class T, class... TArgs>
+	T* FAlloc::New(TArgs&&... Args)
 	{
-		T* Data = new T();
+		T* Data = nullptr;
+		if (FPoolAlloc::IsPoolable<T>())
+		{
+			void* const Memory = FPoolAlloc::Allocate(sizeof(T));
+			Data = new (Memory) T(std::forward<TArgs>(Args)...);
+		}
+		else
+		{
+			Data = new T(std::forward<TArgs>(Args)...);
+		}
 
 		F_Assert(Data, "Failed to allocate memory.");
 		return Data;
@@ -205,7 +372,20 @@ namespace Phoenix
 	template <class T>
 	void FAlloc::Delete(T* Data)
 	{
-		delete Data;
+		if (!Data)
+		{
+			return;
+		}
+
+		if (FPoolAlloc::IsPoolable<T>())
+		{
+			Data->~T();
+			FPoolAlloc::Free(Data, sizeof(T));
+		}
+		else
+		{
+			delete Data;
+		}
 	}
 
 	template <class T>
@@ -228,6 +408,17 @@ namespace Phoenix
 		Data = nullptr;
 	}
 
+	//	--------------------------------------------------------------------------------
+	/*! \brief Lets TUniquePtr own objects that were made with FAlloc::New. */
+	struct FAllocDeleter
+	{
+		template <class T>
+		void operator()(T* const Data) const
+		{
+			FAlloc::Delete(Data);
+		}
+	};
+
 	struct FAlignedAlloc
 	{
 	public:
@@ -0,0 +1,167 @@
+#include "Stdafx.h"
+#include "Utility/Misc/FrameAllocator.h"
+
+#include <algorithm>
+
+#include "Utility/Debug/Assert.h"
+#include "Utility/Debug/Debug.h"
+#include "Utility/Misc/Allocator.h"
+
+using namespace Phoenix;
+
+namespace FFrameAllocatorConstants
+{
+	// Overflow goes to FRawAlloc, which only guarantees the default new alignment.
+	const SizeT MaxAlignment = alignof(std::max_align_t);
+}
+
+FOutputStream& FFrameAllocatorStats::Output(FOutputStream& LHS) const
+{
+	LHS << "Frames: " << FrameCount
+		<< " Capacity: " << CapacityBytes / 1024 << "KB"
+		<< " Last Frame: " << FrameUsedBytes / 1024 << "KB in " << FrameAllocCount << " allocs"
+		<< " Peak: " << PeakUsedBytes / 1024 << "KB"
+		<< " Overflows: " << OverflowCount << " (" << OverflowBytes / 1024 << "KB)";
+
+	return LHS;
+}
+
+FFrameAllocator::FFrameAllocator(const SizeT Capacity)
+	: RequiredCapacity(Capacity)
+	, OwnerThreadID(NThread::GetCallingThreadID())
+{
+	F_Assert(Capacity, "Capacity should be greater than zero.");
+
+	for (auto& Buffer : Buffers)
+	{
+		ResetBuffer(Buffer);
+	}
+
+	Stats.CapacityBytes = Capacity;
+}
+
+FFrameAllocator::~FFrameAllocator()
+{
+	for (auto& Buffer : Buffers)
+	{
+		FRawAlloc::Delete(Buffer.Data);
+	}
+}
+
+FFrameAllocator& FFrameAllocator::GetThreadAllocator()
+{
+	static thread_local FFrameAllocator ThreadAllocator;
+	return ThreadAllocator;
+}
+
+void* FFrameAllocator::Allocate(const SizeT Size, const SizeT Alignment)
+{
+	F_Assert(Size, "Size should be greater than zero.");
+	F_Assert(Alignment && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two.");
+	F_Assert(Alignment <= FFrameAllocatorConstants::MaxAlignment, "Alignment is not supported.");
+	F_Assert(OwnerThreadID == NThread::GetCallingThreadID(), "Frame allocators may only be used on their own thread.");
+
+	FBuffer& Buffer = Buffers[CurrentBuffer];
+	const SizeT AlignedOffset = (Buffer.Offset + Alignment - 1) & ~(Alignment - 1);
+
+	FrameUsedBytes += Size;
+	++FrameAllocCount;
+
+	if (AlignedOffset + Size > Buffer.Capacity)
+	{
+		++FrameOverflowCount;
+		++Stats.OverflowCount;
+		Stats.OverflowBytes += Size;
+
+		void* const Data = FRawAlloc::New(Size);
+		return Data;
+	}
+
+	LastAllocOffset = AlignedOffset;
+	Buffer.Offset = AlignedOffset + Size;
+
+	void* const Data = Buffer.Data + AlignedOffset;
+	return Data;
+}
+
+void FFrameAllocator::Deallocate(void* const Data, const SizeT Size)
+{
+	F_Assert(OwnerThreadID == NThread::GetCallingThreadID(), "Frame allocators may only be used on their own thread.");
+
+	FBuffer& Buffer = Buffers[CurrentBuffer];
+	if (IsInBuffer(Buffer, Data))
+	{
+		const bool IsLastAlloc = Data == Buffer.Data + LastAllocOffset && LastAllocOffset + Size == Buffer.Offset;
+		if (IsLastAlloc)
+		{
+			Buffer.Offset = LastAllocOffset;
+		}
+
+		return;
+	}
+
+	if (IsInBuffer(Buffers[1 - CurrentBuffer], Data))
+	{
+		return;
+	}
+
+	FRawAlloc::Delete(Data);
+}
+
+void FFrameAllocator::EndFrame()
+{
+	F_Assert(OwnerThreadID == NThread::GetCallingThreadID(), "Frame allocators may only be used on their own thread.");
+
+	RequiredCapacity = std::max(RequiredCapacity, FrameUsedBytes);
+
+	F_LogWarningIf(FrameOverflowCount, "Frame allocator overflowed " << FrameOverflowCount << " times.  "
+		<< FrameUsedBytes << " bytes were needed but only " << Buffers[CurrentBuffer].Capacity
+		<< " bytes are available.  The buffers will grow.");
+
+	++Stats.FrameCount;
+	Stats.FrameUsedBytes = FrameUsedBytes;
+	Stats.FrameAllocCount = FrameAllocCount;
+	Stats.PeakUsedBytes = std::max(Stats.PeakUsedBytes, FrameUsedBytes);
+
+	FrameUsedBytes = 0;
+	FrameAllocCount = 0;
+	FrameOverflowCount = 0;
+
+	CurrentBuffer = 1 - CurrentBuffer;
+	ResetBuffer(Buffers[CurrentBuffer]);
+
+	Stats.CapacityBytes = Buffers[CurrentBuffer].Capacity;
+}
+
+const FFrameAllocatorStats& FFrameAllocator::GetStats() const
+{
+	return Stats;
+}
+
+bool FFrameAllocator::IsInBuffer(const FBuffer& Buffer, const void* const Data) const
+{
+	const UInt8* const BytePtr = static_cast<const UInt8*>(Data);
+
+	const bool Result = BytePtr >= Buffer.Data && BytePtr < Buffer.Data + Buffer.Capacity;
+	return Result;
+}
+
+void FFrameAllocator::ResetBuffer(FBuffer& Buffer)
+{
+	Buffer.Offset = 0;
+	LastAllocOffset = 0;
+
+	if (Buffer.Capacity >= RequiredCapacity)
+	{
+		return;
+	}
+
+	// Nothing allocated from this buffer is alive anymore, so it can be replaced outright.
+	if (Buffer.Data)
+	{
+		FRawAlloc::Delete(Buffer.Data);
+	}
+
+	Buffer.Data = static_cast<UInt8*>(FRawAlloc::New(RequiredCapacity));
+	Buffer.Capacity = RequiredCapacity;
+}
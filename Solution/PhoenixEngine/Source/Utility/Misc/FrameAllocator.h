@@ -0,0 +1,176 @@
+#ifndef PHOENIX_FRAME_ALLOCATOR_H
+#define PHOENIX_FRAME_ALLOCATOR_H
+
+#include "Utility/Containers/Array.h"
+#include "Utility/Misc/OutputStream.h"
+#include "Utility/Misc/Primitives.h"
+#include "Utility/Threading/Thread.h"
+
+namespace Phoenix
+{
+	struct FFrameAllocatorStats
+	{
+		UInt32 FrameCount{ 0 };
+		SizeT CapacityBytes{ 0 };
+
+		/*! \brief Bytes handed out during the last completed frame, including overflow. */
+		SizeT FrameUsedBytes{ 0 };
+		UInt32 FrameAllocCount{ 0 };
+		SizeT PeakUsedBytes{ 0 };
+
+		/*! \brief Allocations that did not fit and went to the heap instead. */
+		UInt32 OverflowCount{ 0 };
+		UInt64 OverflowBytes{ 0 };
+
+		FOutputStream& Output(FOutputStream& LHS) const;
+	};
+
+	static FOutputStream& operator<<(FOutputStream& LHS, const FFrameAllocatorStats& RHS)
+	{
+		return RHS.Output(LHS);
+	}
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Hands out memory that lives until the end of the next frame.
+	*
+	*	@desc Allocations bump an offset into the current buffer and EndFrame switches to
+	*		the other buffer by resetting its offset, so nothing is freed one by one.
+	*		Memory from the previous frame stays valid for one more frame.  Allocations that
+	*		don't fit go to the heap, are reported, and the buffers grow to fit on reset.
+	*	@note Each thread has its own allocator, which may only be used on that thread.
+	*/
+	class FFrameAllocator
+	{
+	public:
+		static const SizeT DefaultCapacity = 256 * 1024;
+
+		explicit FFrameAllocator(const SizeT Capacity = DefaultCapacity);
+
+		FFrameAllocator(const FFrameAllocator&) = delete;
+		FFrameAllocator& operator=(const FFrameAllocator&) = delete;
+
+		FFrameAllocator(FFrameAllocator&&) = delete;
+		FFrameAllocator& operator=(FFrameAllocator&&) = delete;
+
+		~FFrameAllocator();
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the calling thread's allocator, creating it on first use. */
+		static FFrameAllocator& GetThreadAllocator();
+
+		void* Allocate(const SizeT Size, const SizeT Alignment);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Releases an allocation early.
+		*
+		*	@note Only heap overflow is actually freed.  If Data is the most recent
+		*		allocation, its space is handed out again, so scratch memory that is
+		*		released in reverse order doesn't use up the buffer.
+		*/
+		void Deallocate(void* const Data, const SizeT Size);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Switches buffers.  Allocations from two frames ago are invalidated. */
+		void EndFrame();
+
+		const FFrameAllocatorStats& GetStats() const;
+
+	private:
+		struct FBuffer
+		{
+			UInt8* Data{ nullptr };
+			SizeT Capacity{ 0 };
+			SizeT Offset{ 0 };
+		};
+
+		TArray<FBuffer, 2> Buffers;
+		SizeT CurrentBuffer{ 0 };
+		SizeT LastAllocOffset{ 0 };
+
+		/*! \brief Capacity that would have fit the largest frame so far. */
+		SizeT RequiredCapacity{ 0 };
+		SizeT FrameUsedBytes{ 0 };
+		UInt32 FrameAllocCount{ 0 };
+		UInt32 FrameOverflowCount{ 0 };
+
+		FThreadID OwnerThreadID;
+		FFrameAllocatorStats Stats;
+
+		bool IsInBuffer(const FBuffer& Buffer, const void* const Data) const;
+
+		void ResetBuffer(FBuffer& Buffer);
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief STL allocator over a thread's FFrameAllocator.
+	*
+	*	@note Containers using it must not outlive the frame after the one they were
+	*		filled in, and must only grow on the thread that created them.
+	*/
+	template <class T>
+	class TFrameAlloc
+	{
+	public:
+		typedef T value_type;
+
+		TFrameAlloc();
+
+		template <class U>
+		TFrameAlloc(const TFrameAlloc<U>& RHS);
+
+		T* allocate(const SizeT Count);
+
+		void deallocate(T* const Data, const SizeT Count);
+
+		FFrameAllocator* GetFrameAllocator() const;
+
+	private:
+		FFrameAllocator* FrameAllocator;
+	};
+
+	template <class T>
+	TFrameAlloc<T>::TFrameAlloc()
+		: FrameAllocator(&FFrameAllocator::GetThreadAllocator())
+	{
+	}
+
+	template <class T>
+	template <class U>
+	TFrameAlloc<T>::TFrameAlloc(const TFrameAlloc<U>& RHS)
+		: FrameAllocator(RHS.GetFrameAllocator())
+	{
+	}
+
+	template <class T>
+	T* TFrameAlloc<T>::allocate(const SizeT Count)
+	{
+		void* const Data = FrameAllocator->Allocate(sizeof(T) * Count, alignof(T));
+		return static_cast<T*>(Data);
+	}
+
+	template <class T>
+	void TFrameAlloc<T>::deallocate(T* const Data, const SizeT Count)
+	{
+		FrameAllocator->Deallocate(Data, sizeof(T) * Count);
+	}
+
+	template <class T>
+	FFrameAllocator* TFrameAlloc<T>::GetFrameAllocator() const
+	{
+		return FrameAllocator;
+	}
+
+	template <class T, class U>
+	bool operator==(const TFrameAlloc<T>& LHS, const TFrameAlloc<U>& RHS)
+	{
+		return LHS.GetFrameAllocator() == RHS.GetFrameAllocator();
+	}
+
+	template <class T, class U>
+	bool operator!=(const TFrameAlloc<T>& LHS, const TFrameAlloc<U>& RHS)
+	{
+		return !(LHS == RHS);
+	}
+}
+
+#endif
@@ -1,12 +1,282 @@
 #ifndef PHOENIX_FUNCTION_H
 #define PHOENIX_FUNCTION_H
 
+#include <cstddef>
 #include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Utility/Debug/Assert.h"
+#include "Utility/Misc/Allocator.h"
+#include "Utility/Misc/Primitives.h"
+#include "Utility/Misc/TypeTraits.h"
 
 namespace Phoenix
 {
 	template<class T>
 	using TFunction = std::function<T>;
+
+	template <class TSignature, SizeT Bytes = 32>
+	class TInlineFunction;
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief A move only TFunction that stores callables of up to Bytes bytes inside itself.
+	*
+	*	@desc Lambdas that capture a few pointers or handles are stored without touching
+	*		the heap.  Larger callables, or ones that can't be moved without throwing,
+	*		are allocated with FAlloc, which serves those of up to 256 bytes from the pools.  Since it never copies, callables
+	*		may capture move only types directly.
+	*/
+	template <class TReturn, class... TArgs, SizeT Bytes>
+	class TInlineFunction<TReturn(TArgs...), Bytes>
+	{
+	public:
+		TInlineFunction() = default;
+
+		TInlineFunction(const NullptrT);
+
+		template <class TCallable, TEnableIf<!TIsSame<std::decay_t<TCallable>, TInlineFunction>::value, Int32> = 0>
+		TInlineFunction(TCallable&& Callable);
+
+		TInlineFunction(const TInlineFunction&) = delete;
+		TInlineFunction& operator=(const TInlineFunction&) = delete;
+
+		TInlineFunction(TInlineFunction&& RHS);
+		TInlineFunction& operator=(TInlineFunction&& RHS);
+
+		TInlineFunction& operator=(const NullptrT);
+
+		template <class TCallable, TEnableIf<!TIsSame<std::decay_t<TCallable>, TInlineFunction>::value, Int32> = 0>
+		TInlineFunction& operator=(TCallable&& Callable);
+
+		~TInlineFunction();
+
+		TReturn operator()(TArgs... Args) const;
+
+		explicit operator bool() const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Checks whether the callable is stored inside this object rather than on the heap. */
+		bool IsInline() const;
+
+		void Reset();
+
+	private:
+		struct FOps
+		{
+			TReturn (*Invoke)(void* const Storage, TArgs&&... Args);
+			void (*Move)(void* const Dest, void* const Source);
+			void (*Destroy)(void* const Storage);
+			bool IsInline;
+		};
+
+		template <class TCallable>
+		struct TInlineOps
+		{
+			static TReturn Invoke(void* const Storage, TArgs&&... Args)
+			{
+				return (*static_cast<TCallable*>(Storage))(std::forward<TArgs>(Args)...);
+			}
+
+			static void Move(void* const Dest, void* const Source)
+			{
+				TCallable& SourceCallable = *static_cast<TCallable*>(Source);
+				new (Dest) TCallable(std::move(SourceCallable));
+				SourceCallable.~TCallable();
+			}
+
+			static void Destroy(void* const Storage)
+			{
+				static_cast<TCallable*>(Storage)->~TCallable();
+			}
+		};
+
+		template <class TCallable>
+		struct THeapOps
+		{
+			static TCallable*& GetPtr(void* const Storage)
+			{
+				return *static_cast<TCallable**>(Storage);
+			}
+
+			static TReturn Invoke(void* const Storage, TArgs&&... Args)
+			{
+				return (*GetPtr(Storage))(std::forward<TArgs>(Args)...);
+			}
+
+			static void Move(void* const Dest, void* const Source)
+			{
+				new (Dest) TCallable*(GetPtr(Source));
+			}
+
+			static void Destroy(void* const Storage)
+			{
+				FAlloc::Delete(GetPtr(Storage));
+			}
+		};
+
+		template <class TCallable>
+		static constexpr bool CanStoreInline()
+		{
+			return sizeof(TCallable) <= Bytes
+				&& alignof(std::max_align_t) % alignof(TCallable) == 0
+				&& std::is_nothrow_move_constructible<TCallable>::value;
+		}
+
+		alignas(std::max_align_t) UInt8 Storage[Bytes < sizeof(void*) ? sizeof(void*) : Bytes];
+		const FOps* Ops{ nullptr };
+
+		template <class TCallable>
+		void Assign(TCallable&& Callable);
+
+		template <class TCallable>
+		void Assign(TCallable&& Callable, FTrueType);
+
+		template <class TCallable>
+		void Assign(TCallable&& Callable, FFalseType);
+	};
+
+	template <class TReturn, class... TArgs, SizeT Bytes>
+	TInlineFunction<TReturn(TArgs...), Bytes>::TInlineFunction(const NullptrT)
+	{
+	}
+
+	template <class TReturn, class... TArgs, SizeT Bytes>
+	template <class TCallable, TEnableIf<!TIsSame<std::decay_t<TCallable>, TInlineFunction<TReturn(TArgs...), Bytes>>::value, Int32>>
+	TInlineFunction<TReturn(TArgs...), Bytes>::TInlineFunction(TCallable&& Callable)
+	{
+		Assign(std::forward<TCallable>(Callable));
+	}
+
+	template <class TReturn, class... TArgs, SizeT Bytes>
+	TInlineFunction<TReturn(TArgs...), Bytes>::TInlineFunction(TInlineFunction&& RHS)
+		: Ops(RHS.Ops)
+	{
+		if (Ops)
+		{
+			Ops->Move(Storage, RHS.Storage);
+			RHS.Ops = nullptr;
+		}
+	}
+
+	template <class TReturn, class... TArgs, SizeT Bytes>
+	TInlineFunction<TReturn(TArgs...), Bytes>& TInlineFunction<TReturn(TArgs...), Bytes>::operator=(TInlineFunction&& RHS)
+	{
+		if (this == &RHS)
+		{
+			return *this;
+		}
+
+		Reset();
+
+		Ops = RHS.Ops;
+		if (Ops)
+		{
+			Ops->Move(Storage, RHS.Storage);
+			RHS.Ops = nullptr;
+		}
+
+		return *this;
+	}
+
+	template <class TReturn, class... TArgs, SizeT Bytes>
+	TInlineFunction<TReturn(TArgs...), Bytes>& TInlineFunction<TReturn(TArgs...), Bytes>::operator=(const NullptrT)
+	{
+		Reset();
+		return *this;
+	}
+
+	template <class TReturn, class... TArgs, SizeT Bytes>
+	template <class TCallable, TEnableIf<!TIsSame<std::decay_t<TCallable>, TInlineFunction<TReturn(TArgs...), Bytes>>::value, Int32>>
+	TInlineFunction<TReturn(TArgs...), Bytes>& TInlineFunction<TReturn(TArgs...), Bytes>::operator=(TCallable&& Callable)
+	{
+		Reset();
+		Assign(std::forward<TCallable>(Callable));
+		return *this;
+	}
+
+	template <class TReturn, class... TArgs, SizeT Bytes>
+	TInlineFunction<TReturn(TArgs...), Bytes>::~TInlineFunction()
+	{
+		Reset();
+	}
+
+	template <class TReturn, class... TArgs, SizeT Bytes>
+	TReturn TInlineFunction<TReturn(TArgs...), Bytes>::operator()(TArgs... Args) const
+	{
+		F_Assert(Ops, "Calling an empty function.");
+
+		// Like TFunction, calling through a const function may still change its callable.
+		void* const MutableStorage = const_cast<UInt8*>(Storage);
+		return Ops->Invoke(MutableStorage, std::forward<TArgs>(Args)...);
+	}
+
+	template <class TReturn, class... TArgs, SizeT Bytes>
+	TInlineFunction<TReturn(TArgs...), Bytes>::operator bool() const
+	{
+		return Ops != nullptr;
+	}
+
+	template <class TReturn, class... TArgs, SizeT Bytes>
+	bool TInlineFunction<TReturn(TArgs...), Bytes>::IsInline() const
+	{
+		return Ops && Ops->IsInline;
+	}
+
+	template <class TReturn, class... TArgs, SizeT Bytes>
+	void TInlineFunction<TReturn(TArgs...), Bytes>::Reset()
+	{
+		if (Ops)
+		{
+			Ops->Destroy(Storage);
+			Ops = nullptr;
+		}
+	}
+
+	template <class TReturn, class... TArgs, SizeT Bytes>
+	template <class TCallable>
+	void TInlineFunction<TReturn(TArgs...), Bytes>::Assign(TCallable&& Callable)
+	{
+		typedef std::decay_t<TCallable> FCallable;
+		Assign(std::forward<TCallable>(Callable), TIntegralConst<bool, CanStoreInline<FCallable>()>());
+	}
+
+	template <class TReturn, class... TArgs, SizeT Bytes>
+	template <class TCallable>
+	void TInlineFunction<TReturn(TArgs...), Bytes>::Assign(TCallable&& Callable, FTrueType)
+	{
+		typedef std::decay_t<TCallable> FCallable;
+
+		static const FOps InlineOps =
+		{
+			&TInlineOps<FCallable>::Invoke,
+			&TInlineOps<FCallable>::Move,
+			&TInlineOps<FCallable>::Destroy,
+			true
+		};
+
+		new (Storage) FCallable(std::forward<TCallable>(Callable));
+		Ops = &InlineOps;
+	}
+
+	template <class TReturn, class... TArgs, SizeT Bytes>
+	template <class TCallable>
+	void TInlineFunction<TReturn(TArgs...), Bytes>::Assign(TCallable&& Callable, FFalseType)
+	{
+		typedef std::decay_t<TCallable> FCallable;
+
+		static const FOps HeapOps =
+		{
+			&THeapOps<FCallable>::Invoke,
+			&THeapOps<FCallable>::Move,
+			&THeapOps<FCallable>::Destroy,
+			false
+		};
+
+		new (Storage) FCallable*(FAlloc::New<FCallable>(std::forward<TCallable>(Callable)));
+		Ops = &HeapOps;
+	}
 }
 
 #endif
@@ -8,8 +8,8 @@
 
 namespace Phoenix
 {
-	template<class T>
-	using TUniquePtr = std::unique_ptr<T>;
+	template<class T, class TDeleter = std::default_delete<T>>
+	using TUniquePtr = std::unique_ptr<T, TDeleter>;
 
 	template <class T>
 	using TSharedPtr = std::shared_ptr<T>;
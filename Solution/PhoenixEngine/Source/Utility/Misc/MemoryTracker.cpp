@@ -0,0 +1,208 @@
+#include "Stdafx.h"
+#include "Utility/Misc/MemoryTracker.h"
+
+#include <algorithm>
+#include <iomanip>
+
+#include "Utility/Containers/Vector.h"
+#include "Utility/Debug/Assert.h"
+#include "Utility/Threading/Atomic.h"
+#include "Utility/Threading/Mutex.h"
+
+using namespace Phoenix;
+
+namespace FMemoryTrackerConstants
+{
+	const Float64 BytesPerKB = 1024.0;
+	const Int32 NameWidth = 8;
+	const Int32 ColumnWidth = 14;
+}
+
+namespace FMemoryTrackerInternal
+{
+	struct FTagTotals
+	{
+		UInt64 AllocBytes{ 0 };
+		UInt64 AllocCount{ 0 };
+		UInt64 FreeBytes{ 0 };
+		UInt64 FreeCount{ 0 };
+	};
+
+	typedef TArray<FTagTotals, EMemoryTag::Count> FTotals;
+
+	struct FTagCounters
+	{
+		TAtomic<UInt64> AllocBytes{ 0 };
+		TAtomic<UInt64> AllocCount{ 0 };
+		TAtomic<UInt64> FreeBytes{ 0 };
+		TAtomic<UInt64> FreeCount{ 0 };
+	};
+
+	// Only the owning thread writes a counter, so a relaxed load and store is enough and
+	// avoids the locked instruction a fetch_add would cost.
+	void AddToCounter(TAtomic<UInt64>& Counter, const UInt64 Value)
+	{
+		Counter.store(Counter.load(std::memory_order_relaxed) + Value, std::memory_order_relaxed);
+	}
+
+	void AddToTotals(FTotals& Totals, const TArray<FTagCounters, EMemoryTag::Count>& Counters)
+	{
+		for (SizeT I = 0; I < EMemoryTag::Count; ++I)
+		{
+			Totals[I].AllocBytes += Counters[I].AllocBytes.load(std::memory_order_relaxed);
+			Totals[I].AllocCount += Counters[I].AllocCount.load(std::memory_order_relaxed);
+			Totals[I].FreeBytes += Counters[I].FreeBytes.load(std::memory_order_relaxed);
+			Totals[I].FreeCount += Counters[I].FreeCount.load(std::memory_order_relaxed);
+		}
+	}
+
+	struct FThreadCounters;
+
+	struct FRegistry
+	{
+		FMutex Mutex;
+		TVector<FThreadCounters*> Threads;
+
+		/*! \brief Counters of threads that have exited. */
+		FTotals RetiredTotals{};
+		FTotals LastFrameTotals{};
+		FMemoryReport Report;
+	};
+
+	FRegistry& GetRegistry()
+	{
+		static FRegistry Registry;
+		return Registry;
+	}
+
+	struct FThreadCounters
+	{
+		TArray<FTagCounters, EMemoryTag::Count> Tags;
+
+		FThreadCounters()
+		{
+			FRegistry& Registry = GetRegistry();
+			FMutexLock Lock(Registry.Mutex);
+			Registry.Threads.push_back(this);
+		}
+
+		~FThreadCounters()
+		{
+			FRegistry& Registry = GetRegistry();
+			FMutexLock Lock(Registry.Mutex);
+
+			AddToTotals(Registry.RetiredTotals, Tags);
+
+			auto& Threads = Registry.Threads;
+			Threads.erase(std::remove(Threads.begin(), Threads.end(), this), Threads.end());
+		}
+	};
+
+	FThreadCounters& GetThreadCounters()
+	{
+		static thread_local FThreadCounters ThreadCounters;
+		return ThreadCounters;
+	}
+}
+
+using namespace FMemoryTrackerInternal;
+
+FOutputStream& FMemoryReport::Output(FOutputStream& LHS) const
+{
+	using namespace FMemoryTrackerConstants;
+
+	LHS << "Memory after " << FrameCount << " frames\n"
+		<< std::left << std::setw(NameWidth) << "Tag" << std::right
+		<< std::setw(ColumnWidth) << "Current KB"
+		<< std::setw(ColumnWidth) << "Peak KB"
+		<< std::setw(ColumnWidth) << "Live Allocs"
+		<< std::setw(ColumnWidth) << "Frame Allocs"
+		<< std::setw(ColumnWidth) << "Frame KB"
+		<< std::setw(ColumnWidth) << "Frame Frees"
+		<< std::setw(ColumnWidth) << "Total Allocs" << "\n";
+
+	const auto OldFlags = LHS.flags();
+	const auto OldPrecision = LHS.precision();
+	LHS << std::fixed << std::setprecision(1);
+
+	for (SizeT I = 0; I < EMemoryTag::Count; ++I)
+	{
+		const FMemoryTagStats& Stats = Tags[I];
+
+		LHS << std::left << std::setw(NameWidth) << EMemoryTag::ToString(static_cast<EMemoryTag::Type>(I)) << std::right
+			<< std::setw(ColumnWidth) << Stats.CurrentBytes / BytesPerKB
+			<< std::setw(ColumnWidth) << Stats.PeakBytes / BytesPerKB
+			<< std::setw(ColumnWidth) << Stats.CurrentCount
+			<< std::setw(ColumnWidth) << Stats.FrameAllocCount
+			<< std::setw(ColumnWidth) << Stats.FrameAllocBytes / BytesPerKB
+			<< std::setw(ColumnWidth) << Stats.FrameFreeCount
+			<< std::setw(ColumnWidth) << Stats.TotalAllocCount << "\n";
+	}
+
+	LHS.flags(OldFlags);
+	LHS.precision(OldPrecision);
+	return LHS;
+}
+
+void FMemoryTracker::RecordAlloc(const EMemoryTag::Value Tag, const SizeT Size)
+{
+	F_Assert(Tag < EMemoryTag::Count, "Invalid memory tag.");
+	FTagCounters& Counters = GetThreadCounters().Tags[Tag];
+
+	AddToCounter(Counters.AllocBytes, Size);
+	AddToCounter(Counters.AllocCount, 1);
+}
+
+void FMemoryTracker::RecordFree(const EMemoryTag::Value Tag, const SizeT Size)
+{
+	F_Assert(Tag < EMemoryTag::Count, "Invalid memory tag.");
+	FTagCounters& Counters = GetThreadCounters().Tags[Tag];
+
+	AddToCounter(Counters.FreeBytes, Size);
+	AddToCounter(Counters.FreeCount, 1);
+}
+
+void FMemoryTracker::EndFrame()
+{
+	FRegistry& Registry = GetRegistry();
+	FMutexLock Lock(Registry.Mutex);
+
+	FTotals Totals = Registry.RetiredTotals;
+	for (const FThreadCounters* const ThreadCounters : Registry.Threads)
+	{
+		AddToTotals(Totals, ThreadCounters->Tags);
+	}
+
+	FMemoryReport& Report = Registry.Report;
+	for (SizeT I = 0; I < EMemoryTag::Count; ++I)
+	{
+		const FTagTotals& Current = Totals[I];
+		const FTagTotals& Last = Registry.LastFrameTotals[I];
+		FMemoryTagStats& Stats = Report.Tags[I];
+
+		// Memory may be freed on a different thread than it was allocated on, so only the
+		// sum over all threads is meaningful.
+		Stats.CurrentBytes = static_cast<Int64>(Current.AllocBytes - Current.FreeBytes);
+		Stats.CurrentCount = static_cast<Int64>(Current.AllocCount - Current.FreeCount);
+		Stats.PeakBytes = std::max(Stats.PeakBytes, Stats.CurrentBytes);
+
+		Stats.FrameAllocBytes = Current.AllocBytes - Last.AllocBytes;
+		Stats.FrameAllocCount = Current.AllocCount - Last.AllocCount;
+		Stats.FrameFreeBytes = Current.FreeBytes - Last.FreeBytes;
+		Stats.FrameFreeCount = Current.FreeCount - Last.FreeCount;
+
+		Stats.TotalAllocCount = Current.AllocCount;
+	}
+
+	++Report.FrameCount;
+	Registry.LastFrameTotals = Totals;
+}
+
+FMemoryReport FMemoryTracker::GetReport()
+{
+	FRegistry& Registry = GetRegistry();
+	FMutexLock Lock(Registry.Mutex);
+
+	const FMemoryReport Report = Registry.Report;
+	return Report;
+}
@@ -0,0 +1,98 @@
+#ifndef PHOENIX_MEMORY_TRACKER_H
+#define PHOENIX_MEMORY_TRACKER_H
+
+#include "Utility/Containers/Array.h"
+#include "Utility/Misc/OutputStream.h"
+#include "Utility/Misc/Primitives.h"
+
+namespace Phoenix
+{
+	namespace EMemoryTag
+	{
+		typedef UInt8 Type;
+
+		enum Value : Type
+		{
+			Misc,
+			ECS,
+			GFX,
+			Audio,
+			Assets,
+			Count
+		};
+
+		static const FChar* ToString(const Type MemoryTag)
+		{
+			static_assert(EMemoryTag::Count == 5, "This table requires updating.");
+			static const TArray<const FChar* const, EMemoryTag::Count> LookUpTable =
+			{
+				"Misc",
+				"ECS",
+				"GFX",
+				"Audio",
+				"Assets",
+			};
+
+			const FChar* const Result = LookUpTable[MemoryTag];
+			return Result;
+		}
+	}
+
+	struct FMemoryTagStats
+	{
+		Int64 CurrentBytes{ 0 };
+		Int64 CurrentCount{ 0 };
+		Int64 PeakBytes{ 0 };
+
+		/*! \brief Allocations and frees made between the last two calls to EndFrame. */
+		UInt64 FrameAllocBytes{ 0 };
+		UInt64 FrameAllocCount{ 0 };
+		UInt64 FrameFreeBytes{ 0 };
+		UInt64 FrameFreeCount{ 0 };
+
+		UInt64 TotalAllocCount{ 0 };
+	};
+
+	struct FMemoryReport
+	{
+		TArray<FMemoryTagStats, EMemoryTag::Count> Tags;
+		UInt32 FrameCount{ 0 };
+
+		FOutputStream& Output(FOutputStream& LHS) const;
+	};
+
+	static FOutputStream& operator<<(FOutputStream& LHS, const FMemoryReport& RHS)
+	{
+		return RHS.Output(LHS);
+	}
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Attributes allocations to memory tags.
+	*
+	*	@desc Every thread records into its own counters, so recording never takes a lock
+	*		or contends on a cache line.  EndFrame sums the counters of all threads into
+	*		the current, peak and per frame figures returned by GetReport.
+	*	@note Peaks are sampled at EndFrame, so a spike that is freed within a frame is
+	*		only visible in that frame's churn.
+	*/
+	class FMemoryTracker
+	{
+	public:
+		static void RecordAlloc(const EMemoryTag::Value Tag, const SizeT Size);
+
+		static void RecordFree(const EMemoryTag::Value Tag, const SizeT Size);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Merges the counters of every thread and starts a new frame.
+		*
+		*	@note Should only be called from one thread, once per frame.
+		*/
+		static void EndFrame();
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the figures as of the last call to EndFrame. */
+		static FMemoryReport GetReport();
+	};
+}
+
+#endif
@@ -0,0 +1,259 @@
+#include "Stdafx.h"
+#include "Utility/Misc/Name.h"
+
+#include <cstring>
+
+#include "Utility/Containers/Array.h"
+#include "Utility/Containers/Vector.h"
+#include "Utility/Debug/Assert.h"
+#include "Utility/Misc/Memory.h"
+#include "Utility/Threading/Atomic.h"
+#include "Utility/Threading/Mutex.h"
+
+using namespace Phoenix;
+
+namespace FNameConstants
+{
+	const SizeT ChunkSizeLog2 = 10;
+	const SizeT ChunkSize = 1 << ChunkSizeLog2;
+	const SizeT MaxChunkCount = 4096;
+	const SizeT InitialSlotCount = 1024;
+}
+
+namespace FNameInternal
+{
+	struct FEntry
+	{
+		FString String;
+		UInt32 Hash{ 0 };
+	};
+
+	/*! \brief Open addressed indices of interned entries.  Zero marks an empty slot. */
+	struct FSlotTable
+	{
+		SizeT Capacity{ 0 };
+		TUniquePtr<TAtomic<UInt32>[]> Slots;
+
+		explicit FSlotTable(const SizeT InCapacity)
+			: Capacity(InCapacity)
+			, Slots(new TAtomic<UInt32>[InCapacity])
+		{
+			for (SizeT I = 0; I < Capacity; ++I)
+			{
+				Slots[I].store(0, std::memory_order_relaxed);
+			}
+		}
+	};
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Stores every interned string.
+	*
+	*	@desc Entries live in fixed size chunks that never move, and a slot is only
+	*		written once its entry is fully constructed, so readers can probe without the
+	*		lock.  Growing builds a new slot table and publishes it whole.  Old tables are
+	*		kept, since a reader may still be probing one.  A reader that misses there
+	*		simply falls back to the locked path.
+	*/
+	class FNameTable
+	{
+	public:
+		FNameTable()
+		{
+			for (auto& Chunk : Chunks)
+			{
+				Chunk.store(nullptr, std::memory_order_relaxed);
+			}
+
+			SlotTables.emplace_back(new FSlotTable(FNameConstants::InitialSlotCount));
+			CurrentSlotTable.store(SlotTables.back().get(), std::memory_order_release);
+
+			// Index zero is the empty string, so default constructed names need no lookup.
+			AllocateEntry(FString(), 0);
+		}
+
+		UInt32 Find(const FChar* const String, const SizeT Length, const UInt32 Hash) const
+		{
+			const FSlotTable& SlotTable = *CurrentSlotTable.load(std::memory_order_acquire);
+
+			const UInt32 Index = FindInSlotTable(SlotTable, String, Length, Hash);
+			return Index;
+		}
+
+		UInt32 FindOrAdd(const FChar* const String, const SizeT Length, const UInt32 Hash)
+		{
+			const UInt32 ExistingIndex = Find(String, Length, Hash);
+			if (ExistingIndex)
+			{
+				return ExistingIndex;
+			}
+
+			FMutexLock Lock(Mutex);
+
+			// Another thread may have added it since the unlocked lookup.
+			const UInt32 AddedIndex = FindInSlotTable(*SlotTables.back(), String, Length, Hash);
+			if (AddedIndex)
+			{
+				return AddedIndex;
+			}
+
+			if ((EntryCount + 1) * 2 > SlotTables.back()->Capacity)
+			{
+				Grow();
+			}
+
+			const UInt32 Index = AllocateEntry(FString(String, Length), Hash);
+			InsertSlot(*SlotTables.back(), Index, Hash);
+
+			return Index;
+		}
+
+		const FEntry& GetEntry(const UInt32 Index) const
+		{
+			const FEntry* const Chunk = Chunks[Index >> FNameConstants::ChunkSizeLog2].load(std::memory_order_acquire);
+			F_Assert(Chunk, "Name index " << Index << " is invalid.");
+
+			const FEntry& Entry = Chunk[Index & (FNameConstants::ChunkSize - 1)];
+			return Entry;
+		}
+
+		SizeT GetEntryCount() const
+		{
+			FMutexLock Lock(Mutex);
+			return EntryCount;
+		}
+
+	private:
+		TArray<TAtomic<FEntry*>, FNameConstants::MaxChunkCount> Chunks;
+		TAtomic<FSlotTable*> CurrentSlotTable;
+		TVector<TUniquePtr<FSlotTable>> SlotTables;
+		UInt32 EntryCount{ 0 };
+		mutable FMutex Mutex;
+
+		UInt32 FindInSlotTable(const FSlotTable& SlotTable, const FChar* const String, const SizeT Length, const UInt32 Hash) const
+		{
+			const SizeT Mask = SlotTable.Capacity - 1;
+
+			for (SizeT I = Hash & Mask; ; I = (I + 1) & Mask)
+			{
+				const UInt32 Index = SlotTable.Slots[I].load(std::memory_order_acquire);
+				if (!Index)
+				{
+					return 0;
+				}
+
+				const FEntry& Entry = GetEntry(Index);
+				if (Entry.Hash == Hash
+					&& Entry.String.size() == Length
+					&& std::memcmp(Entry.String.data(), String, Length) == 0)
+				{
+					return Index;
+				}
+			}
+		}
+
+		void InsertSlot(FSlotTable& SlotTable, const UInt32 Index, const UInt32 Hash)
+		{
+			const SizeT Mask = SlotTable.Capacity - 1;
+
+			SizeT I = Hash & Mask;
+			while (SlotTable.Slots[I].load(std::memory_order_relaxed))
+			{
+				I = (I + 1) & Mask;
+			}
+
+			SlotTable.Slots[I].store(Index, std::memory_order_release);
+		}
+
+		UInt32 AllocateEntry(FString&& String, const UInt32 Hash)
+		{
+			const UInt32 Index = EntryCount;
+			const SizeT ChunkIndex = Index >> FNameConstants::ChunkSizeLog2;
+			F_Assert(ChunkIndex < FNameConstants::MaxChunkCount, "Too many names have been interned.");
+
+			FEntry* Chunk = Chunks[ChunkIndex].load(std::memory_order_relaxed);
+			if (!Chunk)
+			{
+				Chunk = new FEntry[FNameConstants::ChunkSize];
+				Chunks[ChunkIndex].store(Chunk, std::memory_order_release);
+			}
+
+			FEntry& Entry = Chunk[Index & (FNameConstants::ChunkSize - 1)];
+			Entry.String = std::move(String);
+			Entry.Hash = Hash;
+
+			++EntryCount;
+			return Index;
+		}
+
+		void Grow()
+		{
+			TUniquePtr<FSlotTable> SlotTable(new FSlotTable(SlotTables.back()->Capacity * 2));
+
+			for (UInt32 I = 1; I < EntryCount; ++I)
+			{
+				InsertSlot(*SlotTable, I, GetEntry(I).Hash);
+			}
+
+			CurrentSlotTable.store(SlotTable.get(), std::memory_order_release);
+			SlotTables.push_back(std::move(SlotTable));
+		}
+	};
+
+	// Intentionally never destroyed, since static objects may still hold names at exit.
+	FNameTable& GetNameTable()
+	{
+		static FNameTable* const NameTable = new FNameTable();
+		return *NameTable;
+	}
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief 32 bit FNV-1a. */
+	UInt32 HashString(const FChar* const String, const SizeT Length)
+	{
+		UInt32 Hash = 2166136261u;
+		for (SizeT I = 0; I < Length; ++I)
+		{
+			Hash ^= static_cast<UInt8>(String[I]);
+			Hash *= 16777619u;
+		}
+
+		return Hash;
+	}
+}
+
+using namespace FNameInternal;
+
+FName::FName(const FChar* const String)
+{
+	F_Assert(String, "String is null.");
+	Init(String, std::strlen(String));
+}
+
+FName::FName(const FString& String)
+{
+	Init(String.data(), String.size());
+}
+
+const FString& FName::GetString() const
+{
+	const FString& String = GetNameTable().GetEntry(Index).String;
+	return String;
+}
+
+SizeT FName::GetNameCount()
+{
+	// The empty string isn't counted.
+	const SizeT NameCount = GetNameTable().GetEntryCount() - 1;
+	return NameCount;
+}
+
+void FName::Init(const FChar* const String, const SizeT Length)
+{
+	if (!Length)
+	{
+		return;
+	}
+
+	Hash = HashString(String, Length);
+	Index = GetNameTable().FindOrAdd(String, Length, Hash);
+}
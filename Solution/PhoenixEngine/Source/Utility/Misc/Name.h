@@ -0,0 +1,110 @@
+#ifndef PHOENIX_NAME_H
+#define PHOENIX_NAME_H
+
+#include <functional>
+
+#include "Utility/Misc/OutputStream.h"
+#include "Utility/Misc/Primitives.h"
+#include "Utility/Misc/String.h"
+
+namespace Phoenix
+{
+	//	--------------------------------------------------------------------------------
+	/*! \brief An interned string, such as an asset or resource name.
+	*
+	*	@desc Every distinct string is stored once in a global table and an FName is only
+	*		its index there plus its precomputed hash, so copying, comparing and hashing
+	*		names never touches the characters.  Constructing an FName from a string
+	*		that's already interned doesn't take a lock.
+	*	@note Thread safe.  Interned strings live until the program exits.
+	*/
+	class FName
+	{
+	public:
+		FName() = default;
+
+		FName(const FChar* const String);
+
+		FName(const FString& String);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the interned string.  The reference stays valid until the program exits. */
+		const FString& GetString() const;
+
+		UInt32 GetIndex() const;
+
+		UInt32 GetHash() const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Checks whether this is the name of the empty string, which is the default. */
+		bool IsNone() const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the number of distinct strings that have been interned. */
+		static SizeT GetNameCount();
+
+		bool operator==(const FName& RHS) const;
+
+		bool operator!=(const FName& RHS) const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Orders names by the order they were interned in, not alphabetically. */
+		bool operator<(const FName& RHS) const;
+
+	private:
+		UInt32 Index{ 0 };
+		UInt32 Hash{ 0 };
+
+		void Init(const FChar* const String, const SizeT Length);
+	};
+
+	inline UInt32 FName::GetIndex() const
+	{
+		return Index;
+	}
+
+	inline UInt32 FName::GetHash() const
+	{
+		return Hash;
+	}
+
+	inline bool FName::IsNone() const
+	{
+		return Index == 0;
+	}
+
+	inline bool FName::operator==(const FName& RHS) const
+	{
+		return Index == RHS.Index;
+	}
+
+	inline bool FName::operator!=(const FName& RHS) const
+	{
+		return Index != RHS.Index;
+	}
+
+	inline bool FName::operator<(const FName& RHS) const
+	{
+		return Index < RHS.Index;
+	}
+
+	static FOutputStream& operator<<(FOutputStream& LHS, const FName& RHS)
+	{
+		LHS << RHS.GetString();
+		return LHS;
+	}
+}
+
+namespace std
+{
+	template <>
+	struct hash<Phoenix::FName>
+	{
+		size_t operator()(const Phoenix::FName& Name) const
+		{
+			return Name.GetHash();
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,268 @@
+#include "Stdafx.h"
+#include "Utility/Misc/PoolAllocator.h"
+
+#include "Utility/Containers/Vector.h"
+#include "Utility/Debug/Assert.h"
+#include "Utility/Misc/Allocator.h"
+#include "Utility/Threading/Mutex.h"
+
+using namespace Phoenix;
+
+namespace FPoolAllocConstants
+{
+	const SizeT SizeClassCount = FPoolAllocStats::SizeClassCount;
+	const SizeT MagazineSize = 32;
+	const SizeT SlabSize = 64 * 1024;
+}
+
+namespace FPoolAllocInternal
+{
+	struct FFreeBlock
+	{
+		FFreeBlock* Next;
+	};
+
+	/*! \brief An intrusive list of free blocks, so whole magazines move by value. */
+	struct FMagazine
+	{
+		FFreeBlock* Head{ nullptr };
+		SizeT Count{ 0 };
+
+		void Push(void* const Data)
+		{
+			FFreeBlock* const Block = static_cast<FFreeBlock*>(Data);
+			Block->Next = Head;
+			Head = Block;
+			++Count;
+		}
+
+		void* Pop()
+		{
+			FFreeBlock* const Block = Head;
+			Head = Block->Next;
+			--Count;
+			return Block;
+		}
+	};
+
+	struct FSizeClassDepot
+	{
+		TVector<FMagazine> Magazines;
+		TVector<UInt8*> Slabs;
+		UInt8* SlabCursor{ nullptr };
+		UInt8* SlabEnd{ nullptr };
+		SizeT DepotBlockCount{ 0 };
+	};
+
+	struct FDepot
+	{
+		FMutex Mutex;
+		TArray<FSizeClassDepot, FPoolAllocConstants::SizeClassCount> SizeClasses;
+	};
+
+	// Intentionally never destroyed.  Static objects may still free pooled memory while
+	// they are being destroyed at exit, and the OS reclaims the slabs afterwards.
+	FDepot& GetDepot()
+	{
+		static FDepot* const Depot = new FDepot();
+		return *Depot;
+	}
+
+	SizeT GetSizeClass(const SizeT Size)
+	{
+		const SizeT SizeClass = (Size + FPoolAlloc::SizeClassGranularity - 1) / FPoolAlloc::SizeClassGranularity - 1;
+		return SizeClass;
+	}
+
+	SizeT GetBlockSize(const SizeT SizeClass)
+	{
+		const SizeT BlockSize = (SizeClass + 1) * FPoolAlloc::SizeClassGranularity;
+		return BlockSize;
+	}
+
+	FMagazine TakeMagazine(const SizeT SizeClass)
+	{
+		using namespace FPoolAllocConstants;
+
+		FDepot& Depot = GetDepot();
+		FMutexLock Lock(Depot.Mutex);
+		FSizeClassDepot& ClassDepot = Depot.SizeClasses[SizeClass];
+
+		FMagazine Magazine;
+		if (!ClassDepot.Magazines.empty())
+		{
+			Magazine = ClassDepot.Magazines.back();
+			ClassDepot.Magazines.pop_back();
+			ClassDepot.DepotBlockCount -= Magazine.Count;
+			return Magazine;
+		}
+
+		const SizeT BlockSize = GetBlockSize(SizeClass);
+		for (SizeT I = 0; I < MagazineSize; ++I)
+		{
+			if (ClassDepot.SlabCursor == ClassDepot.SlabEnd)
+			{
+				UInt8* const Slab = static_cast<UInt8*>(FRawAlloc::New(SlabSize));
+				ClassDepot.Slabs.push_back(Slab);
+				ClassDepot.SlabCursor = Slab;
+				ClassDepot.SlabEnd = Slab + SlabSize / BlockSize * BlockSize;
+			}
+
+			Magazine.Push(ClassDepot.SlabCursor);
+			ClassDepot.SlabCursor += BlockSize;
+		}
+
+		return Magazine;
+	}
+
+	void ReturnMagazine(const SizeT SizeClass, const FMagazine& Magazine)
+	{
+		if (!Magazine.Count)
+		{
+			return;
+		}
+
+		FDepot& Depot = GetDepot();
+		FMutexLock Lock(Depot.Mutex);
+		FSizeClassDepot& ClassDepot = Depot.SizeClasses[SizeClass];
+
+		ClassDepot.Magazines.push_back(Magazine);
+		ClassDepot.DepotBlockCount += Magazine.Count;
+	}
+
+	/*! \brief Set once the calling thread's cache is gone, after which it goes straight to the depot. */
+	thread_local bool IsThreadCacheDestroyed = false;
+
+	struct FThreadCache
+	{
+		struct FSizeClassCache
+		{
+			FMagazine Loaded;
+			FMagazine Previous;
+		};
+
+		TArray<FSizeClassCache, FPoolAllocConstants::SizeClassCount> SizeClasses;
+
+		~FThreadCache()
+		{
+			IsThreadCacheDestroyed = true;
+
+			for (SizeT I = 0; I < FPoolAllocConstants::SizeClassCount; ++I)
+			{
+				ReturnMagazine(I, SizeClasses[I].Loaded);
+				ReturnMagazine(I, SizeClasses[I].Previous);
+			}
+		}
+	};
+
+	FThreadCache& GetThreadCache()
+	{
+		static thread_local FThreadCache ThreadCache;
+		return ThreadCache;
+	}
+}
+
+using namespace FPoolAllocInternal;
+
+FOutputStream& FPoolAllocStats::Output(FOutputStream& LHS) const
+{
+	LHS << "Pool size classes (block size: reserved KB / free blocks in depot)\n";
+
+	for (SizeT I = 0; I < SizeClassCount; ++I)
+	{
+		if (!ReservedBytes[I])
+		{
+			continue;
+		}
+
+		LHS << "\t" << GetBlockSize(I) << ": " << ReservedBytes[I] / 1024 << "KB / " << DepotBlockCount[I] << "\n";
+	}
+
+	return LHS;
+}
+
+void* FPoolAlloc::Allocate(const SizeT Size)
+{
+	F_Assert(Size, "Size should be greater than zero.");
+	if (Size > MaxBlockSize)
+	{
+		return FRawAlloc::New(Size);
+	}
+
+	const SizeT SizeClass = GetSizeClass(Size);
+	if (IsThreadCacheDestroyed)
+	{
+		FMagazine Magazine = TakeMagazine(SizeClass);
+		void* const Data = Magazine.Pop();
+		ReturnMagazine(SizeClass, Magazine);
+		return Data;
+	}
+
+	FThreadCache::FSizeClassCache& Cache = GetThreadCache().SizeClasses[SizeClass];
+
+	if (!Cache.Loaded.Count)
+	{
+		std::swap(Cache.Loaded, Cache.Previous);
+
+		if (!Cache.Loaded.Count)
+		{
+			Cache.Loaded = TakeMagazine(SizeClass);
+		}
+	}
+
+	void* const Data = Cache.Loaded.Pop();
+	return Data;
+}
+
+void FPoolAlloc::Free(void* const Data, const SizeT Size)
+{
+	if (!Data)
+	{
+		return;
+	}
+
+	if (Size > MaxBlockSize)
+	{
+		FRawAlloc::Delete(Data);
+		return;
+	}
+
+	const SizeT SizeClass = GetSizeClass(Size);
+	if (IsThreadCacheDestroyed)
+	{
+		FMagazine Magazine;
+		Magazine.Push(Data);
+		ReturnMagazine(SizeClass, Magazine);
+		return;
+	}
+
+	FThreadCache::FSizeClassCache& Cache = GetThreadCache().SizeClasses[SizeClass];
+
+	if (Cache.Loaded.Count == FPoolAllocConstants::MagazineSize)
+	{
+		if (Cache.Previous.Count)
+		{
+			ReturnMagazine(SizeClass, Cache.Previous);
+			Cache.Previous = FMagazine();
+		}
+
+		std::swap(Cache.Loaded, Cache.Previous);
+	}
+
+	Cache.Loaded.Push(Data);
+}
+
+FPoolAllocStats FPoolAlloc::GetStats()
+{
+	FDepot& Depot = GetDepot();
+	FMutexLock Lock(Depot.Mutex);
+
+	FPoolAllocStats Stats;
+	for (SizeT I = 0; I < FPoolAllocConstants::SizeClassCount; ++I)
+	{
+		Stats.ReservedBytes[I] = Depot.SizeClasses[I].Slabs.size() * FPoolAllocConstants::SlabSize;
+		Stats.DepotBlockCount[I] = Depot.SizeClasses[I].DepotBlockCount;
+	}
+
+	return Stats;
+}
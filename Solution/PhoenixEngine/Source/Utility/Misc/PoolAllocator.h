@@ -0,0 +1,116 @@
+#ifndef PHOENIX_POOL_ALLOCATOR_H
+#define PHOENIX_POOL_ALLOCATOR_H
+
+#include <type_traits>
+
+#include "Utility/Containers/Array.h"
+#include "Utility/Misc/OutputStream.h"
+#include "Utility/Misc/Primitives.h"
+
+namespace Phoenix
+{
+	struct FPoolAllocStats
+	{
+		static const SizeT SizeClassCount = 16;
+
+		/*! \brief Bytes taken from the heap for each size class.  Never given back. */
+		TArray<SizeT, SizeClassCount> ReservedBytes{};
+		/*! \brief Free blocks waiting in the central depot for each size class. */
+		TArray<SizeT, SizeClassCount> DepotBlockCount{};
+
+		FOutputStream& Output(FOutputStream& LHS) const;
+	};
+
+	static FOutputStream& operator<<(FOutputStream& LHS, const FPoolAllocStats& RHS)
+	{
+		return RHS.Output(LHS);
+	}
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Allocates small blocks from size class pools.
+	*
+	*	@desc Each thread caches free blocks in two magazines per size class, so the common
+	*		case never takes a lock.  When both are empty or full, a whole magazine is
+	*		swapped with the central depot in O(1).  Blocks freed on another thread simply
+	*		join that thread's magazines.  Sizes above MaxBlockSize go to the heap.
+	*	@note The caller must pass the same size to Free that it passed to Allocate.
+	*/
+	class FPoolAlloc
+	{
+	public:
+		static const SizeT SizeClassGranularity = 16;
+		static const SizeT MaxBlockSize = SizeClassGranularity * FPoolAllocStats::SizeClassCount;
+		static const SizeT BlockAlignment = SizeClassGranularity;
+
+		static void* Allocate(const SizeT Size);
+
+		static void Free(void* const Data, const SizeT Size);
+
+		static FPoolAllocStats GetStats();
+
+		template <class T>
+		static constexpr bool IsPoolable();
+	};
+
+	template <class T>
+	constexpr bool FPoolAlloc::IsPoolable()
+	{
+		// A polymorphic object may be deleted through a base pointer, which has the wrong size.
+		return sizeof(T) <= MaxBlockSize
+			&& alignof(T) <= BlockAlignment
+			&& !std::is_polymorphic<T>::value;
+	}
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief STL allocator over FPoolAlloc.  Suited to node based containers. */
+	template <class T>
+	class TPoolAlloc
+	{
+	public:
+		typedef T value_type;
+
+		TPoolAlloc() = default;
+
+		template <class U>
+		TPoolAlloc(const TPoolAlloc<U>&);
+
+		T* allocate(const SizeT Count);
+
+		void deallocate(T* const Data, const SizeT Count);
+	};
+
+	template <class T>
+	template <class U>
+	TPoolAlloc<T>::TPoolAlloc(const TPoolAlloc<U>&)
+	{
+	}
+
+	template <class T>
+	T* TPoolAlloc<T>::allocate(const SizeT Count)
+	{
+		static_assert(alignof(T) <= FPoolAlloc::BlockAlignment, "T is over aligned for the pools.");
+
+		T* const Data = static_cast<T*>(FPoolAlloc::Allocate(sizeof(T) * Count));
+		return Data;
+	}
+
+	template <class T>
+	void TPoolAlloc<T>::deallocate(T* const Data, const SizeT Count)
+	{
+		FPoolAlloc::Free(Data, sizeof(T) * Count);
+	}
+
+	template <class T, class U>
+	bool operator==(const TPoolAlloc<T>&, const TPoolAlloc<U>&)
+	{
+		return true;
+	}
+
+	template <class T, class U>
+	bool operator!=(const TPoolAlloc<T>&, const TPoolAlloc<U>&)
+	{
+		return false;
+	}
+}
+
+#endif
@@ -1,11 +1,8 @@
 #pragma once
 
 #include <cctype>
-#include <string>
-
-#ifdef __linux__
 #include <cstring>
-#endif
+#include <string>
 
 #include "Utility/Misc/Primitives.h"
 
@@ -108,4 +105,57 @@ namespace Phoenix
 		*/
 		void ToLower(FChar* const String);
 	}
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Hashes FString and FChar* alike, so hash tables can find FString keys
+	*	without building a temporary FString.  Pair it with FStringEqual.
+	*/
+	struct FStringHash
+	{
+		typedef void is_transparent;
+
+		SizeT operator()(const FString& String) const
+		{
+			return Hash(String.data(), String.size());
+		}
+
+		SizeT operator()(const FChar* const String) const
+		{
+			return Hash(String, std::strlen(String));
+		}
+
+	private:
+		static SizeT Hash(const FChar* const String, const SizeT Length)
+		{
+			// 64 bit FNV-1a.
+			UInt64 Result = 14695981039346656037ull;
+			for (SizeT I = 0; I < Length; ++I)
+			{
+				Result ^= static_cast<UInt8>(String[I]);
+				Result *= 1099511628211ull;
+			}
+
+			return static_cast<SizeT>(Result);
+		}
+	};
+
+	struct FStringEqual
+	{
+		typedef void is_transparent;
+
+		bool operator()(const FString& LHS, const FString& RHS) const
+		{
+			return LHS == RHS;
+		}
+
+		bool operator()(const FString& LHS, const FChar* const RHS) const
+		{
+			return LHS == RHS;
+		}
+
+		bool operator()(const FChar* const LHS, const FString& RHS) const
+		{
+			return RHS == LHS;
+		}
+	};
 }
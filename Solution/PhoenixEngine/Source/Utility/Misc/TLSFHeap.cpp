@@ -0,0 +1,533 @@
+#include "Stdafx.h"
+#include "Utility/Misc/TLSFHeap.h"
+
+#include <algorithm>
+
+#if _WIN32
+#	include <intrin.h>
+#	include "ExternalLib/Win32Includes.h"
+#else
+#	include <sys/mman.h>
+#endif
+
+#include "Utility/Debug/Assert.h"
+#include "Utility/Debug/Debug.h"
+
+using namespace Phoenix;
+
+namespace FTLSFHeapConstants
+{
+	// Windows hands out address space in 64KB steps, so arenas are sized in those on every platform.
+	const SizeT ArenaGranularity = 64 * 1024;
+}
+
+struct FTLSFHeap::FBlock
+{
+	/*! \brief The block right before this one in its arena, or null for the first block. */
+	FBlock* PrevPhysical;
+	/*! \brief Payload size in the upper bits, IsFreeBit in the lowest. */
+	SizeT SizeAndFlags;
+
+	// Only valid while the block is free.  These overlap the payload.
+	FBlock* NextFree;
+	FBlock* PrevFree;
+
+	static const SizeT IsFreeBit = 1;
+	static const SizeT HeaderSize = sizeof(FBlock*) + sizeof(SizeT);
+	static const SizeT MinSize = sizeof(FBlock*) * 2;
+
+	// Arenas start page aligned and block sizes are rounded to MinAlignment, so payloads
+	// only stay aligned while the header is a multiple of it too.
+	static_assert(HeaderSize % MinAlignment == 0, "Block headers would misalign payloads.");
+
+	SizeT GetSize() const
+	{
+		return SizeAndFlags & ~IsFreeBit;
+	}
+
+	void SetSize(const SizeT Size)
+	{
+		SizeAndFlags = Size | (SizeAndFlags & IsFreeBit);
+	}
+
+	bool IsFree() const
+	{
+		return (SizeAndFlags & IsFreeBit) != 0;
+	}
+
+	void SetFree(const bool IsFree)
+	{
+		SizeAndFlags = IsFree ? SizeAndFlags | IsFreeBit : SizeAndFlags & ~IsFreeBit;
+	}
+
+	UInt8* GetPayload()
+	{
+		return reinterpret_cast<UInt8*>(this) + HeaderSize;
+	}
+
+	FBlock* GetNextPhysical()
+	{
+		return reinterpret_cast<FBlock*>(GetPayload() + GetSize());
+	}
+
+	static FBlock* FromPayload(const void* const Data)
+	{
+		return reinterpret_cast<FBlock*>(const_cast<UInt8*>(static_cast<const UInt8*>(Data)) - HeaderSize);
+	}
+};
+
+namespace FTLSFHeapInternal
+{
+	static_assert(FTLSFHeap::MinAlignment == 16, "Block sizes and headers assume 16 byte alignment.");
+
+	SizeT FindLastSet(const UInt64 Value)
+	{
+#if _WIN32
+		unsigned long Index = 0;
+		_BitScanReverse64(&Index, Value);
+		return Index;
+#else
+		return 63 - __builtin_clzll(Value);
+#endif
+	}
+
+	SizeT FindFirstSet(const UInt32 Value)
+	{
+#if _WIN32
+		unsigned long Index = 0;
+		_BitScanForward(&Index, Value);
+		return Index;
+#else
+		return __builtin_ctz(Value);
+#endif
+	}
+
+	SizeT AlignUp(const SizeT Value, const SizeT Alignment)
+	{
+		return (Value + Alignment - 1) & ~(Alignment - 1);
+	}
+
+	UInt8* MapMemory(const SizeT Size)
+	{
+#if _WIN32
+		void* const Data = VirtualAlloc(nullptr, Size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+		return static_cast<UInt8*>(Data);
+#else
+		void* const Data = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		return Data == MAP_FAILED ? nullptr : static_cast<UInt8*>(Data);
+#endif
+	}
+
+	void UnmapMemory(UInt8* const Data, const SizeT Size)
+	{
+#if _WIN32
+		VirtualFree(Data, 0, MEM_RELEASE);
+#else
+		munmap(Data, Size);
+#endif
+	}
+}
+
+using namespace FTLSFHeapInternal;
+
+Float32 FTLSFHeapStats::GetFragmentation() const
+{
+	if (!FreeBytes)
+	{
+		return 0.f;
+	}
+
+	const Float32 Result = 1.f - static_cast<Float32>(LargestFreeBlock) / static_cast<Float32>(FreeBytes);
+	return Result;
+}
+
+FOutputStream& FTLSFHeapStats::Output(FOutputStream& LHS) const
+{
+	LHS << "Arenas: " << ArenaCount << " (" << ReservedBytes / 1024 << "KB)"
+		<< " Used: " << UsedBytes / 1024 << "KB in " << UsedBlockCount << " blocks"
+		<< " Free: " << FreeBytes / 1024 << "KB in " << FreeBlockCount << " blocks"
+		<< " Largest Free: " << LargestFreeBlock / 1024 << "KB"
+		<< " Fragmentation: " << GetFragmentation() * 100.f << "%";
+
+	return LHS;
+}
+
+FTLSFHeap::FTLSFHeap(const SizeT InArenaSize)
+	: ArenaSize(AlignUp(InArenaSize, FTLSFHeapConstants::ArenaGranularity))
+{
+	F_Assert(InArenaSize, "Arena size should be greater than zero.");
+}
+
+FTLSFHeap::~FTLSFHeap()
+{
+	F_LogWarningIf(UsedBlockCount, "TLSF heap destroyed with " << UsedBlockCount << " blocks still allocated.");
+
+	for (const FArena& Arena : Arenas)
+	{
+		UnmapMemory(Arena.Base, Arena.Size);
+	}
+}
+
+FTLSFHeap& FTLSFHeap::GetAssetHeap()
+{
+	// Intentionally never destroyed, since static objects may still own asset data at exit.
+	static FTLSFHeap* const AssetHeap = new FTLSFHeap();
+	return *AssetHeap;
+}
+
+void* FTLSFHeap::Allocate(const SizeT Size, const SizeT InAlignment)
+{
+	F_Assert(Size, "Size should be greater than zero.");
+	F_Assert(InAlignment && (InAlignment & (InAlignment - 1)) == 0, "Alignment must be a power of two.");
+
+	const SizeT Alignment = InAlignment > MinAlignment ? InAlignment : MinAlignment;
+	const SizeT BlockSize = AlignUp(Size > FBlock::MinSize ? Size : FBlock::MinSize, MinAlignment);
+
+	// Leaves room to split off a free block in front of the aligned payload.
+	const SizeT AlignmentPadding = Alignment > MinAlignment ? Alignment + FBlock::HeaderSize + FBlock::MinSize : 0;
+	const SizeT SearchSize = BlockSize + AlignmentPadding;
+
+	FMutexLock Lock(Mutex);
+
+	FBlock* Block = FindFreeBlock(SearchSize);
+	if (!Block)
+	{
+		if (!AddArena(SearchSize))
+		{
+			F_LogError("TLSF heap failed to map an arena for " << Size << " bytes.");
+			return nullptr;
+		}
+
+		Block = FindFreeBlock(SearchSize);
+		F_Assert(Block, "A new arena should always fit the allocation.");
+	}
+
+	RemoveFreeBlock(Block);
+
+	if (Alignment > MinAlignment)
+	{
+		const SizeT PayloadValue = reinterpret_cast<SizeT>(Block->GetPayload());
+		SizeT Gap = AlignUp(PayloadValue, Alignment) - PayloadValue;
+
+		if (Gap)
+		{
+			// The gap becomes a free block, so it needs room for one.
+			if (Gap < FBlock::HeaderSize + FBlock::MinSize)
+			{
+				Gap = AlignUp(PayloadValue + FBlock::HeaderSize + FBlock::MinSize, Alignment) - PayloadValue;
+			}
+
+			FBlock* const AlignedBlock = SplitBlock(Block, Gap - FBlock::HeaderSize);
+
+			// A free block's neighbours are never free, so the gap needs no merging.
+			InsertFreeBlock(Block);
+			Block = AlignedBlock;
+		}
+	}
+
+	F_Assert(Block->GetSize() >= BlockSize, "Block is too small.");
+
+	if (Block->GetSize() >= BlockSize + FBlock::HeaderSize + FBlock::MinSize)
+	{
+		FBlock* const Remainder = SplitBlock(Block, BlockSize);
+		InsertFreeBlock(MergeWithNext(Remainder));
+	}
+
+	Block->SetFree(false);
+	UsedBytes += Block->GetSize();
+	++UsedBlockCount;
+
+	void* const Data = Block->GetPayload();
+	F_Assert(reinterpret_cast<SizeT>(Data) % Alignment == 0, "Allocation is misaligned.");
+	return Data;
+}
+
+void FTLSFHeap::Free(void* const Data)
+{
+	if (!Data)
+	{
+		return;
+	}
+
+	FMutexLock Lock(Mutex);
+
+	FBlock* Block = FBlock::FromPayload(Data);
+	F_Assert(!Block->IsFree(), "Block was already freed.");
+
+	UsedBytes -= Block->GetSize();
+	--UsedBlockCount;
+
+	Block = MergeWithNext(Block);
+	Block = MergeWithPrevious(Block);
+
+	// Arenas bigger than ArenaSize only ever hold the one allocation they were mapped for,
+	// so they go straight back to the OS rather than waiting for a Trim.
+	const SizeT BlockArenaSize = Block->GetSize() + FBlock::HeaderSize * 2;
+	if (!Block->PrevPhysical && BlockArenaSize > ArenaSize && Block->GetNextPhysical()->GetSize() == 0)
+	{
+		UInt8* const Base = reinterpret_cast<UInt8*>(Block);
+		auto Arena = std::find_if(Arenas.begin(), Arenas.end(), [Base](const FArena& Item)
+		{
+			return Item.Base == Base;
+		});
+
+		F_Assert(Arena != Arenas.end(), "Block's arena was not found.");
+		F_Assert(Arena->Size == BlockArenaSize, "Block should span its whole arena.");
+
+		UnmapMemory(Arena->Base, Arena->Size);
+		Arenas.erase(Arena);
+		return;
+	}
+
+	InsertFreeBlock(Block);
+}
+
+SizeT FTLSFHeap::GetAllocationSize(const void* const Data) const
+{
+	F_Assert(Data, "Data is null.");
+
+	const FBlock* const Block = FBlock::FromPayload(Data);
+	return Block->GetSize();
+}
+
+SizeT FTLSFHeap::Trim()
+{
+	FMutexLock Lock(Mutex);
+
+	SizeT TrimmedBytes = 0;
+
+	auto IsArenaEmpty = [](const FArena& Arena)
+	{
+		const FBlock* const First = reinterpret_cast<const FBlock*>(Arena.Base);
+		return First->IsFree() && First->GetSize() == Arena.Size - FBlock::HeaderSize * 2;
+	};
+
+	auto Trimmed = std::remove_if(Arenas.begin(), Arenas.end(), [&](const FArena& Arena)
+	{
+		if (!IsArenaEmpty(Arena))
+		{
+			return false;
+		}
+
+		RemoveFreeBlock(reinterpret_cast<FBlock*>(Arena.Base));
+		UnmapMemory(Arena.Base, Arena.Size);
+		TrimmedBytes += Arena.Size;
+		return true;
+	});
+
+	Arenas.erase(Trimmed, Arenas.end());
+
+	return TrimmedBytes;
+}
+
+FTLSFHeapStats FTLSFHeap::GetStats() const
+{
+	FMutexLock Lock(Mutex);
+
+	FTLSFHeapStats Stats;
+	Stats.ArenaCount = Arenas.size();
+	Stats.UsedBytes = UsedBytes;
+	Stats.UsedBlockCount = UsedBlockCount;
+
+	for (const FArena& Arena : Arenas)
+	{
+		Stats.ReservedBytes += Arena.Size;
+	}
+
+	for (const auto& SLFreeLists : FreeLists)
+	{
+		for (const FBlock* Block : SLFreeLists)
+		{
+			for (; Block; Block = Block->NextFree)
+			{
+				++Stats.FreeBlockCount;
+				Stats.FreeBytes += Block->GetSize();
+				Stats.LargestFreeBlock = std::max(Stats.LargestFreeBlock, Block->GetSize());
+			}
+		}
+	}
+
+	return Stats;
+}
+
+void FTLSFHeap::MappingInsert(const SizeT Size, SizeT& FL, SizeT& SL)
+{
+	if (Size < SmallBlockSize)
+	{
+		FL = 0;
+		SL = Size / (SmallBlockSize / SLCount);
+		return;
+	}
+
+	const SizeT LastSet = FindLastSet(Size);
+	SL = (Size >> (LastSet - SLCountLog2)) ^ SLCount;
+	FL = LastSet - (FLIndexShift - 1);
+}
+
+void FTLSFHeap::MappingSearch(const SizeT Size, SizeT& FL, SizeT& SL)
+{
+	// Rounds up to the next bin, so every block in the bin that's found is big enough.
+	SizeT RoundedSize = Size;
+	if (Size >= SmallBlockSize)
+	{
+		RoundedSize += (static_cast<SizeT>(1) << (FindLastSet(Size) - SLCountLog2)) - 1;
+	}
+
+	MappingInsert(RoundedSize, FL, SL);
+}
+
+FTLSFHeap::FBlock* FTLSFHeap::FindFreeBlock(const SizeT Size)
+{
+	SizeT FL = 0;
+	SizeT SL = 0;
+	MappingSearch(Size, FL, SL);
+
+	if (FL >= FLCount)
+	{
+		return nullptr;
+	}
+
+	UInt32 SLMap = SLBitmaps[FL] & (~0u << SL);
+	if (!SLMap)
+	{
+		const UInt32 FLMap = FL + 1 < FLCount ? FLBitmap & (~0u << (FL + 1)) : 0;
+		if (!FLMap)
+		{
+			return nullptr;
+		}
+
+		FL = FindFirstSet(FLMap);
+		SLMap = SLBitmaps[FL];
+	}
+
+	SL = FindFirstSet(SLMap);
+
+	FBlock* const Block = FreeLists[FL][SL];
+	return Block;
+}
+
+void FTLSFHeap::InsertFreeBlock(FBlock* const Block)
+{
+	SizeT FL = 0;
+	SizeT SL = 0;
+	MappingInsert(Block->GetSize(), FL, SL);
+
+	FBlock*& Head = FreeLists[FL][SL];
+
+	Block->SetFree(true);
+	Block->PrevFree = nullptr;
+	Block->NextFree = Head;
+
+	if (Head)
+	{
+		Head->PrevFree = Block;
+	}
+
+	Head = Block;
+	FLBitmap |= 1u << FL;
+	SLBitmaps[FL] |= 1u << SL;
+}
+
+void FTLSFHeap::RemoveFreeBlock(FBlock* const Block)
+{
+	SizeT FL = 0;
+	SizeT SL = 0;
+	MappingInsert(Block->GetSize(), FL, SL);
+
+	if (Block->PrevFree)
+	{
+		Block->PrevFree->NextFree = Block->NextFree;
+	}
+	else
+	{
+		FreeLists[FL][SL] = Block->NextFree;
+	}
+
+	if (Block->NextFree)
+	{
+		Block->NextFree->PrevFree = Block->PrevFree;
+	}
+
+	if (!FreeLists[FL][SL])
+	{
+		SLBitmaps[FL] &= ~(1u << SL);
+		if (!SLBitmaps[FL])
+		{
+			FLBitmap &= ~(1u << FL);
+		}
+	}
+}
+
+FTLSFHeap::FBlock* FTLSFHeap::SplitBlock(FBlock* const Block, const SizeT Size)
+{
+	F_Assert(Block->GetSize() >= Size + FBlock::HeaderSize + FBlock::MinSize, "Block is too small to split.");
+
+	FBlock* const Remainder = reinterpret_cast<FBlock*>(Block->GetPayload() + Size);
+	Remainder->PrevPhysical = Block;
+	Remainder->SizeAndFlags = Block->GetSize() - Size - FBlock::HeaderSize;
+
+	Block->SetSize(Size);
+	Remainder->GetNextPhysical()->PrevPhysical = Remainder;
+
+	return Remainder;
+}
+
+FTLSFHeap::FBlock* FTLSFHeap::MergeWithNext(FBlock* const Block)
+{
+	FBlock* const Next = Block->GetNextPhysical();
+	if (!Next->IsFree())
+	{
+		return Block;
+	}
+
+	RemoveFreeBlock(Next);
+
+	Block->SetSize(Block->GetSize() + FBlock::HeaderSize + Next->GetSize());
+	Block->GetNextPhysical()->PrevPhysical = Block;
+
+	return Block;
+}
+
+FTLSFHeap::FBlock* FTLSFHeap::MergeWithPrevious(FBlock* const Block)
+{
+	FBlock* const Prev = Block->PrevPhysical;
+	if (!Prev || !Prev->IsFree())
+	{
+		return Block;
+	}
+
+	RemoveFreeBlock(Prev);
+
+	Prev->SetSize(Prev->GetSize() + FBlock::HeaderSize + Block->GetSize());
+	Prev->GetNextPhysical()->PrevPhysical = Prev;
+
+	return Prev;
+}
+
+bool FTLSFHeap::AddArena(const SizeT MinBlockSize)
+{
+	const SizeT Size = std::max(ArenaSize, AlignUp(MinBlockSize + FBlock::HeaderSize * 2, FTLSFHeapConstants::ArenaGranularity));
+
+	FArena Arena;
+	Arena.Base = MapMemory(Size);
+	Arena.Size = Size;
+
+	if (!Arena.Base)
+	{
+		return false;
+	}
+
+	Arenas.push_back(Arena);
+
+	FBlock* const First = reinterpret_cast<FBlock*>(Arena.Base);
+	First->PrevPhysical = nullptr;
+	First->SizeAndFlags = Size - FBlock::HeaderSize * 2;
+
+	// A zero sized, permanently used block ends the arena so merges stop there.
+	FBlock* const Sentinel = First->GetNextPhysical();
+	Sentinel->PrevPhysical = First;
+	Sentinel->SizeAndFlags = 0;
+
+	InsertFreeBlock(First);
+	return true;
+}
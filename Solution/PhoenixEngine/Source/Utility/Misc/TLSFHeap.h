@@ -0,0 +1,143 @@
+#ifndef PHOENIX_TLSF_HEAP_H
+#define PHOENIX_TLSF_HEAP_H
+
+#include "Utility/Containers/Array.h"
+#include "Utility/Containers/Vector.h"
+#include "Utility/Misc/OutputStream.h"
+#include "Utility/Misc/Primitives.h"
+#include "Utility/Threading/Mutex.h"
+
+namespace Phoenix
+{
+	struct FTLSFHeapStats
+	{
+		SizeT ArenaCount{ 0 };
+		/*! \brief Bytes mapped from the OS, including block headers. */
+		SizeT ReservedBytes{ 0 };
+		SizeT UsedBytes{ 0 };
+		SizeT UsedBlockCount{ 0 };
+		SizeT FreeBytes{ 0 };
+		SizeT FreeBlockCount{ 0 };
+		SizeT LargestFreeBlock{ 0 };
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets how much of the free memory is unusable for one allocation of its size.
+		*
+		*	@return Returns 0 when all free memory is in one block, approaching 1 as it splinters.
+		*/
+		Float32 GetFragmentation() const;
+
+		FOutputStream& Output(FOutputStream& LHS) const;
+	};
+
+	static FOutputStream& operator<<(FOutputStream& LHS, const FTLSFHeapStats& RHS)
+	{
+		return RHS.Output(LHS);
+	}
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief A Two-Level Segregated Fit heap over arenas mapped directly from the OS.
+	*
+	*	@desc Free blocks are binned by the power of two of their size and then by one of
+	*		16 linear steps within it.  Two levels of bitmaps find a bin that is guaranteed
+	*		to fit, so allocating and freeing are O(1) and neighbours are merged right away.
+	*		Arenas that become completely free can be unmapped with Trim.
+	*	@note Thread safe.  Every call takes the heap's lock.
+	*/
+	class FTLSFHeap
+	{
+	public:
+		static const SizeT DefaultArenaSize = 16 * 1024 * 1024;
+		static const SizeT MinAlignment = 16;
+
+		explicit FTLSFHeap(const SizeT ArenaSize = DefaultArenaSize);
+
+		FTLSFHeap(const FTLSFHeap&) = delete;
+		FTLSFHeap& operator=(const FTLSFHeap&) = delete;
+
+		FTLSFHeap(FTLSFHeap&&) = delete;
+		FTLSFHeap& operator=(FTLSFHeap&&) = delete;
+
+		~FTLSFHeap();
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the heap that large asset buffers are allocated from. */
+		static FTLSFHeap& GetAssetHeap();
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Allocates Size bytes aligned to Alignment.
+		*
+		*	@param Alignment - A power of two.  Anything below MinAlignment is raised to it.
+		*	@note Allocations bigger than the arena size get an arena of their own.
+		*/
+		void* Allocate(const SizeT Size, const SizeT Alignment = MinAlignment);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Frees an allocation.
+		*
+		*	@note An allocation that got an arena of its own has that arena unmapped right away.
+		*/
+		void Free(void* const Data);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the usable size of an allocation, which may exceed what was asked for. */
+		SizeT GetAllocationSize(const void* const Data) const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Returns every completely free arena to the OS.
+		*
+		*	@return Returns the number of bytes that were unmapped.
+		*/
+		SizeT Trim();
+
+		FTLSFHeapStats GetStats() const;
+
+	private:
+		static const SizeT SLCountLog2 = 4;
+		static const SizeT SLCount = 1 << SLCountLog2;
+		static const SizeT FLIndexShift = SLCountLog2 + 4;
+		static const SizeT FLIndexMax = 39;
+		static const SizeT FLCount = FLIndexMax - FLIndexShift + 1;
+		static const SizeT SmallBlockSize = 1 << FLIndexShift;
+
+		struct FBlock;
+
+		struct FArena
+		{
+			UInt8* Base{ nullptr };
+			SizeT Size{ 0 };
+		};
+
+		SizeT ArenaSize{ 0 };
+		TVector<FArena> Arenas;
+
+		UInt32 FLBitmap{ 0 };
+		TArray<UInt32, FLCount> SLBitmaps{};
+		TArray<TArray<FBlock*, SLCount>, FLCount> FreeLists{};
+
+		SizeT UsedBytes{ 0 };
+		SizeT UsedBlockCount{ 0 };
+
+		mutable FMutex Mutex;
+
+		static void MappingInsert(const SizeT Size, SizeT& FL, SizeT& SL);
+
+		static void MappingSearch(const SizeT Size, SizeT& FL, SizeT& SL);
+
+		FBlock* FindFreeBlock(const SizeT Size);
+
+		void InsertFreeBlock(FBlock* const Block);
+
+		void RemoveFreeBlock(FBlock* const Block);
+
+		FBlock* SplitBlock(FBlock* const Block, const SizeT Size);
+
+		FBlock* MergeWithNext(FBlock* const Block);
+
+		FBlock* MergeWithPrevious(FBlock* const Block);
+
+		bool AddArena(const SizeT MinBlockSize);
+	};
+}
+
+#endif
@@ -27,17 +27,19 @@ namespace Phoenix
 
 		//Vector of Non-bool Primitives
 		template<typename T
+				, class TAllocator
 				, TEnableIf<TIsArithmetic<T>::value
 							&& !TIsSame<T, bool>::value, Int32> = 0>
-		void Load(TVector<T>& VectorData);
+		void Load(TVector<T, TAllocator>& VectorData);
 
 		//Vectors of bools
 		void Load(TVector<bool>& VectorData);
 
 		//Vector of Class Types
 		template<typename T
+				, class TAllocator
 				, TDisableIf<TIsArithmetic<T>::value, Int32> = 0>
-		void Load(TVector<T>& VectorData);
+		void Load(TVector<T, TAllocator>& VectorData);
 
 		//Array
 		template<typename T, SizeT Size
@@ -77,9 +79,10 @@ namespace Phoenix
 	}
 
 	template<typename T
+			, class TAllocator
 			, TEnableIf<TIsArithmetic<T>::value
 						&& !TIsSame<T, bool>::value, Int32>>
-	void FBinaryDeserializer::Load(TVector<T>& VectorData)
+	void FBinaryDeserializer::Load(TVector<T, TAllocator>& VectorData)
 	{
 		SizeT VectorSize = 0;
 		Serialize(VectorSize);
@@ -90,8 +93,9 @@ namespace Phoenix
 	}
 
 	template<typename T
+			, class TAllocator
 			, TDisableIf<TIsArithmetic<T>::value, Int32>>
-	void FBinaryDeserializer::Load(TVector<T>& VectorData)
+	void FBinaryDeserializer::Load(TVector<T, TAllocator>& VectorData)
 	{
 		SizeT VectorSize = 0;
 		Serialize(VectorSize);
@@ -29,17 +29,19 @@ namespace Phoenix
 
 		//Vector of Non-bool Primitives
 		template<typename T
+				, class TAllocator
 				, TEnableIf<TIsArithmetic<T>::value
 							&& !TIsSame<T, bool>::value, Int32> = 0>
-		void Save(TVector<T>& VectorData);
+		void Save(TVector<T, TAllocator>& VectorData);
 
 		//Vectors of bools
 		void Save(TVector<bool>& VectorData);
 
 		//Vector of Class Types
 		template<typename T
+				, class TAllocator
 				, TDisableIf<TIsArithmetic<T>::value, Int32> = 0>
-		void Save(TVector<T>& VectorData);
+		void Save(TVector<T, TAllocator>& VectorData);
 
 		//Array
 		template<typename T, SizeT Size
@@ -77,9 +79,10 @@ namespace Phoenix
 	}
 
 	template<typename T
+			, class TAllocator
 			, TEnableIf<TIsArithmetic<T>::value
 						&& !TIsSame<T, bool>::value, Int32>>
-	void FBinarySerializer::Save(TVector<T>& VectorData)
+	void FBinarySerializer::Save(TVector<T, TAllocator>& VectorData)
 	{
 		const SizeT VectorSize = VectorData.size();
 		Serialize(VectorSize);
@@ -88,8 +91,9 @@ namespace Phoenix
 	}
 
 	template<typename T
+			, class TAllocator
 			, TDisableIf<TIsArithmetic<T>::value, Int32>>
-	void FBinarySerializer::Save(TVector<T>& VectorData)
+	void FBinarySerializer::Save(TVector<T, TAllocator>& VectorData)
 	{
 		const SizeT VectorSize = VectorData.size();
 		Serialize(VectorSize);
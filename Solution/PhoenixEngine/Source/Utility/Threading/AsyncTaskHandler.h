@@ -12,7 +12,7 @@
 
 namespace Phoenix
 {
-	typedef TFunction<void()> FAsyncTask;
+	typedef TInlineFunction<void()> FAsyncTask;
 	typedef TVector<FAsyncTask> FAsyncTasks;
 
 	class FAsyncTaskHandler
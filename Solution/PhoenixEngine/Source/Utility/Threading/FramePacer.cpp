@@ -0,0 +1,165 @@
+#include "Stdafx.h"
+#include "Utility/Threading/FramePacer.h"
+
+#include <thread>
+
+#if defined(__linux__)
+#	include <cerrno>
+#	include <time.h>
+#endif
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#	include <emmintrin.h>
+#	define F_CpuRelax() _mm_pause()
+#else
+#	define F_CpuRelax() ((void)0)
+#endif
+
+#include "Utility/Debug/Assert.h"
+
+using namespace Phoenix;
+
+namespace FFramePacerConstants
+{
+	// Linux timer slack alone is about 50us, so start well above that until calibrated.
+	const std::chrono::nanoseconds InitialSpinMargin = std::chrono::microseconds(500);
+	const std::chrono::nanoseconds MinSpinMargin = std::chrono::microseconds(20);
+	const std::chrono::nanoseconds MaxSpinMargin = std::chrono::milliseconds(4);
+
+	// The margin grows to any overshoot it fails to cover and decays slowly toward tighter ones.
+	const Int64 GrowthPercent = 125;
+	const Int64 DecayShift = 6;
+}
+
+const TArray<Int64, FFramePacerStats::BucketCount> FFramePacerStats::BucketLimitsUS =
+{
+	10, 25, 50, 100, 250, 500, 1000, 2000, 5000, TNumericLimits<Int64>::max()
+};
+
+void FFramePacerStats::AddSample(const Int64 LatenessNS)
+{
+	const Int64 LatenessUS = LatenessNS / 1000;
+
+	SizeT Bucket = 0;
+	while (LatenessUS >= BucketLimitsUS[Bucket])
+	{
+		++Bucket;
+	}
+
+	++Buckets[Bucket];
+	++FrameCount;
+	TotalLatenessNS += LatenessNS;
+	MaxLatenessNS = std::max(MaxLatenessNS, LatenessNS);
+}
+
+FOutputStream& FFramePacerStats::Output(FOutputStream& LHS) const
+{
+	const Int64 AverageLatenessNS = FrameCount ? TotalLatenessNS / FrameCount : 0;
+
+	LHS << "Frames: " << FrameCount
+		<< " Missed: " << MissedFrameCount
+		<< " Avg Lateness: " << AverageLatenessNS / 1000 << "us"
+		<< " Max Lateness: " << MaxLatenessNS / 1000 << "us\n";
+
+	for (SizeT I = 0; I < BucketCount; ++I)
+	{
+		const bool IsLastBucket = I + 1 == BucketCount;
+		if (IsLastBucket)
+		{
+			LHS << "\t>= " << BucketLimitsUS[I - 1] << "us: " << Buckets[I] << "\n";
+		}
+		else
+		{
+			LHS << "\t<  " << BucketLimitsUS[I] << "us: " << Buckets[I] << "\n";
+		}
+	}
+
+	return LHS;
+}
+
+void FFramePacer::Init(const Float32 FramesPerSec)
+{
+	F_Assert(FramesPerSec > 0.f, "Frame rate must be positive.");
+
+	const std::chrono::duration<Float64> PeriodSeconds(1.0 / FramesPerSec);
+
+	Period = std::chrono::duration_cast<FNanoseconds>(PeriodSeconds);
+	SpinMargin = FFramePacerConstants::InitialSpinMargin;
+	Deadline = FClock::now() + Period;
+	Stats = FFramePacerStats();
+}
+
+void FFramePacer::WaitForNextFrame()
+{
+	F_Assert(Period.count() > 0, "Frame pacer has not been initialized.");
+
+	const FTimePoint WakeTime = Deadline - SpinMargin;
+	if (FClock::now() < WakeTime)
+	{
+		SleepUntil(WakeTime);
+		CalibrateSpinMargin(FClock::now() - WakeTime);
+	}
+
+	FTimePoint Now = FClock::now();
+	while (Now < Deadline)
+	{
+		F_CpuRelax();
+		Now = FClock::now();
+	}
+
+	Stats.AddSample((Now - Deadline).count());
+	Deadline += Period;
+
+	const bool IsFrameMissed = Now >= Deadline;
+	if (IsFrameMissed)
+	{
+		const Int64 MissedCount = (Now - Deadline) / Period + 1;
+		Stats.MissedFrameCount += static_cast<UInt32>(MissedCount);
+		Deadline += Period * MissedCount;
+	}
+}
+
+const FFramePacerStats& FFramePacer::GetStats() const
+{
+	return Stats;
+}
+
+Float32 FFramePacer::GetSpinMarginSeconds() const
+{
+	const Float32 SpinMarginSeconds = std::chrono::duration_cast<std::chrono::duration<Float32>>(SpinMargin).count();
+	return SpinMarginSeconds;
+}
+
+void FFramePacer::SleepUntil(const FTimePoint& WakeTime)
+{
+#if defined(__linux__)
+	// steady_clock is CLOCK_MONOTONIC on Linux, so the deadline can be passed as an absolute time.
+	const FNanoseconds SinceEpoch = WakeTime.time_since_epoch();
+	const Int64 NanosecondsPerSecond = 1000000000;
+
+	timespec WakeTimeSpec;
+	WakeTimeSpec.tv_sec = static_cast<time_t>(SinceEpoch.count() / NanosecondsPerSecond);
+	WakeTimeSpec.tv_nsec = static_cast<long>(SinceEpoch.count() % NanosecondsPerSecond);
+
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &WakeTimeSpec, nullptr) == EINTR)
+	{
+	}
+#else
+	std::this_thread::sleep_until(WakeTime);
+#endif
+}
+
+void FFramePacer::CalibrateSpinMargin(const FNanoseconds Overshoot)
+{
+	if (Overshoot >= SpinMargin)
+	{
+		SpinMargin = Overshoot * FFramePacerConstants::GrowthPercent / 100;
+	}
+	else
+	{
+		SpinMargin -= (SpinMargin - Overshoot) / (1 << FFramePacerConstants::DecayShift);
+	}
+
+	SpinMargin = std::max(SpinMargin, FFramePacerConstants::MinSpinMargin);
+	SpinMargin = std::min(SpinMargin, FFramePacerConstants::MaxSpinMargin);
+}
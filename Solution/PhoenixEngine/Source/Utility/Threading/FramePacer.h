@@ -0,0 +1,86 @@
+#ifndef PHOENIX_FRAME_PACER_H
+#define PHOENIX_FRAME_PACER_H
+
+#include <chrono>
+
+#include "Utility/Containers/Array.h"
+#include "Utility/Misc/OutputStream.h"
+#include "Utility/Misc/Primitives.h"
+
+namespace Phoenix
+{
+	struct FFramePacerStats
+	{
+		static const SizeT BucketCount = 10;
+
+		//! Upper bound, in microseconds, of each lateness bucket.  The last bucket is open ended.
+		static const TArray<Int64, BucketCount> BucketLimitsUS;
+
+		TArray<UInt32, BucketCount> Buckets{};
+		UInt32 FrameCount{ 0 };
+		UInt32 MissedFrameCount{ 0 };
+		Int64 TotalLatenessNS{ 0 };
+		Int64 MaxLatenessNS{ 0 };
+
+		void AddSample(const Int64 LatenessNS);
+
+		FOutputStream& Output(FOutputStream& LHS) const;
+	};
+
+	static FOutputStream& operator<<(FOutputStream& LHS, const FFramePacerStats& RHS)
+	{
+		return RHS.Output(LHS);
+	}
+
+	//	--------------------------------------------------------------------------------
+	/*! \brief Blocks the calling thread until the start of its next frame.
+	*
+	*	@desc The thread sleeps until shortly before the deadline and then spins the rest
+	*		of the way.  The spin margin is calibrated at runtime from how late the OS
+	*		actually wakes the thread, so the spin stays short without missing deadlines.
+	*/
+	class FFramePacer
+	{
+	public:
+		FFramePacer() = default;
+
+		FFramePacer(const FFramePacer&) = delete;
+		FFramePacer& operator=(const FFramePacer&) = delete;
+
+		FFramePacer(FFramePacer&&) = delete;
+		FFramePacer& operator=(FFramePacer&&) = delete;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Sets the frame rate and anchors the first deadline one period from now. */
+		void Init(const Float32 FramesPerSec);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Waits for the next deadline and advances it by one period.
+		*
+		*	@note If the caller falls a full period behind, the missed deadlines are skipped
+		*		rather than run back to back.
+		*/
+		void WaitForNextFrame();
+
+		const FFramePacerStats& GetStats() const;
+
+		Float32 GetSpinMarginSeconds() const;
+
+	private:
+		typedef std::chrono::steady_clock FClock;
+		typedef FClock::time_point FTimePoint;
+		typedef std::chrono::nanoseconds FNanoseconds;
+
+		FTimePoint Deadline;
+		FNanoseconds Period{ 0 };
+		FNanoseconds SpinMargin{ 0 };
+
+		FFramePacerStats Stats;
+
+		void SleepUntil(const FTimePoint& WakeTime);
+
+		void CalibrateSpinMargin(const FNanoseconds Overshoot);
+	};
+}
+
+#endif
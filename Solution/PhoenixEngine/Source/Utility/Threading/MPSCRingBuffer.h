@@ -0,0 +1,227 @@
+#ifndef PHOENIX_MPSC_RING_BUFFER_H
+#define PHOENIX_MPSC_RING_BUFFER_H
+
+#include "Utility/Containers/Array.h"
+#include "Utility/Debug/Assert.h"
+#include "Utility/Misc/Primitives.h"
+#include "Utility/Threading/Atomic.h"
+
+namespace Phoenix
+{
+	//	--------------------------------------------------------------------------------
+	/*! \brief A bounded, lock-free, multiple producer single consumer queue.
+	*
+	*	@desc Every slot carries a sequence number that tells producers and the consumer
+	*		whether the slot is free or holds a published item.  Storage is fixed at
+	*		compile time so pushing and popping never allocate.
+	*	@note Push may be called from any thread.  Peek, Pop and TryPop must only be
+	*		called from the single consumer thread.
+	*/
+	template <class T, SizeT Capacity>
+	class TMPSCRingBuffer
+	{
+		static_assert(Capacity >= 2, "Capacity must be at least 2.");
+		static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
+	public:
+		TMPSCRingBuffer();
+
+		TMPSCRingBuffer(const TMPSCRingBuffer&) = delete;
+		TMPSCRingBuffer& operator=(const TMPSCRingBuffer&) = delete;
+
+		TMPSCRingBuffer(TMPSCRingBuffer&&) = delete;
+		TMPSCRingBuffer& operator=(TMPSCRingBuffer&&) = delete;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Copies an item into the queue.
+		*
+		*	@return Returns false if the queue is full, in which case nothing is added.
+		*/
+		bool TryPush(const T& Item);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the oldest item without removing it.
+		*
+		*	@return Returns null if the queue is empty.
+		*	@note Consumer thread only.
+		*/
+		const T* Peek() const;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Removes the oldest item.  Peek must have returned a non-null value first.
+		*
+		*	@note Consumer thread only.
+		*/
+		void Pop();
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Moves the oldest item into OutItem and removes it from the queue.
+		*
+		*	@return Returns false if the queue is empty.
+		*	@note Consumer thread only.
+		*/
+		bool TryPop(T& OutItem);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Removes items, oldest first, for as long as Predicate accepts them.
+		*
+		*	@param Predicate - Called with the oldest item.  Returning false leaves it and
+		*		every newer item in the queue.
+		*	@param Function - Called with each accepted item before it is removed.
+		*	@return Returns the number of items removed.
+		*	@note Consumer thread only.
+		*/
+		template <class TPredicate, class TFunction>
+		SizeT PopWhile(const TPredicate& Predicate, const TFunction& Function);
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the number of items in the queue.
+		*
+		*	@note Consumer thread only.  The value is a snapshot while producers are active.
+		*/
+		SizeT GetSizeApprox() const;
+
+		static constexpr SizeT GetCapacity();
+
+	private:
+		static const SizeT IndexMask = Capacity - 1;
+		static const SizeT CacheLineSize = 64;
+
+		struct FCell
+		{
+			TAtomic<SizeT> Sequence;
+			T Item;
+		};
+
+		TArray<FCell, Capacity> Cells;
+
+		// Keep the producer and consumer positions on separate cache lines.
+		UInt8 ProducerPadding[CacheLineSize];
+		TAtomic<SizeT> EnqueuePos{ 0 };
+		UInt8 ConsumerPadding[CacheLineSize];
+		SizeT DequeuePos{ 0 };
+	};
+
+	template <class T, SizeT Capacity>
+	TMPSCRingBuffer<T, Capacity>::TMPSCRingBuffer()
+	{
+		for (SizeT I = 0; I < Capacity; ++I)
+		{
+			Cells[I].Sequence.store(I, std::memory_order_relaxed);
+		}
+	}
+
+	template <class T, SizeT Capacity>
+	bool TMPSCRingBuffer<T, Capacity>::TryPush(const T& Item)
+	{
+		SizeT Pos = EnqueuePos.load(std::memory_order_relaxed);
+		FCell* Cell = nullptr;
+
+		for (;;)
+		{
+			Cell = &Cells[Pos & IndexMask];
+
+			const SizeT Sequence = Cell->Sequence.load(std::memory_order_acquire);
+			const Int64 Difference = static_cast<Int64>(Sequence) - static_cast<Int64>(Pos);
+
+			if (Difference == 0)
+			{
+				if (EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (Difference < 0)
+			{
+				return false;
+			}
+			else
+			{
+				Pos = EnqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		Cell->Item = Item;
+		Cell->Sequence.store(Pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	template <class T, SizeT Capacity>
+	const T* TMPSCRingBuffer<T, Capacity>::Peek() const
+	{
+		const FCell& Cell = Cells[DequeuePos & IndexMask];
+		const SizeT Sequence = Cell.Sequence.load(std::memory_order_acquire);
+
+		const bool IsPublished = Sequence == DequeuePos + 1;
+		if (!IsPublished)
+		{
+			return nullptr;
+		}
+
+		return &Cell.Item;
+	}
+
+	template <class T, SizeT Capacity>
+	void TMPSCRingBuffer<T, Capacity>::Pop()
+	{
+		FCell& Cell = Cells[DequeuePos & IndexMask];
+		F_Assert(Cell.Sequence.load(std::memory_order_relaxed) == DequeuePos + 1, "Pop was called on an empty slot.");
+
+		Cell.Sequence.store(DequeuePos + Capacity, std::memory_order_release);
+		++DequeuePos;
+	}
+
+	template <class T, SizeT Capacity>
+	bool TMPSCRingBuffer<T, Capacity>::TryPop(T& OutItem)
+	{
+		FCell& Cell = Cells[DequeuePos & IndexMask];
+		const SizeT Sequence = Cell.Sequence.load(std::memory_order_acquire);
+
+		if (Sequence != DequeuePos + 1)
+		{
+			return false;
+		}
+
+		OutItem = std::move(Cell.Item);
+		Cell.Sequence.store(DequeuePos + Capacity, std::memory_order_release);
+		++DequeuePos;
+		return true;
+	}
+
+	template <class T, SizeT Capacity>
+	template <class TPredicate, class TFunction>
+	SizeT TMPSCRingBuffer<T, Capacity>::PopWhile(const TPredicate& Predicate, const TFunction& Function)
+	{
+		SizeT PoppedCount = 0;
+
+		while (const T* const Item = Peek())
+		{
+			if (!Predicate(*Item))
+			{
+				break;
+			}
+
+			Function(*Item);
+			Pop();
+			++PoppedCount;
+		}
+
+		return PoppedCount;
+	}
+
+	template <class T, SizeT Capacity>
+	SizeT TMPSCRingBuffer<T, Capacity>::GetSizeApprox() const
+	{
+		const SizeT LocalEnqueuePos = EnqueuePos.load(std::memory_order_relaxed);
+		const SizeT Size = LocalEnqueuePos >= DequeuePos ? LocalEnqueuePos - DequeuePos : 0;
+		return Size;
+	}
+
+	template <class T, SizeT Capacity>
+	constexpr SizeT TMPSCRingBuffer<T, Capacity>::GetCapacity()
+	{
+		return Capacity;
+	}
+}
+
+#endif
@@ -21,6 +21,13 @@ namespace Phoenix
 			std::this_thread::sleep_for(Duration);
 		}
 
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gives up the rest of the thread's time slice. */
+		static inline void YieldThread()
+		{
+			std::this_thread::yield();
+		}
+
 		//	--------------------------------------------------------------------------------
 		/*! \brief Returns the thread id of the thread that this function runs on. */
 		static inline FThreadID GetCallingThreadID()
@@ -0,0 +1,142 @@
+#ifndef PHOENIX_TRIPLE_BUFFER_H
+#define PHOENIX_TRIPLE_BUFFER_H
+
+#include "Utility/Containers/Array.h"
+#include "Utility/Debug/Assert.h"
+#include "Utility/Misc/Memory.h"
+#include "Utility/Misc/Primitives.h"
+#include "Utility/Threading/Atomic.h"
+
+namespace Phoenix
+{
+	//	--------------------------------------------------------------------------------
+	/*! \brief Hands the latest value from a single producer to a single consumer without waiting.
+	*
+	*	@desc The producer writes into its own back buffer and publishes it with one atomic
+	*		exchange.  The consumer swaps in the newest published buffer when it wants one.
+	*		If the producer publishes again before the consumer swaps, the older value is
+	*		dropped instead of either side blocking.
+	*	@note GetWriteBuffer and Publish must only be called from the producer thread.
+	*		Acquire and GetReadBuffer must only be called from the consumer thread.
+	*/
+	template <class T>
+	class TTripleBuffer
+	{
+	public:
+		TTripleBuffer();
+
+		TTripleBuffer(const TTripleBuffer&) = delete;
+		TTripleBuffer& operator=(const TTripleBuffer&) = delete;
+
+		TTripleBuffer(TTripleBuffer&&) = delete;
+		TTripleBuffer& operator=(TTripleBuffer&&) = delete;
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the buffer the producer fills in before publishing.
+		*
+		*	@note Producer thread only.  It still holds whatever was written into it last.
+		*/
+		T& GetWriteBuffer();
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Makes the write buffer the latest value and takes over a free buffer.
+		*
+		*	@note Producer thread only.
+		*/
+		void Publish();
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Swaps the newest published value into the read buffer.
+		*
+		*	@return Returns true if a value was published since the last acquire.
+		*	@note Consumer thread only.
+		*/
+		bool Acquire();
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the buffer holding the most recently acquired value.
+		*
+		*	@note Consumer thread only.
+		*/
+		T& GetReadBuffer();
+
+		//	--------------------------------------------------------------------------------
+		/*! \brief Gets the number of published values that were replaced before they were acquired.
+		*
+		*	@note Producer thread only.
+		*/
+		UInt32 GetDroppedCount() const;
+
+	private:
+		static const UInt8 IndexMask = 0x3;
+		static const UInt8 NewBit = 0x4;
+		static const SizeT CacheLineSize = 64;
+
+		TArray<TUniquePtr<T>, 3> Buffers;
+
+		/*! \brief Index of the published buffer, plus NewBit if it hasn't been acquired yet. */
+		TAtomic<UInt8> Middle{ 1 };
+
+		// The producer and consumer indices are each only touched by their own thread.
+		UInt8 ProducerPadding[CacheLineSize];
+		UInt8 Back{ 0 };
+		UInt32 DroppedCount{ 0 };
+		UInt8 ConsumerPadding[CacheLineSize];
+		UInt8 Front{ 2 };
+	};
+
+	template <class T>
+	TTripleBuffer<T>::TTripleBuffer()
+	{
+		for (auto& Buffer : Buffers)
+		{
+			Buffer = std::make_unique<T>();
+		}
+	}
+
+	template <class T>
+	T& TTripleBuffer<T>::GetWriteBuffer()
+	{
+		return *Buffers[Back];
+	}
+
+	template <class T>
+	void TTripleBuffer<T>::Publish()
+	{
+		const UInt8 Previous = Middle.exchange(Back | NewBit, std::memory_order_acq_rel);
+
+		const bool WasDropped = (Previous & NewBit) != 0;
+		DroppedCount += WasDropped ? 1 : 0;
+
+		Back = Previous & IndexMask;
+	}
+
+	template <class T>
+	bool TTripleBuffer<T>::Acquire()
+	{
+		if ((Middle.load(std::memory_order_relaxed) & NewBit) == 0)
+		{
+			return false;
+		}
+
+		const UInt8 Previous = Middle.exchange(Front, std::memory_order_acq_rel);
+		F_Assert(Previous & NewBit, "Only the consumer may clear the new bit.");
+
+		Front = Previous & IndexMask;
+		return true;
+	}
+
+	template <class T>
+	T& TTripleBuffer<T>::GetReadBuffer()
+	{
+		return *Buffers[Front];
+	}
+
+	template <class T>
+	UInt32 TTripleBuffer<T>::GetDroppedCount() const
+	{
+		return DroppedCount;
+	}
+}
+
+#endif
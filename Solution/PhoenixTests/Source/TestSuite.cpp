@@ -1,7 +1,13 @@
 #include "TestSuite.h"
+#include "Tests/Containers/ContainersTest.h"
 #include "Tests/ECS/ECSTest.h"
+#include "Tests/Handle/HandleTest.h"
+#include "Tests/Memory/MemoryTest.h"
 #include "Tests/MetaProgramming/MetaProgrammingTest.h"
+#include "Tests/Name/NameTest.h"
+#include "Tests/Rendering/RenderingTest.h"
 #include "Tests/Serialization/SerializationTest.h"
+#include "Tests/Threading/ThreadingTest.h"
 
 void Phoenix::FTestSuite::RunTests() const
 {
@@ -13,4 +19,22 @@ void Phoenix::FTestSuite::RunTests() const
 
 	FECSTest ECSTest;
 	ECSTest.RunTests();
+
+	FThreadingTest ThreadingTest;
+	ThreadingTest.RunTests();
+
+	FMemoryTest MemoryTest;
+	MemoryTest.RunTests();
+
+	FNameTest NameTest;
+	NameTest.RunTests();
+
+	FContainersTest ContainersTest;
+	ContainersTest.RunTests();
+
+	FHandleTest HandleTest;
+	HandleTest.RunTests();
+
+	FRenderingTest RenderingTest;
+	RenderingTest.RunTests();
 }
@@ -0,0 +1,506 @@
+#include "Tests/Containers/ContainersTest.h"
+
+#include <chrono>
+
+#include "Utility/Containers/Array.h"
+#include "Utility/Containers/FlatHashMap.h"
+#include "Utility/Containers/FlatHashSet.h"
+#include "Utility/Containers/InlineVector.h"
+#include "Utility/Containers/UnorderedMap.h"
+#include "Utility/Containers/Vector.h"
+#include "Utility/Debug/Assert.h"
+#include "Utility/Debug/Debug.h"
+#include "Utility/Misc/Function.h"
+#include "Utility/Misc/Memory.h"
+#include "Utility/Misc/Primitives.h"
+#include "Utility/Misc/String.h"
+
+using namespace Phoenix;
+
+void FContainersTest::RunTests() const
+{
+	TestFlatHashMap();
+	TestFlatHashSet();
+	TestInlineVector();
+	TestInlineFunction();
+}
+
+void FContainersTest::TestFlatHashMap() const
+{
+	FlatHashMapBasicTests();
+	FlatHashMapEraseTests();
+	FlatHashMapGrowthTests();
+	FlatHashMapHeterogeneousTests();
+	FlatHashMapMoveOnlyTests();
+	FlatHashMapBenchmark();
+}
+
+void FContainersTest::FlatHashMapBasicTests() const
+{
+	TFlatHashMap<UInt32, UInt32> Map;
+	F_AssertTrue(Map.empty(), "Map should start empty.");
+	F_AssertEqual(Map.bucket_count(), 0, "An empty map should not allocate.");
+	F_AssertTrue(Map.find(1) == Map.end(), "An empty map should find nothing.");
+
+	F_AssertTrue(Map.emplace(1, 10).second, "Key should be inserted.");
+	F_AssertTrue(Map.insert(std::make_pair(2, 20)).second, "Key should be inserted.");
+	F_AssertTrue(!Map.emplace(1, 11).second, "Duplicate keys should be rejected.");
+	F_AssertEqual(Map.at(1), 10, "Duplicate insert should not overwrite.");
+
+	Map[3] = 30;
+	F_AssertEqual(Map[3], 30, "operator[] should insert.");
+	F_AssertEqual(Map.size(), 3, "Map size is incorrect.");
+
+	F_AssertTrue(!Map.insert_or_assign(1, 12).second, "Existing key should be assigned.");
+	F_AssertEqual(Map.at(1), 12, "insert_or_assign should overwrite.");
+
+	F_AssertTrue(!Map.try_emplace(2, 99).second, "try_emplace should not overwrite.");
+	F_AssertEqual(Map.at(2), 20, "try_emplace should not overwrite.");
+
+	UInt32 KeySum = 0;
+	UInt32 ValueSum = 0;
+	for (const auto& Pair : Map)
+	{
+		KeySum += Pair.first;
+		ValueSum += Pair.second;
+	}
+
+	F_AssertEqual(KeySum, 6, "Iteration should visit every key once.");
+	F_AssertEqual(ValueSum, 62, "Iteration should visit every value once.");
+
+	const TFlatHashMap<UInt32, UInt32> Copy = Map;
+	F_AssertEqual(Copy.size(), Map.size(), "Copy size is incorrect.");
+	F_AssertEqual(Copy.at(3), 30, "Copy should hold the same values.");
+
+	TFlatHashMap<UInt32, UInt32> Moved = std::move(Map);
+	F_AssertEqual(Moved.size(), 3, "Moved map size is incorrect.");
+	F_AssertTrue(Map.empty(), "Moved from map should be empty.");
+
+	Moved.clear();
+	F_AssertTrue(Moved.empty(), "Cleared map should be empty.");
+	F_AssertTrue(Moved.bucket_count() > 0, "Clearing should keep the capacity.");
+	F_AssertTrue(Moved.begin() == Moved.end(), "Cleared map should have nothing to iterate.");
+}
+
+void FContainersTest::FlatHashMapEraseTests() const
+{
+	const UInt32 KeyCount = 1000;
+
+	TFlatHashMap<UInt32, UInt32> Map;
+	for (UInt32 I = 0; I < KeyCount; ++I)
+	{
+		Map.emplace(I, I * 2);
+	}
+
+	for (auto Iter = Map.begin(); Iter != Map.end();)
+	{
+		if (Iter->first % 2)
+		{
+			Iter = Map.erase(Iter);
+		}
+		else
+		{
+			++Iter;
+		}
+	}
+
+	F_AssertEqual(Map.size(), KeyCount / 2, "Half of the keys should be erased.");
+	F_AssertEqual(Map.erase(0), 1, "Key should be erased.");
+	F_AssertEqual(Map.erase(0), 0, "Key should already be erased.");
+	F_AssertEqual(Map.count(1), 0, "Erased keys should not be found.");
+	F_AssertEqual(Map.at(2), 4, "Remaining keys should keep their values.");
+
+	// Churning a fixed number of keys should reuse tombstones rather than grow.
+	const SizeT BucketCount = Map.bucket_count();
+	for (UInt32 Round = 0; Round < 100; ++Round)
+	{
+		for (UInt32 I = 1; I < KeyCount; I += 2)
+		{
+			Map.emplace(I + Round * KeyCount, I);
+		}
+
+		for (UInt32 I = 1; I < KeyCount; I += 2)
+		{
+			Map.erase(I + Round * KeyCount);
+		}
+	}
+
+	F_AssertEqual(Map.size(), KeyCount / 2 - 1, "Churn should leave the size unchanged.");
+	F_AssertEqual(Map.bucket_count(), BucketCount, "Churn should not grow the table.");
+
+	for (UInt32 I = 2; I < KeyCount; I += 2)
+	{
+		F_AssertEqual(Map.at(I), I * 2, "Churn should not disturb the remaining keys.");
+	}
+}
+
+void FContainersTest::FlatHashMapGrowthTests() const
+{
+	const UInt32 KeyCount = 100000;
+
+	TFlatHashMap<UInt32, UInt32> Map;
+	Map.reserve(KeyCount);
+
+	const SizeT BucketCount = Map.bucket_count();
+	F_AssertTrue(BucketCount >= KeyCount, "Reserve should allocate enough buckets.");
+
+	for (UInt32 I = 0; I < KeyCount; ++I)
+	{
+		Map.emplace(I, I);
+	}
+
+	F_AssertEqual(Map.bucket_count(), BucketCount, "Reserved inserts should not rehash.");
+	F_AssertTrue(Map.load_factor() <= Map.max_load_factor(), "Load factor is too high.");
+
+	TFlatHashMap<UInt32, UInt32> Grown;
+	for (UInt32 I = 0; I < KeyCount; ++I)
+	{
+		Grown.emplace(I * 16, I);
+	}
+
+	F_AssertEqual(Grown.size(), KeyCount, "Grown map size is incorrect.");
+	for (UInt32 I = 0; I < KeyCount; ++I)
+	{
+		F_AssertEqual(Grown.at(I * 16), I, "Growth should keep every key.");
+	}
+}
+
+void FContainersTest::FlatHashMapHeterogeneousTests() const
+{
+	TFlatHashMap<FString, UInt32, FStringHash, FStringEqual> Map;
+	Map.emplace("Default.png", 1);
+	Map.emplace(FString("Golem.png"), 2);
+
+	const FChar* const Key = "Golem.png";
+	F_AssertTrue(Map.find(Key) != Map.end(), "FChar* lookups should find FString keys.");
+	F_AssertEqual(Map.at(Key), 2, "FChar* lookups should find FString keys.");
+	F_AssertTrue(Map.contains("Default.png"), "String literals should find FString keys.");
+	F_AssertTrue(!Map.contains("Missing.png"), "Missing keys should not be found.");
+
+	F_AssertEqual(Map.erase("Default.png"), 1, "FChar* erase should remove FString keys.");
+	F_AssertEqual(Map.size(), 1, "Map size is incorrect.");
+}
+
+void FContainersTest::FlatHashMapMoveOnlyTests() const
+{
+	const UInt32 KeyCount = 100;
+
+	TFlatHashMap<UInt32, TUniquePtr<UInt32>> Map;
+	for (UInt32 I = 0; I < KeyCount; ++I)
+	{
+		Map.try_emplace(I, new UInt32(I));
+	}
+
+	F_AssertEqual(Map.size(), KeyCount, "Map size is incorrect.");
+	for (UInt32 I = 0; I < KeyCount; ++I)
+	{
+		F_AssertEqual(*Map.at(I), I, "Move only values should survive growth.");
+	}
+
+	Map[KeyCount].reset(new UInt32(KeyCount));
+	F_AssertEqual(*Map.at(KeyCount), KeyCount, "operator[] should default construct the value.");
+}
+
+void FContainersTest::FlatHashMapBenchmark() const
+{
+	typedef std::chrono::high_resolution_clock ClockT;
+
+	const UInt64 KeyCount = 100000;
+	const UInt64 LookupCount = 1000000;
+	const SizeT IterationCount = 100;
+
+	TVector<UInt64> Keys;
+	Keys.reserve(KeyCount);
+	for (UInt64 I = 0; I < KeyCount; ++I)
+	{
+		Keys.push_back(I * 2654435761ull);
+	}
+
+	TFlatHashMap<UInt64, UInt64> FlatMap;
+	TUnorderedMap<UInt64, UInt64> StdMap;
+
+	const auto FlatInsertStart = ClockT::now();
+	for (const UInt64 Key : Keys)
+	{
+		FlatMap.emplace(Key, Key);
+	}
+	const auto FlatInsertEnd = ClockT::now();
+
+	const auto StdInsertStart = ClockT::now();
+	for (const UInt64 Key : Keys)
+	{
+		StdMap.emplace(Key, Key);
+	}
+	const auto StdInsertEnd = ClockT::now();
+
+	// Keys are looked up out of insertion order, since TUnorderedMap's nodes sit in memory
+	// in that order.  Every other lookup misses, since odd keys are never inserted.
+	const auto GetLookupKey = [&Keys, KeyCount](const UInt64 I)
+	{
+		return Keys[(I * 7919) % KeyCount] + (I & 1);
+	};
+
+	UInt64 FlatLookupSum = 0;
+	const auto FlatLookupStart = ClockT::now();
+	for (UInt64 I = 0; I < LookupCount; ++I)
+	{
+		const auto Iter = FlatMap.find(GetLookupKey(I));
+		FlatLookupSum += Iter != FlatMap.end() ? Iter->second : 0;
+	}
+	const auto FlatLookupEnd = ClockT::now();
+
+	UInt64 StdLookupSum = 0;
+	const auto StdLookupStart = ClockT::now();
+	for (UInt64 I = 0; I < LookupCount; ++I)
+	{
+		const auto Iter = StdMap.find(GetLookupKey(I));
+		StdLookupSum += Iter != StdMap.end() ? Iter->second : 0;
+	}
+	const auto StdLookupEnd = ClockT::now();
+
+	UInt64 FlatIterationSum = 0;
+	const auto FlatIterationStart = ClockT::now();
+	for (SizeT I = 0; I < IterationCount; ++I)
+	{
+		for (const auto& Pair : FlatMap)
+		{
+			FlatIterationSum += Pair.second;
+		}
+	}
+	const auto FlatIterationEnd = ClockT::now();
+
+	UInt64 StdIterationSum = 0;
+	const auto StdIterationStart = ClockT::now();
+	for (SizeT I = 0; I < IterationCount; ++I)
+	{
+		for (const auto& Pair : StdMap)
+		{
+			StdIterationSum += Pair.second;
+		}
+	}
+	const auto StdIterationEnd = ClockT::now();
+
+	F_AssertEqual(FlatLookupSum, StdLookupSum, "Both maps should find the same keys.");
+	F_AssertEqual(FlatIterationSum, StdIterationSum, "Both maps should hold the same values.");
+
+	const auto ToMS = [](const ClockT::duration Duration)
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(Duration).count();
+	};
+
+	F_Log("Hash map inserts (" << KeyCount << "): TFlatHashMap " << ToMS(FlatInsertEnd - FlatInsertStart)
+		<< "ms vs TUnorderedMap: " << ToMS(StdInsertEnd - StdInsertStart) << "ms");
+	F_Log("Hash map lookups (" << LookupCount << "): TFlatHashMap " << ToMS(FlatLookupEnd - FlatLookupStart)
+		<< "ms vs TUnorderedMap: " << ToMS(StdLookupEnd - StdLookupStart) << "ms");
+	F_Log("Hash map iteration (" << IterationCount << "x" << KeyCount << "): TFlatHashMap "
+		<< ToMS(FlatIterationEnd - FlatIterationStart) << "ms vs TUnorderedMap: "
+		<< ToMS(StdIterationEnd - StdIterationStart) << "ms");
+}
+
+void FContainersTest::TestFlatHashSet() const
+{
+	FlatHashSetBasicTests();
+}
+
+void FContainersTest::FlatHashSetBasicTests() const
+{
+	TFlatHashSet<UInt32> Set = { 1, 2, 3 };
+	F_AssertEqual(Set.size(), 3, "Set size is incorrect.");
+	F_AssertTrue(Set.contains(2), "Set should contain its values.");
+	F_AssertTrue(!Set.insert(2).second, "Duplicate values should be rejected.");
+
+	F_AssertEqual(Set.erase(2), 1, "Value should be erased.");
+	F_AssertTrue(!Set.contains(2), "Erased values should not be found.");
+	F_AssertTrue(Set.insert(2).second, "Erased values should be insertable again.");
+
+	UInt32 Sum = 0;
+	for (const UInt32 Value : Set)
+	{
+		Sum += Value;
+	}
+
+	F_AssertEqual(Sum, 6, "Iteration should visit every value once.");
+}
+
+void FContainersTest::TestInlineVector() const
+{
+	InlineVectorBasicTests();
+	InlineVectorSpillTests();
+}
+
+void FContainersTest::InlineVectorBasicTests() const
+{
+	TInlineVector<UInt32, 4> Vector;
+	F_AssertTrue(Vector.empty(), "Vector should start empty.");
+	F_AssertEqual(Vector.capacity(), 4, "Capacity should start at the inline capacity.");
+	F_AssertTrue(Vector.IsInline(), "Vector should start inline.");
+
+	Vector.push_back(1);
+	Vector.emplace_back(2);
+	Vector.push_back(3);
+	F_AssertEqual(Vector.size(), 3, "Vector size is incorrect.");
+	F_AssertEqual(Vector.front(), 1, "Front is incorrect.");
+	F_AssertEqual(Vector.back(), 3, "Back is incorrect.");
+	F_AssertTrue(Vector.IsInline(), "Vector should still be inline.");
+
+	Vector.erase(Vector.begin());
+	F_AssertEqual(Vector.size(), 2, "Vector size is incorrect.");
+	F_AssertEqual(Vector[0], 2, "Erase should shift later elements down.");
+
+	Vector.pop_back();
+	F_AssertEqual(Vector.size(), 1, "Vector size is incorrect.");
+
+	Vector.resize(4, 7);
+	F_AssertEqual(Vector[3], 7, "Resize should fill new elements.");
+
+	const TInlineVector<UInt32, 4> Copy = Vector;
+	F_AssertTrue(Copy == Vector, "Copy should equal the original.");
+
+	TInlineVector<TUniquePtr<UInt32>, 2> MoveOnly;
+	MoveOnly.emplace_back(new UInt32(5));
+
+	const TInlineVector<TUniquePtr<UInt32>, 2> Moved = std::move(MoveOnly);
+	F_AssertEqual(*Moved[0], 5, "Moved elements should survive.");
+	F_AssertTrue(MoveOnly.empty(), "Moved from vector should be empty.");
+}
+
+void FContainersTest::InlineVectorSpillTests() const
+{
+	const UInt32 ElementCount = 100;
+
+	TInlineVector<FString, 4> Vector;
+	for (UInt32 I = 0; I < ElementCount; ++I)
+	{
+		Vector.push_back(std::to_string(I));
+	}
+
+	F_AssertTrue(!Vector.IsInline(), "Vector should have spilled to the heap.");
+	F_AssertEqual(Vector.size(), ElementCount, "Vector size is incorrect.");
+	for (UInt32 I = 0; I < ElementCount; ++I)
+	{
+		F_AssertEqual(Vector[I], std::to_string(I), "Spilling should keep every element.");
+	}
+
+	// The pushed element refers to the vector's own storage, which moves while growing.
+	Vector.resize(Vector.capacity());
+	Vector.push_back(Vector[0]);
+	F_AssertEqual(Vector.back(), "0", "Pushing an element of the vector itself should copy it.");
+
+	const TInlineVector<FString, 4> Moved = std::move(Vector);
+	F_AssertTrue(!Moved.IsInline(), "Moving should take over the heap buffer.");
+	F_AssertTrue(Vector.IsInline() && Vector.empty(), "Moved from vector should be empty and inline.");
+}
+
+void FContainersTest::TestInlineFunction() const
+{
+	InlineFunctionBasicTests();
+	InlineFunctionBenchmark();
+}
+
+void FContainersTest::InlineFunctionBasicTests() const
+{
+	UInt32 Total = 0;
+
+	TInlineFunction<void(UInt32)> Add = [&Total](const UInt32 Value)
+	{
+		Total += Value;
+	};
+
+	F_AssertTrue(Add, "Function should be set.");
+	F_AssertTrue(Add.IsInline(), "Small captures should be stored inline.");
+
+	Add(2);
+	Add(3);
+	F_AssertEqual(Total, 5, "Function should be called.");
+
+	TArray<UInt64, 16> Large;
+	Large.fill(1);
+
+	const TInlineFunction<UInt64()> Sum = [Large]()
+	{
+		UInt64 Result = 0;
+		for (const UInt64 Value : Large)
+		{
+			Result += Value;
+		}
+
+		return Result;
+	};
+
+	F_AssertTrue(!Sum.IsInline(), "Large captures should be stored on the heap.");
+	F_AssertEqual(Sum(), 16, "Heap stored functions should be called.");
+
+	TUniquePtr<UInt32> Value(new UInt32(7));
+	TInlineFunction<UInt32()> GetValue = [Value = std::move(Value)]()
+	{
+		return *Value;
+	};
+
+	TInlineFunction<UInt32()> MovedGetValue = std::move(GetValue);
+	F_AssertTrue(!GetValue, "Moved from function should be empty.");
+	F_AssertEqual(MovedGetValue(), 7, "Move only captures should survive a move.");
+
+	MovedGetValue = nullptr;
+	F_AssertTrue(!MovedGetValue, "Assigning null should clear the function.");
+}
+
+void FContainersTest::InlineFunctionBenchmark() const
+{
+	typedef std::chrono::high_resolution_clock ClockT;
+
+	const SizeT TaskCount = 1000000;
+
+	// The same size of capture as the async load tasks, a pointer and a name.
+	UInt64 Total = 0;
+	const UInt64 Value = 1;
+
+	TVector<TFunction<void()>> Functions;
+	Functions.reserve(TaskCount);
+
+	const auto FunctionStart = ClockT::now();
+	for (SizeT I = 0; I < TaskCount; ++I)
+	{
+		Functions.emplace_back([&Total, Value, I]()
+		{
+			Total += Value + I;
+		});
+	}
+
+	for (const auto& Function : Functions)
+	{
+		Function();
+	}
+
+	Functions.clear();
+	const auto FunctionEnd = ClockT::now();
+
+	const UInt64 FunctionTotal = Total;
+	Total = 0;
+
+	TVector<TInlineFunction<void()>> InlineFunctions;
+	InlineFunctions.reserve(TaskCount);
+
+	const auto InlineStart = ClockT::now();
+	for (SizeT I = 0; I < TaskCount; ++I)
+	{
+		InlineFunctions.emplace_back([&Total, Value, I]()
+		{
+			Total += Value + I;
+		});
+	}
+
+	for (const auto& Function : InlineFunctions)
+	{
+		Function();
+	}
+
+	InlineFunctions.clear();
+	const auto InlineEnd = ClockT::now();
+
+	F_AssertEqual(Total, FunctionTotal, "Both functions should do the same work.");
+
+	const auto FunctionMS = std::chrono::duration_cast<std::chrono::milliseconds>(FunctionEnd - FunctionStart).count();
+	const auto InlineMS = std::chrono::duration_cast<std::chrono::milliseconds>(InlineEnd - InlineStart).count();
+
+	F_Log("Task functions (" << TaskCount << "): TInlineFunction " << InlineMS << "ms vs TFunction: " << FunctionMS << "ms");
+}
@@ -0,0 +1,37 @@
+#ifndef PHOENIX_CONTAINERS_TEST_H
+#define PHOENIX_CONTAINERS_TEST_H
+
+namespace Phoenix
+{
+	class FContainersTest
+	{
+	public:
+		void RunTests() const;
+
+	private:
+		void TestFlatHashMap() const;
+
+		void FlatHashMapBasicTests() const;
+		void FlatHashMapEraseTests() const;
+		void FlatHashMapGrowthTests() const;
+		void FlatHashMapHeterogeneousTests() const;
+		void FlatHashMapMoveOnlyTests() const;
+		void FlatHashMapBenchmark() const;
+
+		void TestFlatHashSet() const;
+
+		void FlatHashSetBasicTests() const;
+
+		void TestInlineVector() const;
+
+		void InlineVectorBasicTests() const;
+		void InlineVectorSpillTests() const;
+
+		void TestInlineFunction() const;
+
+		void InlineFunctionBasicTests() const;
+		void InlineFunctionBenchmark() const;
+	};
+}
+
+#endif
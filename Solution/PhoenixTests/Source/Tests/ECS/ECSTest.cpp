@@ -4,6 +4,7 @@
 #include "ECS/ComponentManagerConfig.h"
 #include "ECS/RequirementBitArrayStorage.h"
 #include "Math/Vector3D.h"
+#include "Utility/Containers/FrameVector.h"
 #include "Utility/Debug/Assert.h"
 #include "Utility/MetaProgramming/TypeList.h"
 
@@ -39,6 +40,30 @@ namespace ECSTestStructs
 	using SystemList = TTypeList<System0>;
 
 	using Config = TComponentManagerConfig<ComponentList, TagList, RequirementList, SystemList>;
+
+	struct SBatchedCreation
+	{
+		SizeT CallCount{ 0 };
+		SizeT EntityCount{ 0 };
+
+		template<typename TComponentManager>
+		void OnEntitiesCreated(const TFrameVector<SizeT>& NewEntityList, TComponentManager&)
+		{
+			++CallCount;
+			EntityCount += NewEntityList.size();
+		}
+	};
+
+	struct SSingleCreation
+	{
+		SizeT CallCount{ 0 };
+
+		template<typename TComponentManager>
+		void OnEntityCreated(SizeT, TComponentManager&)
+		{
+			++CallCount;
+		}
+	};
 }
 
 void FECSTest::RunTests() const
@@ -72,6 +97,7 @@ void FECSTest::TestComponentManager() const
 	ManagerBasicTests();
 	ManagerKillTests();
 	ManagerComponentTests();
+	ManagerCreationTests();
 }
 
 void FECSTest::ManagerBasicTests() const
@@ -327,3 +353,28 @@ void FECSTest::ManagerComponentTests() const
 	CRigidBody& Rigidbody2 = ComponentManager.GetComponent<CRigidBody>(Entity3);
 	F_AssertEqual(Rigidbody2.Velocity, FVector3D(3.0f, 3.0f, 3.0f), "Component data incorrect");
 }
+
+void FECSTest::ManagerCreationTests() const
+{
+	using namespace ECSTestStructs;
+
+	using CreationSystemList = TTypeList<SBatchedCreation, SSingleCreation>;
+	using CreationConfig = TComponentManagerConfig<ComponentList, TagList, RequirementList, CreationSystemList>;
+
+	TComponentManager<CreationConfig> ComponentManager;
+
+	const SizeT EntityCount = 5;
+	for (SizeT I = 0; I < EntityCount; ++I)
+	{
+		ComponentManager.CreateEntity();
+	}
+
+	ComponentManager.Refresh();
+
+	const SBatchedCreation& Batched = ComponentManager.GetSystem<SBatchedCreation>();
+	F_AssertEqual(Batched.CallCount, 1, "Batched systems should hear about new entities once per refresh");
+	F_AssertEqual(Batched.EntityCount, EntityCount, "Batched systems should receive every new entity");
+
+	const SSingleCreation& Single = ComponentManager.GetSystem<SSingleCreation>();
+	F_AssertEqual(Single.CallCount, EntityCount, "Other systems should hear about each new entity");
+}
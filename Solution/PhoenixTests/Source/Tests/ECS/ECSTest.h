@@ -15,6 +15,7 @@ namespace Phoenix
 		void ManagerBasicTests() const;
 		void ManagerKillTests() const;
 		void ManagerComponentTests() const;
+		void ManagerCreationTests() const;
 	};
 }
 
@@ -0,0 +1,439 @@
+#include "Tests/Handle/HandleTest.h"
+
+#include <chrono>
+
+#include "Utility/Containers/Vector.h"
+#include "Utility/Debug/Assert.h"
+#include "Utility/Debug/Debug.h"
+#include "Utility/Handle/Handle.h"
+#include "Utility/Handle/Handles.h"
+#include "Utility/Handle/WeakHandle.h"
+#include "Utility/Misc/Primitives.h"
+#include "Utility/Threading/Atomic.h"
+#include "Utility/Threading/Thread.h"
+#include "Rendering/GFXScene.h"
+#include "Rendering/Model/ModelInstance.h"
+
+using namespace Phoenix;
+
+namespace HandleTestStructs
+{
+	struct FCopyCounter
+	{
+		static SizeT CopyCount;
+		static SizeT MoveCount;
+
+		UInt32 Value{ 0 };
+
+		FCopyCounter() = default;
+
+		explicit FCopyCounter(const UInt32 InValue)
+			: Value(InValue)
+		{
+		}
+
+		FCopyCounter(const FCopyCounter& RHS)
+			: Value(RHS.Value)
+		{
+			++CopyCount;
+		}
+
+		FCopyCounter& operator=(const FCopyCounter& RHS)
+		{
+			Value = RHS.Value;
+			++CopyCount;
+			return *this;
+		}
+
+		FCopyCounter(FCopyCounter&& RHS)
+			: Value(RHS.Value)
+		{
+			++MoveCount;
+		}
+
+		FCopyCounter& operator=(FCopyCounter&& RHS)
+		{
+			Value = RHS.Value;
+			++MoveCount;
+			return *this;
+		}
+	};
+
+	SizeT FCopyCounter::CopyCount = 0;
+	SizeT FCopyCounter::MoveCount = 0;
+}
+
+using namespace HandleTestStructs;
+
+void FHandleTest::RunTests() const
+{
+	TestHandles();
+}
+
+void FHandleTest::TestHandles() const
+{
+	HandlesBasicTests();
+	HandlesReleaseTests();
+	HandlesGenerationTests();
+	HandlesThreadSafeTests();
+	HandlesBulkTests();
+	HandlesBenchmark();
+}
+
+void FHandleTest::HandlesBasicTests() const
+{
+	THandles<UInt32> Handles;
+	F_AssertEqual(Handles.GetDataSize(), 0, "Handles should start empty.");
+
+	THandle<UInt32> First = Handles.CreateHandle(10u);
+	F_AssertTrue(First.IsValid(), "Created handles should be valid.");
+	F_AssertEqual(*First, 10, "Handle should see the value it was created with.");
+	F_AssertEqual(First.GetRefCount(), 1, "A new handle should hold one reference.");
+
+	{
+		THandle<UInt32> Copy = First;
+		F_AssertEqual(First.GetRefCount(), 2, "Copies should add a reference.");
+
+		THandle<UInt32> Moved = std::move(Copy);
+		F_AssertTrue(!Copy.IsValid(), "Moved from handles should be invalid.");
+		F_AssertEqual(Moved.GetRefCount(), 2, "Moves should not add a reference.");
+	}
+
+	F_AssertEqual(First.GetRefCount(), 1, "Destroyed copies should drop their reference.");
+	F_AssertEqual(Handles.GetDataSize(), 1, "Data should live while a reference remains.");
+
+	First.DeInit();
+	F_AssertTrue(!First.IsValid(), "Released handles should be invalid.");
+	F_AssertEqual(Handles.GetDataSize(), 0, "Data should be removed with its last reference.");
+
+	THandle<UInt32> Reused = Handles.CreateHandle(20u);
+	F_AssertEqual(*Reused, 20, "Handles that reuse a slot should see their own value.");
+	F_AssertEqual(Handles.GetDataSize(), 1, "Data size is incorrect.");
+}
+
+void FHandleTest::HandlesReleaseTests() const
+{
+	const UInt32 HandleCount = 64;
+
+	THandles<UInt32> Handles;
+	TVector<THandle<UInt32>> Items;
+
+	for (UInt32 I = 0; I < HandleCount; ++I)
+	{
+		Items.push_back(Handles.CreateHandle(I));
+	}
+
+	F_AssertEqual(Handles.GetRevision(), 0, "Creating items shouldn't change the revision.");
+
+	// Release from the front, back and middle, so that both the swap-remove and the plain
+	// pop paths run, then check every surviving handle still sees its own value.
+	const UInt32 ReleaseOrder[] = { 0, 63, 31, 1, 62, 32, 17, 45 };
+	for (const UInt32 Index : ReleaseOrder)
+	{
+		Items[Index].DeInit();
+	}
+
+	F_AssertEqual(Handles.GetDataSize(), HandleCount - 8, "Data size is incorrect.");
+	F_AssertEqual(Handles.GetRevision(), 8, "Every release should change the revision.");
+	for (UInt32 I = 0; I < HandleCount; ++I)
+	{
+		if (Items[I].IsValid())
+		{
+			F_AssertEqual(*Items[I], I, "Handle lost track of its data after a swap-remove.");
+		}
+	}
+
+	// Refill the freed slots and release again in a different order.
+	for (const UInt32 Index : ReleaseOrder)
+	{
+		Items[Index] = Handles.CreateHandle(Index);
+	}
+
+	for (UInt32 I = 0; I < HandleCount; I += 3)
+	{
+		Items[I].DeInit();
+	}
+
+	for (UInt32 I = 0; I < HandleCount; ++I)
+	{
+		if (Items[I].IsValid())
+		{
+			F_AssertEqual(*Items[I], I, "Handle lost track of its data after reuse.");
+		}
+	}
+
+	Items.clear();
+	F_AssertEqual(Handles.GetDataSize(), 0, "Every element should be released.");
+}
+
+void FHandleTest::HandlesGenerationTests() const
+{
+	THandles<UInt32> Handles;
+
+	THandle<UInt32> First = Handles.CreateHandle(10u);
+	TWeakHandle<UInt32> Weak = First;
+	const UInt32 FirstGeneration = First.GetGeneration();
+
+	F_AssertTrue(Weak.IsValid(), "Weak handles to live items should be valid.");
+	F_AssertEqual(*Weak.TryGet(), 10, "Weak handles should see the item.");
+	F_AssertEqual(First.GetRefCount(), 1, "Weak handles should not add a reference.");
+
+	{
+		THandle<UInt32> Locked = Weak.Lock();
+		F_AssertTrue(Locked.IsValid(), "Locking a live item should succeed.");
+		F_AssertEqual(First.GetRefCount(), 2, "Locking should add a reference.");
+	}
+
+	First.DeInit();
+	F_AssertTrue(!Weak.IsValid(), "Weak handles should go stale with the last reference.");
+	F_AssertTrue(Weak.TryGet() == nullptr, "Stale weak handles should give nothing.");
+	F_AssertTrue(!Weak.Lock().IsValid(), "Locking a released item should fail.");
+
+	// The released slot is reused, but under a new generation.
+	THandle<UInt32> Second = Handles.CreateHandle(20u);
+	const TWeakHandle<UInt32> SecondWeak = Second;
+
+	F_AssertTrue(Second.GetGeneration() != FirstGeneration, "Reused slots should get a new generation.");
+	F_AssertTrue(!Weak.IsValid(), "Weak handles should not see an item that reused their slot.");
+	F_AssertTrue(SecondWeak.IsValid(), "Weak handles to the new item should be valid.");
+	F_AssertTrue(Weak != SecondWeak, "Weak handles from different generations should differ.");
+
+	Weak.Reset();
+	F_AssertTrue(!Weak.IsValid(), "Reset weak handles should be invalid.");
+	F_AssertTrue(!Weak.Lock().IsValid(), "Locking a reset weak handle should fail.");
+}
+
+void FHandleTest::HandlesThreadSafeTests() const
+{
+	const UInt32 ItemCount = 256;
+	const SizeT ThreadCount = 4;
+	const SizeT IterationCount = 20000;
+
+	TThreadSafeHandles<UInt32> Handles;
+	TVector<TThreadSafeHandle<UInt32>> Owners;
+	TVector<TThreadSafeWeakHandle<UInt32>> Weaks;
+
+	for (UInt32 I = 0; I < ItemCount; ++I)
+	{
+		Owners.push_back(Handles.CreateHandle(I));
+		Weaks.push_back(Owners.back());
+	}
+
+	// Each worker owns every ThreadCount'th item and releases its owners one at a time
+	// in between locking weak handles to all items, so locks race the final releases
+	// made on the other threads.
+	const SizeT OwnedCount = ItemCount / ThreadCount;
+	const SizeT ReleaseInterval = IterationCount / OwnedCount;
+
+	TAtomic<SizeT> ReadyCount{ 0 };
+	TAtomic<SizeT> LockCount{ 0 };
+	TAtomic<SizeT> FailedLockCount{ 0 };
+	TVector<FThread> Threads;
+
+	for (SizeT T = 0; T < ThreadCount; ++T)
+	{
+		Threads.emplace_back([&, T]()
+		{
+			// Holds every worker back until all of them are running, so their loops overlap.
+			++ReadyCount;
+			while (ReadyCount.load() < ThreadCount)
+			{
+				NThread::YieldThread();
+			}
+
+			SizeT Locked = 0;
+			SizeT Failed = 0;
+			for (SizeT I = 0; I < IterationCount; ++I)
+			{
+				const SizeT Owned = I / ReleaseInterval;
+				if (I % ReleaseInterval == 0 && Owned < OwnedCount)
+				{
+					Owners[Owned * ThreadCount + T].DeInit();
+				}
+
+				const TThreadSafeWeakHandle<UInt32>& Weak = Weaks[(I * 7 + T * 13) % ItemCount];
+
+				TThreadSafeHandle<UInt32> Handle = Weak.Lock();
+				if (Handle.IsValid())
+				{
+					F_AssertEqual(Handle.GetGeneration(), Weak.GetGeneration(), "Locked the wrong generation.");
+					TThreadSafeHandle<UInt32> Copy = Handle;
+					++Locked;
+				}
+				else
+				{
+					++Failed;
+				}
+			}
+
+			LockCount += Locked;
+			FailedLockCount += Failed;
+		});
+	}
+
+	for (FThread& Thread : Threads)
+	{
+		Thread.join();
+	}
+
+	F_AssertTrue(LockCount.load() > 0, "Weak handles to items that are still owned should lock.");
+	F_AssertTrue(FailedLockCount.load() > 0, "Weak handles to released items should fail to lock.");
+	F_AssertEqual(LockCount.load() + FailedLockCount.load(), ThreadCount * IterationCount, "Every lock should be counted.");
+
+	F_AssertEqual(Handles.GetDataSize(), 0, "Every item should be released once.");
+	for (const TThreadSafeWeakHandle<UInt32>& Weak : Weaks)
+	{
+		F_AssertTrue(!Weak.IsValid(), "Every weak handle should be stale.");
+	}
+
+	F_Log("Thread safe handles: " << LockCount.load() << " of " << ThreadCount * IterationCount
+		<< " weak locks succeeded while the workers released the owners.");
+}
+
+void FHandleTest::HandlesBulkTests() const
+{
+	using namespace HandleTestStructs;
+
+	const UInt32 ItemCount = 1000;
+
+	THandles<FCopyCounter> Handles;
+	Handles.Reserve(ItemCount);
+
+	FCopyCounter::CopyCount = 0;
+	FCopyCounter::MoveCount = 0;
+
+	TVector<THandle<FCopyCounter>> Items;
+	Items.push_back(Handles.CreateHandle(0u));
+
+	const FCopyCounter* const Data = Handles.GetData().data();
+	Handles.EmplaceHandles(ItemCount - 1, [](FCopyCounter& Item, const SizeT Index)
+	{
+		Item.Value = static_cast<UInt32>(Index + 1);
+	}, Items);
+
+	F_AssertEqual(Items.size(), ItemCount, "Every handle should be appended.");
+	F_AssertTrue(Handles.GetData().data() == Data, "Reserved items should not be reallocated.");
+	F_AssertEqual(FCopyCounter::CopyCount, 0, "Items should be created in place.");
+	F_AssertEqual(FCopyCounter::MoveCount, 0, "Items should not be moved while being created.");
+
+	for (UInt32 I = 0; I < ItemCount; ++I)
+	{
+		F_AssertEqual(Items[I]->Value, I, "Handles should be appended in creation order.");
+	}
+
+	// Release a few so that the dense order no longer matches the creation order.
+	for (UInt32 I = 0; I < ItemCount; I += 7)
+	{
+		Items[I].DeInit();
+	}
+
+	SizeT SpanCount = 0;
+	SizeT VisitedCount = 0;
+	Handles.ForEachDense([&SpanCount, &VisitedCount, &Handles](const THandles<FCopyCounter>::SpanT& Span)
+	{
+		F_AssertTrue(Span.size() <= 64, "Spans should not exceed the maximum size.");
+		F_AssertTrue(Span.data() == &Handles[Span.GetDenseIndex(0)], "Spans should point into the dense items.");
+
+		for (SizeT I = 0; I < Span.size(); ++I)
+		{
+			const TWeakHandle<FCopyCounter> Weak = Span.GetWeakHandle(I);
+			F_AssertTrue(Weak.IsValid(), "Span items should be alive.");
+			F_AssertTrue(Weak.TryGet() == &Span[I], "Span handle slots should refer to their items.");
+		}
+
+		++SpanCount;
+		VisitedCount += Span.size();
+	}, 64);
+
+	F_AssertEqual(VisitedCount, Handles.GetDataSize(), "Spans should cover every item once.");
+	F_AssertEqual(SpanCount, (Handles.GetDataSize() + 63) / 64, "Span count is incorrect.");
+
+	const THandles<FCopyCounter>& ConstHandles = Handles;
+	UInt32 ValueSum = 0;
+	ConstHandles.ForEachDense([&ValueSum](const THandles<FCopyCounter>::ConstSpanT& Span)
+	{
+		for (const FCopyCounter& Item : Span)
+		{
+			ValueSum += Item.Value;
+		}
+	});
+
+	UInt32 ExpectedSum = 0;
+	for (UInt32 I = 0; I < ItemCount; ++I)
+	{
+		ExpectedSum += Items[I].IsValid() ? I : 0;
+	}
+
+	F_AssertEqual(ValueSum, ExpectedSum, "Const spans should see every item.");
+	F_AssertEqual(FCopyCounter::CopyCount, 0, "Releasing and iterating should not copy items.");
+}
+
+void FHandleTest::HandlesBenchmark() const
+{
+	typedef std::chrono::high_resolution_clock ClockT;
+
+	const SizeT InstanceCount = 100000;
+
+	TVector<TThreadSafeHandle<FModelInstance>> Instances;
+	Instances.reserve(InstanceCount);
+
+	FGFXScene SingleScene;
+	SingleScene.Init();
+
+	const auto SingleSpawnStart = ClockT::now();
+	for (SizeT I = 0; I < InstanceCount; ++I)
+	{
+		Instances.push_back(SingleScene.CreateModel("golem.pmesh"));
+	}
+	const auto SingleSpawnEnd = ClockT::now();
+
+	Instances.clear();
+	SingleScene.DeInit();
+
+	FGFXScene Scene;
+	Scene.Init();
+
+	const auto BulkSpawnStart = ClockT::now();
+	Scene.CreateModels(InstanceCount, "golem.pmesh", Instances);
+	const auto BulkSpawnEnd = ClockT::now();
+
+	F_AssertEqual(Instances.size(), InstanceCount, "Every instance should be created.");
+	for (SizeT I = 0; I < InstanceCount; ++I)
+	{
+		Instances[I]->SetPosition(FVector3D(static_cast<Float32>(I), 0.f, 0.f));
+	}
+
+	// Released out of creation order, so nearly every release swaps the last element in.
+	const auto ReleaseStart = ClockT::now();
+	for (SizeT I = 0; I < InstanceCount / 2; ++I)
+	{
+		Instances[(I * 7919) % InstanceCount].DeInit();
+	}
+	const auto ReleaseMid = ClockT::now();
+
+	for (SizeT I = 0; I < InstanceCount; ++I)
+	{
+		if (Instances[I].IsValid())
+		{
+			F_AssertEqual(Instances[I]->GetPosition().x, static_cast<Float32>(I),
+				"Instance lost track of its data after a swap-remove.");
+		}
+	}
+
+	const auto ReleaseRestStart = ClockT::now();
+	Instances.clear();
+	const auto ReleaseEnd = ClockT::now();
+
+	F_AssertEqual(Scene.GetModelInstances().GetDataSize(), 0, "Every instance should be released.");
+	Scene.DeInit();
+
+	const auto ToMS = [](const ClockT::duration Duration)
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(Duration).count();
+	};
+
+	F_Log("FModelInstance spawns (" << InstanceCount << "): CreateModels " << ToMS(BulkSpawnEnd - BulkSpawnStart)
+		<< "ms vs CreateModel: " << ToMS(SingleSpawnEnd - SingleSpawnStart) << "ms");
+	F_Log("FModelInstance handle releases (" << InstanceCount << "): "
+		<< ToMS((ReleaseMid - ReleaseStart) + (ReleaseEnd - ReleaseRestStart)) << "ms");
+}
@@ -0,0 +1,23 @@
+#ifndef PHOENIX_HANDLE_TEST_H
+#define PHOENIX_HANDLE_TEST_H
+
+namespace Phoenix
+{
+	class FHandleTest
+	{
+	public:
+		void RunTests() const;
+
+	private:
+		void TestHandles() const;
+
+		void HandlesBasicTests() const;
+		void HandlesReleaseTests() const;
+		void HandlesGenerationTests() const;
+		void HandlesThreadSafeTests() const;
+		void HandlesBulkTests() const;
+		void HandlesBenchmark() const;
+	};
+}
+
+#endif
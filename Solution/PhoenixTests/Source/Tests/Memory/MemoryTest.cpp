@@ -0,0 +1,566 @@
+#include "Tests/Memory/MemoryTest.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#include "Utility/Containers/AssetVector.h"
+#include "Utility/Containers/FrameVector.h"
+#include "Utility/Containers/Map.h"
+#include "Utility/Containers/UnorderedMap.h"
+#include "Utility/Containers/Vector.h"
+#include "Utility/Debug/Assert.h"
+#include "Utility/Debug/Debug.h"
+#include "Utility/Misc/Allocator.h"
+#include "Utility/Misc/FrameAllocator.h"
+#include "Utility/Misc/MemoryTracker.h"
+#include "Utility/Misc/PoolAllocator.h"
+#include "Utility/Misc/Primitives.h"
+#include "Utility/Misc/TLSFHeap.h"
+#include "Utility/Threading/Thread.h"
+
+using namespace Phoenix;
+
+void FMemoryTest::RunTests() const
+{
+	TestTrackedAlloc();
+	TestFrameAllocator();
+	TestPoolAllocator();
+	TestTLSFHeap();
+}
+
+void FMemoryTest::TestTrackedAlloc() const
+{
+	TrackedAllocBasicTests();
+	TrackedAllocMultiThreadedTests();
+}
+
+void FMemoryTest::TrackedAllocBasicTests() const
+{
+	typedef TVector<UInt32, TTrackedAlloc<UInt32, EMemoryTag::Audio>> FTrackedVector;
+
+	FMemoryTracker::EndFrame();
+	const FMemoryTagStats Before = FMemoryTracker::GetReport().Tags[EMemoryTag::Audio];
+
+	{
+		FTrackedVector Vector;
+		Vector.reserve(100);
+
+		FMemoryTracker::EndFrame();
+		const FMemoryTagStats Stats = FMemoryTracker::GetReport().Tags[EMemoryTag::Audio];
+
+		F_AssertEqual(Stats.CurrentBytes - Before.CurrentBytes, 100 * sizeof(UInt32), "Current bytes are incorrect.");
+		F_AssertEqual(Stats.CurrentCount - Before.CurrentCount, 1, "Live allocation count is incorrect.");
+		F_AssertEqual(Stats.FrameAllocCount, 1, "Frame allocation count is incorrect.");
+		F_AssertEqual(Stats.FrameAllocBytes, 100 * sizeof(UInt32), "Frame allocation bytes are incorrect.");
+		F_AssertEqual(Stats.FrameFreeCount, 0, "Frame free count is incorrect.");
+	}
+
+	FMemoryTracker::EndFrame();
+	const FMemoryTagStats After = FMemoryTracker::GetReport().Tags[EMemoryTag::Audio];
+
+	F_AssertEqual(After.CurrentBytes, Before.CurrentBytes, "All memory should have been freed.");
+	F_AssertEqual(After.FrameFreeCount, 1, "Frame free count is incorrect.");
+	F_AssertTrue(After.PeakBytes >= Before.CurrentBytes + static_cast<Int64>(100 * sizeof(UInt32)), "Peak bytes are incorrect.");
+
+	FMemoryTracker::EndFrame();
+	const FMemoryTagStats Idle = FMemoryTracker::GetReport().Tags[EMemoryTag::Audio];
+
+	F_AssertEqual(Idle.FrameAllocCount, 0, "Churn should reset every frame.");
+	F_AssertEqual(Idle.FrameFreeCount, 0, "Churn should reset every frame.");
+
+	// Node based containers rebind the allocator to their node type.
+	typedef TTrackedAlloc<TPair<const UInt32, UInt32>, EMemoryTag::Audio> FMapAllocator;
+	TUnorderedMap<UInt32, UInt32, std::hash<UInt32>, std::equal_to<UInt32>, FMapAllocator> Map;
+	Map.emplace(1, 2);
+
+	FMemoryTracker::EndFrame();
+	F_AssertTrue(FMemoryTracker::GetReport().Tags[EMemoryTag::Audio].CurrentCount > Before.CurrentCount,
+		"Map allocations should be tracked.");
+}
+
+void FMemoryTest::TrackedAllocMultiThreadedTests() const
+{
+	typedef TTrackedAlloc<UInt8, EMemoryTag::Audio> FAllocator;
+	const SizeT ThreadCount = 4;
+	const SizeT AllocCount = 1000;
+	const SizeT AllocSize = 16;
+
+	FMemoryTracker::EndFrame();
+	const FMemoryTagStats Before = FMemoryTracker::GetReport().Tags[EMemoryTag::Audio];
+
+	TVector<TVector<UInt8*>> AllocsPerThread(ThreadCount);
+	{
+		TVector<FThread> Threads;
+		for (SizeT I = 0; I < ThreadCount; ++I)
+		{
+			Threads.emplace_back([&Allocs = AllocsPerThread[I]]()
+			{
+				FAllocator Allocator;
+				for (SizeT J = 0; J < AllocCount; ++J)
+				{
+					Allocs.push_back(Allocator.allocate(AllocSize));
+				}
+			});
+		}
+
+		for (auto& Thread : Threads)
+		{
+			Thread.join();
+		}
+	}
+
+	// The allocating threads have exited, so their counters must have been retired.
+	FMemoryTracker::EndFrame();
+	const FMemoryTagStats Allocated = FMemoryTracker::GetReport().Tags[EMemoryTag::Audio];
+
+	F_AssertEqual(Allocated.CurrentCount - Before.CurrentCount, ThreadCount * AllocCount, "Live allocation count is incorrect.");
+	F_AssertEqual(Allocated.CurrentBytes - Before.CurrentBytes, ThreadCount * AllocCount * AllocSize, "Current bytes are incorrect.");
+
+	// Free on a different thread than the one that allocated.
+	FAllocator Allocator;
+	for (const auto& Allocs : AllocsPerThread)
+	{
+		for (UInt8* const Data : Allocs)
+		{
+			Allocator.deallocate(Data, AllocSize);
+		}
+	}
+
+	FMemoryTracker::EndFrame();
+	const FMemoryTagStats Freed = FMemoryTracker::GetReport().Tags[EMemoryTag::Audio];
+
+	F_AssertEqual(Freed.CurrentCount, Before.CurrentCount, "All allocations should have been freed.");
+	F_AssertEqual(Freed.CurrentBytes, Before.CurrentBytes, "All memory should have been freed.");
+}
+
+void FMemoryTest::TestFrameAllocator() const
+{
+	FrameAllocatorBasicTests();
+	FrameAllocatorOverflowTests();
+	FrameVectorTests();
+}
+
+void FMemoryTest::FrameAllocatorBasicTests() const
+{
+	FFrameAllocator Allocator(1024);
+
+	UInt8* const First = static_cast<UInt8*>(Allocator.Allocate(3, 1));
+	UInt32* const Second = static_cast<UInt32*>(Allocator.Allocate(sizeof(UInt32), alignof(UInt32)));
+
+	F_AssertTrue(reinterpret_cast<SizeT>(Second) % alignof(UInt32) == 0, "Allocation is misaligned.");
+	F_AssertEqual(reinterpret_cast<UInt8*>(Second) - First, 4, "Allocations should be packed.");
+
+	// Releasing the most recent allocation hands its space out again.
+	Allocator.Deallocate(Second, sizeof(UInt32));
+	UInt32* const Third = static_cast<UInt32*>(Allocator.Allocate(sizeof(UInt32), alignof(UInt32)));
+	F_AssertTrue(Third == Second, "The last allocation should have been rolled back.");
+
+	*Third = 42;
+	Allocator.EndFrame();
+
+	// The previous frame's memory survives one frame and is reused the frame after.
+	UInt8* const NextFrame = static_cast<UInt8*>(Allocator.Allocate(3, 1));
+	F_AssertTrue(NextFrame != First, "The previous frame's buffer should still be in use.");
+	F_AssertEqual(*Third, 42, "The previous frame's memory should still be valid.");
+
+	Allocator.EndFrame();
+
+	UInt8* const FrameAfter = static_cast<UInt8*>(Allocator.Allocate(3, 1));
+	F_AssertTrue(FrameAfter == First, "The buffer from two frames ago should have been reset.");
+
+	const FFrameAllocatorStats& Stats = Allocator.GetStats();
+	F_AssertEqual(Stats.FrameCount, 2, "Frame count is incorrect.");
+	F_AssertEqual(Stats.FrameAllocCount, 1, "Frame allocation count is incorrect.");
+	F_AssertEqual(Stats.OverflowCount, 0, "Nothing should have overflowed.");
+}
+
+void FMemoryTest::FrameAllocatorOverflowTests() const
+{
+	const SizeT Capacity = 64;
+	FFrameAllocator Allocator(Capacity);
+
+	void* const Fits = Allocator.Allocate(Capacity, 1);
+	void* const Overflow = Allocator.Allocate(Capacity, 1);
+
+	F_AssertTrue(Fits != nullptr && Overflow != nullptr, "Allocation failed.");
+	F_AssertEqual(Allocator.GetStats().OverflowCount, 1, "The second allocation should have overflowed.");
+
+	Allocator.Deallocate(Overflow, Capacity);
+	Allocator.EndFrame();
+	Allocator.EndFrame();
+
+	// Both buffers have been reset since the overflow, so they've grown to fit the frame.
+	F_AssertTrue(Allocator.GetStats().CapacityBytes >= Capacity * 2, "The buffers should have grown.");
+
+	Allocator.Allocate(Capacity, 1);
+	Allocator.Allocate(Capacity, 1);
+	F_AssertEqual(Allocator.GetStats().OverflowCount, 1, "The grown buffer should have fit the frame.");
+}
+
+void FMemoryTest::FrameVectorTests() const
+{
+	FFrameAllocator& Allocator = FFrameAllocator::GetThreadAllocator();
+	Allocator.EndFrame();
+
+	const UInt32 OverflowCount = Allocator.GetStats().OverflowCount;
+	const SizeT ElementCount = 1000;
+
+	for (SizeT Frame = 0; Frame < 4; ++Frame)
+	{
+		TFrameVector<UInt32> Vector;
+		for (SizeT I = 0; I < ElementCount; ++I)
+		{
+			Vector.push_back(static_cast<UInt32>(I));
+		}
+
+		TFrameVector<UInt32> Copy(Vector);
+		F_AssertTrue(Copy == Vector, "Frame vector copy is incorrect.");
+		F_AssertTrue(Copy.get_allocator() == Vector.get_allocator(), "Frame allocators should compare equal.");
+
+		Allocator.EndFrame();
+	}
+
+	F_AssertEqual(Allocator.GetStats().OverflowCount, OverflowCount, "Frame vectors should not have overflowed.");
+	F_AssertTrue(Allocator.GetStats().FrameAllocCount > 1, "Frame vectors should use the frame allocator.");
+}
+
+void FMemoryTest::TestPoolAllocator() const
+{
+	PoolAllocatorBasicTests();
+	PoolAllocatorCrossThreadTests();
+	PoolAllocatorBenchmark();
+}
+
+void FMemoryTest::PoolAllocatorBasicTests() const
+{
+	const SizeT BlockCount = 100;
+	TVector<void*> Blocks;
+
+	for (SizeT I = 0; I < BlockCount; ++I)
+	{
+		void* const Data = FPoolAlloc::Allocate(24);
+		F_AssertTrue(reinterpret_cast<SizeT>(Data) % FPoolAlloc::BlockAlignment == 0, "Block is misaligned.");
+
+		std::memset(Data, static_cast<int>(I), 24);
+		Blocks.push_back(Data);
+	}
+
+	std::sort(Blocks.begin(), Blocks.end());
+	for (SizeT I = 1; I < BlockCount; ++I)
+	{
+		const SizeT Distance = static_cast<UInt8*>(Blocks[I]) - static_cast<UInt8*>(Blocks[I - 1]);
+		F_AssertTrue(Distance >= 32, "Blocks should not overlap.");
+	}
+
+	for (void* const Data : Blocks)
+	{
+		FPoolAlloc::Free(Data, 24);
+	}
+
+	// The most recently freed block is handed out first.
+	void* const Reused = FPoolAlloc::Allocate(32);
+	F_AssertTrue(Reused == Blocks.back(), "Freed blocks should be reused.");
+	FPoolAlloc::Free(Reused, 32);
+
+	// Sizes above the largest class fall back to the heap.
+	void* const Large = FPoolAlloc::Allocate(FPoolAlloc::MaxBlockSize + 1);
+	std::memset(Large, 0, FPoolAlloc::MaxBlockSize + 1);
+	FPoolAlloc::Free(Large, FPoolAlloc::MaxBlockSize + 1);
+
+	struct FSmall
+	{
+		UInt32 Value{ 7 };
+	};
+
+	static_assert(FPoolAlloc::IsPoolable<FSmall>(), "FSmall should be poolable.");
+
+	FSmall* const Small = FAlloc::New<FSmall>();
+	F_AssertEqual(Small->Value, 7, "Object was not constructed.");
+	FAlloc::Delete(Small);
+
+	TMap<UInt32, UInt32, std::less<UInt32>, TPoolAlloc<TPair<const UInt32, UInt32>>> Map;
+	for (UInt32 I = 0; I < 1000; ++I)
+	{
+		Map.emplace(I, I * 2);
+	}
+
+	F_AssertEqual(Map[500], 1000, "Map contents are incorrect.");
+
+	const FPoolAllocStats Stats = FPoolAlloc::GetStats();
+	F_AssertTrue(Stats.ReservedBytes[1] > 0, "The 32 byte class should have reserved memory.");
+}
+
+void FMemoryTest::PoolAllocatorCrossThreadTests() const
+{
+	const SizeT BlockCount = 10000;
+	const SizeT BlockSize = 64;
+	TVector<UInt8*> Blocks(BlockCount);
+
+	FThread Producer([&Blocks]()
+	{
+		for (SizeT I = 0; I < BlockCount; ++I)
+		{
+			Blocks[I] = static_cast<UInt8*>(FPoolAlloc::Allocate(BlockSize));
+			std::memset(Blocks[I], static_cast<int>(I & 0xFF), BlockSize);
+		}
+	});
+
+	Producer.join();
+
+	// The producer's cached magazines went back to the depot when it exited.
+	for (SizeT I = 0; I < BlockCount; ++I)
+	{
+		F_AssertEqual(Blocks[I][BlockSize - 1], I & 0xFF, "Block contents were overwritten.");
+		FPoolAlloc::Free(Blocks[I], BlockSize);
+	}
+
+	FThread Consumer([&Blocks]()
+	{
+		for (SizeT I = 0; I < BlockCount; ++I)
+		{
+			Blocks[I] = static_cast<UInt8*>(FPoolAlloc::Allocate(BlockSize));
+		}
+
+		for (SizeT I = 0; I < BlockCount; ++I)
+		{
+			FPoolAlloc::Free(Blocks[I], BlockSize);
+		}
+	});
+
+	Consumer.join();
+}
+
+void FMemoryTest::PoolAllocatorBenchmark() const
+{
+	const SizeT ThreadCount = 4;
+	const SizeT LiveCount = 1024;
+	const SizeT OpCount = 500000;
+
+	typedef void* (*FAllocFunc)(const SizeT);
+	typedef void (*FFreeFunc)(void* const, const SizeT);
+
+	// Each thread keeps a window of live blocks and replaces a random one every step.
+	auto RunChurn = [=](FAllocFunc AllocFunc, FFreeFunc FreeFunc)
+	{
+		const auto StartTime = std::chrono::high_resolution_clock::now();
+
+		TVector<FThread> Threads;
+		for (SizeT I = 0; I < ThreadCount; ++I)
+		{
+			Threads.emplace_back([=]()
+			{
+				TVector<TPair<void*, SizeT>> Live(LiveCount, TPair<void*, SizeT>(nullptr, 0));
+				UInt32 Seed = static_cast<UInt32>(I * 7919 + 1);
+
+				for (SizeT J = 0; J < OpCount; ++J)
+				{
+					Seed = Seed * 1664525u + 1013904223u;
+					auto& Entry = Live[(Seed >> 8) % LiveCount];
+
+					FreeFunc(Entry.first, Entry.second);
+
+					Entry.second = 16 + (Seed >> 20) % (FPoolAlloc::MaxBlockSize - 15);
+					Entry.first = AllocFunc(Entry.second);
+					*static_cast<UInt8*>(Entry.first) = 1;
+				}
+
+				for (auto& Entry : Live)
+				{
+					FreeFunc(Entry.first, Entry.second);
+				}
+			});
+		}
+
+		for (auto& Thread : Threads)
+		{
+			Thread.join();
+		}
+
+		const auto EndTime = std::chrono::high_resolution_clock::now();
+		return std::chrono::duration_cast<std::chrono::milliseconds>(EndTime - StartTime).count();
+	};
+
+	const auto PoolTimeMS = RunChurn(
+		[](const SizeT Size) { return FPoolAlloc::Allocate(Size); },
+		[](void* const Data, const SizeT Size) { FPoolAlloc::Free(Data, Size); });
+
+	const auto MallocTimeMS = RunChurn(
+		[](const SizeT Size) { return std::malloc(Size); },
+		[](void* const Data, const SizeT) { std::free(Data); });
+
+	F_Log("Pool allocator churn (" << ThreadCount << " threads x " << OpCount << " ops): "
+		<< PoolTimeMS << "ms vs malloc: " << MallocTimeMS << "ms");
+}
+
+void FMemoryTest::TestTLSFHeap() const
+{
+	TLSFHeapBasicTests();
+	TLSFHeapAlignmentTests();
+	TLSFHeapFragmentationTests();
+	AssetVectorTests();
+}
+
+void FMemoryTest::TLSFHeapBasicTests() const
+{
+	const SizeT ArenaSize = 1024 * 1024;
+	FTLSFHeap Heap(ArenaSize);
+
+	F_AssertEqual(Heap.GetStats().ArenaCount, 0, "Arenas should only be mapped on demand.");
+
+	const SizeT BlockCount = 64;
+	TVector<void*> Blocks;
+
+	for (SizeT I = 0; I < BlockCount; ++I)
+	{
+		const SizeT Size = 1 + I * 97;
+		void* const Data = Heap.Allocate(Size);
+
+		F_AssertTrue(Data, "Allocation failed.");
+		F_AssertTrue(reinterpret_cast<SizeT>(Data) % FTLSFHeap::MinAlignment == 0, "Block is misaligned.");
+		F_AssertTrue(Heap.GetAllocationSize(Data) >= Size, "Block is smaller than requested.");
+
+		std::memset(Data, static_cast<int>(I), Size);
+		Blocks.push_back(Data);
+	}
+
+	for (SizeT I = 0; I < BlockCount; ++I)
+	{
+		const UInt8* const Bytes = static_cast<const UInt8*>(Blocks[I]);
+		F_AssertEqual(Bytes[I * 97], static_cast<UInt8>(I), "Block contents were overwritten.");
+	}
+
+	FTLSFHeapStats Stats = Heap.GetStats();
+	F_AssertEqual(Stats.ArenaCount, 1, "Small allocations should share an arena.");
+	F_AssertEqual(Stats.UsedBlockCount, BlockCount, "Used block count is incorrect.");
+
+	// Freeing every other block and then the rest must merge everything back together.
+	for (SizeT I = 0; I < BlockCount; I += 2)
+	{
+		Heap.Free(Blocks[I]);
+	}
+
+	for (SizeT I = 1; I < BlockCount; I += 2)
+	{
+		Heap.Free(Blocks[I]);
+	}
+
+	Stats = Heap.GetStats();
+	F_AssertEqual(Stats.UsedBytes, 0, "All blocks were freed.");
+	F_AssertEqual(Stats.FreeBlockCount, 1, "Free neighbours should have been merged.");
+	F_AssertEqual(Stats.GetFragmentation(), 0.f, "A single free block is not fragmented.");
+
+	// Allocations bigger than an arena get one of their own.
+	const SizeT LargeSize = ArenaSize * 3;
+	void* const Large = Heap.Allocate(LargeSize);
+	std::memset(Large, 0xFF, LargeSize);
+
+	F_AssertEqual(Heap.GetStats().ArenaCount, 2, "A large allocation should map its own arena.");
+
+	// Its arena goes back to the OS as soon as it's freed, without waiting for a Trim.
+	const SizeT ReservedWithLarge = Heap.GetStats().ReservedBytes;
+	Heap.Free(Large);
+
+	Stats = Heap.GetStats();
+	F_AssertEqual(Stats.ArenaCount, 1, "Freeing a large allocation should unmap its arena.");
+	F_AssertTrue(ReservedWithLarge - Stats.ReservedBytes >= LargeSize, "Mapped bytes should drop by the large arena.");
+	F_AssertEqual(Stats.ReservedBytes, ArenaSize, "Only the shared arena should remain mapped.");
+
+	const SizeT TrimmedBytes = Heap.Trim();
+	F_AssertEqual(TrimmedBytes, ArenaSize, "The empty shared arena should be unmapped.");
+	F_AssertEqual(Heap.GetStats().ArenaCount, 0, "No arenas should remain.");
+
+	void* const AfterTrim = Heap.Allocate(128);
+	F_AssertTrue(AfterTrim, "The heap should remap an arena after a trim.");
+	Heap.Free(AfterTrim);
+}
+
+void FMemoryTest::TLSFHeapAlignmentTests() const
+{
+	FTLSFHeap Heap(256 * 1024);
+	TVector<void*> Blocks;
+
+	for (SizeT Alignment = 16; Alignment <= 4096; Alignment *= 2)
+	{
+		for (SizeT Size : { 8, 100, 5000 })
+		{
+			void* const Data = Heap.Allocate(Size, Alignment);
+			F_AssertTrue(reinterpret_cast<SizeT>(Data) % Alignment == 0, "Block is misaligned.");
+
+			std::memset(Data, 0, Size);
+			Blocks.push_back(Data);
+		}
+	}
+
+	for (void* const Data : Blocks)
+	{
+		Heap.Free(Data);
+	}
+
+	const FTLSFHeapStats Stats = Heap.GetStats();
+	F_AssertEqual(Stats.UsedBytes, 0, "All blocks were freed.");
+	F_AssertEqual(Stats.FreeBlockCount, Stats.ArenaCount, "Alignment gaps should merge back in.");
+}
+
+void FMemoryTest::TLSFHeapFragmentationTests() const
+{
+	FTLSFHeap Heap(1024 * 1024);
+	TVector<void*> Blocks;
+
+	const SizeT BlockSize = 1024;
+	while (Heap.GetStats().ArenaCount < 2)
+	{
+		Blocks.push_back(Heap.Allocate(BlockSize));
+	}
+
+	// The last block spilled into a second arena, which is empty again once it's freed.
+	Heap.Free(Blocks.back());
+	Blocks.pop_back();
+
+	F_AssertEqual(Heap.Trim(), 1024 * 1024, "The second arena should be unmapped.");
+
+	// Leaves holes of one block each, so no single free block can hold more than that.
+	for (SizeT I = 0; I < Blocks.size(); I += 2)
+	{
+		Heap.Free(Blocks[I]);
+		Blocks[I] = nullptr;
+	}
+
+	FTLSFHeapStats Stats = Heap.GetStats();
+	F_AssertTrue(Stats.FreeBlockCount > 100, "Holes should stay separate.");
+	F_AssertTrue(Stats.GetFragmentation() > 0.5f, "Splintered free memory should report fragmentation.");
+	F_Log("TLSF fragmented heap: " << Stats);
+
+	F_AssertEqual(Heap.Trim(), 0, "No arena is completely free.");
+
+	for (void* const Data : Blocks)
+	{
+		Heap.Free(Data);
+	}
+
+	Stats = Heap.GetStats();
+	F_AssertEqual(Stats.FreeBlockCount, 1, "The arena should be one free block again.");
+	F_AssertEqual(Stats.GetFragmentation(), 0.f, "A single free block is not fragmented.");
+
+	F_AssertEqual(Heap.Trim(), Stats.ReservedBytes, "Every arena should be unmapped.");
+}
+
+void FMemoryTest::AssetVectorTests() const
+{
+	const FTLSFHeapStats InitialStats = FTLSFHeap::GetAssetHeap().GetStats();
+
+	{
+		TAssetVector<Float32> Positions;
+		for (SizeT I = 0; I < 10000; ++I)
+		{
+			Positions.push_back(static_cast<Float32>(I));
+		}
+
+		F_AssertEqual(Positions[9999], 9999.f, "Vector contents are incorrect.");
+		F_AssertTrue(FTLSFHeap::GetAssetHeap().GetStats().UsedBytes >= 10000 * sizeof(Float32),
+			"Asset vectors should allocate from the asset heap.");
+	}
+
+	F_AssertEqual(FTLSFHeap::GetAssetHeap().GetStats().UsedBytes, InitialStats.UsedBytes,
+		"Asset vectors should return their memory.");
+}
@@ -0,0 +1,38 @@
+#ifndef PHOENIX_MEMORY_TEST_H
+#define PHOENIX_MEMORY_TEST_H
+
+namespace Phoenix
+{
+	class FMemoryTest
+	{
+	public:
+		void RunTests() const;
+
+	private:
+		void TestTrackedAlloc() const;
+
+		void TrackedAllocBasicTests() const;
+		void TrackedAllocMultiThreadedTests() const;
+
+		void TestFrameAllocator() const;
+
+		void FrameAllocatorBasicTests() const;
+		void FrameAllocatorOverflowTests() const;
+		void FrameVectorTests() const;
+
+		void TestPoolAllocator() const;
+
+		void PoolAllocatorBasicTests() const;
+		void PoolAllocatorCrossThreadTests() const;
+		void PoolAllocatorBenchmark() const;
+
+		void TestTLSFHeap() const;
+
+		void TLSFHeapBasicTests() const;
+		void TLSFHeapAlignmentTests() const;
+		void TLSFHeapFragmentationTests() const;
+		void AssetVectorTests() const;
+	};
+}
+
+#endif
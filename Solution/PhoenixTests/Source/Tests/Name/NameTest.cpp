@@ -0,0 +1,322 @@
+#include "Tests/Name/NameTest.h"
+
+#include <chrono>
+
+#include "Utility/Containers/NamedItemCache.h"
+#include "Utility/Containers/UnorderedMap.h"
+#include "Utility/Containers/Vector.h"
+#include "Utility/Debug/Assert.h"
+#include "Utility/Debug/Debug.h"
+#include "Utility/Handle/Handles.h"
+#include "Utility/Misc/Name.h"
+#include "Utility/Misc/Primitives.h"
+#include "Utility/Misc/String.h"
+#include "Utility/Threading/Thread.h"
+
+using namespace Phoenix;
+
+void FNameTest::RunTests() const
+{
+	TestName();
+	TestNamedItemCache();
+}
+
+void FNameTest::TestName() const
+{
+	NameBasicTests();
+	NameGrowthTests();
+	NameMultiThreadedTests();
+}
+
+void FNameTest::NameBasicTests() const
+{
+	const FName None;
+	F_AssertTrue(None.IsNone(), "Default names should be none.");
+	F_AssertTrue(None == FName(""), "The empty string should be none.");
+	F_AssertTrue(None.GetString().empty(), "None should have an empty string.");
+
+	const FName Golem("golem.fbx");
+	const FName GolemCopy(FString("golem.fbx"));
+	const FName Crate("crate.fbx");
+
+	F_AssertTrue(!Golem.IsNone(), "Name should not be none.");
+	F_AssertTrue(Golem == GolemCopy, "Equal strings should intern to the same name.");
+	F_AssertTrue(Golem != Crate, "Different strings should intern to different names.");
+	F_AssertEqual(Golem.GetIndex(), GolemCopy.GetIndex(), "Equal names should share an index.");
+	F_AssertEqual(Golem.GetHash(), GolemCopy.GetHash(), "Equal names should share a hash.");
+	F_AssertEqual(Golem.GetString(), "golem.fbx", "Interned string is incorrect.");
+	F_AssertEqual(std::hash<FName>()(Golem), Golem.GetHash(), "std::hash should use the precomputed hash.");
+
+	// The interned string isn't tied to the string the name was made from.
+	FString Temporary = "temporary.png";
+	const FName TemporaryName(Temporary);
+	Temporary = "changed.png";
+	F_AssertEqual(TemporaryName.GetString(), "temporary.png", "Interned string should be a copy.");
+
+	const SizeT NameCount = FName::GetNameCount();
+	const FName Again("golem.fbx");
+	F_AssertEqual(FName::GetNameCount(), NameCount, "Interning an existing string should not add a name.");
+}
+
+void FNameTest::NameGrowthTests() const
+{
+	// Enough names to grow the slot table and allocate several entry chunks.
+	const SizeT NameCount = 10000;
+
+	TVector<FName> Names;
+	Names.reserve(NameCount);
+
+	for (SizeT I = 0; I < NameCount; ++I)
+	{
+		Names.emplace_back("GrowthTest_" + std::to_string(I));
+	}
+
+	for (SizeT I = 0; I < NameCount; ++I)
+	{
+		const FString Expected = "GrowthTest_" + std::to_string(I);
+
+		F_AssertEqual(Names[I].GetString(), Expected, "Interned string is incorrect.");
+		F_AssertTrue(FName(Expected) == Names[I], "Names should be found after the table grows.");
+	}
+}
+
+void FNameTest::NameMultiThreadedTests() const
+{
+	const SizeT ThreadCount = 4;
+	const SizeT NameCount = 5000;
+
+	TVector<TVector<FName>> NamesPerThread(ThreadCount);
+	{
+		TVector<FThread> Threads;
+		for (SizeT I = 0; I < ThreadCount; ++I)
+		{
+			Threads.emplace_back([&Names = NamesPerThread[I], I]()
+			{
+				// Each thread interns the same strings in a different order.
+				for (SizeT J = 0; J < NameCount; ++J)
+				{
+					const SizeT NameIndex = (J + I * NameCount / ThreadCount) % NameCount;
+					Names.emplace_back("ThreadTest_" + std::to_string(NameIndex));
+				}
+			});
+		}
+
+		for (auto& Thread : Threads)
+		{
+			Thread.join();
+		}
+	}
+
+	for (SizeT I = 0; I < ThreadCount; ++I)
+	{
+		for (SizeT J = 0; J < NameCount; ++J)
+		{
+			const SizeT NameIndex = (J + I * NameCount / ThreadCount) % NameCount;
+			const FName& Name = NamesPerThread[I][J];
+
+			F_AssertTrue(Name == NamesPerThread[0][NameIndex],
+				"Every thread should get the same name for the same string.");
+			F_AssertEqual(Name.GetString(), "ThreadTest_" + std::to_string(NameIndex), "Interned string is incorrect.");
+		}
+	}
+}
+
+void FNameTest::TestNamedItemCache() const
+{
+	NamedItemCacheBasicTests();
+	NamedItemCacheEvictionTests();
+	NamedItemCachePinningTests();
+	NamedHandleRefTests();
+	NamedItemCacheBenchmark();
+}
+
+void FNameTest::NamedItemCacheBasicTests() const
+{
+	TNamedItemCache<UInt32> Cache;
+
+	F_AssertTrue(Cache.AddEntry(FName("a.png"), 1), "Entry should be added.");
+	F_AssertTrue(Cache.AddEntry("b.png", 2), "Entry should be added.");
+	F_AssertTrue(!Cache.AddEntry(FName("a.png"), 3), "Duplicate entries should be rejected.");
+
+	F_AssertEqual(Cache.GetItemCount(), 2, "Item count is incorrect.");
+	F_AssertTrue(Cache.HasItem(FName("b.png")), "Item should exist.");
+	F_AssertEqual(Cache.GetItemCopy(FName("a.png")), 1, "Item is incorrect.");
+
+	UInt32 Default = 0;
+	F_AssertEqual(Cache.GetItem(FName("missing.png"), Default), 0, "Missing items should return the default.");
+
+	F_AssertTrue(Cache.RemoveItem(FName("a.png")), "Item should be removed.");
+	F_AssertTrue(!Cache.HasItem(FName("a.png")), "Item should no longer exist.");
+}
+
+void FNameTest::NamedItemCacheEvictionTests() const
+{
+	TNamedItemCache<UInt32> Cache;
+	F_AssertEqual(Cache.GetBudget(), TNumericLimits<SizeT>::max(), "Caches should start without a budget.");
+
+	const FName A("a.png");
+	const FName B("b.png");
+	const FName C("c.png");
+	const FName D("d.png");
+
+	Cache.AddEntry(A, 1);
+	Cache.AddEntry(B, 2);
+	Cache.AddEntry(C, 3);
+	Cache.AddEntry(D, 4);
+	F_AssertEqual(Cache.GetUsedBytes(), 4 * sizeof(UInt32), "Items should be sized by sizeof.");
+
+	// Every item was just added, so the first sweep only takes away their second chance.
+	Cache.SetBudget(3 * sizeof(UInt32));
+	F_AssertEqual(Cache.GetItemCount(), 3, "One item should be evicted to fit the budget.");
+	F_AssertTrue(!Cache.HasItem(A), "The first item the hand reaches should be evicted.");
+
+	// Items that are looked up get a second chance over ones that aren't.
+	Cache.GetItem(B);
+	Cache.GetItem(C);
+	Cache.SetBudget(2 * sizeof(UInt32));
+	F_AssertTrue(Cache.HasItem(B), "Recently used items should survive.");
+	F_AssertTrue(Cache.HasItem(C), "Recently used items should survive.");
+	F_AssertTrue(!Cache.HasItem(D), "Unused items should be evicted first.");
+
+	Cache.AddEntry(A, 1);
+	F_AssertEqual(Cache.GetItemCount(), 2, "Adding over budget should evict.");
+	F_AssertTrue(Cache.GetUsedBytes() <= Cache.GetBudget(), "The cache should fit its budget.");
+
+	Cache.ResetStats();
+	UInt32 Default = 0;
+	Cache.GetItem(FName("missing.png"), Default);
+	for (const FName& Name : { A, B, C })
+	{
+		Cache.GetItem(Name);
+	}
+
+	const FNamedItemCacheStats& Stats = Cache.GetStats();
+	F_AssertEqual(Stats.Hits + Stats.Misses, 4, "Every lookup should be counted.");
+	F_AssertEqual(Stats.Misses, 4 - Cache.GetItemCount(), "Misses are incorrect.");
+	F_AssertEqual(Stats.ItemCount, Cache.GetItemCount(), "Occupancy is incorrect.");
+	F_AssertEqual(Stats.UsedBytes, Cache.GetUsedBytes(), "Occupancy is incorrect.");
+	F_AssertEqual(Stats.Evictions, 0, "Resetting stats should zero evictions.");
+	F_AssertEqual(Stats.GetHitRate(), 0.5f, "Hit rate is incorrect.");
+}
+
+void FNameTest::NamedItemCachePinningTests() const
+{
+	THandles<UInt32> Handles;
+	TNamedItemCache<THandle<UInt32>> Cache;
+
+	const FName A("a.png");
+	const FName B("b.png");
+	const FName C("c.png");
+
+	Cache.AddEntry(A, Handles.CreateHandle(1u));
+	Cache.AddEntry(B, Handles.CreateHandle(2u));
+	Cache.AddEntry(C, Handles.CreateHandle(3u));
+	F_AssertEqual(Cache.GetUsedBytes(), 3 * sizeof(UInt32), "Handles should be sized by their items.");
+
+	// Holding a handle outside of the cache pins its item.
+	THandle<UInt32> Pinned = Cache.GetItemCopy(B);
+
+	Cache.SetBudget(0);
+	F_AssertEqual(Cache.GetItemCount(), 1, "Every unpinned item should be evicted.");
+	F_AssertTrue(Cache.HasItem(B), "Pinned items should never be evicted.");
+	F_AssertEqual(Handles.GetDataSize(), 1, "Evicted handles should release their items.");
+	F_AssertEqual(Cache.GetStats().Evictions, 2, "Evictions are incorrect.");
+	F_AssertEqual(Cache.GetStats().EvictedBytes, 2 * sizeof(UInt32), "Evicted bytes are incorrect.");
+
+	F_AssertEqual(Cache.Trim(), 0, "Trimming should skip pinned items.");
+
+	Pinned.DeInit();
+	F_AssertEqual(Cache.Trim(), 1, "Unpinned items should be evicted by the next trim.");
+	F_AssertEqual(Handles.GetDataSize(), 0, "Every item should be released.");
+	F_AssertEqual(Cache.GetUsedBytes(), 0, "An empty cache should use nothing.");
+}
+
+void FNameTest::NamedHandleRefTests() const
+{
+	THandles<UInt32> Handles;
+	TNamedItemCache<THandle<UInt32>> Cache;
+
+	const FName A("a.pmesh");
+	const FName B("b.pmesh");
+
+	// Until the item is loaded, every resolve looks it up again.
+	TNamedHandleRef<UInt32> Ref;
+	F_AssertTrue(!Ref.Resolve(A, Cache).IsValid(), "Missing items should resolve to an invalid handle.");
+	F_AssertTrue(!Ref.Resolve(A, Cache).IsValid(), "Missing items should resolve to an invalid handle.");
+	F_AssertEqual(Cache.GetStats().Misses, 2, "Misses should be looked up again.");
+
+	Cache.AddEntry(A, Handles.CreateHandle(1u));
+	Cache.AddEntry(B, Handles.CreateHandle(2u));
+	Cache.ResetStats();
+
+	// An instance that's drawn every frame only looks its model up once.
+	for (SizeT I = 0; I < 100; ++I)
+	{
+		F_AssertEqual(*Ref.Resolve(A, Cache), 1u, "The resolved item is incorrect.");
+	}
+
+	F_AssertEqual(Cache.GetStats().Hits, 1, "Resolving the same name should only look it up once.");
+
+	// Holding the resolved handle pins the item in use, however far over budget the cache is.
+	Cache.SetBudget(0);
+	F_AssertTrue(Cache.HasItem(A), "Resolved items should be pinned.");
+	F_AssertTrue(!Cache.HasItem(B), "Unresolved items should be evicted.");
+
+	// A new name is looked up, which unpins the old one.
+	Cache.SetBudget(2 * sizeof(UInt32));
+	Cache.AddEntry(B, Handles.CreateHandle(2u));
+	F_AssertEqual(*Ref.Resolve(B, Cache), 2u, "Changing the name should resolve the new item.");
+	F_AssertEqual(Cache.GetStats().Hits, 2, "Changing the name should look it up.");
+
+	Cache.SetBudget(sizeof(UInt32));
+	F_AssertTrue(!Cache.HasItem(A), "The item that's no longer resolved should be evicted.");
+	F_AssertTrue(Cache.HasItem(B), "Resolved items should be pinned.");
+
+	Ref.Handle.DeInit();
+	Cache.Clear();
+	F_AssertEqual(Handles.GetDataSize(), 0, "Every item should be released.");
+}
+
+void FNameTest::NamedItemCacheBenchmark() const
+{
+	const SizeT ItemCount = 1000;
+	const SizeT LookupCount = 1000000;
+
+	TVector<FString> Strings;
+	TVector<FName> Names;
+
+	TNamedItemCache<UInt32> NameCache;
+	TUnorderedMap<FString, UInt32> StringCache;
+
+	for (SizeT I = 0; I < ItemCount; ++I)
+	{
+		Strings.push_back("Assets/Models/SomeLongishDirectory/Model_" + std::to_string(I) + ".fbx");
+		Names.emplace_back(Strings.back());
+
+		NameCache.AddEntry(Names.back(), static_cast<UInt32>(I));
+		StringCache.emplace(Strings.back(), static_cast<UInt32>(I));
+	}
+
+	UInt64 NameSum = 0;
+	const auto NameStart = std::chrono::high_resolution_clock::now();
+	for (SizeT I = 0; I < LookupCount; ++I)
+	{
+		NameSum += *NameCache.GetItem(Names[I % ItemCount]);
+	}
+	const auto NameEnd = std::chrono::high_resolution_clock::now();
+
+	UInt64 StringSum = 0;
+	const auto StringStart = std::chrono::high_resolution_clock::now();
+	for (SizeT I = 0; I < LookupCount; ++I)
+	{
+		StringSum += StringCache.find(Strings[I % ItemCount])->second;
+	}
+	const auto StringEnd = std::chrono::high_resolution_clock::now();
+
+	F_AssertEqual(NameSum, StringSum, "Both caches should hold the same items.");
+
+	const auto NameMS = std::chrono::duration_cast<std::chrono::milliseconds>(NameEnd - NameStart).count();
+	const auto StringMS = std::chrono::duration_cast<std::chrono::milliseconds>(StringEnd - StringStart).count();
+
+	F_Log("Named item cache lookups (" << LookupCount << "): FName " << NameMS << "ms vs FString: " << StringMS << "ms");
+}
@@ -0,0 +1,28 @@
+#ifndef PHOENIX_NAME_TEST_H
+#define PHOENIX_NAME_TEST_H
+
+namespace Phoenix
+{
+	class FNameTest
+	{
+	public:
+		void RunTests() const;
+
+	private:
+		void TestName() const;
+
+		void NameBasicTests() const;
+		void NameGrowthTests() const;
+		void NameMultiThreadedTests() const;
+
+		void TestNamedItemCache() const;
+
+		void NamedItemCacheBasicTests() const;
+		void NamedItemCacheEvictionTests() const;
+		void NamedItemCachePinningTests() const;
+		void NamedHandleRefTests() const;
+		void NamedItemCacheBenchmark() const;
+	};
+}
+
+#endif
@@ -0,0 +1,1815 @@
+#include "Tests/Rendering/RenderingTest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "Config/GFXCompileConfig.h"
+#include "Utility/Containers/Vector.h"
+#include "Utility/Handle/Handles.h"
+#include "Utility/Debug/Assert.h"
+#include "Utility/Debug/Debug.h"
+#include "Utility/Misc/Name.h"
+#include "Utility/Misc/Primitives.h"
+#include "Utility/Misc/Random.h"
+#include "Utility/Threading/AsyncTaskHandler.h"
+#include "Utility/Threading/Thread.h"
+#include "Math/Bounds.h"
+#include "Math/MatrixTransform.h"
+#include "Platform/Window/HeadlessWindow.h"
+#include "Rendering/Camera.h"
+#include "Rendering/GFXEngine.h"
+#include "Rendering/GFXRenderSync.h"
+#include "Rendering/GFXScene.h"
+#include "Rendering/Caches/AssetRequestTable.h"
+#include "Rendering/Culling/FrustumCuller.h"
+#include "Rendering/GL/GLRecorder.h"
+#include "Rendering/GL/GLTypes.h"
+#include "Rendering/Model/ModelInstance.h"
+#include "Rendering/Queue/InstanceBatcher.h"
+#include "Rendering/Queue/RenderCommandBuffer.h"
+#include "Rendering/Queue/RenderQueue.h"
+#include "Rendering/Queue/RenderStateCache.h"
+#include "Rendering/Queue/SpriteBatcher.h"
+#include "Rendering/Threading/GFXTaskReceiver.h"
+#include "Rendering/Transform/TransformBuilder.h"
+
+using namespace Phoenix;
+
+namespace RenderingTestStructs
+{
+	struct FTestSprite
+	{
+		UInt32 Layer;
+		UInt32 Image;
+		UInt32 Shader;
+	};
+
+	// Sorts the sprites the way the GFX engine does, then batches them.
+	void BatchSprites(FSpriteBatcher& Batcher, const TVector<FTestSprite>& TestSprites)
+	{
+		FRenderQueue RenderQueue;
+		for (SizeT I = 0; I < TestSprites.size(); ++I)
+		{
+			const FTestSprite& TestSprite = TestSprites[I];
+			const UInt64 Key = FRenderQueue::MakeKey(
+				ERenderPass::Transparent,
+				TestSprite.Shader,
+				Batcher.GetTexture(TestSprite.Image),
+				0,
+				TestSprite.Layer);
+
+			RenderQueue.Add(Key, static_cast<UInt32>(I));
+		}
+
+		RenderQueue.Sort();
+
+		Batcher.Clear();
+		for (const FRenderQueueItem& Item : RenderQueue.GetItems())
+		{
+			FSprite Sprite;
+			Sprite.Image = TestSprites[Item.Index].Image;
+			Sprite.Shader = TestSprites[Item.Index].Shader;
+			Batcher.Add(Sprite);
+		}
+	}
+
+	FMatrix4D MakeWorld(const FVector3D& Position, const FQuaternion& Rotation, const FVector3D& Scale)
+	{
+		return glm::translate(FMatrix4D(1.f), Position) * glm::mat4_cast(Rotation) * glm::scale(FMatrix4D(1.f), Scale);
+	}
+
+	// Compares each element, relative to the larger of the two when they're big.
+	bool IsNear(const FVector4D& A, const FVector4D& B)
+	{
+		for (SizeT Row = 0; Row < 4; ++Row)
+		{
+			const Float32 Magnitude = std::max(1.f, std::max(std::abs(A[Row]), std::abs(B[Row])));
+			if (std::abs(A[Row] - B[Row]) > 1e-4f * Magnitude)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool IsNear(const FMatrix4D& A, const FMatrix4D& B)
+	{
+		for (SizeT Column = 0; Column < 4; ++Column)
+		{
+			if (!IsNear(A[Column], B[Column]))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void AddRandomTransforms(FRandom& Random, const SizeT Count, FTransforms& Transforms)
+	{
+		for (SizeT I = 0; I < Count; ++I)
+		{
+			const FVector3D Position(
+				Random.Range(-500.f, 500.f),
+				Random.Range(-500.f, 500.f),
+				Random.Range(-500.f, 500.f));
+
+			const FQuaternion Rotation = glm::normalize(FQuaternion(
+				Random.Range(-1.f, 1.f),
+				Random.Range(-1.f, 1.f),
+				Random.Range(-1.f, 1.f),
+				Random.Range(-1.f, 1.f)));
+
+			const FVector3D Scale(
+				Random.Range(0.1f, 4.f),
+				Random.Range(0.1f, 4.f),
+				Random.Range(0.1f, 4.f));
+
+			Transforms.Add(Position, Rotation, Scale);
+		}
+	}
+
+	FQuaternion GetRotation(const FTransforms& Transforms, const SizeT I)
+	{
+		return FQuaternion(Transforms.RotationW[I], Transforms.RotationX[I], Transforms.RotationY[I], Transforms.RotationZ[I]);
+	}
+}
+
+void FRenderingTest::RunTests() const
+{
+	TestAssetRequests();
+	TestCulling();
+	TestRenderQueue();
+	TestInstancing();
+	TestSprites();
+	TestGLRecorder();
+	TestInterpolation();
+	TestRenderSync();
+	TestTransforms();
+	TestRenderCommands();
+}
+
+void FRenderingTest::TestAssetRequests() const
+{
+	AssetRequestBasicTests();
+	AssetRequestBackoffTests();
+	AssetRequestTaskFailureTests();
+}
+
+void FRenderingTest::AssetRequestBasicTests() const
+{
+	FAssetRequestTable Requests;
+
+	const FName Model("Cube.obj");
+	const FName Image("Cube.png");
+
+	F_AssertEqual(Requests.GetState(Model), EAssetRequest::None, "Unrequested assets should have no state.");
+
+	F_AssertTrue(Requests.BeginRequest(Model, 0.f), "The first request should start a load.");
+	F_AssertEqual(Requests.GetState(Model), EAssetRequest::InFlight, "The load should be in flight.");
+
+	// Every instance of a model misses the cache on the same frame, but only one load should start.
+	for (SizeT I = 0; I < 100; ++I)
+	{
+		F_AssertTrue(!Requests.BeginRequest(Model, 0.f), "Requests for a load in flight should be coalesced.");
+	}
+
+	F_AssertTrue(Requests.BeginRequest(Image, 0.f), "Other assets should load independently.");
+	F_AssertEqual(Requests.GetInFlightCount(), 2, "Two loads should be in flight.");
+
+	Requests.OnSucceeded(Model);
+	F_AssertEqual(Requests.GetState(Model), EAssetRequest::Succeeded, "The load should have succeeded.");
+	F_AssertEqual(Requests.GetInFlightCount(), 1, "One load should be in flight.");
+
+	// A succeeded asset only misses the cache again once it has been evicted.
+	F_AssertTrue(Requests.BeginRequest(Model, 1.f), "Evicted assets should be loaded again.");
+	Requests.OnSucceeded(Model);
+	Requests.OnSucceeded(Image);
+
+	const FAssetRequestStats& Stats = Requests.GetStats();
+	F_AssertEqual(Stats.Started, 3, "Started loads are incorrect.");
+	F_AssertEqual(Stats.Coalesced, 100, "Coalesced requests are incorrect.");
+	F_AssertEqual(Stats.Succeeded, 3, "Succeeded loads are incorrect.");
+	F_AssertEqual(Requests.GetInFlightCount(), 0, "No loads should be in flight.");
+
+	Requests.Clear();
+	F_AssertEqual(Requests.GetState(Model), EAssetRequest::None, "Clearing should forget every asset.");
+}
+
+void FRenderingTest::AssetRequestBackoffTests() const
+{
+	FAssetRequestTable::FInitParams InitParams;
+	InitParams.InitialBackoff = 1.f;
+	InitParams.MaxBackoff = 4.f;
+
+	FAssetRequestTable Requests;
+	Requests.Init(InitParams);
+
+	const FName Model("Missing.obj");
+
+	F_AssertTrue(Requests.BeginRequest(Model, 0.f), "The first request should start a load.");
+	Requests.OnFailed(Model, 0.f);
+	F_AssertEqual(Requests.GetState(Model), EAssetRequest::Failed, "The load should have failed.");
+
+	// A bad file should not be re-read every frame.
+	for (SizeT I = 0; I < 59; ++I)
+	{
+		const Float32 Time = static_cast<Float32>(I) / 60.f;
+		F_AssertTrue(!Requests.BeginRequest(Model, Time), "Failed assets should back off.");
+	}
+
+	F_AssertEqual(Requests.GetStats().Suppressed, 59, "Suppressed requests are incorrect.");
+
+	// The backoff doubles with each failure in a row, up to the max.
+	const Float32 ExpectedBackoffs[] = { 1.f, 2.f, 4.f, 4.f };
+
+	Float32 Time = 0.f;
+	for (const Float32 Backoff : ExpectedBackoffs)
+	{
+		Time += Backoff;
+		F_AssertTrue(!Requests.BeginRequest(Model, Time - 0.01f), "The load should be retried only after the backoff.");
+		F_AssertTrue(Requests.BeginRequest(Model, Time), "The load should be retried after the backoff.");
+		Requests.OnFailed(Model, Time);
+	}
+
+	F_AssertEqual(Requests.GetFailureCount(Model), 5, "Failure count is incorrect.");
+	F_AssertEqual(Requests.GetStats().Failed, 5, "Failed loads are incorrect.");
+
+	// A success resets the backoff.
+	Time += 4.f;
+	F_AssertTrue(Requests.BeginRequest(Model, Time), "The load should be retried after the backoff.");
+	Requests.OnSucceeded(Model);
+	F_AssertEqual(Requests.GetFailureCount(Model), 0, "Succeeding should reset the failure count.");
+
+	F_AssertTrue(Requests.BeginRequest(Model, Time), "Evicted assets should be loaded again.");
+	Requests.OnFailed(Model, Time);
+	F_AssertTrue(!Requests.BeginRequest(Model, Time + 0.5f), "The backoff should start over.");
+	F_AssertTrue(Requests.BeginRequest(Model, Time + 1.f), "The backoff should start over.");
+}
+
+void FRenderingTest::AssetRequestTaskFailureTests() const
+{
+	FAssetRequestTable Requests;
+	FGFXTaskReceiver Receiver;
+	Receiver.Init();
+
+	const FName Model("Golem.pmesh");
+	const FName Image("Golem.png");
+
+	F_AssertTrue(Requests.BeginRequest(Model, 0.f), "The first request should start a load.");
+	F_AssertTrue(Requests.BeginRequest(Image, 0.f), "The first request should start a load.");
+
+	// Laid out like a model load's set.  The model's task is first, so it runs after its textures.
+	SizeT TexturesRun = 0;
+
+	FGFXTaskReceiver::FTasks ModelTasks;
+	ModelTasks.emplace_back([&Requests, &Model]()
+	{
+		Requests.OnSucceeded(Model);
+		return true;
+	});
+
+	ModelTasks.emplace_back([&TexturesRun]()
+	{
+		++TexturesRun;
+		return true;
+	});
+
+	ModelTasks.emplace_back([&TexturesRun]()
+	{
+		++TexturesRun;
+		return false;
+	});
+
+	FGFXTaskReceiver::FTasks ImageTasks;
+	ImageTasks.emplace_back([&Requests, &Image]()
+	{
+		Requests.OnSucceeded(Image);
+		return true;
+	});
+
+	Receiver.ReceiveTasks(std::move(ModelTasks));
+	Receiver.ReceiveTasks(std::move(ImageTasks));
+
+	FGFXTaskReceiver::FTasks Tasks;
+	for (SizeT I = 0; I < 4; ++I)
+	{
+		Receiver.RunNextTask(Tasks);
+	}
+
+	F_AssertEqual(TexturesRun, 2, "Every texture task should run.");
+	F_AssertEqual(Requests.GetState(Model), EAssetRequest::Succeeded, "A failed texture should not drop its model's task.");
+	F_AssertEqual(Requests.GetState(Image), EAssetRequest::Succeeded, "A failed texture should not drop other assets' tasks.");
+	F_AssertEqual(Requests.GetInFlightCount(), 0, "No loads should be left in flight.");
+	F_AssertTrue(Tasks.empty(), "Every task should have run.");
+	F_AssertEqual(Receiver.GetTasksQueueSize(), 0, "Every task set should have been retrieved.");
+}
+
+void FRenderingTest::TestCulling() const
+{
+	BoundsTests();
+	CullingBasicTests();
+	CullingBenchmark();
+}
+
+void FRenderingTest::BoundsTests() const
+{
+	const Float32 Positions[] =
+	{
+		-1.f, 0.f, 0.f,
+		1.f, 0.f, 0.f,
+		0.f, 2.f, 0.f,
+		0.f, 0.f, -4.f,
+	};
+
+	const FBounds Bounds = NBounds::Create(Positions, 4, 3);
+	F_AssertTrue(Bounds.Min == FVector3D(-1.f, 0.f, -4.f), "Min is incorrect.");
+	F_AssertTrue(Bounds.Max == FVector3D(1.f, 2.f, 0.f), "Max is incorrect.");
+	F_AssertTrue(Bounds.Center == FVector3D(0.f, 1.f, -2.f), "Center is incorrect.");
+	F_AssertEqual(Bounds.Radius, std::sqrt(6.f), "The radius should reach the farthest vertex.");
+
+	const Float32 Positions2D[] = { -2.f, -2.f, 2.f, 2.f };
+	const FBounds Bounds2D = NBounds::Create(Positions2D, 2, 2);
+	F_AssertTrue(Bounds2D.Min == FVector3D(-2.f, -2.f, 0.f), "2D positions should have a Z of 0.");
+
+	FBounds Left;
+	Left.Center = FVector3D(-2.f, 0.f, 0.f);
+	Left.Radius = 1.f;
+
+	FBounds Right;
+	Right.Center = FVector3D(2.f, 0.f, 0.f);
+	Right.Radius = 1.f;
+
+	const FBounds Merged = NBounds::Merge(Left, Right);
+	F_AssertTrue(Merged.Center == FVector3D(0.f), "Merged center is incorrect.");
+	F_AssertEqual(Merged.Radius, 3.f, "Merged radius is incorrect.");
+
+	FBounds Inner;
+	Inner.Center = FVector3D(0.5f, 0.f, 0.f);
+	Inner.Radius = 0.5f;
+
+	const FBounds Enclosing = NBounds::Merge(Merged, Inner);
+	F_AssertEqual(Enclosing.Radius, Merged.Radius, "Enclosed bounds should not grow the sphere.");
+}
+
+void FRenderingTest::CullingBasicTests() const
+{
+	FCamera Camera;
+	Camera.SetPerspective(glm::radians(90.f), 1.f, 1.f, 100.f);
+	Camera.SetView(FVector3D(0.f), FVector3D(0.f, 0.f, -1.f), FVector3D(0.f, 1.f, 0.f));
+
+	FFrustum Frustum;
+	Frustum.Init(Camera.GetProjection() * Camera.GetView());
+
+	F_AssertTrue(Frustum.IsVisible(FVector3D(0.f, 0.f, -10.f), 1.f), "Spheres in front should be visible.");
+	F_AssertTrue(!Frustum.IsVisible(FVector3D(0.f, 0.f, 10.f), 1.f), "Spheres behind should be culled.");
+	F_AssertTrue(!Frustum.IsVisible(FVector3D(0.f, 0.f, -200.f), 1.f), "Spheres past the far plane should be culled.");
+	F_AssertTrue(!Frustum.IsVisible(FVector3D(-20.f, 0.f, -10.f), 1.f), "Spheres to the side should be culled.");
+	F_AssertTrue(Frustum.IsVisible(FVector3D(-10.5f, 0.f, -10.f), 1.f), "Spheres straddling a plane should be visible.");
+
+	// Enough spheres for a few SIMD blocks and a scalar tail.
+	FCullSpheres Spheres;
+	for (SizeT I = 0; I < 23; ++I)
+	{
+		const Float32 Z = (I % 2) ? -10.f : 10.f;
+		Spheres.Add(FVector3D(0.f, 0.f, Z), 1.f);
+	}
+
+	FFrustumCuller Culler;
+	TVector<UInt32> Visible;
+	Culler.Cull(Frustum, Spheres, Visible);
+
+	F_AssertEqual(Visible.size(), 11, "Every sphere in front should be visible.");
+	for (SizeT I = 0; I < Visible.size(); ++I)
+	{
+		F_AssertEqual(Visible[I], I * 2 + 1, "Visible indices should be ascending.");
+	}
+
+	F_AssertEqual(Culler.GetStats().Tested, 23, "Tested count is incorrect.");
+	F_AssertEqual(Culler.GetStats().Visible, 11, "Visible count is incorrect.");
+
+	Spheres.Clear();
+	Culler.Cull(Frustum, Spheres, Visible);
+	F_AssertTrue(Visible.empty(), "Nothing should be visible.");
+}
+
+void FRenderingTest::CullingBenchmark() const
+{
+	typedef std::chrono::high_resolution_clock ClockT;
+
+	const SizeT InstanceCount = 100000;
+	const SizeT Iterations = 20;
+
+	FCamera Camera;
+	Camera.SetPerspective(glm::radians(45.f), 16.f / 9.f, 0.1f, 500.f);
+	Camera.SetView(FVector3D(0.f, 0.f, 5.f), FVector3D(0.f), FVector3D(0.f, 1.f, 0.f));
+
+	FFrustum Frustum;
+	Frustum.Init(Camera.GetProjection() * Camera.GetView());
+
+	FRandom Random;
+	FCullSpheres Spheres;
+	Spheres.Reserve(InstanceCount);
+
+	for (SizeT I = 0; I < InstanceCount; ++I)
+	{
+		const FVector3D Center(
+			Random.Range(-500.f, 500.f),
+			Random.Range(-500.f, 500.f),
+			Random.Range(-500.f, 500.f));
+
+		Spheres.Add(Center, Random.Range(0.5f, 5.f));
+	}
+
+	TVector<UInt32> Expected;
+	const auto ScalarStart = ClockT::now();
+	for (SizeT Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		Expected.clear();
+		for (SizeT I = 0; I < InstanceCount; ++I)
+		{
+			const FVector3D Center(Spheres.X[I], Spheres.Y[I], Spheres.Z[I]);
+			if (Frustum.IsVisible(Center, Spheres.Radius[I]))
+			{
+				Expected.push_back(static_cast<UInt32>(I));
+			}
+		}
+	}
+	const auto ScalarEnd = ClockT::now();
+
+	FFrustumCuller Culler;
+	TVector<UInt32> Visible;
+
+	const auto SIMDStart = ClockT::now();
+	for (SizeT Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		Culler.Cull(Frustum, Spheres, Visible);
+	}
+	const auto SIMDEnd = ClockT::now();
+
+	F_AssertTrue(Visible == Expected, "SIMD culling should match the scalar reference.");
+
+	FAsyncTaskHandler TaskHandler;
+	FAsyncTaskHandler::FInitParams InitParams;
+	InitParams.MaxThreadCountHint = NThread::GetHardwareThreadCount();
+	TaskHandler.Init(InitParams);
+	TaskHandler.Run();
+
+	const auto ParallelStart = ClockT::now();
+	for (SizeT Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		Culler.Cull(Frustum, Spheres, Visible, &TaskHandler);
+	}
+	const auto ParallelEnd = ClockT::now();
+
+	F_AssertTrue(Visible == Expected, "Parallel culling should match the scalar reference.");
+	F_AssertTrue(Culler.GetStats().Chunks > 1, "Parallel culling should split the spheres into chunks.");
+
+	TaskHandler.ForceShutDown();
+	while (!TaskHandler.IsShutDown())
+	{
+		NThread::SleepThread(1);
+	}
+
+	const auto ToUS = [Iterations](const ClockT::duration Duration)
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(Duration).count() / static_cast<Int64>(Iterations);
+	};
+
+	F_Log("Frustum culling (" << InstanceCount << " instances, " << Visible.size() << " visible): Scalar "
+		<< ToUS(ScalarEnd - ScalarStart) << "us vs SIMD " << ToUS(SIMDEnd - SIMDStart) << "us vs SIMD on "
+		<< TaskHandler.GetThreadCount() + 1 << " threads " << ToUS(ParallelEnd - ParallelStart) << "us");
+}
+
+void FRenderingTest::TestRenderQueue() const
+{
+	RenderQueueKeyTests();
+	RenderQueueSortTests();
+	RenderQueueBenchmark();
+}
+
+void FRenderingTest::RenderQueueKeyTests() const
+{
+	const UInt32 Near = FRenderQueue::GetDepthBucket(0.1f);
+	const UInt32 Far = FRenderQueue::GetDepthBucket(0.9f);
+
+	F_AssertEqual(FRenderQueue::GetDepthBucket(-1.f), 0, "Depths should be clamped.");
+	F_AssertEqual(FRenderQueue::GetDepthBucket(2.f), FRenderQueue::GetMaxDepthBucket(), "Depths should be clamped.");
+
+	// Opaque draws share state first, then go front to back.
+	const UInt64 OpaqueNear = FRenderQueue::MakeKey(ERenderPass::Opaque, 1, 1, 1, Near);
+	const UInt64 OpaqueFar = FRenderQueue::MakeKey(ERenderPass::Opaque, 1, 1, 1, Far);
+	const UInt64 OpaqueOtherMesh = FRenderQueue::MakeKey(ERenderPass::Opaque, 1, 1, 2, Near);
+	const UInt64 OpaqueOtherTexture = FRenderQueue::MakeKey(ERenderPass::Opaque, 1, 2, 1, Near);
+	const UInt64 OpaqueOtherShader = FRenderQueue::MakeKey(ERenderPass::Opaque, 2, 1, 1, Near);
+
+	F_AssertTrue(OpaqueNear < OpaqueFar, "Opaque draws should go front to back.");
+	F_AssertTrue(OpaqueFar < OpaqueOtherMesh, "Opaque draws should be grouped by mesh before depth.");
+	F_AssertTrue(OpaqueOtherMesh < OpaqueOtherTexture, "Opaque draws should be grouped by texture before mesh.");
+	F_AssertTrue(OpaqueOtherTexture < OpaqueOtherShader, "Opaque draws should be grouped by shader before texture.");
+
+	// Transparent draws go back to front, and only share state within a depth.
+	const UInt64 TransparentNear = FRenderQueue::MakeKey(ERenderPass::Transparent, 1, 1, 1, Near);
+	const UInt64 TransparentFar = FRenderQueue::MakeKey(ERenderPass::Transparent, 2, 2, 2, Far);
+	const UInt64 TransparentFarOtherTexture = FRenderQueue::MakeKey(ERenderPass::Transparent, 2, 3, 2, Far);
+
+	F_AssertTrue(TransparentFar < TransparentNear, "Transparent draws should go back to front.");
+	F_AssertTrue(TransparentFar < TransparentFarOtherTexture, "Transparent draws should be grouped within a depth.");
+	F_AssertTrue(OpaqueOtherShader < TransparentFar, "Opaque draws should come before transparent ones.");
+
+	F_AssertEqual(FRenderQueue::GetPass(OpaqueFar), ERenderPass::Opaque, "Pass is incorrect.");
+	F_AssertEqual(FRenderQueue::GetPass(TransparentNear), ERenderPass::Transparent, "Pass is incorrect.");
+}
+
+void FRenderingTest::RenderQueueSortTests() const
+{
+	FRenderQueue RenderQueue;
+	RenderQueue.Sort();
+	F_AssertEqual(RenderQueue.GetSize(), 0, "Sorting an empty queue should do nothing.");
+
+	FRandom Random;
+	TVector<FRenderQueueItem> Expected;
+
+	for (UInt32 I = 0; I < 5000; ++I)
+	{
+		const ERenderPass::Value Pass = Random.Bool() ? ERenderPass::Opaque : ERenderPass::Transparent;
+		const UInt64 Key = FRenderQueue::MakeKey(
+			Pass,
+			Random.Bounded(4u),
+			Random.Bounded(64u),
+			Random.Bounded(16u),
+			FRenderQueue::GetDepthBucket(Random.UnitFloat()));
+
+		RenderQueue.Add(Key, I, I % 3);
+		Expected.push_back({ Key, I, I % 3 });
+	}
+
+	// Items with equal keys should keep the order they were added in.
+	RenderQueue.Sort();
+	std::stable_sort(Expected.begin(), Expected.end(), [](const FRenderQueueItem& LHS, const FRenderQueueItem& RHS)
+	{
+		return LHS.Key < RHS.Key;
+	});
+
+	const auto& Items = RenderQueue.GetItems();
+	F_AssertEqual(Items.size(), Expected.size(), "Sorting should keep every item.");
+
+	for (SizeT I = 0; I < Items.size(); ++I)
+	{
+		F_AssertEqual(Items[I].Key, Expected[I].Key, "Items are out of order at " << I);
+		F_AssertEqual(Items[I].Index, Expected[I].Index, "The sort should be stable at " << I);
+		F_AssertEqual(Items[I].SubIndex, Expected[I].SubIndex, "Items lost their sub index at " << I);
+	}
+
+	RenderQueue.Clear();
+	F_AssertEqual(RenderQueue.GetSize(), 0, "Clearing should remove every item.");
+}
+
+void FRenderingTest::RenderQueueBenchmark() const
+{
+	typedef std::chrono::high_resolution_clock ClockT;
+
+	const SizeT ItemCount = 100000;
+	const SizeT Iterations = 20;
+
+	FRandom Random;
+	TVector<FRenderQueueItem> Items;
+	Items.reserve(ItemCount);
+
+	for (UInt32 I = 0; I < ItemCount; ++I)
+	{
+		const UInt64 Key = FRenderQueue::MakeKey(
+			ERenderPass::Opaque,
+			Random.Bounded(4u),
+			Random.Bounded(256u),
+			Random.Bounded(64u),
+			FRenderQueue::GetDepthBucket(Random.UnitFloat()));
+
+		Items.push_back({ Key, I, 0 });
+	}
+
+	FRenderQueue RenderQueue;
+	RenderQueue.Reserve(ItemCount);
+
+	const auto RadixStart = ClockT::now();
+	for (SizeT Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		RenderQueue.Clear();
+		for (const FRenderQueueItem& Item : Items)
+		{
+			RenderQueue.Add(Item.Key, Item.Index, Item.SubIndex);
+		}
+
+		RenderQueue.Sort();
+	}
+	const auto RadixEnd = ClockT::now();
+
+	TVector<FRenderQueueItem> Sorted;
+	const auto StdSortStart = ClockT::now();
+	for (SizeT Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		Sorted = Items;
+		std::sort(Sorted.begin(), Sorted.end(), [](const FRenderQueueItem& LHS, const FRenderQueueItem& RHS)
+		{
+			return LHS.Key < RHS.Key;
+		});
+	}
+	const auto StdSortEnd = ClockT::now();
+
+	const auto& RadixItems = RenderQueue.GetItems();
+	for (SizeT I = 0; I < ItemCount; ++I)
+	{
+		F_AssertEqual(RadixItems[I].Key, Sorted[I].Key, "The radix sort disagrees with std::sort at " << I);
+	}
+
+	const auto ToUS = [Iterations](const ClockT::duration Duration)
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(Duration).count() / static_cast<Int64>(Iterations);
+	};
+
+	F_Log("Render queue sort (" << ItemCount << "): Radix " << ToUS(RadixEnd - RadixStart)
+		<< "us vs std::sort " << ToUS(StdSortEnd - StdSortStart) << "us");
+}
+
+void FRenderingTest::TestInstancing() const
+{
+	InstanceBatcherBasicTests();
+	InstanceBatcherDrawCountTests();
+}
+
+void FRenderingTest::InstanceBatcherBasicTests() const
+{
+	FInstanceBatcher Batcher;
+	F_AssertEqual(Batcher.GetBatches().size(), 0, "A new batcher should have no batches.");
+
+	const UInt64 Groups[] = { 7, 7, 7, 3, 3, 7 };
+	for (UInt32 I = 0; I < 6; ++I)
+	{
+		FInstanceData Instance;
+		Instance.WorldViewProjection = FMatrix4D(static_cast<Float32>(I));
+		Instance.Origin = FVector4D(static_cast<Float32>(I));
+
+		Batcher.Add(Groups[I], I, I % 2, Instance);
+	}
+
+	// A group that is interrupted by another starts a new batch.
+	const auto& Batches = Batcher.GetBatches();
+	F_AssertEqual(Batches.size(), 3, "Each run of a group should be one batch.");
+	F_AssertEqual(Batcher.GetInstanceCount(), 6, "Every instance should be kept.");
+
+	F_AssertEqual(Batches[0].Group, 7, "Batch group is incorrect.");
+	F_AssertEqual(Batches[0].FirstInstance, 0, "Batch offset is incorrect.");
+	F_AssertEqual(Batches[0].InstanceCount, 3, "Batch size is incorrect.");
+
+	F_AssertEqual(Batches[1].Group, 3, "Batch group is incorrect.");
+	F_AssertEqual(Batches[1].Index, 3, "A batch should keep its first instance's index.");
+	F_AssertEqual(Batches[1].SubIndex, 1, "A batch should keep its first instance's sub index.");
+	F_AssertEqual(Batches[1].FirstInstance, 3, "Batch offset is incorrect.");
+	F_AssertEqual(Batches[1].InstanceCount, 2, "Batch size is incorrect.");
+
+	F_AssertEqual(Batches[2].FirstInstance, 5, "Batch offset is incorrect.");
+	F_AssertEqual(Batches[2].InstanceCount, 1, "Batch size is incorrect.");
+
+	const auto& Instances = Batcher.GetInstances();
+	for (SizeT I = 0; I < Instances.size(); ++I)
+	{
+		F_AssertEqual(Instances[I].Origin.x, static_cast<Float32>(I), "Instances should keep the order they were added in.");
+	}
+
+	Batcher.Clear();
+	F_AssertEqual(Batcher.GetBatches().size(), 0, "Clearing should remove every batch.");
+	F_AssertEqual(Batcher.GetInstanceCount(), 0, "Clearing should remove every instance.");
+}
+
+void FRenderingTest::InstanceBatcherDrawCountTests() const
+{
+	// Each mesh has its own vertex array and one of a few materials, like the meshes of loaded models.
+	struct FTestMesh
+	{
+		UInt32 VertexArray;
+		UInt32 Material;
+	};
+
+	const TVector<TVector<FTestMesh>> Models =
+	{
+		{ { 1, 10 }, { 2, 11 } },
+		{ { 3, 10 } },
+		{ { 4, 12 }, { 5, 12 }, { 6, 11 } }
+	};
+
+	const UInt32 InstanceCount = 2000;
+	const UInt32 Shader = 1;
+
+	FRandom Random;
+	FRenderQueue RenderQueue;
+	TVector<UInt32> InstanceModels;
+	SizeT MeshDrawCount = 0;
+
+	for (UInt32 I = 0; I < InstanceCount; ++I)
+	{
+		// Bounded's upper bound is inclusive for integers.
+		const UInt32 Model = Random.Bounded(static_cast<UInt32>(Models.size() - 1));
+		const UInt32 DepthBucket = FRenderQueue::GetDepthBucket(Random.UnitFloat());
+		InstanceModels.push_back(Model);
+
+		for (UInt32 M = 0; M < Models[Model].size(); ++M)
+		{
+			const FTestMesh& Mesh = Models[Model][M];
+			RenderQueue.Add(
+				FRenderQueue::MakeKey(ERenderPass::Opaque, Shader, Mesh.Material, Mesh.VertexArray, DepthBucket),
+				I,
+				M);
+
+			++MeshDrawCount;
+		}
+	}
+
+	RenderQueue.Sort();
+
+	FInstanceBatcher Batcher;
+	Batcher.Reserve(RenderQueue.GetSize());
+
+	for (const FRenderQueueItem& Item : RenderQueue.GetItems())
+	{
+		const FTestMesh& Mesh = Models[InstanceModels[Item.Index]][Item.SubIndex];
+		const UInt64 Group = (static_cast<UInt64>(Mesh.Material) << 32) | Mesh.VertexArray;
+
+		FInstanceData Instance;
+		Instance.Origin = FVector4D(static_cast<Float32>(Item.Index));
+		Batcher.Add(Group, Item.Index, Item.SubIndex, Instance);
+	}
+
+	// One instanced draw per mesh, instead of one draw per mesh of every instance.
+	const auto& Batches = Batcher.GetBatches();
+	F_AssertEqual(Batches.size(), 6, "There should be one draw per mesh and material.");
+	F_AssertEqual(Batcher.GetInstanceCount(), MeshDrawCount, "Every mesh draw should become an instance.");
+
+	UInt32 NextInstance = 0;
+	for (const FInstanceBatch& Batch : Batches)
+	{
+		F_AssertEqual(Batch.FirstInstance, NextInstance, "Batches should be packed contiguously.");
+		NextInstance += Batch.InstanceCount;
+
+		const FTestMesh& BatchMesh = Models[InstanceModels[Batch.Index]][Batch.SubIndex];
+		for (UInt32 I = Batch.FirstInstance; I < NextInstance; ++I)
+		{
+			const UInt32 Index = static_cast<UInt32>(Batcher.GetInstances()[I].Origin.x);
+			const bool bHasMesh = std::any_of(Models[InstanceModels[Index]].begin(), Models[InstanceModels[Index]].end(),
+				[&BatchMesh](const FTestMesh& Mesh)
+			{
+				return Mesh.VertexArray == BatchMesh.VertexArray;
+			});
+
+			F_AssertTrue(bHasMesh, "Instance " << I << " doesn't use its batch's mesh.");
+		}
+	}
+
+	F_Log("Instancing (" << InstanceCount << " models): " << MeshDrawCount << " draws became " << Batches.size());
+}
+
+void FRenderingTest::TestSprites() const
+{
+	SpriteVertexTests();
+	SpriteBatchCountTests();
+}
+
+void FRenderingTest::SpriteVertexTests() const
+{
+	FSpriteBatcher Batcher;
+
+	FSprite Sprite;
+	Sprite.Position = FVector2D(100.f, 50.f);
+	Sprite.HalfSize = FVector2D(20.f, 10.f);
+	Sprite.Color = FVector4D(1.f, 0.f, 0.f, 0.5f);
+	Sprite.ViewRect = FVector4D(0.5f, 0.25f, 0.5f, 0.5f);
+	Sprite.Image = 1;
+
+	Batcher.Add(Sprite);
+
+	const auto& Vertices = Batcher.GetVertices();
+	F_AssertEqual(Vertices.size(), FSpriteBatcher::VerticesPerSprite, "A sprite should be two triangles.");
+	F_AssertEqual(Batcher.GetSpriteCount(), 1, "Sprite count is incorrect.");
+
+	// The first vertex is the bottom left corner and the third is the top right one.
+	F_AssertTrue(Vertices[0].Position == FVector2D(90.f, 45.f), "A view rect should shrink the sprite.");
+	F_AssertTrue(Vertices[2].Position == FVector2D(110.f, 55.f), "A view rect should shrink the sprite.");
+	F_AssertTrue(Vertices[0].TexCoord == FVector2D(0.5f, 0.25f), "Texture coordinates should start at the view rect.");
+	F_AssertTrue(Vertices[2].TexCoord == FVector2D(1.f, 0.75f), "Texture coordinates should end at the view rect.");
+	F_AssertTrue(Vertices[5].Color == Sprite.Color, "Every vertex should have the sprite's color.");
+
+	// Flipping mirrors within the view rect.
+	Sprite.Flip = FVector2D(-1.f, 1.f);
+	Batcher.Add(Sprite);
+
+	F_AssertTrue(Vertices[6].TexCoord == FVector2D(1.f, 0.25f), "Flipping should mirror within the view rect.");
+	F_AssertTrue(Vertices[8].TexCoord == FVector2D(0.5f, 0.75f), "Flipping should mirror within the view rect.");
+
+	// An atlas region remaps the view rect into the atlas.
+	FSpriteAtlasRegion Region;
+	Region.Texture = 9;
+	Region.Rect = FVector4D(0.5f, 0.f, 0.5f, 0.5f);
+	Batcher.SetAtlasRegion(1, Region);
+
+	Batcher.Clear();
+	Sprite.Flip = FVector2D(1.f, 1.f);
+	Batcher.Add(Sprite);
+
+	F_AssertEqual(Batcher.GetBatches()[0].Texture, 9, "Atlas images should be drawn with the atlas texture.");
+	F_AssertTrue(Vertices[0].TexCoord == FVector2D(0.75f, 0.125f), "View rects should be relative to the atlas region.");
+	F_AssertTrue(Vertices[2].TexCoord == FVector2D(1.f, 0.375f), "View rects should be relative to the atlas region.");
+
+	Batcher.RemoveAtlasRegion(1);
+	F_AssertEqual(Batcher.GetTexture(1), 1, "Removed atlas regions should no longer be used.");
+}
+
+void FRenderingTest::SpriteBatchCountTests() const
+{
+	using namespace RenderingTestStructs;
+
+	FSpriteBatcher Batcher;
+
+	// Layers are sorted back to front and textures are grouped within each layer, so
+	// this is drawn as A A | B B B C, and B stays batched across its layers.
+	const TVector<FTestSprite> Sprites =
+	{
+		{ 2, 10, 1 }, { 2, 11, 1 }, { 2, 10, 1 },
+		{ 1, 11, 1 },
+		{ 0, 12, 1 }, { 0, 11, 1 }
+	};
+
+	BatchSprites(Batcher, Sprites);
+	F_AssertEqual(Batcher.GetSpriteCount(), Sprites.size(), "Every sprite should be drawn.");
+	F_AssertEqual(Batcher.GetBatches().size(), 3, "Only texture changes should break batches.");
+
+	UInt32 NextVertex = 0;
+	for (const FSpriteBatch& Batch : Batcher.GetBatches())
+	{
+		F_AssertEqual(Batch.FirstVertex, NextVertex, "Batches should be packed contiguously.");
+		NextVertex += Batch.VertexCount;
+	}
+
+	// A texture that's interleaved with another across layers can't be merged.
+	const TVector<FTestSprite> Interleaved =
+	{
+		{ 3, 10, 1 }, { 2, 11, 1 }, { 1, 10, 1 }, { 0, 11, 1 }
+	};
+
+	BatchSprites(Batcher, Interleaved);
+	F_AssertEqual(Batcher.GetBatches().size(), 4, "Layer order should be kept over batching.");
+
+	// A shader change breaks a batch even if the texture is the same.
+	const TVector<FTestSprite> MixedShaders =
+	{
+		{ 1, 10, 1 }, { 0, 10, 2 }
+	};
+
+	BatchSprites(Batcher, MixedShaders);
+	F_AssertEqual(Batcher.GetBatches().size(), 2, "Shader changes should break batches.");
+
+	// Once every image is in one atlas, everything is one draw.
+	for (UInt32 Image = 10; Image <= 12; ++Image)
+	{
+		FSpriteAtlasRegion Region;
+		Region.Texture = 99;
+		Region.Rect = FVector4D(static_cast<Float32>(Image - 10) / 3.f, 0.f, 1.f / 3.f, 1.f);
+		Batcher.SetAtlasRegion(Image, Region);
+	}
+
+	BatchSprites(Batcher, Sprites);
+	F_AssertEqual(Batcher.GetBatches().size(), 1, "Atlased sprites should merge into one draw.");
+
+	BatchSprites(Batcher, Interleaved);
+	F_AssertEqual(Batcher.GetBatches().size(), 1, "Atlased sprites should merge across layers.");
+
+	Batcher.ClearAtlasRegions();
+	BatchSprites(Batcher, Interleaved);
+	F_AssertEqual(Batcher.GetBatches().size(), 4, "Clearing the atlas regions should restore the textures.");
+}
+
+void FRenderingTest::TestGLRecorder() const
+{
+	GLRecorderBindTests();
+	GLRecorderFrameTests();
+	HeadlessWindowTests();
+	GFXEngineRecordingTests();
+}
+
+void FRenderingTest::GLRecorderBindTests() const
+{
+	FGLRecorder Recorder;
+
+	const UInt32 BufferA = Recorder.CreateObject(GL::EBuffer::Array);
+	const UInt32 BufferB = Recorder.CreateObject(GL::EBuffer::Array);
+	F_AssertTrue(BufferA != 0 && BufferB != 0, "Fake IDs should never be 0.");
+	F_AssertTrue(BufferA != BufferB, "Fake IDs should be unique.");
+
+	Recorder.Bind(EGLCommand::BindBuffer, GL::EBuffer::Array, BufferA);
+	Recorder.Bind(EGLCommand::BindBuffer, GL::EBuffer::Array, BufferA);
+	Recorder.Bind(EGLCommand::BindBuffer, GL::EBuffer::ElementArray, BufferA);
+	Recorder.Bind(EGLCommand::BindBuffer, GL::EBuffer::Array, BufferB);
+
+	F_AssertEqual(Recorder.GetFrameCounts().Binds, 4, "Every bind should be counted.");
+	F_AssertEqual(Recorder.GetFrameCounts().RedundantBinds, 1, "Only rebinding to the same target is redundant.");
+
+	// Texture binds are tracked per texture unit.
+	Recorder.SetActiveTexture(GL::ETex::T0);
+	Recorder.Bind(EGLCommand::BindTexture, GL::ETexTarget::T2D, 5);
+	Recorder.SetActiveTexture(GL::ETex::T1);
+	Recorder.Bind(EGLCommand::BindTexture, GL::ETexTarget::T2D, 5);
+	Recorder.Bind(EGLCommand::BindTexture, GL::ETexTarget::T2D, 5);
+
+	F_AssertEqual(Recorder.GetFrameCounts().RedundantBinds, 2, "Texture units should be tracked separately.");
+
+	// Binding a vertex array replaces the element array buffer binding.
+	Recorder.Bind(EGLCommand::BindVertexArray, 0, 7);
+	Recorder.Bind(EGLCommand::BindBuffer, GL::EBuffer::ElementArray, BufferA);
+	Recorder.Bind(EGLCommand::UseProgram, 0, 3);
+	Recorder.Bind(EGLCommand::UseProgram, 0, 3);
+
+	F_AssertEqual(Recorder.GetFrameCounts().RedundantBinds, 3, "Vertex array binds should reset the element array buffer.");
+
+	F_AssertEqual(Recorder.GetUniformLocation("WVP"), Recorder.GetUniformLocation("WVP"), "Uniform locations should be stable.");
+	F_AssertTrue(Recorder.GetUniformLocation("WVP") != Recorder.GetUniformLocation("World"), "Uniform locations should be unique.");
+
+	Recorder.Reset();
+	F_AssertEqual(Recorder.GetFrameCounts().Binds, 0, "Reset should clear the counts.");
+	F_AssertEqual(Recorder.CreateObject(GL::EBuffer::Array), 1, "Reset should restart the IDs.");
+}
+
+void FRenderingTest::GLRecorderFrameTests() const
+{
+	FGLRecorder Recorder;
+
+	FGLCommand Upload;
+	Upload.Type = EGLCommand::BufferUpload;
+	Upload.Bytes = 256;
+	Recorder.Record(Upload);
+	Recorder.Record(Upload);
+
+	FGLCommand TextureUpload;
+	TextureUpload.Type = EGLCommand::TextureUpload;
+	TextureUpload.Bytes = 64 * 64 * 4;
+	Recorder.Record(TextureUpload);
+
+	FGLCommand Draw;
+	Draw.Type = EGLCommand::Draw;
+	Draw.Count = 36;
+	Draw.InstanceCount = 10;
+	Recorder.Record(Draw);
+
+	Draw.InstanceCount = 1;
+	Recorder.Record(Draw);
+
+	const FGLFrameCounts& Counts = Recorder.GetFrameCounts();
+	F_AssertEqual(Counts.Commands, 5, "Every command should be counted.");
+	F_AssertEqual(Counts.BufferUploadBytes, 512, "Buffer upload bytes are incorrect.");
+	F_AssertEqual(Counts.TextureUploadBytes, 64 * 64 * 4, "Texture upload bytes are incorrect.");
+	F_AssertEqual(Counts.DrawCalls, 2, "Draw call count is incorrect.");
+	F_AssertEqual(Counts.Instances, 11, "Instance count is incorrect.");
+	F_AssertEqual(Recorder.GetCommands().size(), 5, "Commands should be kept by default.");
+	F_AssertTrue(Recorder.GetCommands()[3].Type == EGLCommand::Draw, "Commands should be kept in order.");
+
+	Recorder.EndFrame();
+	F_AssertEqual(Recorder.GetFrameCount(), 1, "Frame count is incorrect.");
+	F_AssertEqual(Recorder.GetLastFrameCounts().DrawCalls, 2, "Ending a frame should keep its counts.");
+	F_AssertEqual(Recorder.GetLastFrameCommands().size(), 5, "Ending a frame should keep its commands.");
+	F_AssertEqual(Recorder.GetFrameCounts().Commands, 0, "Ending a frame should restart the counts.");
+	F_AssertTrue(Recorder.GetCommands().empty(), "Ending a frame should restart the commands.");
+
+	Recorder.SetKeepCommands(false);
+	Recorder.Record(Draw);
+	F_AssertEqual(Recorder.GetFrameCounts().DrawCalls, 1, "Commands should still be counted when they aren't kept.");
+	F_AssertTrue(Recorder.GetCommands().empty(), "Commands shouldn't be kept.");
+}
+
+void FRenderingTest::HeadlessWindowTests() const
+{
+	FHeadlessWindow Window(1280, 720, "Headless");
+	F_AssertTrue(Window.GetDimensions() == FVector2D(1280, 720), "The window should keep its dimensions.");
+	F_AssertEqual(Window.GetWindowTitle(), "Headless", "The window should keep its title.");
+	F_AssertEqual(Window.GetRefreshRate(), 0, "Without a display there should be no refresh rate.");
+
+	// The GFX engine's start up and per frame window calls must all be safe without a context.
+	Window.SetGraphicsContextCurrent();
+	Window.SetSwapInterval(1);
+	Window.Show();
+	Window.BufferSwap();
+	Window.ProcessEvents();
+
+	Window.SetDimensions(FVector2D(640, 360));
+	F_AssertTrue(Window.GetDimensions() == FVector2D(640, 360), "Resizing should update the dimensions.");
+}
+
+void FRenderingTest::GFXEngineRecordingTests() const
+{
+#if PHOENIX_GFX_USE_RECORDING_GL && !PHOENIX_GFX_ENABLE_MULTI_THREADED_RENDERING
+	// Rendering runs on this thread, so the recorder's counts can be read as soon as Draw returns.
+	FGLRecorder& Recorder = FGLRecorder::Get();
+	Recorder.Reset();
+
+	FHeadlessWindow Window(640, 360, "GFX Engine Recording");
+
+	FGFXEngine::FInitParams InitParams;
+	InitParams.Window = &Window;
+
+	FGFXEngine Engine;
+	Engine.Init(InitParams);
+	F_AssertTrue(Engine.IsValid(), "The GFX engine should initialize without a context.");
+
+	const UInt32 ImageCount = 3;
+	const UInt32 ImageWidth = 200;
+	const UInt32 ImageHeight = 150;
+
+	TVector<TThreadSafeHandle<FImageInstance>> Images;
+	for (UInt32 I = 0; I < ImageCount; ++I)
+	{
+		Images.push_back(Engine.GetScene().CreateImage("AlphaTest_200x150.png"));
+		Images.back()->SetPosition(ImageWidth * static_cast<Float32>(I), 0.f);
+	}
+
+	// The image loads asynchronously, so draw until every sprite has made it into a frame.
+	const UInt32 MaxLoadFrames = 1000;
+	UInt32 LoadFrames = 0;
+	SizeT TextureUploadBytes = 0;
+
+	while (Engine.GetRenderStats().Sprites < ImageCount && LoadFrames < MaxLoadFrames)
+	{
+		Engine.SetUpNextRender();
+		Engine.Draw(1.f);
+		TextureUploadBytes += Recorder.GetLastFrameCounts().TextureUploadBytes;
+
+		NThread::SleepThread(1);
+		++LoadFrames;
+	}
+
+	F_AssertEqual(Engine.GetRenderStats().Sprites, ImageCount, "Every image should be drawn once it has loaded.");
+	F_AssertEqual(TextureUploadBytes, ImageWidth * ImageHeight * 4, "The shared texture should be uploaded exactly once.");
+
+	const UInt32 SteadyFrames = 4;
+	const SizeT SpriteBytes = ImageCount * FSpriteBatcher::VerticesPerSprite * sizeof(FSpriteVertex);
+
+	FGLFrameCounts FirstCounts;
+	for (UInt32 I = 0; I < SteadyFrames; ++I)
+	{
+		Engine.SetUpNextRender();
+		Engine.Draw(1.f);
+
+		const FGLFrameCounts& Counts = Recorder.GetLastFrameCounts();
+		if (I == 0)
+		{
+			FirstCounts = Counts;
+		}
+
+		// The images share a texture, so they batch into one sprite draw after the deferred pass's full screen quad.
+		F_AssertEqual(Counts.DrawCalls, 2, "A frame of same texture sprites should take two draw calls.");
+		F_AssertEqual(Counts.Instances, 2, "Each draw call should draw a single instance.");
+		F_AssertEqual(Counts.TextureUploadBytes, 0, "A loaded texture shouldn't be uploaded again.");
+		F_AssertEqual(Counts.BufferUploadBytes, SpriteBytes, "Only the sprites' vertices should be uploaded each frame.");
+		F_AssertEqual(Counts.Binds, FirstCounts.Binds, "An unchanged scene should bind the same amount each frame.");
+		F_AssertEqual(Counts.RedundantBinds, FirstCounts.RedundantBinds, "Redundant binds shouldn't grow between frames.");
+		F_AssertTrue(Counts.RedundantBinds <= 1, "The state cache should filter all but the frame's first rebind.");
+	}
+
+	F_Log("GFX engine recorded frame: " << FirstCounts.DrawCalls << " draw calls, " << FirstCounts.Binds << " binds ("
+		<< FirstCounts.RedundantBinds << " redundant), " << FirstCounts.BufferUploadBytes << " buffer bytes after "
+		<< LoadFrames << " load frames.");
+
+	Images.clear();
+	Engine.ForceShutDown();
+	F_AssertTrue(Engine.IsShutDown(), "The GFX engine should shut down cleanly without a context.");
+#else
+	F_Log("Skipping the GFX engine recording tests, they need a recording build without multi-threaded rendering.");
+#endif
+}
+
+void FRenderingTest::TestInterpolation() const
+{
+	InterpolationTests();
+	NullSceneFrameTests();
+}
+
+void FRenderingTest::InterpolationTests() const
+{
+	using namespace RenderingTestStructs;
+
+	FGFXScene Scene;
+	Scene.Init();
+
+	TThreadSafeHandle<FModelInstance> Model = Scene.CreateModel("golem.pmesh");
+	TThreadSafeHandle<FImageInstance> Image = Scene.CreateImage("golem.png");
+
+	const FVector3D StartPosition(0.f, 2.f, -4.f);
+	const FVector3D EndPosition(10.f, -2.f, 4.f);
+	const Float32 QuarterTurn = 1.5707964f;
+	const FQuaternion StartRotation = glm::angleAxis(0.f, FVector3D(0.f, 1.f, 0.f));
+	const FQuaternion EndRotation = glm::angleAxis(QuarterTurn, FVector3D(0.f, 1.f, 0.f));
+
+	Model->SetPosition(StartPosition);
+	Model->SetRotation(StartRotation);
+	Image->SetPosition(FVector2D(StartPosition));
+
+	F_AssertTrue(Model->GetInterpolatedPosition(0.5f) == StartPosition, "Before the first step the current transform should be drawn.");
+
+	// The first tick stores the transforms set at creation and then moves the instances.
+	Scene.StorePreviousTransforms();
+	Model->SetPosition(EndPosition);
+	Model->SetRotation(EndRotation);
+	Model->SetScale(FVector3D(3.f));
+	Image->SetPosition(FVector2D(EndPosition));
+
+	const Float32 Progresses[] = { 0.f, 0.25f, 0.5f, 1.f };
+	for (const Float32 Progress : Progresses)
+	{
+		const FVector3D ExpectedPosition = StartPosition + (EndPosition - StartPosition) * Progress;
+		const FVector3D ExpectedScale(1.f + 2.f * Progress);
+		const FQuaternion ExpectedRotation = glm::angleAxis(QuarterTurn * Progress, FVector3D(0.f, 1.f, 0.f));
+
+		F_AssertTrue(IsNear(FVector4D(Model->GetInterpolatedPosition(Progress), 0.f), FVector4D(ExpectedPosition, 0.f)),
+			"Position should be blended by the frame progress " << Progress);
+		F_AssertTrue(IsNear(FVector4D(Model->GetInterpolatedScale(Progress), 0.f), FVector4D(ExpectedScale, 0.f)),
+			"Scale should be blended by the frame progress " << Progress);
+
+		// The rotation is compared as a matrix since q and -q are the same rotation.
+		F_AssertTrue(IsNear(glm::mat4_cast(Model->GetInterpolatedRotation(Progress)), glm::mat4_cast(ExpectedRotation)),
+			"Rotation should be blended by the frame progress " << Progress);
+
+		const FVector2D ImagePosition = Image->GetInterpolatedPosition(Progress);
+		F_AssertTrue(IsNear(FVector4D(ImagePosition, 0.f, 0.f), FVector4D(FVector2D(ExpectedPosition), 0.f, 0.f)),
+			"Image position should be blended by the frame progress " << Progress);
+	}
+
+	// The next tick starts from where the last one ended, so an instance that stops moving holds still.
+	Scene.StorePreviousTransforms();
+	F_AssertTrue(IsNear(FVector4D(Model->GetInterpolatedPosition(0.5f), 0.f), FVector4D(EndPosition, 0.f)),
+		"A model that didn't move during the step shouldn't be blended.");
+
+	Image.DeInit();
+	Model.DeInit();
+	Scene.DeInit();
+}
+
+void FRenderingTest::NullSceneFrameTests() const
+{
+	const SizeT EntityCount = 64;
+	const UInt32 FrameCount = 5;
+
+	// Runs the scene side of headless frames: every step stores the previous transforms
+	// and then moves each entity by its own amount.
+	FGFXScene Scene;
+	Scene.Init(EGFXSceneType::Null);
+	F_AssertTrue(Scene.IsValid(), "Null scene should be valid.");
+
+	TVector<TThreadSafeHandle<FModelInstance>> Models;
+	TVector<TThreadSafeHandle<FImageInstance>> Images;
+
+	Scene.CreateModels(EntityCount / 2, "golem.pmesh", Models);
+	for (SizeT I = Models.size(); I < EntityCount; ++I)
+	{
+		Models.push_back(Scene.CreateModel("golem.pmesh"));
+		Images.push_back(Scene.CreateImage("golem.png"));
+	}
+
+	F_AssertEqual(Scene.GetModelInstances().GetDataSize(), EntityCount, "Every entity should get its own model instance.");
+	F_AssertEqual(Scene.GetImageInstances().GetDataSize(), EntityCount / 2, "Every entity should get its own image instance.");
+
+	for (UInt32 Frame = 1; Frame <= FrameCount; ++Frame)
+	{
+		Scene.StorePreviousTransforms();
+
+		for (SizeT I = 0; I < EntityCount; ++I)
+		{
+			Models[I]->SetPosition(FVector3D(static_cast<Float32>(I * Frame)));
+		}
+
+		for (SizeT I = 0; I < Images.size(); ++I)
+		{
+			Images[I]->SetPosition(FVector2D(static_cast<Float32>(I * Frame)));
+		}
+	}
+
+	bool IsEachMoved = true;
+	bool IsEachInterpolated = true;
+
+	for (SizeT I = 0; I < EntityCount; ++I)
+	{
+		const Float32 Last = static_cast<Float32>(I * FrameCount);
+		const Float32 Previous = static_cast<Float32>(I * (FrameCount - 1));
+
+		IsEachMoved &= Models[I]->GetPosition() == FVector3D(Last);
+		IsEachInterpolated &= Models[I]->GetInterpolatedPosition(0.5f) == FVector3D((Last + Previous) * 0.5f);
+	}
+
+	for (SizeT I = 0; I < Images.size(); ++I)
+	{
+		IsEachMoved &= Images[I]->GetPosition() == FVector2D(static_cast<Float32>(I * FrameCount));
+	}
+
+	F_AssertTrue(IsEachMoved, "Every entity should keep its own transform.");
+	F_AssertTrue(IsEachInterpolated, "Every entity should interpolate between its own steps.");
+
+	for (TThreadSafeHandle<FModelInstance>& Model : Models)
+	{
+		Model.DeInit();
+	}
+
+	for (TThreadSafeHandle<FImageInstance>& Image : Images)
+	{
+		Image.DeInit();
+	}
+
+	F_AssertEqual(Scene.GetModelInstances().GetDataSize(), 0, "Released instances should be freed.");
+	Scene.DeInit();
+}
+
+void FRenderingTest::TestRenderSync() const
+{
+	RenderSyncBasicTests();
+	RenderSyncBenchmark();
+}
+
+void FRenderingTest::RenderSyncBasicTests() const
+{
+	const SizeT InstanceCount = 100;
+
+	FModelInstances Instances;
+	TVector<TThreadSafeHandle<FModelInstance>> Handles;
+	Instances.EmplaceHandles(InstanceCount, [](FModelInstance& Instance, const SizeT Index)
+	{
+		Instance.SetPosition(FVector3D(static_cast<Float32>(Index)));
+	}, Handles);
+
+	FModelRenderSync Sync;
+	TVector<FModelInstance> CopyA;
+	TVector<FModelInstance> CopyB;
+	FRenderSyncTarget TargetA;
+	FRenderSyncTarget TargetB;
+
+	Sync.Collect(Instances);
+	FRenderSyncStats Stats = Sync.Sync(Instances, CopyA, TargetA);
+	F_AssertEqual(Stats.Items, InstanceCount, "The first sync should copy every instance.");
+	F_AssertTrue(Stats.WasFullCopy, "The first sync should be a full copy.");
+	F_AssertEqual(CopyA.size(), InstanceCount, "The copy should match the instances' size.");
+
+	// Nothing changed, so there's nothing to copy.
+	Sync.Collect(Instances);
+	Stats = Sync.Sync(Instances, CopyA, TargetA);
+	F_AssertEqual(Stats.Items, 0, "Clean instances shouldn't be copied.");
+
+	// Changes are copied in contiguous runs.
+	Handles[10]->SetPosition(FVector3D(-1.f));
+	Handles[11]->SetPosition(FVector3D(-2.f));
+	Handles[50]->SetPosition(FVector3D(-3.f));
+
+	Sync.Collect(Instances);
+	Stats = Sync.Sync(Instances, CopyA, TargetA);
+	F_AssertEqual(Stats.Items, 3, "Only the changed instances should be copied.");
+	F_AssertEqual(Stats.Ranges, 2, "Adjacent changes should be copied together.");
+	F_AssertEqual(Stats.Bytes, 3 * sizeof(FModelInstance), "Copied bytes are incorrect.");
+	F_AssertTrue(CopyA[11].GetPosition() == FVector3D(-2.f), "The copy should see the change.");
+
+	// A copy that lags behind picks up every change since its own last sync.
+	Sync.Collect(Instances);
+	Stats = Sync.Sync(Instances, CopyB, TargetB);
+	F_AssertEqual(Stats.Items, InstanceCount, "A new copy should copy every instance.");
+
+	Handles[20]->SetPosition(FVector3D(-4.f));
+	Sync.Collect(Instances);
+	Sync.Sync(Instances, CopyA, TargetA);
+
+	Handles[30]->SetPosition(FVector3D(-5.f));
+	Sync.Collect(Instances);
+	Stats = Sync.Sync(Instances, CopyB, TargetB);
+	F_AssertEqual(Stats.Items, 2, "A lagging copy should get every change it missed.");
+	F_AssertTrue(CopyB[20].GetPosition() == FVector3D(-4.f), "A lagging copy should get every change it missed.");
+
+	// A model that moved is copied once more after its previous transform is stored.
+	Instances.ForEachDense([](const FModelInstances::SpanT& Span)
+	{
+		for (FModelInstance& Instance : Span)
+		{
+			Instance.StorePreviousTransform();
+		}
+	});
+
+	Sync.Collect(Instances);
+	Stats = Sync.Sync(Instances, CopyA, TargetA);
+	F_AssertEqual(Stats.Items, InstanceCount, "Storing the first previous transform should change every instance.");
+
+	Handles[40]->SetPosition(FVector3D(-6.f));
+	Instances.ForEachDense([](const FModelInstances::SpanT& Span)
+	{
+		for (FModelInstance& Instance : Span)
+		{
+			Instance.StorePreviousTransform();
+		}
+	});
+
+	Sync.Collect(Instances);
+	Stats = Sync.Sync(Instances, CopyA, TargetA);
+	F_AssertEqual(Stats.Items, 1, "Only instances that moved should change when previous transforms are stored.");
+
+	// Releasing moves the last instance, so every copy has to be redone.
+	Handles[0].DeInit();
+	Handles.erase(Handles.begin());
+
+	Sync.Collect(Instances);
+	Stats = Sync.Sync(Instances, CopyA, TargetA);
+	F_AssertTrue(Stats.WasFullCopy, "A release should force a full copy.");
+	F_AssertEqual(CopyA.size(), InstanceCount - 1, "The copy should shrink with the instances.");
+
+	for (SizeT I = 0; I < CopyA.size(); ++I)
+	{
+		F_AssertTrue(CopyA[I].GetPosition() == Instances[I].GetPosition(), "The copy should match the instances.");
+	}
+
+	// New instances are dirty, so growing patches the copy.
+	Instances.EmplaceHandles(10, [](FModelInstance&, const SizeT) {}, Handles);
+
+	Sync.Collect(Instances);
+	Stats = Sync.Sync(Instances, CopyA, TargetA);
+	F_AssertTrue(!Stats.WasFullCopy, "Creating instances shouldn't force a full copy.");
+	F_AssertEqual(Stats.Items, 10, "Only the new instances should be copied.");
+	F_AssertEqual(CopyA.size(), InstanceCount + 9, "The copy should grow with the instances.");
+}
+
+void FRenderingTest::RenderSyncBenchmark() const
+{
+	typedef std::chrono::high_resolution_clock ClockT;
+
+	const SizeT InstanceCount = 10000;
+	const SizeT MovingCount = InstanceCount / 100;
+	const SizeT Iterations = 200;
+
+	FModelInstances Instances;
+	TVector<TThreadSafeHandle<FModelInstance>> Handles;
+	Instances.EmplaceHandles(InstanceCount, [](FModelInstance& Instance, const SizeT Index)
+	{
+		Instance.SetModel("golem.pmesh");
+		Instance.SetPosition(FVector3D(static_cast<Float32>(Index)));
+	}, Handles);
+
+	// The handoff before render syncs: every instance was copied every time.
+	TVector<FModelInstance> FullCopy;
+	const auto FullStart = ClockT::now();
+	for (SizeT Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		FullCopy.assign(Instances.GetData().begin(), Instances.GetData().end());
+	}
+	const auto FullEnd = ClockT::now();
+
+	// Three copies, like the render data's triple buffer, with 1% of the instances
+	// moving between handoffs.
+	FModelRenderSync Sync;
+	TVector<FModelInstance> Copies[3];
+	FRenderSyncTarget Targets[3];
+
+	for (SizeT I = 0; I < 3; ++I)
+	{
+		Sync.Collect(Instances);
+		Sync.Sync(Instances, Copies[I], Targets[I]);
+	}
+
+	FRandom Random;
+	UInt64 SyncedBytes = 0;
+
+	const auto SyncStart = ClockT::now();
+	for (SizeT Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (SizeT I = 0; I < MovingCount; ++I)
+		{
+			// Bounded is inclusive.
+			const SizeT Index = Random.Bounded(InstanceCount - 1);
+			Handles[Index]->SetPosition(FVector3D(static_cast<Float32>(Iteration)));
+		}
+
+		Sync.Collect(Instances);
+
+		const SizeT CopyIndex = Iteration % 3;
+		SyncedBytes += Sync.Sync(Instances, Copies[CopyIndex], Targets[CopyIndex]).Bytes;
+	}
+	const auto SyncEnd = ClockT::now();
+
+	for (SizeT I = 0; I < InstanceCount; ++I)
+	{
+		const SizeT LastCopyIndex = (Iterations - 1) % 3;
+		F_AssertTrue(Copies[LastCopyIndex][I].GetPosition() == Instances[I].GetPosition(), "The synced copy should match the instances.");
+	}
+
+	const auto ToUS = [Iterations](const ClockT::duration Duration)
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(Duration).count() / static_cast<Int64>(Iterations);
+	};
+
+	F_Log("Render handoff (" << InstanceCount << " models, " << MovingCount << " moving): Full copy "
+		<< ToUS(FullEnd - FullStart) << "us, " << InstanceCount * sizeof(FModelInstance) << " bytes vs Synced "
+		<< ToUS(SyncEnd - SyncStart) << "us, " << SyncedBytes / Iterations << " bytes");
+}
+
+void FRenderingTest::TestTransforms() const
+{
+	TransformBuilderBasicTests();
+	TransformBuilderBenchmark();
+}
+
+void FRenderingTest::TransformBuilderBasicTests() const
+{
+	using namespace RenderingTestStructs;
+
+	FCamera Camera;
+	Camera.SetPerspective(glm::radians(45.f), 16.f / 9.f, 0.1f, 500.f);
+	Camera.SetView(FVector3D(0.f, 0.f, 5.f), FVector3D(0.f), FVector3D(0.f, 1.f, 0.f));
+	const FMatrix4D ViewProjection = Camera.GetProjection() * Camera.GetView();
+
+	FTransformBuilder Builder;
+	FTransforms Transforms;
+
+	// A rotation with a non-uniform scale must scale each column, not just the diagonal.
+	const FQuaternion Rotation = glm::angleAxis(glm::radians(90.f), FVector3D(0.f, 0.f, 1.f));
+	Transforms.Add(FVector3D(1.f, 2.f, 3.f), Rotation, FVector3D(2.f, 3.f, 4.f));
+
+	FMatrix4D World;
+	FMatrix4D WVP;
+	Builder.Build(ViewProjection, Transforms, &World, &WVP);
+
+	F_AssertTrue(IsNear(World * FVector4D(1.f, 0.f, 0.f, 1.f), FVector4D(1.f, 4.f, 3.f, 1.f)),
+		"X should be scaled by 2 and then turned toward Y.");
+	F_AssertTrue(World[3] == FVector4D(1.f, 2.f, 3.f, 1.f), "The last column should be the position.");
+	F_AssertTrue(IsNear(WVP, ViewProjection * World), "WVP should be the view projection times the world.");
+
+	// Every count up to a few SIMD widths, so each tail length is covered.
+	FRandom Random;
+	for (SizeT Count = 0; Count <= 37; ++Count)
+	{
+		Transforms.Clear();
+		AddRandomTransforms(Random, Count, Transforms);
+
+		TVector<FMatrix4D> Worlds(Count);
+		TVector<FMatrix4D> WVPs(Count);
+		Builder.Build(ViewProjection, Transforms, Worlds.data(), WVPs.data());
+
+		F_AssertEqual(Builder.GetStats().Built, Count, "Every transform should be built.");
+
+		for (SizeT I = 0; I < Count; ++I)
+		{
+			const FVector3D Position(Transforms.PositionX[I], Transforms.PositionY[I], Transforms.PositionZ[I]);
+			const FVector3D Scale(Transforms.ScaleX[I], Transforms.ScaleY[I], Transforms.ScaleZ[I]);
+			const FMatrix4D Expected = MakeWorld(Position, GetRotation(Transforms, I), Scale);
+
+			F_AssertTrue(IsNear(Worlds[I], Expected), "World matrix " << I << " of " << Count << " should match GLM.");
+			F_AssertTrue(IsNear(WVPs[I], ViewProjection * Expected), "WVP matrix " << I << " of " << Count << " should match GLM.");
+		}
+	}
+
+	// Either output may be skipped.
+	TVector<FMatrix4D> WVPs(Transforms.GetSize());
+	Builder.Build(ViewProjection, Transforms, nullptr, WVPs.data());
+
+	TVector<FMatrix4D> Worlds(Transforms.GetSize());
+	Builder.Build(ViewProjection, Transforms, Worlds.data(), nullptr);
+
+	for (SizeT I = 0; I < Transforms.GetSize(); ++I)
+	{
+		F_AssertTrue(IsNear(WVPs[I], ViewProjection * Worlds[I]), "Separately built matrices should agree.");
+	}
+}
+
+void FRenderingTest::TransformBuilderBenchmark() const
+{
+	using namespace RenderingTestStructs;
+	typedef std::chrono::high_resolution_clock ClockT;
+
+	const SizeT InstanceCount = 100000;
+	const SizeT Iterations = 20;
+
+	FCamera Camera;
+	Camera.SetPerspective(glm::radians(45.f), 16.f / 9.f, 0.1f, 500.f);
+	Camera.SetView(FVector3D(0.f, 0.f, 5.f), FVector3D(0.f), FVector3D(0.f, 1.f, 0.f));
+	const FMatrix4D ViewProjection = Camera.GetProjection() * Camera.GetView();
+
+	FRandom Random;
+	FTransforms Transforms;
+	Transforms.Reserve(InstanceCount);
+	AddRandomTransforms(Random, InstanceCount, Transforms);
+
+	TVector<FVector3D> Positions;
+	TVector<FQuaternion> Rotations;
+	TVector<FVector3D> Scales;
+
+	for (SizeT I = 0; I < InstanceCount; ++I)
+	{
+		Positions.emplace_back(Transforms.PositionX[I], Transforms.PositionY[I], Transforms.PositionZ[I]);
+		Rotations.push_back(GetRotation(Transforms, I));
+		Scales.emplace_back(Transforms.ScaleX[I], Transforms.ScaleY[I], Transforms.ScaleZ[I]);
+	}
+
+	TVector<FMatrix4D> ExpectedWorlds(InstanceCount);
+	TVector<FMatrix4D> ExpectedWVPs(InstanceCount);
+
+	const auto ScalarStart = ClockT::now();
+	for (SizeT Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (SizeT I = 0; I < InstanceCount; ++I)
+		{
+			ExpectedWorlds[I] = MakeWorld(Positions[I], Rotations[I], Scales[I]);
+			ExpectedWVPs[I] = ViewProjection * ExpectedWorlds[I];
+		}
+	}
+	const auto ScalarEnd = ClockT::now();
+
+	FTransformBuilder Builder;
+	TVector<FMatrix4D> Worlds(InstanceCount);
+	TVector<FMatrix4D> WVPs(InstanceCount);
+
+	const auto SIMDStart = ClockT::now();
+	for (SizeT Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		Builder.Build(ViewProjection, Transforms, Worlds.data(), WVPs.data());
+	}
+	const auto SIMDEnd = ClockT::now();
+
+	bool AllNear = true;
+	for (SizeT I = 0; I < InstanceCount; ++I)
+	{
+		AllNear = AllNear && IsNear(Worlds[I], ExpectedWorlds[I]) && IsNear(WVPs[I], ExpectedWVPs[I]);
+	}
+
+	F_AssertTrue(AllNear, "SIMD matrices should match the GLM reference.");
+
+	FAsyncTaskHandler TaskHandler;
+	FAsyncTaskHandler::FInitParams InitParams;
+	InitParams.MaxThreadCountHint = NThread::GetHardwareThreadCount();
+	TaskHandler.Init(InitParams);
+	TaskHandler.Run();
+
+	std::fill(WVPs.begin(), WVPs.end(), FMatrix4D(0.f));
+
+	const auto ParallelStart = ClockT::now();
+	for (SizeT Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		Builder.Build(ViewProjection, Transforms, Worlds.data(), WVPs.data(), &TaskHandler);
+	}
+	const auto ParallelEnd = ClockT::now();
+
+	AllNear = true;
+	for (SizeT I = 0; I < InstanceCount; ++I)
+	{
+		AllNear = AllNear && IsNear(WVPs[I], ExpectedWVPs[I]);
+	}
+
+	F_AssertTrue(AllNear, "Parallel matrices should match the GLM reference.");
+
+	const SizeT ParallelThreadCount = Builder.GetStats().Threads;
+	const bool bHasSpareThreads = NThread::GetHardwareThreadCount() > 1 && TaskHandler.GetThreadCount() > 0;
+	F_AssertEqual(ParallelThreadCount > 1, bHasSpareThreads, "Only spare hardware threads should help with builds.");
+	F_AssertEqual(Builder.GetStats().Chunks > 1, bHasSpareThreads, "Parallel builds should split the transforms into chunks.");
+
+	if (!bHasSpareThreads)
+	{
+		F_Log("Skipping the transform build crossover sweep, there are no spare hardware threads to build on.");
+	}
+	else
+	{
+		// Finds where forcing the task handler in starts to beat building on the calling thread.
+		const SizeT SweepCounts[] = { 1024, 4096, 16384, 32768, 65536, InstanceCount };
+		SizeT Crossover = 0;
+
+		FTransformBuilder ForcedBuilder;
+		ForcedBuilder.SetMinParallelCount(0);
+
+		for (const SizeT Count : SweepCounts)
+		{
+			FTransforms SweepTransforms;
+			SweepTransforms.Reserve(Count);
+			AddRandomTransforms(Random, Count, SweepTransforms);
+
+			// Smaller inputs run more often so that every count is timed over a similar amount of work.
+			const SizeT SweepIterations = Iterations * InstanceCount / Count;
+
+			const auto SweepSingleStart = ClockT::now();
+			for (SizeT Iteration = 0; Iteration < SweepIterations; ++Iteration)
+			{
+				Builder.Build(ViewProjection, SweepTransforms, Worlds.data(), WVPs.data());
+			}
+			const auto SweepSingleEnd = ClockT::now();
+
+			const auto SweepParallelStart = ClockT::now();
+			for (SizeT Iteration = 0; Iteration < SweepIterations; ++Iteration)
+			{
+				ForcedBuilder.Build(ViewProjection, SweepTransforms, Worlds.data(), WVPs.data(), &TaskHandler);
+			}
+			const auto SweepParallelEnd = ClockT::now();
+
+			const auto ToNS = [SweepIterations](const ClockT::duration Duration)
+			{
+				return std::chrono::duration_cast<std::chrono::nanoseconds>(Duration).count() / static_cast<Int64>(SweepIterations);
+			};
+
+			const Int64 SingleNS = ToNS(SweepSingleEnd - SweepSingleStart);
+			const Int64 ParallelNS = ToNS(SweepParallelEnd - SweepParallelStart);
+
+			const bool bRanInParallel = ForcedBuilder.GetStats().Threads > 1;
+			if (Crossover == 0 && bRanInParallel && ParallelNS < SingleNS)
+			{
+				Crossover = Count;
+			}
+
+			F_Log("Transform build crossover (" << Count << " instances): 1 thread " << SingleNS / 1000 << "us vs "
+				<< ForcedBuilder.GetStats().Threads << " threads " << ParallelNS / 1000 << "us");
+		}
+
+		if (Crossover)
+		{
+			F_Log("Parallel transform builds win from " << Crossover << " instances.  Build goes parallel from "
+				<< Builder.GetMinParallelCount() << ".");
+		}
+		else
+		{
+			F_Log("Parallel transform builds never won up to " << InstanceCount << " instances on "
+				<< NThread::GetHardwareThreadCount() << " hardware threads.  Build goes parallel from "
+				<< Builder.GetMinParallelCount() << ".");
+		}
+	}
+
+	TaskHandler.ForceShutDown();
+	while (!TaskHandler.IsShutDown())
+	{
+		NThread::SleepThread(1);
+	}
+
+	const auto ToUS = [Iterations](const ClockT::duration Duration)
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(Duration).count() / static_cast<Int64>(Iterations);
+	};
+
+	F_Log("World and WVP matrices (" << InstanceCount << " instances): GLM " << ToUS(ScalarEnd - ScalarStart)
+		<< "us vs SIMD " << ToUS(SIMDEnd - SIMDStart) << "us vs SIMD on " << ParallelThreadCount
+		<< " threads " << ToUS(ParallelEnd - ParallelStart) << "us");
+}
+
+void FRenderingTest::TestRenderCommands() const
+{
+	RenderCommandBufferTests();
+	RenderStateCacheTests();
+	RenderStateCacheFrameTests();
+}
+
+void FRenderingTest::RenderCommandBufferTests() const
+{
+	FRenderCommandBuffer ModelCommands;
+	ModelCommands.UseProgram(3);
+	ModelCommands.Uniform(1, FVector3D(1.f, 2.f, 3.f));
+	ModelCommands.DrawElementsInstanced(GL::EMode::Triangles, 36, GL::EType::UInt, 10);
+
+	F_AssertEqual(ModelCommands.GetSize(), 3, "Every command should be recorded.");
+
+	const FRenderCommand& Uniform = ModelCommands.GetCommands()[1];
+	F_AssertTrue(Uniform.Type == ERenderCommand::Uniform, "Commands should be kept in order.");
+	F_AssertEqual(Uniform.Count, 3, "A 3D vector uniform should take up 3 words.");
+	F_AssertEqual(reinterpret_cast<const Float32*>(ModelCommands.GetPayload(Uniform))[2], 3.f, "Uniform payload is incorrect.");
+
+	const FRenderCommand& Draw = ModelCommands.GetCommands()[2];
+	F_AssertEqual(Draw.Count, 36, "Index count is incorrect.");
+	F_AssertEqual(Draw.Extra, 10, "Instance count is incorrect.");
+
+	const UInt32 Vertices[] = { 1, 2, 3, 4 };
+
+	FRenderCommandBuffer ImageCommands;
+	ImageCommands.Uniform(2, 7);
+	ImageCommands.StreamBuffer(GL::EBuffer::Array, 9, Vertices, sizeof(Vertices));
+
+	F_AssertEqual(ImageCommands.GetSize(), 3, "Streaming a buffer should also record its bind.");
+
+	FRenderCommandBuffer FrameCommands;
+	FrameCommands.Append(ModelCommands);
+	FrameCommands.Append(ImageCommands);
+
+	F_AssertEqual(FrameCommands.GetSize(), 6, "Appending should keep every command.");
+
+	// Offsets into the payload and streams must follow the commands to their new buffer.
+	const FRenderCommand& AppendedUniform = FrameCommands.GetCommands()[3];
+	F_AssertEqual(static_cast<Int32>(FrameCommands.GetPayload(AppendedUniform)[0]), 7, "Appended payload should be rebased.");
+
+	const FRenderStream& Stream = FrameCommands.GetStream(FrameCommands.GetCommands()[5]);
+	F_AssertTrue(Stream.Data == Vertices, "Streams should point at the recorded data.");
+	F_AssertEqual(Stream.Size, sizeof(Vertices), "Stream size is incorrect.");
+
+	FrameCommands.Clear();
+	F_AssertEqual(FrameCommands.GetSize(), 0, "Clear should remove every command.");
+}
+
+void FRenderingTest::RenderStateCacheTests() const
+{
+	FRenderCommandBuffer Commands;
+	Commands.UseProgram(3);
+	Commands.UseProgram(3);
+	Commands.Uniform(1, 0);
+	Commands.Uniform(1, 0);
+	Commands.Uniform(1, 1);
+	Commands.ActiveTexture(GL::ETex::T0);
+	Commands.BindTexture(GL::ETexTarget::T2D, 5);
+	Commands.ActiveTexture(GL::ETex::T1);
+	Commands.BindTexture(GL::ETexTarget::T2D, 5);
+	Commands.ActiveTexture(GL::ETex::T0);
+	Commands.BindTexture(GL::ETexTarget::T2D, 5);
+	Commands.Enable(GL::ECapability::Blend);
+	Commands.Enable(GL::ECapability::Blend);
+	Commands.Disable(GL::ECapability::Blend);
+	Commands.DrawArrays(GL::EMode::Triangles, 0, 6);
+	Commands.DrawArrays(GL::EMode::Triangles, 0, 6);
+
+	FRenderStateCache Cache;
+
+	TVector<bool> Issued;
+	for (const FRenderCommand& Command : Commands.GetCommands())
+	{
+		Issued.push_back(Cache.Apply(Commands, Command));
+	}
+
+	const TVector<bool> Expected = {
+		true, false, true, false, true, true, true, true, true, true, false, true, false, true, true, true };
+
+	F_AssertTrue(Issued == Expected, "Only commands that don't change the state should be eliminated.");
+
+	const FRenderStateCacheStats& Stats = Cache.GetStats();
+	F_AssertEqual(Stats.Commands, 16, "Every command should be counted.");
+	F_AssertEqual(Stats.Issued, 12, "Issued count is incorrect.");
+	F_AssertEqual(Stats.EliminatedBinds, 2, "Rebinding the same program or texture should be eliminated.");
+	F_AssertEqual(Stats.EliminatedUniforms, 1, "Setting a uniform to its value should be eliminated.");
+	F_AssertEqual(Stats.EliminatedStateChanges, 1, "Enabling an enabled capability should be eliminated.");
+	F_AssertEqual(Stats.GetEliminated(), 4, "Eliminated count is incorrect.");
+
+	// Binding a vertex array replaces the element array buffer binding.
+	FRenderCommandBuffer BufferCommands;
+	BufferCommands.BindVertexArray(7);
+	BufferCommands.BindBuffer(GL::EBuffer::ElementArray, 2);
+	BufferCommands.BindBuffer(GL::EBuffer::ElementArray, 2);
+	BufferCommands.BindVertexArray(8);
+	BufferCommands.BindBuffer(GL::EBuffer::ElementArray, 2);
+
+	Cache.ResetStats();
+	for (const FRenderCommand& Command : BufferCommands.GetCommands())
+	{
+		Cache.Apply(BufferCommands, Command);
+	}
+
+	F_AssertEqual(Cache.GetStats().EliminatedBinds, 1, "Vertex array binds should forget the element array buffer.");
+}
+
+void FRenderingTest::RenderStateCacheFrameTests() const
+{
+	const FMatrix4D Projection(0.5f);
+
+	// Records what the image pass records for the same frame each time.
+	auto RecordFrame = [&Projection](FRenderCommandBuffer& Commands)
+	{
+		Commands.Clear();
+		Commands.ActiveTexture(GL::ETex::T0);
+		Commands.Enable(GL::ECapability::Blend);
+		Commands.BlendFunc(GL::EBlend::SrcAlpha, GL::EBlend::OneMinusSrcAlpha);
+		Commands.UseProgram(3);
+		Commands.Uniform(1, Projection);
+		Commands.Uniform(2, 0);
+
+		for (UInt32 I = 0; I < 8; ++I)
+		{
+			Commands.BindTexture(GL::ETexTarget::T2D, 10 + I / 4);
+			Commands.DrawArrays(GL::EMode::Triangles, I * 6, 6);
+		}
+	};
+
+	FRenderCommandBuffer Commands;
+	FRenderStateCache Cache;
+
+	auto Replay = [&Commands, &Cache]()
+	{
+		Cache.Invalidate();
+		Cache.ResetStats();
+
+		for (const FRenderCommand& Command : Commands.GetCommands())
+		{
+			Cache.Apply(Commands, Command);
+		}
+
+		return Cache.GetStats();
+	};
+
+	RecordFrame(Commands);
+	const FRenderStateCacheStats FirstFrame = Replay();
+	F_AssertEqual(FirstFrame.EliminatedBinds, 6, "Only texture changes should be bound.");
+	F_AssertEqual(FirstFrame.EliminatedUniforms, 0, "The first frame should upload every uniform.");
+
+	RecordFrame(Commands);
+	const FRenderStateCacheStats SecondFrame = Replay();
+	F_AssertEqual(SecondFrame.EliminatedBinds, 6, "Invalidate should forget the bound objects.");
+	F_AssertEqual(SecondFrame.EliminatedUniforms, 2, "Uniform values should be kept across Invalidate.");
+
+	Cache.Reset();
+	const FRenderStateCacheStats AfterReset = Replay();
+	F_AssertEqual(AfterReset.EliminatedUniforms, 0, "Reset should forget uniform values.");
+
+	F_Log("Command replay (" << SecondFrame.Commands << " commands): " << SecondFrame.Issued << " issued, "
+		<< SecondFrame.EliminatedBinds << " binds, " << SecondFrame.EliminatedUniforms << " uniforms and "
+		<< SecondFrame.EliminatedStateChanges << " state changes eliminated");
+}
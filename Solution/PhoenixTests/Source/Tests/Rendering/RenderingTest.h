@@ -0,0 +1,70 @@
+#ifndef PHOENIX_RENDERING_TEST_H
+#define PHOENIX_RENDERING_TEST_H
+
+namespace Phoenix
+{
+	class FRenderingTest
+	{
+	public:
+		void RunTests() const;
+
+	private:
+		void TestAssetRequests() const;
+
+		void AssetRequestBasicTests() const;
+		void AssetRequestBackoffTests() const;
+		void AssetRequestTaskFailureTests() const;
+
+		void TestCulling() const;
+
+		void BoundsTests() const;
+		void CullingBasicTests() const;
+		void CullingBenchmark() const;
+
+		void TestRenderQueue() const;
+
+		void RenderQueueKeyTests() const;
+		void RenderQueueSortTests() const;
+		void RenderQueueBenchmark() const;
+
+		void TestInstancing() const;
+
+		void InstanceBatcherBasicTests() const;
+		void InstanceBatcherDrawCountTests() const;
+
+		void TestSprites() const;
+
+		void SpriteVertexTests() const;
+		void SpriteBatchCountTests() const;
+
+		void TestGLRecorder() const;
+
+		void GLRecorderBindTests() const;
+		void GLRecorderFrameTests() const;
+		void HeadlessWindowTests() const;
+		void GFXEngineRecordingTests() const;
+
+		void TestInterpolation() const;
+
+		void InterpolationTests() const;
+		void NullSceneFrameTests() const;
+
+		void TestRenderSync() const;
+
+		void RenderSyncBasicTests() const;
+		void RenderSyncBenchmark() const;
+
+		void TestTransforms() const;
+
+		void TransformBuilderBasicTests() const;
+		void TransformBuilderBenchmark() const;
+
+		void TestRenderCommands() const;
+
+		void RenderCommandBufferTests() const;
+		void RenderStateCacheTests() const;
+		void RenderStateCacheFrameTests() const;
+	};
+}
+
+#endif
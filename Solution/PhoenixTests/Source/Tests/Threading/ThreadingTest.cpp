@@ -0,0 +1,318 @@
+#include "Tests/Threading/ThreadingTest.h"
+
+#include "Utility/Containers/Vector.h"
+#include "Utility/Debug/Assert.h"
+#include "Utility/Misc/Primitives.h"
+#include "Utility/Misc/Timer.h"
+#include "Utility/Threading/FramePacer.h"
+#include "Utility/Threading/MPSCRingBuffer.h"
+#include "Utility/Threading/Thread.h"
+#include "Utility/Threading/TripleBuffer.h"
+
+using namespace Phoenix;
+
+namespace ThreadingTestStructs
+{
+	// Check is written to match Value, so a torn read shows up as a mismatch.
+	struct FFrame
+	{
+		UInt64 Value{ 0 };
+		UInt64 Check{ ~0ull };
+	};
+
+	static void SpinForMicroseconds(const UInt32 Microseconds)
+	{
+		const Float32 EndTime = FHighResolutionTimer::GetTimeInSeconds() + Microseconds * 0.000001f;
+		while (FHighResolutionTimer::GetTimeInSeconds() < EndTime)
+		{
+		}
+	}
+}
+
+void FThreadingTest::RunTests() const
+{
+	TestMPSCRingBuffer();
+	TestFramePacer();
+	TestTripleBuffer();
+}
+
+void FThreadingTest::TestMPSCRingBuffer() const
+{
+	RingBufferBasicTests();
+	RingBufferFullTests();
+	RingBufferStepGatingTests();
+	RingBufferMultiProducerTests();
+}
+
+void FThreadingTest::RingBufferBasicTests() const
+{
+	TMPSCRingBuffer<UInt32, 4> RingBuffer;
+
+	F_AssertTrue(RingBuffer.Peek() == nullptr, "Ring buffer should be empty.");
+	F_AssertEqual(RingBuffer.GetSizeApprox(), 0, "Ring buffer should be empty.");
+
+	F_AssertTrue(RingBuffer.TryPush(1), "Push failed.");
+	F_AssertTrue(RingBuffer.TryPush(2), "Push failed.");
+	F_AssertEqual(RingBuffer.GetSizeApprox(), 2, "Ring buffer size is incorrect.");
+
+	const UInt32* const Front = RingBuffer.Peek();
+	F_AssertTrue(Front != nullptr, "Peek failed.");
+	F_AssertEqual(*Front, 1, "Peek should return the oldest item.");
+	RingBuffer.Pop();
+
+	UInt32 Item = 0;
+	F_AssertTrue(RingBuffer.TryPop(Item), "Pop failed.");
+	F_AssertEqual(Item, 2, "Items should be popped in order.");
+	F_AssertTrue(!RingBuffer.TryPop(Item), "Ring buffer should be empty.");
+
+	// Wrap around the storage a few times.
+	for (UInt32 I = 0; I < 10; ++I)
+	{
+		F_AssertTrue(RingBuffer.TryPush(I), "Push failed.");
+		F_AssertTrue(RingBuffer.TryPop(Item), "Pop failed.");
+		F_AssertEqual(Item, I, "Items should be popped in order.");
+	}
+}
+
+void FThreadingTest::RingBufferFullTests() const
+{
+	TMPSCRingBuffer<UInt32, 4> RingBuffer;
+
+	for (UInt32 I = 0; I < RingBuffer.GetCapacity(); ++I)
+	{
+		F_AssertTrue(RingBuffer.TryPush(I), "Push failed.");
+	}
+
+	F_AssertTrue(!RingBuffer.TryPush(4), "Push should fail when the ring buffer is full.");
+
+	UInt32 Item = 0;
+	F_AssertTrue(RingBuffer.TryPop(Item), "Pop failed.");
+	F_AssertEqual(Item, 0, "Items should be popped in order.");
+	F_AssertTrue(RingBuffer.TryPush(4), "Push should succeed once a slot is free.");
+
+	for (UInt32 I = 1; I <= RingBuffer.GetCapacity(); ++I)
+	{
+		F_AssertTrue(RingBuffer.TryPop(Item), "Pop failed.");
+		F_AssertEqual(Item, I, "Items should be popped in order.");
+	}
+}
+
+void FThreadingTest::RingBufferStepGatingTests() const
+{
+	// Mirrors how the game thread handles events: only those stamped at or before the
+	// step being simulated are popped, and newer ones wait for a later step.
+	TMPSCRingBuffer<Float32, 8> RingBuffer;
+
+	const Float32 TimeStamps[] = { 0.010f, 0.015f, 0.020f, 0.045f, 0.050f };
+	for (const Float32 TimeStamp : TimeStamps)
+	{
+		F_AssertTrue(RingBuffer.TryPush(TimeStamp), "Push failed.");
+	}
+
+	TVector<Float32> Handled;
+	auto StepTo = [&RingBuffer, &Handled](const Float32 StepTimeS)
+	{
+		return RingBuffer.PopWhile(
+			[StepTimeS](const Float32 TimeStamp) { return TimeStamp <= StepTimeS; },
+			[&Handled](const Float32 TimeStamp) { Handled.push_back(TimeStamp); });
+	};
+
+	F_AssertEqual(StepTo(0.005f), 0, "Events newer than the step should stay queued.");
+	F_AssertEqual(StepTo(0.020f), 3, "Events up to and including the step should be handled.");
+	F_AssertEqual(*RingBuffer.Peek(), 0.045f, "The first event newer than the step should stay at the front.");
+	F_AssertEqual(StepTo(0.040f), 0, "A step that doesn't reach the next event should handle nothing.");
+
+	// A newer event behind an older one must not be handled out of order.
+	F_AssertTrue(RingBuffer.TryPush(0.030f), "Push failed.");
+	F_AssertEqual(StepTo(0.035f), 0, "Events behind a newer one should wait for it.");
+
+	F_AssertEqual(StepTo(0.060f), 3, "Every remaining event should be handled.");
+	F_AssertTrue(RingBuffer.Peek() == nullptr, "Ring buffer should be empty.");
+
+	const TVector<Float32> Expected = { 0.010f, 0.015f, 0.020f, 0.045f, 0.050f, 0.030f };
+	F_AssertTrue(Handled == Expected, "Events should be handled in the order they were pushed.");
+}
+
+void FThreadingTest::RingBufferMultiProducerTests() const
+{
+	const UInt32 ProducerCount = 4;
+	const UInt32 ItemsPerProducer = 20000;
+	const UInt32 ProducerShift = 24;
+
+	TMPSCRingBuffer<UInt32, 64> RingBuffer;
+	TVector<FThread> Producers;
+
+	for (UInt32 P = 0; P < ProducerCount; ++P)
+	{
+		Producers.emplace_back([&RingBuffer, P, ItemsPerProducer, ProducerShift]()
+		{
+			for (UInt32 I = 0; I < ItemsPerProducer; ++I)
+			{
+				const UInt32 Item = (P << ProducerShift) | I;
+				while (!RingBuffer.TryPush(Item))
+				{
+					NThread::YieldThread();
+				}
+			}
+		});
+	}
+
+	// Items from a single producer must arrive in the order they were pushed.
+	TVector<UInt32> NextExpected(ProducerCount, 0);
+	UInt32 ReceivedCount = 0;
+	bool IsOrdered = true;
+
+	while (ReceivedCount < ProducerCount * ItemsPerProducer)
+	{
+		UInt32 Item = 0;
+		if (!RingBuffer.TryPop(Item))
+		{
+			NThread::YieldThread();
+			continue;
+		}
+
+		const UInt32 Producer = Item >> ProducerShift;
+		const UInt32 Index = Item & ((1 << ProducerShift) - 1);
+
+		IsOrdered &= Producer < ProducerCount && Index == NextExpected[Producer];
+		++NextExpected[Producer];
+		++ReceivedCount;
+	}
+
+	for (FThread& Producer : Producers)
+	{
+		Producer.join();
+	}
+
+	F_AssertTrue(IsOrdered, "Items from each producer should be received in order.");
+	F_AssertTrue(RingBuffer.Peek() == nullptr, "Ring buffer should be empty.");
+}
+
+void FThreadingTest::TestFramePacer() const
+{
+	const Float32 FramesPerSec = 500.f;
+	const UInt32 FrameCount = 50;
+
+	FFramePacer FramePacer;
+	FramePacer.Init(FramesPerSec);
+
+	const Float32 StartTime = FHighResolutionTimer::GetTimeInSeconds();
+	for (UInt32 I = 0; I < FrameCount; ++I)
+	{
+		FramePacer.WaitForNextFrame();
+	}
+	const Float32 ElapsedTime = FHighResolutionTimer::GetTimeInSeconds() - StartTime;
+
+	const FFramePacerStats& Stats = FramePacer.GetStats();
+	F_AssertEqual(Stats.FrameCount, FrameCount, "Every wait should record a frame.");
+
+	UInt32 BucketTotal = 0;
+	for (const UInt32 BucketCount : Stats.Buckets)
+	{
+		BucketTotal += BucketCount;
+	}
+
+	F_AssertEqual(BucketTotal, FrameCount, "Every frame should land in a lateness bucket.");
+	F_AssertTrue(Stats.MaxLatenessNS >= 0, "Lateness should never be negative.");
+
+	// Waits never return before their deadline, so the loop can't finish early.
+	const Float32 MinElapsedTime = (FrameCount - 1) / FramesPerSec;
+	F_AssertTrue(ElapsedTime >= MinElapsedTime, "Frame pacer returned before its deadline.");
+
+	const Float32 SpinMargin = FramePacer.GetSpinMarginSeconds();
+	F_AssertTrue(SpinMargin > 0.f && SpinMargin <= 0.004f, "Spin margin should stay within its limits.");
+}
+
+void FThreadingTest::TestTripleBuffer() const
+{
+	TripleBufferBasicTests();
+
+	// Producer faster than consumer, consumer faster than producer, and both flat out.
+	TripleBufferStressTests(0, 20);
+	TripleBufferStressTests(20, 0);
+	TripleBufferStressTests(0, 0);
+}
+
+void FThreadingTest::TripleBufferBasicTests() const
+{
+	TTripleBuffer<UInt32> TripleBuffer;
+
+	F_AssertTrue(!TripleBuffer.Acquire(), "Nothing has been published yet.");
+
+	TripleBuffer.GetWriteBuffer() = 1;
+	TripleBuffer.Publish();
+
+	F_AssertTrue(TripleBuffer.Acquire(), "A value was published.");
+	F_AssertEqual(TripleBuffer.GetReadBuffer(), 1, "The published value should be read.");
+	F_AssertTrue(!TripleBuffer.Acquire(), "Nothing new has been published.");
+	F_AssertEqual(TripleBuffer.GetReadBuffer(), 1, "The read buffer should keep its value.");
+
+	TripleBuffer.GetWriteBuffer() = 2;
+	TripleBuffer.Publish();
+	TripleBuffer.GetWriteBuffer() = 3;
+	TripleBuffer.Publish();
+
+	F_AssertTrue(TripleBuffer.Acquire(), "A value was published.");
+	F_AssertEqual(TripleBuffer.GetReadBuffer(), 3, "Only the latest value should be read.");
+	F_AssertEqual(TripleBuffer.GetDroppedCount(), 1, "The stale value should have been dropped.");
+}
+
+void FThreadingTest::TripleBufferStressTests(const UInt32 ProducerDelayUS, const UInt32 ConsumerDelayUS) const
+{
+	using namespace ThreadingTestStructs;
+
+	const UInt64 FrameCount = 20000;
+
+	TTripleBuffer<FFrame> TripleBuffer;
+	TAtomic<bool> IsProducerDone{ false };
+
+	FThread Producer([&TripleBuffer, &IsProducerDone, FrameCount, ProducerDelayUS]()
+	{
+		for (UInt64 I = 1; I <= FrameCount; ++I)
+		{
+			FFrame& Frame = TripleBuffer.GetWriteBuffer();
+			Frame.Value = I;
+			Frame.Check = ~I;
+			TripleBuffer.Publish();
+
+			SpinForMicroseconds(ProducerDelayUS);
+		}
+
+		IsProducerDone = true;
+	});
+
+	UInt64 LastValue = 0;
+	UInt64 AcquiredCount = 0;
+	bool IsIntact = true;
+	bool IsIncreasing = true;
+
+	for (;;)
+	{
+		// Read the flag first so that a final publish can't be missed.
+		const bool WasProducerDone = IsProducerDone;
+
+		if (TripleBuffer.Acquire())
+		{
+			const FFrame& Frame = TripleBuffer.GetReadBuffer();
+
+			IsIntact &= Frame.Check == ~Frame.Value;
+			IsIncreasing &= Frame.Value > LastValue;
+
+			LastValue = Frame.Value;
+			++AcquiredCount;
+
+			SpinForMicroseconds(ConsumerDelayUS);
+		}
+		else if (WasProducerDone)
+		{
+			break;
+		}
+	}
+
+	Producer.join();
+
+	F_AssertTrue(IsIntact, "A frame was read while it was being written.");
+	F_AssertTrue(IsIncreasing, "Frames should only ever move forward.");
+	F_AssertEqual(LastValue, FrameCount, "The final frame should always be read.");
+	F_AssertTrue(AcquiredCount <= FrameCount, "No frame should be read twice.");
+}
@@ -0,0 +1,30 @@
+#ifndef PHOENIX_THREADING_TEST_H
+#define PHOENIX_THREADING_TEST_H
+
+#include "Utility/Misc/Primitives.h"
+
+namespace Phoenix
+{
+	class FThreadingTest
+	{
+	public:
+		void RunTests() const;
+
+	private:
+		void TestMPSCRingBuffer() const;
+
+		void RingBufferBasicTests() const;
+		void RingBufferFullTests() const;
+		void RingBufferStepGatingTests() const;
+		void RingBufferMultiProducerTests() const;
+
+		void TestFramePacer() const;
+
+		void TestTripleBuffer() const;
+
+		void TripleBufferBasicTests() const;
+		void TripleBufferStressTests(const UInt32 ProducerDelayUS, const UInt32 ConsumerDelayUS) const;
+	};
+}
+
+#endif
@@ -1,5 +1,5 @@
 workspace "PhoenixEngine"
-	configurations { "Debug", "Release" }
+	configurations { "Debug", "Release", "Recording" }
 	platforms{ "x32", "x64" }
 	
 	includedirs { "PhoenixEngine/Source", "Game/Source", "PhoenixTests/Source", "PhoenixBuild/Source", "Libraries/Include/", "Libraries/Include/FBX/", "Libraries/Include/GLM/" }
@@ -32,6 +32,14 @@ workspace "PhoenixEngine"
 		{
 			["HEADER_SEARCH_PATHS"] = "../Libraries/Include/**"
 		}
+
+	-- A debug build whose GL calls are recorded rather than issued, so the tests can run the engine without a context
+	-- and assert on its draw calls. Rendering stays on the calling thread so the recorder can be read between frames.
+	filter "configurations:Recording"
+		defines { "PHOENIX_GFX_USE_RECORDING_GL=1", "PHOENIX_GFX_ENABLE_MULTI_THREADED_RENDERING=0" }
+		libdirs { "Libraries/Lib/Debug.%{cfg.platform}/**", "Libraries/Lib/Debug/**" }
+
+	filter {}
 					
 project "PhoenixEngine"
 	kind "StaticLib"
@@ -80,6 +88,12 @@ project "PhoenixEngine"
 		defines { "NDEBUG" }
 		optimize "On"
 
+	filter "configurations:Recording"
+		targetdir "Build/Recording"
+		debugdir "Build/Recording"
+		defines { "DEBUG" }
+		flags { "Symbols" }
+
 	configuration "gmake"
 		linkoptions  { "-std=c++1y" }
 		buildoptions { "-std=c++1y" }
@@ -123,6 +137,12 @@ project "Game"
 		defines { "NDEBUG" }
 		optimize "On"
 
+	filter "configurations:Recording"
+		targetdir "Build/Recording"
+		debugdir "Build/Recording"
+		defines { "DEBUG" }
+		flags { "Symbols" }
+
 	configuration "gmake"
 		linkoptions  { "-std=c++1y" }
 		buildoptions { "-std=c++1y" }
@@ -166,6 +186,12 @@ project "PhoenixTests"
 		defines { "NDEBUG" }
 		optimize "On"
 
+	filter "configurations:Recording"
+		targetdir "Build/Recording"
+		debugdir "Build/Recording"
+		defines { "DEBUG" }
+		flags { "Symbols" }
+
 	configuration "gmake"
 		linkoptions  { "-std=c++1y" }
 		buildoptions { "-std=c++1y" }
@@ -209,6 +235,12 @@ project "PhoenixBuild"
 		defines { "NDEBUG" }
 		optimize "On"
 
+	filter "configurations:Recording"
+		targetdir "Build/Recording"
+		debugdir "Build/Recording"
+		defines { "DEBUG" }
+		flags { "Symbols" }
+
 	configuration "gmake"
 		linkoptions  { "-std=c++1y" }
 		buildoptions { "-std=c++1y" }